@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ *
+ * NOTE: This file is licensed under GPL-3.0-or-later (default).
+ * A commercial license can be purchased from Floyd M. Chitalu.
+ *
+ * License details:
+ *
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ *
+ * The commercial license options is for users that wish to use MCUT in
+ * their products for comercial purposes but do not wish to release their
+ * software products under the GPL license.
+ *
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#ifndef MCUT_ARENA_H_
+#define MCUT_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+/*
+    Monotonic memory resource for the temporaries of a dispatch call.
+
+    Memory is handed out by bumping a pointer through fixed-size blocks and is never
+    freed individually. Instead, reset() releases everything at once (when the dispatch
+    has finished) while keeping the blocks around so that the next dispatch can reuse them.
+    In the steady state (i.e. repeated dispatches on similar inputs) this means that the
+    containers which allocate from the arena make no calls to the global allocator.
+
+    Each thread bump-allocates from its own block, so the only synchronisation is
+    when a thread needs a new block.
+*/
+class arena_t {
+public:
+    explicit arena_t(std::size_t block_size = (std::size_t(1) << 20))
+        : m_block_size(block_size)
+        , m_next_block(0)
+        , m_id(next_arena_id())
+        , m_generation(0)
+    {
+    }
+
+    arena_t(const arena_t&) = delete;
+    arena_t& operator=(const arena_t&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        cursor_t& c = thread_cursor();
+
+        if (c.arena_id != m_id || c.generation != m_generation.load(std::memory_order_acquire)) {
+            c.arena_id = m_id; // first allocation by this thread since the last reset
+            c.generation = m_generation.load(std::memory_order_acquire);
+            c.cur = nullptr;
+            c.end = nullptr;
+        }
+
+        char* p = align_up(c.cur, alignment);
+
+        if (p == nullptr || p + bytes > c.end) {
+            if (bytes + alignment > m_block_size / 4) {
+                return allocate_oversized(bytes, alignment); // don't waste the rest of the current block
+            }
+
+            acquire_block(c);
+            p = align_up(c.cur, alignment);
+        }
+
+        c.cur = p + bytes;
+        return p;
+    }
+
+    // Releases all allocations at once. Must only be called when no thread is allocating from
+    // (or still using memory of) the arena e.g. at the end of a dispatch call.
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_oversized_blocks.clear();
+        m_next_block = 0;
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // number of bytes held by the arena (including memory that is currently unused)
+    std::size_t capacity()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_blocks.size() * m_block_size;
+    }
+
+private:
+    struct cursor_t {
+        std::uint64_t arena_id;
+        std::uint32_t generation;
+        char* cur;
+        char* end;
+    };
+
+    static cursor_t& thread_cursor()
+    {
+        static thread_local cursor_t cursor = { 0, 0, nullptr, nullptr };
+        return cursor;
+    }
+
+    // Cursors identify their arena by a unique id rather than by its address, since a new
+    // arena may be created at the address of one that has been destroyed.
+    static std::uint64_t next_arena_id()
+    {
+        static std::atomic<std::uint64_t> counter(0);
+        return ++counter;
+    }
+
+    static char* align_up(char* p, std::size_t alignment)
+    {
+        if (p == nullptr) {
+            return nullptr;
+        }
+        const std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<char*>((v + (alignment - 1)) & ~(std::uintptr_t)(alignment - 1));
+    }
+
+    void acquire_block(cursor_t& c)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_next_block == m_blocks.size()) { // all blocks are in use
+            m_blocks.emplace_back(new char[m_block_size]);
+        }
+
+        char* block = m_blocks[m_next_block++].get();
+        c.cur = block;
+        c.end = block + m_block_size;
+    }
+
+    void* allocate_oversized(std::size_t bytes, std::size_t alignment)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_oversized_blocks.emplace_back(new char[bytes + alignment]);
+        return align_up(m_oversized_blocks.back().get(), alignment);
+    }
+
+    const std::size_t m_block_size;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<char[]>> m_blocks; // kept across resets
+    std::size_t m_next_block; // index of the next free block in "m_blocks"
+    std::vector<std::unique_ptr<char[]>> m_oversized_blocks; // freed on reset
+    const std::uint64_t m_id;
+    std::atomic<std::uint32_t> m_generation;
+};
+
+// Standard allocator that takes memory from an arena_t. A default-constructed allocator (i.e.
+// one without an arena) falls back to the global allocator, so containers using it behave like
+// normal containers when no arena is available.
+template <typename T>
+class arena_allocator_t {
+public:
+    typedef T value_type;
+
+    arena_allocator_t(arena_t* arena = nullptr) noexcept
+        : m_arena(arena)
+    {
+    }
+
+    template <typename U>
+    arena_allocator_t(const arena_allocator_t<U>& other) noexcept
+        : m_arena(other.get_arena())
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (m_arena == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+        if (m_arena == nullptr) {
+            ::operator delete(p);
+        }
+        // else: released in bulk by arena_t::reset()
+    }
+
+    arena_t* get_arena() const noexcept
+    {
+        return m_arena;
+    }
+
+private:
+    arena_t* m_arena;
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator_t<T>& a, const arena_allocator_t<U>& b) noexcept
+{
+    return a.get_arena() == b.get_arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator_t<T>& a, const arena_allocator_t<U>& b) noexcept
+{
+    return !(a == b);
+}
+
+template <typename K, typename V>
+using arena_unordered_map_t = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, arena_allocator_t<std::pair<const K, V>>>;
+
+// returns an empty map whose nodes are allocated from "arena"
+template <typename K, typename V>
+arena_unordered_map_t<K, V> make_arena_unordered_map(arena_t* arena)
+{
+    return arena_unordered_map_t<K, V>(0, std::hash<K>(), std::equal_to<K>(), arena_allocator_t<std::pair<const K, V>>(arena));
+}
+
+#endif // MCUT_ARENA_H_
@@ -25,13 +25,20 @@
 #include "mcut/internal/hmesh.h"
 #include "mcut/internal/math.h"
 
+#include <memory>
+#include <string>
+
 #if defined(MCUT_MULTI_THREADED)
 #include "mcut/internal/tpool.h"
 #endif
 
 // OIBVH is over 2-3x faster than the alternative (classic) BVH approaches.
 // Our alternative BVH implementations follow: https://www.pbrt.org/chapters/pbrt-2ed-chap4.pdf
+// The classic (SAH) BVH can be selected with MCUT_USE_CLASSIC_BVH, which may be
+// preferable for meshes whose faces are poorly ordered along a Morton curve.
+#if !defined(MCUT_USE_CLASSIC_BVH)
 #define USE_OIBVH 1
+#endif
 
 // Expands a 10-bit integer into 30 bits by inserting 2 zeros after each bit.
 extern unsigned int expandBits(unsigned int v);
@@ -39,6 +46,58 @@ extern unsigned int expandBits(unsigned int v);
 // Calculates a 30-bit Morton code for the given 3D point located within the unit cube [0,1].
 extern unsigned int morton3D(float x, float y, float z);
 
+// Exact (orient3d) test of whether two faces cannot intersect because the vertices of one lie strictly
+// on the same side of the plane of the other. A plane is only inferred from triangles, since
+// the vertices of larger polygons need not be coplanar. Returns false if the test is inconclusive.
+extern bool faces_are_separated_by_plane(
+    const hmesh_t& meshA,
+    const fd_t faceA,
+    const hmesh_t& meshB,
+    const fd_t faceB);
+
+// compute the bounding box of each face of a mesh, optionally enlarged by "slightEnlargmentEps"
+extern void compute_face_bboxes(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    const hmesh_t& mesh,
+    std::vector<bounding_box_t<vec3>>& face_bboxes,
+    const double& slightEnlargmentEps = double(0.0));
+
+// Heuristic that decides whether a uniform grid (rather than a BVH) should be used to find the
+// potentially intersecting faces of "mesh" and another mesh. Grids are preferable for large meshes
+// whose faces have similar sizes (e.g. scans and terrains), which is estimated from a sample of faces.
+extern bool prefer_uniform_grid(const hmesh_t& mesh);
+
+// Broad-phase collision detection with a uniform grid. Source-mesh faces are binned into the cells
+// of a grid that spans the region in which the bounding boxes of both meshes overlap, and each
+// cut-mesh face is then tested against the source-mesh faces in the cells it covers. Source-mesh
+// faces that overlap many cells are kept in an overflow list that is tested by every cut-mesh face.
+// The output has the same form as that of "intersectOIBVHs" (i.e. cut-mesh faces are offsetted by
+// the number of source-mesh faces).
+extern void intersect_uniform_grid(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
+    const std::vector<bounding_box_t<vec3>>& srcMeshFaceBBoxes,
+    const std::vector<bounding_box_t<vec3>>& cutMeshFaceBBoxes,
+    // if both meshes are given, then pairs of faces that are separated by a plane
+    // (see "faces_are_separated_by_plane") are not reported
+    const hmesh_t* srcMesh = nullptr,
+    const hmesh_t* cutMesh = nullptr);
+
+// Find the pairs of faces of "mesh" that intersect (including touching). Candidate pairs are found
+// by querying a BVH of the mesh with the bounding box of each face, and are then tested exactly (faces
+// are tested as fans of triangles). Pairs of faces that share a vertex are not tested. Each pair is
+// reported once, with the smaller face index first.
+extern void find_self_intersecting_faces(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    const hmesh_t& mesh,
+    std::vector<std::pair<fd_t, fd_t>>& intersecting_face_pairs);
+
 #if defined(USE_OIBVH)
 
 // TODO: just use std::pair
@@ -107,12 +166,63 @@ extern void build_oibvh(
     std::vector<bounding_box_t<vec3>>& face_bboxes,
     const double& slightEnlargmentEps = double(0.0));
 
+class mapped_file_t;
+
+// Read-only view of the arrays of an Oi-BVH (see "build_oibvh"). The arrays are either owned by
+// std::vectors (a BVH that was built), or by a memory-mapped file (a BVH that was loaded with
+// "load_oibvh"), which stays mapped for as long as "mapping" is referenced.
+struct oibvh_view_t {
+    array_view_t<bounding_box_t<vec3>> bvhAABBs;
+    array_view_t<fd_t> bvhLeafNodeFaces;
+    array_view_t<bounding_box_t<vec3>> face_bboxes;
+    std::shared_ptr<const mapped_file_t> mapping; // null if the arrays are owned by std::vectors
+};
+
 extern void intersectOIBVHs(
     std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
-    const std::vector<bounding_box_t<vec3>>& srcMeshBvhAABBs,
-    const std::vector<fd_t>& srcMeshBvhLeafNodeFaces,
-    const std::vector<bounding_box_t<vec3>>& cutMeshBvhAABBs,
-    const std::vector<fd_t>& cutMeshBvhLeafNodeFaces);
+    const array_view_t<bounding_box_t<vec3>>& srcMeshBvhAABBs,
+    const array_view_t<fd_t>& srcMeshBvhLeafNodeFaces,
+    const array_view_t<bounding_box_t<vec3>>& cutMeshBvhAABBs,
+    const array_view_t<fd_t>& cutMeshBvhLeafNodeFaces,
+    // if both meshes are given, then leaf-node pairs whose faces are separated by a plane
+    // (see "faces_are_separated_by_plane") are not reported
+    const hmesh_t* srcMesh = nullptr,
+    const hmesh_t* cutMesh = nullptr);
+
+// Version of the binary layout written by "save_oibvh". This must be incremented whenever
+// the layout or the way that "build_oibvh" orders nodes changes, so that stale files are ignored.
+#define MCUT_OIBVH_FILE_VERSION 2
+
+// compute a 64-bit hash of the geometry and connectivity of a mesh (and the BVH enlargement
+// epsilon), which is used to identify the serialized BVH of the mesh. The vertex and face counts
+// of the mesh are stored alongside the hash, so that a hash collision between meshes of different
+// sizes is detected when the file is loaded
+extern uint64_t compute_mesh_content_hash(
+    const hmesh_t& mesh,
+    const double& slightEnlargmentEps = double(0.0));
+
+// write the Oi-BVH of a mesh (as produced by "build_oibvh") to a binary file.
+// The file is first written under a temporary name and then renamed, so that concurrent
+// readers (e.g. other processes) never observe a partially written file.
+extern bool save_oibvh(
+    const std::string& fpath,
+    const uint64_t mesh_content_hash,
+    const uint32_t num_mesh_vertices,
+    const uint32_t num_mesh_faces,
+    const std::vector<bounding_box_t<vec3>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    const std::vector<bounding_box_t<vec3>>& face_bboxes);
+
+// read the Oi-BVH of a mesh from a file that was written with "save_oibvh". The file is
+// memory-mapped read-only and the arrays of "bvh" point directly into the mapping (nothing is
+// copied), so that its pages can be shared by processes loading the same file.
+// Returns false if the file does not exist or it was written for a different mesh or file version.
+extern bool load_oibvh(
+    const std::string& fpath,
+    const uint64_t mesh_content_hash,
+    const uint32_t num_mesh_vertices,
+    const uint32_t num_mesh_faces,
+    oibvh_view_t& bvh);
 #else
 typedef bounding_box_t<vec3> BBox;
 static inline BBox Union(const BBox& a, const BBox& b)
@@ -139,6 +249,11 @@ enum class SplitMethod {
 // of its bounding box, its complete bounding box, and its index in
 // the primitives array
 struct BVHPrimitiveInfo {
+    BVHPrimitiveInfo()
+        : primitiveNumber(-1)
+    {
+    }
+
     BVHPrimitiveInfo(int pn, const BBox& b)
         : primitiveNumber(pn)
         , bounds(b)
@@ -151,63 +266,6 @@ struct BVHPrimitiveInfo {
     bounding_box_t<vec3> bounds;
 };
 
-// Each BVHBuildNode represents a node of the BVH. All nodes store a BBox, which stores
-// the bounds of all of the children beneath the node. Each interior node stores pointers to
-// its two children in children. Interior nodes also record the coordinate axis along which
-// primitives were sorted for distribution to their two children; this information is used to
-// improve the performance of the traversal algorithm. Leaf nodes need to record which
-// primitive or primitives are stored in them; the elements of the BVHAccel::primitives
-// array from the offset firstPrimOffset up to but not including firstPrimOffset +
-// nPrimitives are the primitives in the leaf. (Hence the need for reordering the primi-
-// tives array, so that this representation can be used, rather than, for example, storing a
-// variable-sized array of primitive indices at each leaf node.)
-struct BVHBuildNode {
-    // The BVHBuildNode constructor only initializes the children pointers; we’ll distinguish
-    // between leaf and interior nodes by whether their children pointers are NULL or not,
-    // respectively
-    BVHBuildNode()
-    {
-        children[0] = children[1] = NULL;
-    }
-
-    void InitLeaf(uint32_t first, uint32_t n, const BBox& b)
-    {
-        firstPrimOffset = first;
-        nPrimitives = n;
-        bounds = b;
-    }
-
-    // The InitInterior() method requires that the two children nodes already have been cre-
-    // ated, so that their pointers can be passed in. This requirement makes it easy to compute
-    // the bounds of the interior node, since the children bounds are immediately available.
-    void InitInterior(uint32_t axis, std::shared_ptr<BVHBuildNode>& c0, std::shared_ptr<BVHBuildNode>& c1)
-    {
-        children[0] = c0;
-        children[1] = c1;
-        bounds = Union(c0->bounds, c1->bounds);
-        splitAxis = axis;
-        nPrimitives = 0;
-    }
-
-    bounding_box_t<vec3> bounds;
-    std::shared_ptr<BVHBuildNode> children[2];
-    uint32_t splitAxis, firstPrimOffset, nPrimitives;
-};
-
-struct CompareToMid {
-    CompareToMid(int d, double m)
-    {
-        dim = d;
-        mid = m;
-    }
-    int dim;
-    float mid;
-    bool operator()(const BVHPrimitiveInfo& a) const
-    {
-        return a.centroid[dim] < mid;
-    }
-};
-
 struct ComparePoints {
     ComparePoints(int d) { dim = d; }
     int dim;
@@ -218,49 +276,63 @@ struct ComparePoints {
     }
 };
 
+// The number of buckets that primitive centroids are binned into when evaluating the SAH
+#define MCUT_BVH_SAH_BUCKET_COUNT 12
+
 struct BucketInfo {
     BucketInfo() { count = 0; }
     int count;
     BBox bounds;
 };
 
+// return the SAH bucket into which a primitive centroid falls along axis "dim"
+static inline int get_sah_bucket_index(const vec3& centroid, int dim, const BBox& centroidBounds)
+{
+    const double extent = centroidBounds.maximum()[dim] - centroidBounds.minimum()[dim];
+    int b = (int)(MCUT_BVH_SAH_BUCKET_COUNT * ((centroid[dim] - centroidBounds.minimum()[dim]) / extent));
+    if (b >= MCUT_BVH_SAH_BUCKET_COUNT)
+        b = MCUT_BVH_SAH_BUCKET_COUNT - 1;
+    if (b < 0)
+        b = 0;
+    return b;
+}
+
 struct CompareToBucket {
-    CompareToBucket(int split, int num, int d, const BBox& b)
+    CompareToBucket(int split, int d, const BBox& b)
         : centroidBounds(b)
     {
         splitBucket = split;
-        nBuckets = num;
         dim = d;
     }
 
-    // bool operator()(const BVHPrimitiveInfo &p) const;
     bool operator()(const BVHPrimitiveInfo& p) const
     {
-        int b = nBuckets * ((p.centroid[dim] - centroidBounds.minimum()[dim]) / (centroidBounds.maximum()[dim] - centroidBounds.minimum()[dim]));
-        if (b == nBuckets)
-            b = nBuckets - 1;
-        return b <= splitBucket;
+        return get_sah_bucket_index(p.centroid, dim, centroidBounds) <= splitBucket;
     }
 
-    int splitBucket, nBuckets, dim;
+    int splitBucket, dim;
     const BBox& centroidBounds;
 };
 
 // The LinearBVHNode structure stores the information needed to traverse the BVH. In
 // addition to the bounding box for each node, for leaf nodes it stores the offset and
 // primitive count for the primitives in the node. For interior nodes, it stores the offset to
-// the second child as well as which of the coordinate axes the primitives were partitioned
-// along when the hierarchy was built; this information is used in the traversal routine below
-// to try to visit nodes in front-to-back order along the ray.
+// the first child as well as which of the coordinate axes the primitives were partitioned
+// along when the hierarchy was built. The two children of an interior node are always stored
+// next to each other, so the second child is at "firstChildOffset + 1".
+//
+// Nodes are held by value in one contiguous array, which is grown in pairs of children
+// during construction. There is no separate (pointer-based) build tree that needs to be
+// flattened afterwards.
 struct LinearBVHNode {
     BBox bounds;
     union {
         uint32_t primitivesOffset; // leaf
-        uint32_t secondChildOffset; // interior
+        uint32_t firstChildOffset; // interior
     };
     uint8_t nPrimitives; // 0 -> interior node
     uint8_t axis; // interior node: xyz
-    uint8_t pad[2]; // ensure 32 byte total size
+    uint8_t pad[2];
 };
 
 class BoundingVolumeHierarchy {
@@ -270,32 +342,23 @@ public:
 
     ~BoundingVolumeHierarchy();
 
-    // three stages to BVH construction
-    void buildTree(const hmesh_t& mesh_,
-        const fixed_precision_number_t& enlargementEps_ = fixed_precision_number_t(0.0),
+    // Build the BVH of "mesh_" using (binned) SAH splits by default. With multi-threading,
+    // the upper levels of the tree are split on the master thread (binning primitives in parallel),
+    // after which the remaining subtrees are built concurrently by the worker threads.
+    void buildTree(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool& scheduler,
+#endif
+        const hmesh_t& mesh_,
+        const double& enlargementEps_ = double(0.0),
         uint32_t mp_ = 1,
-        const SplitMethod& sm_ = SplitMethod::SPLIT_MIDDLE);
+        const SplitMethod& sm_ = SplitMethod::SPLIT_SAH);
 
     const BBox& GetPrimitiveBBox(int primitiveIndex) const;
 
-    uint32_t flattenBVHTree(std::shared_ptr<BVHBuildNode> node, uint32_t* offset);
-
-    // The initial call to recursiveBuild() is given all of the primitives to be stored in
-    // the tree. It returns a pointer to the root of the tree, which is represented with
-    // the BVHBuildNode structure.
-
-    // responsible for returning a BVH for the subset of primitives represented by the range from
-    // buildData[start] up to and including buildData[end-1]
-    std::shared_ptr<BVHBuildNode> recursiveBuild(
-        std::vector<BVHPrimitiveInfo>& buildData,
-        uint32_t start,
-        uint32_t end,
-        uint32_t* totalNodes,
-        std::vector<fd_t>& orderedPrims);
-
     int GetNodeCount() const;
 
-    const std::shared_ptr<LinearBVHNode>& GetNode(int idx) const;
+    const LinearBVHNode& GetNode(int idx) const;
 
     const fd_t& GetPrimitive(int index) const;
 
@@ -307,17 +370,42 @@ public:
         const BoundingVolumeHierarchy& bvhA,
         const BoundingVolumeHierarchy& bvhB,
         const uint32_t primitiveOffsetA,
-        const uint32_t primitiveOffsetB);
+        const uint32_t primitiveOffsetB,
+        // do not report leaf-node pairs whose faces are separated by a plane (see "faces_are_separated_by_plane")
+        const bool cullSeparatedFaces = false);
 
 private:
+    // Initialise "node" from the primitives in buildData[start, end), which are reordered so that
+    // the primitives of each child are contiguous. Returns the index into buildData where the second
+    // child starts, or "end" if "node" was made a leaf.
+    uint32_t splitNode(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool* scheduler, // null if primitives must be binned on the calling thread
+#endif
+        LinearBVHNode& node,
+        uint32_t start,
+        uint32_t end);
+
+    // responsible for building the subtree whose root is "nodes_[nodeIndex]" for the subset of
+    // primitives represented by the range from buildData[start] up to and including buildData[end-1].
+    // New nodes are appended to "nodes_".
+    void recursiveBuild(
+        std::vector<LinearBVHNode>& nodes_,
+        uint32_t nodeIndex,
+        uint32_t start,
+        uint32_t end);
+
     const hmesh_t* mesh;
     int maxPrimsInNode;
     SplitMethod splitMethod;
-    fixed_precision_number_t enlargementEps; // used to slight enlarge BVH (with bounds of max cut-mesh perturbation magnitude)
+    double enlargementEps; // used to slight enlarge BVH (with bounds of max cut-mesh perturbation magnitude)
     std::vector<BVHPrimitiveInfo> buildData;
     std::vector<fd_t> primitives; // ordered primitives
     std::vector<BBox> primitiveOrderedBBoxes; // unsorted elements correspond to mesh indices
-    std::vector<std::shared_ptr<LinearBVHNode>> nodes;
+    // NOTE: not allocated from the context's dispatch arena, which is reset after each invocation of
+    // the kernel, whereas the BVH is used across all invocations of one dispatch call (e.g. after
+    // perturbing the cut-mesh). The array is reserved once (see buildTree) instead.
+    std::vector<LinearBVHNode> nodes;
 };
 #endif // #if defined(USE_OIBVH)
 
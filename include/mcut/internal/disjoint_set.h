@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ *
+ * NOTE: This file is licensed under GPL-3.0-or-later (default).
+ * A commercial license can be purchased from Floyd M. Chitalu.
+ *
+ * License details:
+ *
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ *
+ * The commercial license options is for users that wish to use MCUT in
+ * their products for comercial purposes but do not wish to release their
+ * software products under the GPL license.
+ *
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#ifndef MCUT_DISJOINT_SET_H_
+#define MCUT_DISJOINT_SET_H_
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*
+    Union-find over the elements [0, N) which may be used by several threads at once.
+
+    unite() is lock-free and always links the root with the larger index below the
+    root with the smaller index. So, once all unions are done, the root (i.e. the
+    label) of a set is its smallest element regardless of how the unions were
+    scheduled across threads, which keeps results that depend on the labels
+    deterministic.
+*/
+class disjoint_set_t {
+public:
+    explicit disjoint_set_t(std::uint32_t n)
+        : m_parent(n)
+    {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            m_parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    disjoint_set_t(const disjoint_set_t&) = delete;
+    disjoint_set_t& operator=(const disjoint_set_t&) = delete;
+
+    std::uint32_t size() const
+    {
+        return (std::uint32_t)m_parent.size();
+    }
+
+    // returns the root of the set containing "x" (with path halving)
+    std::uint32_t find(std::uint32_t x)
+    {
+        for (;;) {
+            std::uint32_t p = m_parent[x].load(std::memory_order_acquire);
+
+            if (p == x) {
+                return x;
+            }
+
+            const std::uint32_t gp = m_parent[p].load(std::memory_order_acquire);
+
+            if (p != gp) {
+                // fails harmlessly if another thread changed the parent of "x" in the meantime
+                m_parent[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+            }
+
+            x = gp;
+        }
+    }
+
+    void unite(std::uint32_t a, std::uint32_t b)
+    {
+        for (;;) {
+            a = find(a);
+            b = find(b);
+
+            if (a == b) {
+                return;
+            }
+
+            if (a < b) {
+                std::swap(a, b); // link the larger root below the smaller one
+            }
+
+            std::uint32_t expected = a;
+
+            // fails if "a" is no longer a root, in which case we retry from the new roots
+            if (m_parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<std::atomic<std::uint32_t>> m_parent;
+};
+
+#endif // MCUT_DISJOINT_SET_H_
@@ -85,6 +85,9 @@ struct array_mesh_t {
 struct connected_component_t {
     virtual ~connected_component_t() {};
     McConnectedComponentType type = (McConnectedComponentType)0;
+    // position in the sequence of connected components created in the context, which
+    // (unlike the handle) is the same in every run
+    uint64_t creation_index = 0;
     //array_mesh_t indexArrayMesh;
     //hmesh_t mesh;
     output_mesh_info_t kernel_hmesh_data;
@@ -154,13 +157,26 @@ struct context_t {
     thread_pool scheduler;
 #endif
 
+    // memory from which the kernel allocates its temporaries. It is reused by
+    // every dispatch call on this context so that repeated dispatches do not
+    // have to go back to the system allocator.
+    arena_t dispatch_arena;
+
     // the current set of connected components associated with context
     std::map<McConnectedComponent, std::unique_ptr<connected_component_t, void (*)(connected_component_t*)>> connected_components = {};
+    // the number of connected components that have been created in the context
+    uint64_t connected_component_creation_count = 0;
 
     // The state and flag variable current used to configure the next dispatch call
     McFlags flags = (McFlags)0;
     McFlags dispatchFlags = (McFlags)0;
 
+    // directory in which serialized source-mesh BVHs are cached (empty = no caching)
+    std::string bvhCacheDirectory;
+
+    // algorithm used to find potentially intersecting polygons
+    McBroadPhase broadPhase = McBroadPhase::MC_BROAD_PHASE_BVH;
+
     // client/user debugging variable
     // ------------------------------
 
@@ -215,6 +231,12 @@ extern "C" void get_info_impl(
     void* pMem,
     uint64_t* pNumBytes) noexcept(false);
 
+extern "C" void bind_state_impl(
+    const McContext context,
+    McFlags stateInfo,
+    uint64_t bytes,
+    const void* pMem) noexcept(false);
+
 extern "C" void dispatch_impl(
     McContext context,
     McFlags flags,
@@ -26,18 +26,24 @@
 #include "mcut/internal/math.h"
 #include "mcut/internal/utils.h"
 
+#if defined(MCUT_MULTI_THREADED)
+#include "mcut/internal/tpool.h"
+#endif
+
 #include <algorithm>
+#include <deque>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 template <typename T>
 class descriptor_t_ {
 public:
     typedef unsigned int index_type;
-    descriptor_t_() { }
-    virtual ~descriptor_t_() { }
     explicit descriptor_t_(index_type i = (std::numeric_limits<index_type>::max)())
         : m_value(i)
     {
@@ -59,12 +65,6 @@ public:
         return *this;
     }
 
-    descriptor_t_& operator=(const T& _rhs) const
-    {
-        m_value = _rhs.m_value;
-        return *this;
-    }
-
     bool operator==(const T& _rhs) const
     {
         return m_value == _rhs.m_value;
@@ -127,10 +127,6 @@ public:
         : descriptor_t_<halfedge_descriptor_t>(idx)
     {
     }
-
-    virtual ~halfedge_descriptor_t()
-    {
-    }
 };
 
 class edge_descriptor_t : public descriptor_t_<edge_descriptor_t> {
@@ -144,10 +140,6 @@ public:
         : descriptor_t_<edge_descriptor_t>(idx)
     {
     }
-
-    virtual ~edge_descriptor_t()
-    {
-    }
 };
 
 class face_descriptor_t : public descriptor_t_<face_descriptor_t> {
@@ -161,10 +153,6 @@ public:
         : descriptor_t_<face_descriptor_t>(idx)
     {
     }
-
-    virtual ~face_descriptor_t()
-    {
-    }
 };
 
 class vertex_descriptor_t : public descriptor_t_<vertex_descriptor_t> {
@@ -178,10 +166,6 @@ public:
         : descriptor_t_<vertex_descriptor_t>(idx)
     {
     }
-
-    virtual ~vertex_descriptor_t()
-    {
-    }
 };
 
 template <typename T>
@@ -199,6 +183,7 @@ struct halfedge_data_t : id_<halfedge_descriptor_t> {
     vertex_descriptor_t t; // target vertex
     edge_descriptor_t e; // edge
     face_descriptor_t f; // face
+    halfedge_descriptor_t vn; // next halfedge which points to the same target vertex (see vertex_data_t)
 
     halfedge_data_t()
     //: o(null_halfedge()), n(null_halfedge()), p(null_halfedge()), t(null_vertex()), e(null_edge()), f(null_face())
@@ -210,14 +195,276 @@ struct edge_data_t : id_<edge_descriptor_t> {
     halfedge_descriptor_t h; // primary halfedge (even idx)
 };
 
+// NOTE: faces and vertices do not own any heap memory. The halfedges of every face are
+// stored back-to-back in a pool that is shared by the whole mesh, and the halfedges that
+// point to a vertex are chained through their "vn" member. Building, copying and destroying
+// a mesh therefore amounts to a handful of allocations rather than several per element.
 struct face_data_t : id_<face_descriptor_t> {
-    std::vector<halfedge_descriptor_t> m_halfedges;
+    std::uint32_t m_halfedges_offset; // ... of the first halfedge in the mesh's face-halfedge pool
+    std::uint32_t m_halfedges_count;
+
+    face_data_t()
+        : m_halfedges_offset(0)
+        , m_halfedges_count(0)
+    {
+    }
 };
 
+// NOTE: the coordinates of a vertex are not stored here but in the per-axis arrays of the
+// mesh (see hmesh_t::vertex_coordinates).
 struct vertex_data_t : id_<vertex_descriptor_t> {
-    vec3 p; // geometry coordinates
-    std::vector<face_descriptor_t> m_faces; // ... incident to vertex // TODO: this is not needed (can be inferred from "m_halfedges")
-    std::vector<halfedge_descriptor_t> m_halfedges; // ... which point to vertex (note: can be used to infer edges too)
+    halfedge_descriptor_t m_halfedges_first; // first halfedge which points to vertex (in insertion order)
+    halfedge_descriptor_t m_halfedges_last; // ... and the last one (so that appending is O(1))
+};
+
+// A read-only view over a contiguous array that is owned by something else (e.g. a std::vector,
+// or the arrays of a BVH that is loaded from a memory-mapped file). The view does not keep
+// the array alive, and is invalidated when the array is resized or freed.
+template <typename T>
+class array_view_t {
+    const T* m_first;
+    const T* m_last;
+
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+    typedef const T* iterator;
+
+    array_view_t()
+        : m_first(nullptr)
+        , m_last(nullptr)
+    {
+    }
+
+    array_view_t(const T* first, const T* last)
+        : m_first(first)
+        , m_last(last)
+    {
+    }
+
+    explicit array_view_t(const std::vector<T>& v)
+        : m_first(v.data())
+        , m_last(v.data() + v.size())
+    {
+    }
+
+    const_iterator begin() const { return m_first; }
+    const_iterator end() const { return m_last; }
+    const_iterator cbegin() const { return m_first; }
+    const_iterator cend() const { return m_last; }
+    std::size_t size() const { return (std::size_t)(m_last - m_first); }
+    bool empty() const { return m_first == m_last; }
+    const T& operator[](std::size_t i) const { return m_first[i]; }
+    const T& at(std::size_t i) const
+    {
+        MCUT_ASSERT(i < size());
+        return m_first[i];
+    }
+    const T& front() const { return *m_first; }
+    const T& back() const { return *(m_last - 1); }
+};
+
+// A view over a contiguous run of descriptors that is owned by a mesh (e.g. the halfedges
+// of a face). The view is invalidated when elements are added to that mesh, so copy it into
+// a std::vector if the mesh is modified while the view is still needed.
+template <typename T>
+using descriptor_array_view_t = array_view_t<T>;
+
+// Values of one property of the elements of a mesh (see hmesh_t::add_property_map). The values
+// are kept in a dense array indexed by element descriptor.
+class property_array_base_t {
+public:
+    virtual ~property_array_base_t() { }
+
+    virtual std::unique_ptr<property_array_base_t> clone() const = 0;
+    // new elements get the default value
+    virtual void resize(std::size_t n) = 0;
+    virtual void reserve(std::size_t n) = 0;
+    // sets the value of element "i" back to the default (when a removed element's slot is reused)
+    virtual void reset_element(std::size_t i) = 0;
+    // keeps only the values of the given elements, in that order (see hmesh_t::compact)
+    virtual void compact(const std::vector<std::uint32_t>& new_to_old) = 0;
+};
+
+template <typename T>
+class property_array_t : public property_array_base_t {
+public:
+    explicit property_array_t(const T& default_value)
+        : m_default_value(default_value)
+    {
+    }
+
+    std::unique_ptr<property_array_base_t> clone() const override
+    {
+        return std::unique_ptr<property_array_base_t>(new property_array_t<T>(*this));
+    }
+
+    void resize(std::size_t n) override { m_values.resize(n, m_default_value); }
+    void reserve(std::size_t n) override { m_values.reserve(n); }
+    void reset_element(std::size_t i) override { m_values[i] = m_default_value; }
+
+    void compact(const std::vector<std::uint32_t>& new_to_old) override
+    {
+        std::vector<T> values;
+        values.reserve(new_to_old.size());
+        for (std::size_t i = 0; i < new_to_old.size(); ++i) {
+            values.push_back(m_values[new_to_old[i]]);
+        }
+        m_values.swap(values);
+    }
+
+    std::vector<T> m_values;
+    const T m_default_value;
+};
+
+// The properties of one type of mesh element (e.g. all vertex properties). The arrays are kept
+// the same size as the element array of the mesh. Copying the container copies the values.
+class property_container_t {
+public:
+    property_container_t()
+        : m_size(0)
+    {
+    }
+
+    property_container_t(const property_container_t& other)
+        : m_size(other.m_size)
+    {
+        for (std::size_t i = 0; i < other.m_arrays.size(); ++i) {
+            m_arrays.push_back(other.m_arrays[i]->clone());
+        }
+    }
+
+    property_container_t& operator=(const property_container_t& other)
+    {
+        if (this != &other) {
+            property_container_t tmp(other);
+            m_arrays.swap(tmp.m_arrays);
+            m_size = tmp.m_size;
+        }
+        return *this;
+    }
+
+    property_container_t(property_container_t&& other)
+        : m_arrays(std::move(other.m_arrays))
+        , m_size(other.m_size)
+    {
+        other.m_size = 0;
+    }
+
+    property_container_t& operator=(property_container_t&& other)
+    {
+        if (this != &other) {
+            m_arrays = std::move(other.m_arrays);
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    template <typename T>
+    property_array_t<T>* add(const T& default_value)
+    {
+        property_array_t<T>* array = new property_array_t<T>(default_value);
+        m_arrays.emplace_back(array);
+        array->resize(m_size);
+        return array;
+    }
+
+    void remove(const property_array_base_t* array)
+    {
+        for (std::size_t i = 0; i < m_arrays.size(); ++i) {
+            if (m_arrays[i].get() == array) {
+                m_arrays.erase(m_arrays.begin() + i);
+                return;
+            }
+        }
+    }
+
+    void resize(std::size_t n)
+    {
+        m_size = n;
+        for (std::size_t i = 0; i < m_arrays.size(); ++i) {
+            m_arrays[i]->resize(n);
+        }
+    }
+
+    void reserve(std::size_t n)
+    {
+        for (std::size_t i = 0; i < m_arrays.size(); ++i) {
+            m_arrays[i]->reserve(n);
+        }
+    }
+
+    void reset_element(std::size_t i)
+    {
+        for (std::size_t j = 0; j < m_arrays.size(); ++j) {
+            m_arrays[j]->reset_element(i);
+        }
+    }
+
+    void compact(const std::vector<std::uint32_t>& new_to_old)
+    {
+        m_size = new_to_old.size();
+        for (std::size_t i = 0; i < m_arrays.size(); ++i) {
+            m_arrays[i]->compact(new_to_old);
+        }
+    }
+
+    bool empty() const { return m_arrays.empty(); }
+
+private:
+    std::vector<std::unique_ptr<property_array_base_t>> m_arrays;
+    std::size_t m_size; // number of elements (including removed ones)
+};
+
+// Handle to a property of the mesh elements of type "D" (a descriptor type) with values of type "T".
+// The handle is cheap to copy and all copies refer to the same values, which are accessed in constant
+// time by indexing with a descriptor. Different threads may write the values of different elements
+// concurrently (except if "T" is bool, because of std::vector<bool>).
+template <typename D, typename T>
+class property_map_t {
+public:
+    typedef D key_type;
+    typedef T value_type;
+    typedef typename std::vector<T>::reference reference;
+    typedef typename std::vector<T>::const_reference const_reference;
+
+    property_map_t()
+        : m_array(nullptr)
+    {
+    }
+
+    explicit property_map_t(property_array_t<T>* array)
+        : m_array(array)
+    {
+    }
+
+    bool is_valid() const { return m_array != nullptr; }
+
+    reference operator[](const D& d) const
+    {
+        MCUT_ASSERT(m_array != nullptr);
+        MCUT_ASSERT((std::size_t)d < m_array->m_values.size());
+        return m_array->m_values[d];
+    }
+
+    const T& default_value() const { return m_array->m_default_value; }
+    // number of values (i.e. the number of elements in the mesh, including removed ones)
+    std::size_t size() const { return m_array->m_values.size(); }
+
+    property_array_t<T>* array() const { return m_array; }
+
+private:
+    property_array_t<T>* m_array;
+};
+
+// Mapping from the descriptors of a mesh before hmesh_t::compact() to those after. Each table is
+// indexed by the old descriptor, and removed elements map to the null descriptor.
+struct hmesh_remap_t {
+    std::vector<vertex_descriptor_t> vertices;
+    std::vector<edge_descriptor_t> edges;
+    std::vector<halfedge_descriptor_t> halfedges;
+    std::vector<face_descriptor_t> faces;
 };
 
 typedef std::vector<vertex_data_t> vertex_array_t;
@@ -252,6 +499,13 @@ public:
     hmesh_t();
     ~hmesh_t();
 
+    // NOTE: the move operations must be declared explicitly (because of the destructor),
+    // otherwise moving a mesh e.g. into the output silently makes a deep copy
+    hmesh_t(const hmesh_t&) = default;
+    hmesh_t& operator=(const hmesh_t&) = default;
+    hmesh_t(hmesh_t&&) = default;
+    hmesh_t& operator=(hmesh_t&&) = default;
+
     // static member functions
     // -----------------------
 
@@ -283,8 +537,8 @@ public:
 
     vertex_descriptor_t vertex(const edge_descriptor_t e, const int v) const;
 
-    bool is_border(const halfedge_descriptor_t h);
-    bool is_border(const edge_descriptor_t e);
+    bool is_border(const halfedge_descriptor_t h) const;
+    bool is_border(const edge_descriptor_t e) const;
 
     halfedge_descriptor_t halfedge(const edge_descriptor_t e, const int i) const;
     // finds a halfedge between two vertices. Returns a default constructed halfedge descriptor, if source and target are not connected.
@@ -304,6 +558,26 @@ public:
     // (one that is referenced by more than 2 faces which is illegal). 
     bool is_insertable(const std::vector<vertex_descriptor_t> &vi) const;
 
+    // Attach a per-element attribute to the vertices, edges, halfedges or faces of the mesh (selected
+    // with "D"). This is the dense alternative to e.g. std::unordered_map<vd_t, T> for data that is
+    // looked up often. The values grow with the mesh as elements are added, and an element that takes
+    // the slot of a removed one starts with "default_value" again. The returned map stays valid until
+    // it is removed or the mesh is destroyed (a copy of the mesh gets its own copy of the values).
+    template <typename D, typename T>
+    property_map_t<D, T> add_property_map(const T& default_value = T())
+    {
+        property_container_t& properties = get_properties(id_<D> {});
+        property_map_t<D, T> pmap(properties.add<T>(default_value));
+        return pmap;
+    }
+
+    template <typename D, typename T>
+    void remove_property_map(property_map_t<D, T>& pmap)
+    {
+        get_properties(id_<D> {}).remove(pmap.array());
+        pmap = property_map_t<D, T>();
+    }
+
     // also disassociates (not remove) any halfedges(s) and vertices incident to face
     void remove_face(const face_descriptor_t f);
     // also disassociates (not remove) the halfedges(s) and vertex incident to this halfedge
@@ -313,6 +587,16 @@ public:
     void remove_vertex(const vertex_descriptor_t v);
     void remove_elements();
 
+    // Drops the slots of removed elements so that the descriptors of each element type are dense
+    // again (i.e. number_of_X() == number_of_internal_X()). The remaining elements keep their relative
+    // order. The old-to-new mapping is written to "remap" (if given), and any other descriptors, views
+    // and iterators held by the caller are invalidated. Property maps remain valid.
+    void compact(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool& scheduler,
+#endif
+        hmesh_remap_t* remap = nullptr);
+
     void reset();
 
     int number_of_internal_faces() const;
@@ -325,10 +609,26 @@ public:
     int number_of_halfedges_removed() const;
     int number_of_faces_removed() const;
 
-    bool is_removed(face_descriptor_t f) const;
-    bool is_removed(edge_descriptor_t e) const;
-    bool is_removed(halfedge_descriptor_t h) const;
-    bool is_removed(vertex_descriptor_t v) const;
+    // O(1) lookups into the per-element removal flags (called for every element visited by the iterators)
+    inline bool is_removed(face_descriptor_t f) const
+    {
+        return (size_t)f < m_faces_removed_flags.size() && m_faces_removed_flags[f];
+    }
+
+    inline bool is_removed(edge_descriptor_t e) const
+    {
+        return (size_t)e < m_edges_removed_flags.size() && m_edges_removed_flags[e];
+    }
+
+    inline bool is_removed(halfedge_descriptor_t h) const
+    {
+        return (size_t)h < m_halfedges_removed_flags.size() && m_halfedges_removed_flags[h];
+    }
+
+    inline bool is_removed(vertex_descriptor_t v) const
+    {
+        return (size_t)v < m_vertices_removed_flags.size() && m_vertices_removed_flags[v];
+    }
 
     void reserve_for_additional_vertices(std::uint32_t n);
     void reserve_for_additional_edges(std::uint32_t n);
@@ -344,10 +644,10 @@ public:
         return I(); // unused
     }
 
-    const std::vector<vertex_descriptor_t>& get_removed_elements(id_<array_iterator_t<vertex_array_t>>) const;
-    const std::vector<edge_descriptor_t>& get_removed_elements(id_<array_iterator_t<edge_array_t>>) const;
-    const std::vector<halfedge_descriptor_t>& get_removed_elements(id_<array_iterator_t<halfedge_array_t>>) const;
-    const std::vector<face_descriptor_t>& get_removed_elements(id_<array_iterator_t<face_array_t>>) const;
+    const std::deque<vertex_descriptor_t>& get_removed_elements(id_<array_iterator_t<vertex_array_t>>) const;
+    const std::deque<edge_descriptor_t>& get_removed_elements(id_<array_iterator_t<edge_array_t>>) const;
+    const std::deque<halfedge_descriptor_t>& get_removed_elements(id_<array_iterator_t<halfedge_array_t>>) const;
+    const std::deque<face_descriptor_t>& get_removed_elements(id_<array_iterator_t<face_array_t>>) const;
 
     //
     template <typename I = int>
@@ -371,31 +671,52 @@ public:
             return 0;
         }
 
+        const auto& removed_elems = get_removed_elements(id_<array_iterator_t<I>> {});
+
+        if (removed_elems.empty()) {
+            return 0; // common case
+        }
+
         // raw starting ptr offset
         const uint32_t start_ = (std::uint32_t)(start - elements_begin_(id_<array_iterator_t<I>> {}, false));
         uint32_t n = 0;
 
-        for (auto elem_descr : get_removed_elements(id_<array_iterator_t<I>> {})) {
-            const uint32_t descr = (uint32_t)elem_descr;
+        // walk whichever is shorter: the free list or the range itself
+        if ((long long)removed_elems.size() < N) {
+            for (auto elem_descr : removed_elems) {
+                const uint32_t descr = (uint32_t)elem_descr;
 
-            if (descr >= start_ && (descr <= (start_ + (uint32_t)(N - 1)))) {
-                ++n;
+                if (descr >= start_ && (descr <= (start_ + (uint32_t)(N - 1)))) {
+                    ++n;
+                }
+            }
+        } else {
+            typedef typename I::value_type::type element_descriptor_type;
+            for (uint32_t i = start_; i < start_ + (uint32_t)N; ++i) {
+                if (is_removed(element_descriptor_type(i))) {
+                    ++n;
+                }
             }
         }
         return n;
     }
 
-    const vec3& vertex(const vertex_descriptor_t& vd) const;
+    vec3 vertex(const vertex_descriptor_t& vd) const;
+    // The "axis"-th coordinate (0=x, 1=y or 2=z) of every vertex, indexed by vertex descriptor
+    // (removed vertices included). Use this for passes over all vertices of the mesh.
+    const std::vector<double>& vertex_coordinates(const int axis) const;
     // returns vector of halfedges which point to vertex (i.e. "v" is their target)
-    const std::vector<halfedge_descriptor_t>& get_halfedges_around_vertex(const vertex_descriptor_t v) const;
+    std::vector<halfedge_descriptor_t> get_halfedges_around_vertex(const vertex_descriptor_t v) const;
+    void get_halfedges_around_vertex(std::vector<halfedge_descriptor_t>& halfedges, const vertex_descriptor_t v) const;
     std::vector<vertex_descriptor_t> get_vertices_around_face(const face_descriptor_t f, uint32_t prepend_offset = 0) const;
     void get_vertices_around_face(std::vector<vertex_descriptor_t>& vertex_descriptors, const face_descriptor_t f, uint32_t prepend_offset=0) const;
     std::vector<vertex_descriptor_t> get_vertices_around_vertex(const vertex_descriptor_t v) const;
+    void get_vertices_around_vertex(std::vector<vertex_descriptor_t>& vertices_around_vertex, const vertex_descriptor_t v) const;
     uint32_t get_num_vertices_around_face(const face_descriptor_t f) const;
-    const std::vector<halfedge_descriptor_t>& get_halfedges_around_face(const face_descriptor_t f) const;
-    const std::vector<face_descriptor_t> get_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
-    void get_faces_around_face( std::vector<face_descriptor_t>& faces_around_face, const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
-    uint32_t get_num_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const;
+    descriptor_array_view_t<halfedge_descriptor_t> get_halfedges_around_face(const face_descriptor_t f) const;
+    const std::vector<face_descriptor_t> get_faces_around_face(const face_descriptor_t f, const descriptor_array_view_t<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
+    void get_faces_around_face( std::vector<face_descriptor_t>& faces_around_face, const face_descriptor_t f, const descriptor_array_view_t<halfedge_descriptor_t>* halfedges_around_face_ = nullptr) const;
+    uint32_t get_num_faces_around_face(const face_descriptor_t f, const descriptor_array_view_t<halfedge_descriptor_t>* halfedges_around_face_) const;
     
     // iterators
     // ---------
@@ -409,28 +730,54 @@ public:
     face_array_iterator_t faces_begin(bool account_for_removed_elems = true) const;
     face_array_iterator_t faces_end() const;
 
-    const std::vector<vertex_descriptor_t>& get_removed_vertices() const;
-    const std::vector<edge_descriptor_t>& get_removed_edges() const;
-    const std::vector<halfedge_descriptor_t>& get_removed_halfedges() const;
-    const std::vector<face_descriptor_t>& get_removed_faces() const;
+    const std::deque<vertex_descriptor_t>& get_removed_vertices() const;
+    const std::deque<edge_descriptor_t>& get_removed_edges() const;
+    const std::deque<halfedge_descriptor_t>& get_removed_halfedges() const;
+    const std::deque<face_descriptor_t>& get_removed_faces() const;
 
 private:
+    // append/remove "h" to/from the list of halfedges which point to its target vertex
+    void link_halfedge_to_target(const halfedge_descriptor_t h);
+    void unlink_halfedge_from_target(const halfedge_descriptor_t h);
+
+    property_container_t& get_properties(id_<vertex_descriptor_t>) { return m_vertex_properties; }
+    property_container_t& get_properties(id_<edge_descriptor_t>) { return m_edge_properties; }
+    property_container_t& get_properties(id_<halfedge_descriptor_t>) { return m_halfedge_properties; }
+    property_container_t& get_properties(id_<face_descriptor_t>) { return m_face_properties; }
+
     // member variables
     // ----------------
 
     std::vector<vertex_data_t> m_vertices;
+    // vertex coordinates as one contiguous array per axis (structure-of-arrays), which
+    // makes whole-mesh passes over the coordinates simple streaming loops
+    std::vector<double> m_vertex_coordinates[3];
     std::vector<edge_data_t> m_edges;
     std::vector<halfedge_data_t> m_halfedges;
     std::vector<face_data_t> m_faces;
-
-    // NOTE: I use std::vector because we'll have very few (typically zero)
-    // elements removed at a given time. In fact removal only happens during
-    // input-mesh face-partitioning to resolve floating polygons, which is
-    // rare. Maybe in the future things change...
-    std::vector<face_descriptor_t> m_faces_removed;
-    std::vector<edge_descriptor_t> m_edges_removed;
-    std::vector<halfedge_descriptor_t> m_halfedges_removed;
-    std::vector<vertex_descriptor_t> m_vertices_removed;
+    // the halfedges of all faces (see face_data_t)
+    std::vector<halfedge_descriptor_t> m_face_halfedges;
+
+    // Free lists of removed elements. Removal only happens during input-mesh
+    // face-partitioning (to resolve floating polygons) and add_* takes the oldest
+    // unused slot first (NOTE: important for user data mapping), hence a FIFO.
+    std::deque<face_descriptor_t> m_faces_removed;
+    std::deque<edge_descriptor_t> m_edges_removed;
+    std::deque<halfedge_descriptor_t> m_halfedges_removed;
+    std::deque<vertex_descriptor_t> m_vertices_removed;
+
+    // One flag per element which is set while that element sits in the free list.
+    // These are grown lazily (on removal) so they may be shorter than the element arrays.
+    std::vector<bool> m_faces_removed_flags;
+    std::vector<bool> m_edges_removed_flags;
+    std::vector<bool> m_halfedges_removed_flags;
+    std::vector<bool> m_vertices_removed_flags;
+
+    // user-defined properties (see add_property_map)
+    property_container_t m_vertex_properties;
+    property_container_t m_edge_properties;
+    property_container_t m_halfedge_properties;
+    property_container_t m_face_properties;
 
 }; // class hmesh_t {
 
@@ -439,6 +786,20 @@ typedef halfedge_descriptor_t hd_t;
 typedef edge_descriptor_t ed_t;
 typedef face_descriptor_t fd_t;
 
+// Descriptors are plain indices. They must stay as small and as cheap to copy as an
+// "unsigned int" since they are stored (many times over) in every mesh and kernel container.
+static_assert(sizeof(vd_t) == sizeof(vd_t::index_type) && sizeof(hd_t) == sizeof(hd_t::index_type) && //
+        sizeof(ed_t) == sizeof(ed_t::index_type) && sizeof(fd_t) == sizeof(fd_t::index_type),
+    "descriptors must have the size of their index");
+static_assert(std::is_trivially_copyable<vd_t>::value && std::is_trivially_copyable<hd_t>::value && //
+        std::is_trivially_copyable<ed_t>::value && std::is_trivially_copyable<fd_t>::value,
+    "descriptors must be trivially copyable");
+static_assert(std::is_standard_layout<vd_t>::value && std::is_standard_layout<hd_t>::value && //
+        std::is_standard_layout<ed_t>::value && std::is_standard_layout<fd_t>::value,
+    "descriptors must be standard-layout");
+static_assert(sizeof(halfedge_data_t) == 7 * sizeof(hd_t::index_type), "unexpected halfedge_data_t size");
+static_assert(sizeof(edge_data_t) == sizeof(hd_t::index_type), "unexpected edge_data_t size");
+
 void write_off(const char* fpath, const hmesh_t& mesh);
 void read_off(hmesh_t& mesh, const char* fpath);
 
@@ -573,6 +934,259 @@ private:
     face_array_iterator_t cend(id_<face_array_iterator_t>);
 }; // class array_iterator_t : public V::const_iterator
 
+// Array view over the descriptors of one mesh as seen from another mesh that contains the
+// same elements under different descriptors (e.g. a polygon soup made of two meshes). Each stored
+// descriptor "d" is returned as "map[d]" (or as "d" if there is no map). The sequence may also be
+// rotated so that it starts at a given element. Same interface as descriptor_array_view_t, except
+// that elements are returned by value.
+template <typename T>
+class remapped_descriptor_array_view_t {
+    descriptor_array_view_t<T> m_base;
+    const T* m_map;
+    std::uint32_t m_rotation; // index (in "m_base") of the first element
+
+public:
+    class const_iterator {
+        const T* m_first;
+        const T* m_map;
+        std::ptrdiff_t m_size;
+        std::ptrdiff_t m_pos;
+        std::ptrdiff_t m_rotation;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef T reference;
+
+        const_iterator()
+            : m_first(nullptr)
+            , m_map(nullptr)
+            , m_size(0)
+            , m_pos(0)
+            , m_rotation(0)
+        {
+        }
+
+        const_iterator(const T* first, const T* map, std::ptrdiff_t size, std::ptrdiff_t pos, std::ptrdiff_t rotation)
+            : m_first(first)
+            , m_map(map)
+            , m_size(size)
+            , m_pos(pos)
+            , m_rotation(rotation)
+        {
+        }
+
+        T operator*() const { return (*this)[0]; }
+        T operator[](difference_type n) const
+        {
+            std::ptrdiff_t i = m_rotation + m_pos + n;
+            if (i >= m_size) {
+                i -= m_size;
+            }
+            return m_map == nullptr ? m_first[i] : m_map[m_first[i]];
+        }
+        const_iterator& operator++() { ++m_pos; return *this; }
+        const_iterator operator++(int) { const_iterator tmp = *this; ++m_pos; return tmp; }
+        const_iterator& operator--() { --m_pos; return *this; }
+        const_iterator operator--(int) { const_iterator tmp = *this; --m_pos; return tmp; }
+        const_iterator& operator+=(difference_type n) { m_pos += n; return *this; }
+        const_iterator& operator-=(difference_type n) { m_pos -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(m_first, m_map, m_size, m_pos + n, m_rotation); }
+        const_iterator operator-(difference_type n) const { return const_iterator(m_first, m_map, m_size, m_pos - n, m_rotation); }
+        difference_type operator-(const const_iterator& other) const { return m_pos - other.m_pos; }
+        bool operator==(const const_iterator& other) const { return m_pos == other.m_pos; }
+        bool operator!=(const const_iterator& other) const { return m_pos != other.m_pos; }
+        bool operator<(const const_iterator& other) const { return m_pos < other.m_pos; }
+    };
+
+    typedef T value_type;
+    typedef const_iterator iterator;
+
+    remapped_descriptor_array_view_t()
+        : m_map(nullptr)
+        , m_rotation(0)
+    {
+    }
+
+    remapped_descriptor_array_view_t(const descriptor_array_view_t<T>& base, const T* map = nullptr, std::uint32_t rotation = 0)
+        : m_base(base)
+        , m_map(map)
+        , m_rotation(base.empty() ? 0 : (rotation % (std::uint32_t)base.size()))
+    {
+    }
+
+    const_iterator begin() const { return const_iterator(m_base.begin(), m_map, (std::ptrdiff_t)size(), 0, m_rotation); }
+    const_iterator end() const { return const_iterator(m_base.begin(), m_map, (std::ptrdiff_t)size(), (std::ptrdiff_t)size(), m_rotation); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    std::size_t size() const { return m_base.size(); }
+    bool empty() const { return m_base.empty(); }
+    T operator[](std::size_t i) const { return begin()[(std::ptrdiff_t)i]; }
+    T front() const { return (*this)[0]; }
+    T back() const { return (*this)[size() - 1]; }
+
+    // the underlying descriptors (i.e. neither rotated nor mapped)
+    const descriptor_array_view_t<T>& base() const { return m_base; }
+};
+
+class polygon_soup_view_t;
+
+// iterates over the elements of a polygon soup that are not marked as removed
+template <typename D>
+class polygon_soup_iterator_t {
+    const polygon_soup_view_t* m_soup;
+    std::uint32_t m_index;
+    std::uint32_t m_end;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef D value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const D* pointer;
+    typedef D reference;
+
+    polygon_soup_iterator_t()
+        : m_soup(nullptr)
+        , m_index(0)
+        , m_end(0)
+    {
+    }
+
+    polygon_soup_iterator_t(const polygon_soup_view_t* soup, std::uint32_t index, std::uint32_t end)
+        : m_soup(soup)
+        , m_index(index)
+        , m_end(end)
+    {
+        skip_removed();
+    }
+
+    D operator*() const { return D(m_index); }
+
+    polygon_soup_iterator_t& operator++()
+    {
+        ++m_index;
+        skip_removed();
+        return *this;
+    }
+
+    polygon_soup_iterator_t operator++(int)
+    {
+        polygon_soup_iterator_t tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    bool operator==(const polygon_soup_iterator_t& other) const { return m_index == other.m_index; }
+    bool operator!=(const polygon_soup_iterator_t& other) const { return m_index != other.m_index; }
+
+private:
+    inline void skip_removed();
+};
+
+/*
+    Read-only view that presents the source-mesh and the cut-mesh as one mesh (the
+    "polygon soup") without copying either of them.
+
+    The elements of the cut-mesh are placed after those of the source-mesh, and the
+    descriptors of source-mesh elements are the same in the soup. The soup descriptor of
+    a cut-mesh vertex or face is its cut-mesh descriptor plus the number of source-mesh
+    vertices or faces. Cut-mesh edges and halfedges are numbered (using small lookup tables)
+    in the order that they are first visited when walking over the cut-mesh faces, which is
+    the numbering they would get if the faces were copied into the source-mesh one by one.
+*/
+class polygon_soup_view_t {
+public:
+    typedef polygon_soup_iterator_t<vertex_descriptor_t> vertex_iterator_t;
+    typedef polygon_soup_iterator_t<edge_descriptor_t> edge_iterator_t;
+    typedef polygon_soup_iterator_t<face_descriptor_t> face_iterator_t;
+    typedef remapped_descriptor_array_view_t<halfedge_descriptor_t> halfedge_array_view_t;
+
+    polygon_soup_view_t(const hmesh_t& sm, const hmesh_t& cm);
+
+    const hmesh_t& source_mesh() const { return *m_sm; }
+    const hmesh_t& cut_mesh() const { return *m_cm; }
+
+    // excluding removed elements
+    int number_of_vertices() const { return m_sm->number_of_vertices() + m_cm->number_of_vertices(); }
+    int number_of_edges() const { return m_sm->number_of_edges() + (int)m_soup_to_cm_edge.size(); }
+    int number_of_faces() const { return m_sm->number_of_faces() + m_cm->number_of_faces(); }
+    // including removed elements (i.e. upper bound of descriptors)
+    int number_of_internal_vertices() const { return (int)(m_sm_vertices + m_cm->number_of_internal_vertices()); }
+    int number_of_internal_edges() const { return (int)(m_sm_edges + m_soup_to_cm_edge.size()); }
+    int number_of_internal_faces() const { return (int)(m_sm_faces + m_cm->number_of_internal_faces()); }
+
+    // does the soup element belong to the cut-mesh?
+    inline bool is_cut_mesh_element(vertex_descriptor_t v) const { return (std::uint32_t)v >= m_sm_vertices; }
+    inline bool is_cut_mesh_element(halfedge_descriptor_t h) const { return (std::uint32_t)h >= m_sm_halfedges; }
+    inline bool is_cut_mesh_element(edge_descriptor_t e) const { return (std::uint32_t)e >= m_sm_edges; }
+    inline bool is_cut_mesh_element(face_descriptor_t f) const { return (std::uint32_t)f >= m_sm_faces; }
+
+    // soup descriptor -> cut-mesh descriptor (the element must belong to the cut-mesh)
+    inline vertex_descriptor_t to_cut_mesh(vertex_descriptor_t v) const { return vertex_descriptor_t((std::uint32_t)v - m_sm_vertices); }
+    inline halfedge_descriptor_t to_cut_mesh(halfedge_descriptor_t h) const { return m_soup_to_cm_halfedge[(std::uint32_t)h - m_sm_halfedges]; }
+    inline edge_descriptor_t to_cut_mesh(edge_descriptor_t e) const { return m_soup_to_cm_edge[(std::uint32_t)e - m_sm_edges]; }
+    inline face_descriptor_t to_cut_mesh(face_descriptor_t f) const { return face_descriptor_t((std::uint32_t)f - m_sm_faces); }
+
+    // cut-mesh descriptor -> soup descriptor (null descriptors are preserved)
+    inline vertex_descriptor_t from_cut_mesh(vertex_descriptor_t v) const { return v == hmesh_t::null_vertex() ? v : vertex_descriptor_t((std::uint32_t)v + m_sm_vertices); }
+    inline halfedge_descriptor_t from_cut_mesh(halfedge_descriptor_t h) const { return h == hmesh_t::null_halfedge() ? h : m_cm_to_soup_halfedge[h]; }
+    inline edge_descriptor_t from_cut_mesh(edge_descriptor_t e) const { return e == hmesh_t::null_edge() ? e : m_cm_to_soup_edge[e]; }
+    inline face_descriptor_t from_cut_mesh(face_descriptor_t f) const { return f == hmesh_t::null_face() ? f : face_descriptor_t((std::uint32_t)f + m_sm_faces); }
+
+    // NOTE: the soup only contains the cut-mesh edges that are used by its faces
+    inline bool is_removed(vertex_descriptor_t v) const { return is_cut_mesh_element(v) ? m_cm->is_removed(to_cut_mesh(v)) : m_sm->is_removed(v); }
+    inline bool is_removed(edge_descriptor_t e) const { return is_cut_mesh_element(e) ? false : m_sm->is_removed(e); }
+    inline bool is_removed(face_descriptor_t f) const { return is_cut_mesh_element(f) ? m_cm->is_removed(to_cut_mesh(f)) : m_sm->is_removed(f); }
+
+    vec3 vertex(const vertex_descriptor_t& v) const;
+    vertex_descriptor_t vertex(const edge_descriptor_t e, const int v) const;
+    vertex_descriptor_t source(const halfedge_descriptor_t& h) const;
+    vertex_descriptor_t target(const halfedge_descriptor_t& h) const;
+    halfedge_descriptor_t opposite(const halfedge_descriptor_t& h) const;
+    edge_descriptor_t edge(const halfedge_descriptor_t& h) const;
+    face_descriptor_t face(const halfedge_descriptor_t& h) const;
+    halfedge_descriptor_t halfedge(const edge_descriptor_t e, const int i) const;
+    // returns hmesh_t::null_halfedge() if "s" and "t" are not in the same input mesh or not connected
+    halfedge_descriptor_t halfedge(const vertex_descriptor_t s, const vertex_descriptor_t t, bool strict_check = false) const;
+    bool is_border(const halfedge_descriptor_t h) const;
+    bool is_border(const edge_descriptor_t e) const;
+
+    halfedge_array_view_t get_halfedges_around_face(const face_descriptor_t f) const;
+    void get_vertices_around_face(std::vector<vertex_descriptor_t>& vertex_descriptors, const face_descriptor_t f) const;
+    std::vector<face_descriptor_t> get_faces_around_face(const face_descriptor_t f, const halfedge_array_view_t* halfedges_around_face_ = nullptr) const;
+
+    vertex_iterator_t vertices_begin() const { return vertex_iterator_t(this, 0, (std::uint32_t)number_of_internal_vertices()); }
+    vertex_iterator_t vertices_end() const { return vertex_iterator_t(this, (std::uint32_t)number_of_internal_vertices(), (std::uint32_t)number_of_internal_vertices()); }
+    edge_iterator_t edges_begin() const { return edge_iterator_t(this, 0, (std::uint32_t)number_of_internal_edges()); }
+    edge_iterator_t edges_end() const { return edge_iterator_t(this, (std::uint32_t)number_of_internal_edges(), (std::uint32_t)number_of_internal_edges()); }
+    face_iterator_t faces_begin() const { return face_iterator_t(this, 0, (std::uint32_t)number_of_internal_faces()); }
+    face_iterator_t faces_end() const { return face_iterator_t(this, (std::uint32_t)number_of_internal_faces(), (std::uint32_t)number_of_internal_faces()); }
+
+private:
+    const hmesh_t* m_sm;
+    const hmesh_t* m_cm;
+    // number of internal elements in the source-mesh (i.e. where the cut-mesh elements start)
+    std::uint32_t m_sm_vertices;
+    std::uint32_t m_sm_halfedges;
+    std::uint32_t m_sm_edges;
+    std::uint32_t m_sm_faces;
+    // cut-mesh edges and halfedges <-> soup edges and halfedges
+    std::vector<edge_descriptor_t> m_cm_to_soup_edge;
+    std::vector<edge_descriptor_t> m_soup_to_cm_edge; // indexed from "m_sm_edges"
+    std::vector<halfedge_descriptor_t> m_cm_to_soup_halfedge;
+    std::vector<halfedge_descriptor_t> m_soup_to_cm_halfedge; // indexed from "m_sm_halfedges"
+};
+
+template <typename D>
+inline void polygon_soup_iterator_t<D>::skip_removed()
+{
+    while (m_index < m_end && m_soup->is_removed(D(m_index))) {
+        ++m_index;
+    }
+}
+
 namespace std {
 #if 1
 template <>
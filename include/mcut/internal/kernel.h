@@ -22,6 +22,7 @@
 
 #ifndef MCUT_KERNEL_H
 #define MCUT_KERNEL_H
+#include <mcut/internal/arena.h>
 #include <mcut/internal/bvh.h>
 #include <mcut/internal/hmesh.h>
 #if defined(MCUT_MULTI_THREADED)
@@ -113,14 +114,17 @@ struct input_t {
 #if defined(MCUT_MULTI_THREADED)
     thread_pool* scheduler = nullptr;
 #endif
+    // memory resource for temporary data structures that are local to a dispatch call
+    // (released when "dispatch(...)" returns). nullptr = use the global allocator.
+    arena_t* arena = nullptr;
     const hmesh_t* src_mesh = nullptr;
     const hmesh_t* cut_mesh = nullptr;
     // NOTE: we use std::map because it is beneficial that keys are sorted when
     // extracting edge-face intersection pairs
     const std::map<fd_t, std::vector<fd_t>>* ps_face_to_potentially_intersecting_others = nullptr;
 #if defined(USE_OIBVH)
-    const std::vector<bounding_box_t<vec3>>* source_hmesh_face_aabb_array_ptr = nullptr;
-    const std::vector<bounding_box_t<vec3>>* cut_hmesh_face_aabb_array_ptr = nullptr;
+    const array_view_t<bounding_box_t<vec3>>* source_hmesh_face_aabb_array_ptr = nullptr;
+    const array_view_t<bounding_box_t<vec3>>* cut_hmesh_face_aabb_array_ptr = nullptr;
 #else
     BoundingVolumeHierarchy* source_hmesh_BVH;
     BoundingVolumeHierarchy* cut_hmesh_BVH;
@@ -131,6 +135,7 @@ struct input_t {
     bool populate_vertex_maps = false; // compute data relating vertices in cc to original input mesh
     bool populate_face_maps = false; // compute data relating face in cc to original input mesh
     bool enforce_general_position = false;
+    bool deterministic = false; // visit hash tables in key order wherever their order decides how elements are numbered
     // counts how many times we have perturbed the cut-mesh to enforce general-position
     int general_position_enforcement_count = 0;
 
@@ -212,7 +217,11 @@ struct output_t {
 // internal main
 void dispatch(output_t& out, const input_t& in);
 
-int find_connected_components(std::vector<int>& fccmap, const hmesh_t& mesh, std::vector<int>& cc_to_vertex_count,
+int find_connected_components(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    std::vector<int>& fccmap, const hmesh_t& mesh, std::vector<int>& cc_to_vertex_count,
     std::vector<int>& cc_to_face_count);
 
 // return true if point p lies on the plane of every three vertices of f
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <type_traits>
 
 #include <vector>
 
@@ -65,10 +66,6 @@ public:
     {
     }
 
-    virtual ~vec2_()
-    {
-    }
-
     static vec2_ make(const T x, const T y)
     {
         return vec2_<T>(x, y);
@@ -145,29 +142,32 @@ protected:
 
 typedef vec2_<> vec2;
 
+// NOTE: vec3_ does not derive from vec2_ so that both are standard-layout types (all
+// data members are in one class), which lets arrays of them be treated as arrays of "T".
 template <typename T = double>
-class vec3_ : public vec2_<T> {
+class vec3_ {
 public:
+    typedef T element_type;
     vec3_()
-        : vec2_<T>(0.0, 0.0)
+        : m_x(0.0)
+        , m_y(0.0)
         , m_z(0.0)
     {
     }
 
     vec3_(const T& value)
-        : vec2_<T>(value, value)
+        : m_x(value)
+        , m_y(value)
         , m_z(value)
     {
     }
 
     vec3_(const T& x, const T& y, const T& z)
-        : vec2_<T>(x, y)
+        : m_x(x)
+        , m_y(y)
         , m_z(z)
     {
     }
-    ~vec3_()
-    {
-    }
 
     static int cardinality()
     {
@@ -218,17 +218,41 @@ public:
         return vec3_(this->m_x * number, this->m_y * number, this->m_z * number);
     }
 
+    const T& x() const
+    {
+        return m_x;
+    }
+
+    const T& y() const
+    {
+        return m_y;
+    }
+
     const T& z() const
     {
         return m_z;
     }
 
+    T& x()
+    {
+        return m_x;
+    }
+
+    T& y()
+    {
+        return m_y;
+    }
+
 protected:
-    T m_z;
+    T m_x, m_y, m_z;
 }; // vec3_
 
 typedef vec3_<> vec3;
 
+static_assert(sizeof(vec2) == 2 * sizeof(double) && sizeof(vec3) == 3 * sizeof(double), "vectors must not have padding or a vtable");
+static_assert(std::is_trivially_copyable<vec2>::value && std::is_trivially_copyable<vec3>::value, "vectors must be trivially copyable");
+static_assert(std::is_standard_layout<vec2>::value && std::is_standard_layout<vec3>::value, "vectors must be standard-layout");
+
 template <typename T = int>
 class matrix_t {
 public:
@@ -528,6 +552,12 @@ char compute_segment_plane_intersection_type(const vec3& q, const vec3& r,
     const std::vector<vec3>& polygon_vertices,
     const vec3& polygon_normal, const int polygon_normal_largest_component);
 
+// Same as above for a polygon whose vertices are given as an array. Triangles (polygon_vertex_count == 3)
+// are tested in closed form with the triangle's own vertices, which needs no (heap) allocation.
+char compute_segment_plane_intersection_type(const vec3& q, const vec3& r,
+    const vec3* polygon_vertices, const int polygon_vertex_count,
+    const vec3& polygon_normal, const int polygon_normal_largest_component);
+
 // Test if a point 'q' (in 2D) lies inside or outside a given polygon (count the number ray crossings).
 //
 // Return values:
@@ -547,6 +577,18 @@ char compute_point_in_polygon_test(const vec2& q, const std::vector<vec2>& polyg
 char compute_point_in_polygon_test(const vec3& p, const std::vector<vec3>& polygon_vertices,
     const vec3& polygon_normal, const int polygon_normal_largest_component);
 
+// Same as above for a polygon whose vertices are given as an array. Triangles use the closed-form test
+// below and need no (heap) allocation.
+char compute_point_in_polygon_test(const vec3& p, const vec3* polygon_vertices, const int polygon_vertex_count,
+    const vec3& polygon_normal, const int polygon_normal_largest_component);
+
+// Closed-form version of the above test for triangles (p is assumed to lie in the plane of the triangle).
+// The triangle is projected onto the axis-aligned plane that drops the largest component of its normal,
+// which is exact, and "p" is then classified with the signs of its (exact) barycentric coordinates.
+// Returns 0 if the projected triangle is degenerate, otherwise the same values as the polygon test.
+char compute_point_in_triangle_test(const vec3& p, const vec3& a, const vec3& b, const vec3& c,
+    const int triangle_normal_largest_component);
+
 // project a 3d polygon to 3d by eliminating the largest component of its normal
 void project2D(std::vector<vec2>& out, const std::vector<vec3>& polygon_vertices,
     const vec3& polygon_normal, const int polygon_normal_largest_component);
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ *
+ * NOTE: This file is licensed under GPL-3.0-or-later (default).
+ * A commercial license can be purchased from Floyd M. Chitalu.
+ *
+ * License details:
+ *
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ *
+ * The commercial license options is for users that wish to use MCUT in
+ * their products for comercial purposes but do not wish to release their
+ * software products under the GPL license.
+ *
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#ifndef MCUT_RADIX_SORT_H_
+#define MCUT_RADIX_SORT_H_
+
+#include "mcut/internal/utils.h"
+
+#if defined(MCUT_MULTI_THREADED)
+#include "mcut/internal/tpool.h"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+    Sorts 64-bit keys in ascending order with a least-significant-digit radix sort (one byte per pass).
+
+    Only the bytes up to the most significant bit of the largest key are sorted, and a pass is skipped
+    if all keys have the same byte. Each pass counts and then scatters fixed-size blocks of keys, which
+    is done in parallel in the multi-threaded build. The blocks are scattered in order (so every pass is
+    stable), which means that the result does not depend on the number of threads.
+*/
+inline void radix_sort(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    std::vector<std::uint64_t>& keys)
+{
+    const std::size_t n = keys.size();
+
+    if (n < 2) {
+        return;
+    }
+
+    std::uint64_t max_key = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        max_key = (keys[i] > max_key) ? keys[i] : max_key;
+    }
+
+    const std::ptrdiff_t block_size = (std::ptrdiff_t(1) << 14);
+    const std::size_t num_blocks = (n + block_size - 1) / block_size;
+    const int radix = 256;
+
+    // the number of keys of each block with a given byte value, which is then
+    // turned into the position at which the block writes its next key with that value
+    std::vector<std::size_t> block_offsets(num_blocks * radix);
+
+    std::vector<std::uint64_t> sorted(n);
+
+    for (int shift = 0; shift < 64 && (max_key >> shift) != 0; shift += 8) {
+
+        auto fn_count = [&](std::vector<std::uint64_t>::const_iterator block_start_, std::vector<std::uint64_t>::const_iterator block_end_) -> bool {
+            const std::size_t block_idx = (std::size_t)(block_start_ - keys.cbegin()) / block_size;
+            std::size_t* counts = block_offsets.data() + block_idx * radix;
+
+            for (int d = 0; d < radix; ++d) {
+                counts[d] = 0;
+            }
+
+            for (std::vector<std::uint64_t>::const_iterator i = block_start_; i != block_end_; ++i) {
+                counts[(*i >> shift) & 0xFF]++;
+            }
+            return true;
+        };
+
+#if defined(MCUT_MULTI_THREADED)
+        {
+            std::vector<std::future<bool>> futures;
+            bool _1;
+
+            parallel_fork_and_join(
+                scheduler,
+                keys.cbegin(),
+                keys.cend(),
+                block_size,
+                fn_count,
+                _1, // out
+                futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<bool>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                f.wait(); // wait for result to be done
+            }
+        }
+#else
+        for (std::size_t b = 0; b < num_blocks; ++b) {
+            fn_count(keys.cbegin() + b * block_size, (b + 1 == num_blocks) ? keys.cend() : keys.cbegin() + (b + 1) * block_size);
+        }
+#endif
+
+        // exclusive prefix sum over (byte value, block) pairs
+        bool all_keys_have_same_byte = false;
+        std::size_t offset = 0;
+
+        for (int d = 0; d < radix && !all_keys_have_same_byte; ++d) {
+            const std::size_t offset_before = offset;
+
+            for (std::size_t b = 0; b < num_blocks; ++b) {
+                std::size_t& count = block_offsets[b * radix + d];
+                const std::size_t c = count;
+                count = offset;
+                offset += c;
+            }
+
+            all_keys_have_same_byte = (offset - offset_before) == n;
+        }
+
+        if (all_keys_have_same_byte) {
+            continue; // the keys are already ordered w.r.t the current byte
+        }
+
+        auto fn_scatter = [&](std::vector<std::uint64_t>::const_iterator block_start_, std::vector<std::uint64_t>::const_iterator block_end_) -> bool {
+            const std::size_t block_idx = (std::size_t)(block_start_ - keys.cbegin()) / block_size;
+            std::size_t* offsets = block_offsets.data() + block_idx * radix;
+
+            for (std::vector<std::uint64_t>::const_iterator i = block_start_; i != block_end_; ++i) {
+                sorted[offsets[(*i >> shift) & 0xFF]++] = *i;
+            }
+            return true;
+        };
+
+#if defined(MCUT_MULTI_THREADED)
+        {
+            std::vector<std::future<bool>> futures;
+            bool _1;
+
+            parallel_fork_and_join(
+                scheduler,
+                keys.cbegin(),
+                keys.cend(),
+                block_size,
+                fn_scatter,
+                _1, // out
+                futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<bool>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                f.wait(); // wait for result to be done
+            }
+        }
+#else
+        for (std::size_t b = 0; b < num_blocks; ++b) {
+            fn_scatter(keys.cbegin() + b * block_size, (b + 1 == num_blocks) ? keys.cend() : keys.cbegin() + (b + 1) * block_size);
+        }
+#endif
+
+        keys.swap(sorted);
+    }
+}
+
+#endif // MCUT_RADIX_SORT_H_
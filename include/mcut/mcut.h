@@ -340,7 +340,36 @@ typedef enum McDispatchFlags {
         the result for the perturbed input will hopefully still be useful.  This is justified by the fact that
         the task of MCUT is not to decide whether the input is in general position but rather to make perturbation
         on the input (if) necessary within the available precision of the computing device. */
-    MC_DISPATCH_ENFORCE_GENERAL_POSITION = (1 << 15) 
+    MC_DISPATCH_ENFORCE_GENERAL_POSITION = (1 << 15), 
+    /** 
+         * Exactly test pairs of polygons with overlapping bounding boxes during the broad phase, and discard
+         * those pairs in which the vertices of one polygon are strictly on one side of the plane of the other
+         * (a triangle). 
+         * 
+         * Such pairs cannot intersect, and would otherwise be tested (and rejected) later by the kernel. Discarding
+         * them early reduces the amount of work done when the input meshes are close but mostly do not intersect
+         * (e.g. offset surfaces). The connected components that are produced are the same as without this flag.*/
+    MC_DISPATCH_CULL_SEPARATED_POLYGONS = (1 << 16),
+    /**
+         * Check that neither input mesh intersects itself before cutting.
+         *
+         * A self-intersecting input can make MCUT repeatedly perturb the cut-mesh until the maximum number of
+         * attempts is reached, which is expensive. With this flag, each mesh is first checked for pairs of polygons
+         * that intersect (or touch) but do not share a vertex, and ::mcDispatch returns ::MC_INVALID_VALUE if any are found.
+         * The offending pairs of polygons are reported via the debug callback (see ::mcDebugMessageCallback).*/
+    MC_DISPATCH_CHECK_SELF_INTERSECTIONS = (1 << 17),
+    /**
+         * Produce bit-identical output for the same input in every run.
+         *
+         * The output of MCUT does not depend on the number of threads. But, by default, the order of the
+         * connected components that are returned by ::mcGetConnectedComponents depends on the addresses at
+         * which they are allocated, some intersection points and edges are numbered in the (implementation-defined)
+         * order of hash tables, and the perturbation of the cut-mesh (see ::MC_DISPATCH_ENFORCE_GENERAL_POSITION)
+         * depends on previous dispatch calls. With this flag, connected components are returned in the order in which
+         * they are created, hash tables are visited in the order of their keys, and the perturbation only depends on
+         * the input. This makes the output identical between runs, thread counts and standard library implementations.
+         * The overhead is small (typically less than 1% of the dispatch time).*/
+    MC_DISPATCH_DETERMINISTIC = (1 << 18)
 } McDispatchFlags;
 
 /**
@@ -351,9 +380,24 @@ typedef enum McDispatchFlags {
  */
 typedef enum McQueryFlags {
     MC_CONTEXT_FLAGS = 1 << 0, /**< Flags used to create a context.*/
-    MC_DONT_CARE = 1 << 1 /**< wildcard.*/
+    MC_DONT_CARE = 1 << 1, /**< wildcard.*/
+    MC_CONTEXT_BVH_CACHE_DIRECTORY = 1 << 2, /**< Path (null-terminated string) of the directory in which serialized source-mesh BVHs are stored and reused across dispatch calls and processes. An empty path disables caching (default). See also: ::mcBindState */
+    MC_CONTEXT_BROAD_PHASE = 1 << 3 /**< The algorithm (::McBroadPhase) used to find the polygons that are tested for intersection during a dispatch call. See also: ::mcBindState */
 } McQueryFlags;
 
+/**
+ * \enum McBroadPhase
+ * @brief Broad-phase collision detection algorithms.
+ *
+ * This enum structure defines the algorithms that may be used to find pairs of polygons (one from each input mesh) that could intersect, and which are then tested exactly during ::mcDispatch. The choice of algorithm does not change the result of a dispatch call. See also ::MC_CONTEXT_BROAD_PHASE.
+ */
+typedef enum McBroadPhase {
+    MC_BROAD_PHASE_AUTO = 0, /**< Let MCUT choose the algorithm. A uniform grid is used for large source-meshes whose polygons have similar sizes, and a BVH otherwise. */
+    MC_BROAD_PHASE_BVH = 1, /**< Simultaneously traverse the bounding volume hierarchies of both input meshes (default). */
+    MC_BROAD_PHASE_UNIFORM_GRID = 2, /**< Bin the polygons of both input meshes into a uniform grid spanning the region where the meshes overlap. This is typically faster for uniformly tessellated meshes such as scans and terrains. */
+    MC_BROAD_PHASE_MAX_ENUM = 0xFFFFFFFF /**< Wildcard (match all) . */
+} McBroadPhase;
+
 /**
  *  
  * @brief Debug callback function signature type.
@@ -574,6 +618,7 @@ extern MCAPI_ATTR McResult MCAPI_CALL mcDebugMessageControl(
 *   -# \p pCutMeshFaceSizes is NULL.
 *   -# \p numCutMeshVertices is less than three.
 *   -# \p numCutMeshFaces is less than one.
+*   -# ::MC_DISPATCH_CHECK_SELF_INTERSECTIONS is set and an input mesh intersects itself.
 *   -# ::MC_DISPATCH_ENFORCE_GENERAL_POSITION is not set and: 1) Found two intersecting edges between the source-mesh and the cut-mesh and/or 2) An intersection test between a face and an edge failed because an edge vertex only touches (but does not penetrate) the face, and/or 3) One or more source-mesh vertices are colocated with one or more cut-mesh vertices.
 * - ::MC_OUT_OF_MEMORY
 *   -# Insufficient memory to perform operation.
@@ -636,6 +681,48 @@ extern MCAPI_ATTR McResult MCAPI_CALL mcGetInfo(
     void* pMem,
     uint64_t* pNumBytes);
 
+/**
+* @brief Set the value of a selected context parameter.
+*
+* @param[in] context The context handle that was created by a previous call to ::mcCreateContext. 
+* @param[in] stateInfo The parameter being set. ::McQueryFlags
+* @param[in] bytes Size in bytes of memory pointed to by \p pMem.
+* @param[in] pMem Pointer to memory holding the new value of the parameter.
+*
+* Parameters which may be set are:
+* - ::MC_CONTEXT_BVH_CACHE_DIRECTORY: \p pMem points to a character string of \p bytes length naming an existing directory. 
+* On each dispatch, the bounding volume hierarchy of the source-mesh is loaded (memory-mapped) from this directory if it was 
+* previously built for a mesh with identical content, otherwise it is built and written there. Passing \p bytes equal to zero 
+* disables the cache.
+* - ::MC_CONTEXT_BROAD_PHASE: \p pMem points to an ::McBroadPhase value, and \p bytes is sizeof(::McBroadPhase). Bounding
+* volume hierarchies are always used when MCUT is built with MCUT_USE_CLASSIC_BVH.
+*
+ * An example of usage:
+ * @code
+ * const char* cacheDir = "/tmp/mcut-bvh-cache";
+ * McResult err = mcBindState(context, MC_CONTEXT_BVH_CACHE_DIRECTORY, strlen(cacheDir), cacheDir);
+ * if(err != MC_NO_ERROR)
+ * {
+ *  // deal with error
+ * }
+ * @endcode
+* @return Error code.
+*
+* <b>Error codes</b> 
+* - MC_NO_ERROR  
+*   -# proper exit 
+* - MC_INVALID_VALUE 
+*   -# \p pContext is NULL or \p pContext is not an existing context.
+*   -# \p stateInfo is not a parameter that can be set.
+*   -# \p bytes is not zero and \p pMem is NULL.
+*   -# \p stateInfo is ::MC_CONTEXT_BROAD_PHASE and \p bytes is not sizeof(::McBroadPhase), or \p pMem does not point to a valid ::McBroadPhase value.
+*/
+extern MCAPI_ATTR McResult MCAPI_CALL mcBindState(
+    const McContext context,
+    McFlags stateInfo,
+    uint64_t bytes,
+    const void* pMem);
+
 /**
 * @brief Query the connected components available in a context.
 * 
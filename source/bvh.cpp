@@ -25,6 +25,20 @@
 
 #include <queue>
 #include <cmath> // see: if it is possible to remove thsi header
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #ifdef _MSC_VER
 #include <intrin.h>
@@ -49,6 +63,533 @@ unsigned int __inline clz_(unsigned int value)
 #define CHAR_BIT 8
 #endif
 
+    // returns true if all vertices of "face" lie strictly on one side of the plane of triangle "tri"
+    static bool face_is_strictly_on_one_side_of_triangle(
+        const hmesh_t& mesh,
+        const std::vector<vd_t>& face_vertices,
+        const hmesh_t& tri_mesh,
+        const std::vector<vd_t>& tri_vertices)
+    {
+        MCUT_ASSERT(tri_vertices.size() == 3);
+
+        const vec3& a = tri_mesh.vertex(tri_vertices[0]);
+        const vec3& b = tri_mesh.vertex(tri_vertices[1]);
+        const vec3& c = tri_mesh.vertex(tri_vertices[2]);
+
+        int side = 0;
+
+        for (std::vector<vd_t>::const_iterator v = face_vertices.cbegin(); v != face_vertices.cend(); ++v) {
+            const double orientation = orient3d(a, b, c, mesh.vertex(*v));
+
+            if (orientation == double(0.0)) {
+                return false; // touches the plane
+            }
+
+            const int vertex_side = orientation > double(0.0) ? 1 : -1;
+
+            if (side == 0) {
+                side = vertex_side;
+            } else if (side != vertex_side) {
+                return false; // straddles the plane
+            }
+        }
+
+        return true;
+    }
+
+    bool faces_are_separated_by_plane(
+        const hmesh_t& meshA,
+        const fd_t faceA,
+        const hmesh_t& meshB,
+        const fd_t faceB)
+    {
+        thread_local std::vector<vd_t> faceA_vertices;
+        thread_local std::vector<vd_t> faceB_vertices;
+
+        meshA.get_vertices_around_face(faceA_vertices, faceA);
+        meshB.get_vertices_around_face(faceB_vertices, faceB);
+
+        if (faceB_vertices.size() == 3 && face_is_strictly_on_one_side_of_triangle(meshA, faceA_vertices, meshB, faceB_vertices)) {
+            return true;
+        }
+
+        if (faceA_vertices.size() == 3 && face_is_strictly_on_one_side_of_triangle(meshB, faceB_vertices, meshA, faceA_vertices)) {
+            return true;
+        }
+
+        return false;
+    }
+
+// minimum number of faces in a mesh for "prefer_uniform_grid" to consider a uniform grid
+#define MCUT_UNIFORM_GRID_MIN_FACE_COUNT (1 << 14)
+// number of faces sampled by "prefer_uniform_grid" to estimate the variation in face size
+#define MCUT_UNIFORM_GRID_SAMPLE_FACE_COUNT 1024
+// upper bound on the number of cells in a uniform grid
+#define MCUT_UNIFORM_GRID_MAX_CELL_COUNT (1 << 24)
+// upper bound on the number of cells into which a source-mesh face is binned (larger faces are put in an overflow list)
+#define MCUT_UNIFORM_GRID_MAX_CELLS_PER_FACE 64
+
+    // pointers to the per-axis vertex coordinate arrays of a mesh
+    struct vertex_coordinate_arrays_t {
+        const double* axis[3];
+
+        explicit vertex_coordinate_arrays_t(const hmesh_t& mesh)
+        {
+            for (int i = 0; i < 3; ++i) {
+                axis[i] = mesh.vertex_coordinates(i).data();
+            }
+        }
+    };
+
+    static inline bounding_box_t<vec3> compute_face_bbox(const hmesh_t& mesh, const vertex_coordinate_arrays_t& coords, const fd_t f)
+    {
+        bounding_box_t<vec3> bbox;
+        const descriptor_array_view_t<hd_t> halfedges_on_face = mesh.get_halfedges_around_face(f);
+
+        // for each vertex on face
+        for (descriptor_array_view_t<hd_t>::const_iterator h = halfedges_on_face.cbegin(); h != halfedges_on_face.cend(); ++h) {
+            const vd_t v = mesh.target(*h);
+
+            for (int i = 0; i < 3; ++i) {
+                const double c = coords.axis[i][v];
+                bbox.m_minimum[i] = std::min(bbox.m_minimum[i], c);
+                bbox.m_maximum[i] = std::max(bbox.m_maximum[i], c);
+            }
+        }
+
+        return bbox;
+    }
+
+    void compute_face_bboxes(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool& scheduler,
+#endif
+        const hmesh_t& mesh,
+        std::vector<bounding_box_t<vec3>>& face_bboxes,
+        const double& slightEnlargmentEps)
+    {
+        TIMESTACK_PUSH(__FUNCTION__);
+
+        face_bboxes.resize(mesh.number_of_faces());
+
+        const vertex_coordinate_arrays_t coords(mesh);
+
+        auto fn_compute_face_bboxes = [&](std::vector<bounding_box_t<vec3>>::iterator block_start_, std::vector<bounding_box_t<vec3>>::iterator block_end_) {
+            for (std::vector<bounding_box_t<vec3>>::iterator it = block_start_; it != block_end_; ++it) {
+                const fd_t f((int)std::distance(face_bboxes.begin(), it));
+
+                bounding_box_t<vec3> bbox = compute_face_bbox(mesh, coords, f);
+
+                if (slightEnlargmentEps > double(0.0)) {
+                    bbox.enlarge(slightEnlargmentEps);
+                }
+
+                *it = bbox;
+            }
+        };
+
+#if defined(MCUT_MULTI_THREADED)
+        {
+            auto fn_compute_face_bboxes_block = [&](std::vector<bounding_box_t<vec3>>::iterator block_start_, std::vector<bounding_box_t<vec3>>::iterator block_end_) -> bool {
+                fn_compute_face_bboxes(block_start_, block_end_);
+                return true;
+            };
+
+            std::vector<std::future<bool>> futures;
+            bool _1;
+
+            parallel_fork_and_join(
+                scheduler,
+                face_bboxes.begin(),
+                face_bboxes.end(),
+                (1 << 12),
+                fn_compute_face_bboxes_block,
+                _1, // out
+                futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<bool>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                f.wait(); // wait for result to be done
+            }
+        }
+#else
+        fn_compute_face_bboxes(face_bboxes.begin(), face_bboxes.end());
+#endif
+
+        TIMESTACK_POP();
+    }
+
+    bool prefer_uniform_grid(const hmesh_t& mesh)
+    {
+        const int face_count = mesh.number_of_faces();
+
+        if (face_count < MCUT_UNIFORM_GRID_MIN_FACE_COUNT) {
+            return false; // a BVH is cheap enough to build
+        }
+
+        // Estimate the coefficient of variation of face size (largest bounding box extent).
+        // Grids work well when faces have similar sizes, since then one cell size suits all faces.
+
+        const int stride = std::max(1, face_count / MCUT_UNIFORM_GRID_SAMPLE_FACE_COUNT);
+        std::vector<vd_t> vertices_on_face;
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        int sample_count = 0;
+
+        for (int i = 0; i < face_count; i += stride) {
+            mesh.get_vertices_around_face(vertices_on_face, fd_t(i));
+
+            bounding_box_t<vec3> bbox;
+            for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+                bbox.expand(mesh.vertex(*v));
+            }
+
+            const vec3 diag = bbox.maximum() - bbox.minimum();
+            const double extent = std::max(diag.x(), std::max(diag.y(), diag.z()));
+
+            sum += extent;
+            sum_sq += extent * extent;
+            sample_count++;
+        }
+
+        const double mean = sum / sample_count;
+
+        if (mean <= double(0.0)) {
+            return false;
+        }
+
+        const double variance = std::max(double(0.0), (sum_sq / sample_count) - (mean * mean));
+        const double coefficient_of_variation = std::sqrt(variance) / mean;
+
+        return coefficient_of_variation < double(0.5);
+    }
+
+    void intersect_uniform_grid(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool& scheduler,
+#endif
+        std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
+        const std::vector<bounding_box_t<vec3>>& srcMeshFaceBBoxes,
+        const std::vector<bounding_box_t<vec3>>& cutMeshFaceBBoxes,
+        const hmesh_t* srcMesh,
+        const hmesh_t* cutMesh)
+    {
+        TIMESTACK_PUSH(__FUNCTION__);
+
+        const int numSrcMeshFaces = (int)srcMeshFaceBBoxes.size();
+        const int numCutMeshFaces = (int)cutMeshFaceBBoxes.size();
+        const bool cull_separated_faces = (srcMesh != nullptr && cutMesh != nullptr);
+
+        if (numSrcMeshFaces == 0 || numCutMeshFaces == 0) {
+            TIMESTACK_POP();
+            return;
+        }
+
+        // compute the region of the grid
+        // ::::::::::::::::::::::::::::::
+
+        bounding_box_t<vec3> srcMeshBBox;
+        double average_src_face_extent = 0.0;
+
+        for (int i = 0; i < numSrcMeshFaces; ++i) {
+            const bounding_box_t<vec3>& bbox = SAFE_ACCESS(srcMeshFaceBBoxes, i);
+            const vec3 diag = bbox.maximum() - bbox.minimum();
+            average_src_face_extent += std::max(diag.x(), std::max(diag.y(), diag.z()));
+            srcMeshBBox.expand(bbox);
+        }
+
+        average_src_face_extent /= numSrcMeshFaces;
+
+        bounding_box_t<vec3> cutMeshBBox;
+
+        for (int i = 0; i < numCutMeshFaces; ++i) {
+            cutMeshBBox.expand(SAFE_ACCESS(cutMeshFaceBBoxes, i));
+        }
+
+        if (!intersect_bounding_boxes(srcMeshBBox, cutMeshBBox)) {
+            TIMESTACK_POP();
+            return; // nothing can intersect
+        }
+
+        // only the region where both meshes overlap can contain intersecting faces
+        const bounding_box_t<vec3> region(
+            compwise_max(srcMeshBBox.minimum(), cutMeshBBox.minimum()),
+            compwise_min(srcMeshBBox.maximum(), cutMeshBBox.maximum()));
+        const vec3 region_extent = region.maximum() - region.minimum();
+        const double max_region_extent = std::max(region_extent.x(), std::max(region_extent.y(), region_extent.z()));
+
+        // choose the cell size
+        // ::::::::::::::::::::
+
+        // Start with cells that are as large as the average source-mesh face, and grow them
+        // until the grid does not have (much) more cells than there are source-mesh faces.
+
+        double cell_size = average_src_face_extent;
+
+        if (cell_size <= double(0.0)) {
+            cell_size = max_region_extent;
+        }
+
+        if (cell_size <= double(0.0)) {
+            cell_size = 1.0; // the region is a point
+        }
+
+        const double max_cell_count = (double)std::min(MCUT_UNIFORM_GRID_MAX_CELL_COUNT, std::max(64, 4 * numSrcMeshFaces));
+        int grid_dims[3] = { 1, 1, 1 };
+
+        while (true) {
+            double cell_count = 1.0;
+
+            for (int i = 0; i < 3; ++i) {
+                const double d = std::max(double(1.0), std::ceil(region_extent[i] / cell_size));
+                cell_count *= d;
+                grid_dims[i] = (int)std::min(d, max_cell_count);
+            }
+
+            if (cell_count <= max_cell_count) {
+                break;
+            }
+
+            cell_size *= 1.5;
+        }
+
+        const int cell_count = grid_dims[0] * grid_dims[1] * grid_dims[2];
+        const double inv_cell_size = double(1.0) / cell_size;
+
+        // maps a point to the (clamped) coordinates of the cell containing it
+        auto get_cell_coords = [&](const vec3& point, int coords[3]) {
+            for (int i = 0; i < 3; ++i) {
+                const int c = (int)std::floor((point[i] - region.minimum()[i]) * inv_cell_size);
+                coords[i] = std::min(std::max(c, 0), grid_dims[i] - 1);
+            }
+        };
+
+        // maps a bounding box to the range of cells that it overlaps in the region
+        auto get_cell_range = [&](const bounding_box_t<vec3>& bbox, int lo[3], int hi[3]) -> bool {
+            if (!intersect_bounding_boxes(bbox, region)) {
+                return false;
+            }
+            get_cell_coords(bbox.minimum(), lo);
+            get_cell_coords(bbox.maximum(), hi);
+            return true;
+        };
+
+        auto get_cell_index = [&](const int coords[3]) -> int {
+            return (coords[2] * grid_dims[1] + coords[1]) * grid_dims[0] + coords[0];
+        };
+
+        // bin source-mesh faces into cells
+        // ::::::::::::::::::::::::::::::::
+
+        // The cells are stored in compressed form, where the faces in cell "i" are
+        // "cell_faces[cell_offsets[i]]" to "cell_faces[cell_offsets[i + 1] - 1]".
+        // Faces that overlap too many cells are not binned (which would need O(cells) memory
+        // for one face) but are instead tested against every cut-mesh face.
+
+        std::vector<uint32_t> cell_offsets(cell_count + 1, 0);
+        std::vector<fd_t> cell_faces;
+        std::vector<fd_t> overflow_faces;
+
+        {
+            std::vector<int> face_cell_ranges(numSrcMeshFaces * 6, -1);
+
+            auto fn_compute_cell_ranges = [&](std::vector<bounding_box_t<vec3>>::const_iterator block_start_, std::vector<bounding_box_t<vec3>>::const_iterator block_end_) {
+                for (std::vector<bounding_box_t<vec3>>::const_iterator it = block_start_; it != block_end_; ++it) {
+                    const int i = (int)std::distance(srcMeshFaceBBoxes.cbegin(), it);
+                    int* range = face_cell_ranges.data() + (i * 6);
+                    if (!get_cell_range(*it, range, range + 3)) {
+                        range[0] = -1; // face is outside of region
+                    }
+                }
+            };
+
+#if defined(MCUT_MULTI_THREADED)
+            {
+                auto fn_compute_cell_ranges_block = [&](std::vector<bounding_box_t<vec3>>::const_iterator block_start_, std::vector<bounding_box_t<vec3>>::const_iterator block_end_) -> bool {
+                    fn_compute_cell_ranges(block_start_, block_end_);
+                    return true;
+                };
+
+                std::vector<std::future<bool>> futures;
+                bool _1;
+
+                parallel_fork_and_join(
+                    scheduler,
+                    srcMeshFaceBBoxes.cbegin(),
+                    srcMeshFaceBBoxes.cend(),
+                    (1 << 12),
+                    fn_compute_cell_ranges_block,
+                    _1, // out
+                    futures);
+
+                for (int i = 0; i < (int)futures.size(); ++i) {
+                    std::future<bool>& f = futures[i];
+                    MCUT_ASSERT(f.valid());
+                    f.wait(); // wait for result to be done
+                }
+            }
+#else
+            fn_compute_cell_ranges(srcMeshFaceBBoxes.cbegin(), srcMeshFaceBBoxes.cend());
+#endif
+
+            // counting sort of the faces by cell (two passes: count, then scatter)
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int i = 0; i < numSrcMeshFaces; ++i) {
+                    const int* range = face_cell_ranges.data() + (i * 6);
+
+                    if (range[0] == -1) {
+                        continue;
+                    }
+
+                    const int64_t range_cell_count = (int64_t)(range[3] - range[0] + 1) * (range[4] - range[1] + 1) * (range[5] - range[2] + 1);
+
+                    if (range_cell_count > MCUT_UNIFORM_GRID_MAX_CELLS_PER_FACE) {
+                        if (pass == 0) {
+                            overflow_faces.push_back(fd_t(i));
+                        }
+                        continue;
+                    }
+
+                    int c[3];
+                    for (c[2] = range[2]; c[2] <= range[5]; ++c[2]) {
+                        for (c[1] = range[1]; c[1] <= range[4]; ++c[1]) {
+                            for (c[0] = range[0]; c[0] <= range[3]; ++c[0]) {
+                                const int cell = get_cell_index(c);
+                                if (pass == 0) {
+                                    cell_offsets[cell + 1]++;
+                                } else {
+                                    cell_faces[cell_offsets[cell]++] = fd_t(i);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                if (pass == 0) {
+                    // prefix sum
+                    for (int i = 0; i < cell_count; ++i) {
+                        cell_offsets[i + 1] += cell_offsets[i];
+                    }
+                    cell_faces.resize(cell_offsets.back());
+                } else {
+                    // the scatter pass advanced each offset to the start of the next cell
+                    for (int i = cell_count; i > 0; --i) {
+                        cell_offsets[i] = cell_offsets[i - 1];
+                    }
+                    cell_offsets[0] = 0;
+                }
+            }
+        }
+
+        // query the grid with cut-mesh faces
+        // ::::::::::::::::::::::::::::::::::
+
+        // A pair of faces whose bounding boxes overlap may share several cells, so the pair is
+        // only reported in the cell containing the minimum corner of the boxes' intersection.
+
+        typedef std::vector<std::pair<fd_t, fd_t>> OutputStorageType; // (source-mesh face, cut-mesh face)
+
+        auto fn_query_grid = [&](std::vector<bounding_box_t<vec3>>::const_iterator block_start_, std::vector<bounding_box_t<vec3>>::const_iterator block_end_) {
+            OutputStorageType pairs;
+
+            for (std::vector<bounding_box_t<vec3>>::const_iterator it = block_start_; it != block_end_; ++it) {
+                const int cut_face_idx = (int)std::distance(cutMeshFaceBBoxes.cbegin(), it);
+                const bounding_box_t<vec3>& cut_face_bbox = *it;
+                int lo[3];
+                int hi[3];
+
+                if (!get_cell_range(cut_face_bbox, lo, hi)) {
+                    continue;
+                }
+
+                int c[3];
+                for (c[2] = lo[2]; c[2] <= hi[2]; ++c[2]) {
+                    for (c[1] = lo[1]; c[1] <= hi[1]; ++c[1]) {
+                        for (c[0] = lo[0]; c[0] <= hi[0]; ++c[0]) {
+                            const int cell = get_cell_index(c);
+
+                            for (uint32_t j = cell_offsets[cell]; j < cell_offsets[cell + 1]; ++j) {
+                                const fd_t src_face = cell_faces[j];
+                                const bounding_box_t<vec3>& src_face_bbox = SAFE_ACCESS(srcMeshFaceBBoxes, src_face);
+
+                                if (!intersect_bounding_boxes(src_face_bbox, cut_face_bbox)) {
+                                    continue;
+                                }
+
+                                int owner[3];
+                                get_cell_coords(compwise_max(src_face_bbox.minimum(), cut_face_bbox.minimum()), owner);
+
+                                if (owner[0] != c[0] || owner[1] != c[1] || owner[2] != c[2]) {
+                                    continue; // pair is reported in another cell
+                                }
+
+                                if (cull_separated_faces && faces_are_separated_by_plane(*srcMesh, src_face, *cutMesh, fd_t(cut_face_idx))) {
+                                    continue;
+                                }
+
+                                pairs.emplace_back(src_face, fd_t(cut_face_idx));
+                            }
+                        }
+                    }
+                }
+
+                for (std::vector<fd_t>::const_iterator of = overflow_faces.cbegin(); of != overflow_faces.cend(); ++of) {
+                    const fd_t src_face = *of;
+
+                    if (!intersect_bounding_boxes(SAFE_ACCESS(srcMeshFaceBBoxes, src_face), cut_face_bbox)) {
+                        continue;
+                    }
+
+                    if (cull_separated_faces && faces_are_separated_by_plane(*srcMesh, src_face, *cutMesh, fd_t(cut_face_idx))) {
+                        continue;
+                    }
+
+                    pairs.emplace_back(src_face, fd_t(cut_face_idx));
+                }
+            }
+
+            return pairs;
+        };
+
+        auto fn_merge_pairs = [&](const OutputStorageType& pairs) {
+            for (OutputStorageType::const_iterator it = pairs.cbegin(); it != pairs.cend(); ++it) {
+                const fd_t cs_face_offsetted = fd_t(it->second + numSrcMeshFaces);
+
+                ps_face_to_potentially_intersecting_others[it->first].push_back(cs_face_offsetted);
+                ps_face_to_potentially_intersecting_others[cs_face_offsetted].push_back(it->first);
+            }
+        };
+
+#if defined(MCUT_MULTI_THREADED)
+        {
+            std::vector<std::future<OutputStorageType>> futures;
+            OutputStorageType partial_res;
+
+            parallel_fork_and_join(
+                scheduler,
+                cutMeshFaceBBoxes.cbegin(),
+                cutMeshFaceBBoxes.cend(),
+                (1 << 10),
+                fn_query_grid,
+                partial_res, // output of master thread
+                futures);
+
+            fn_merge_pairs(partial_res);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<OutputStorageType>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                fn_merge_pairs(f.get());
+            }
+        }
+#else
+        fn_merge_pairs(fn_query_grid(cutMeshFaceBBoxes.cbegin(), cutMeshFaceBBoxes.cend()));
+#endif
+
+        TIMESTACK_POP();
+    }
+
 #if defined(USE_OIBVH)
     // count leading zeros in 32 bit bitfield
     unsigned int clz(unsigned int x) // stub
@@ -199,6 +740,33 @@ unsigned int __inline clz_(unsigned int value)
         return (xx * 4 + yy * 2 + zz);
     };
 
+    // bounding box of all vertices of "mesh" (which must not have removed vertices) computed
+    // with one streaming pass over each coordinate array
+    static bounding_box_t<vec3> compute_mesh_bbox(const hmesh_t& mesh)
+    {
+        MCUT_ASSERT(mesh.number_of_vertices_removed() == 0);
+
+        bounding_box_t<vec3> bbox;
+
+        for (int i = 0; i < 3; ++i) {
+            const std::vector<double>& coords = mesh.vertex_coordinates(i);
+            const double* const coords_ptr = coords.data();
+            const std::size_t coords_count = coords.size();
+            double axis_min = bbox.m_minimum[i];
+            double axis_max = bbox.m_maximum[i];
+
+            for (std::size_t j = 0; j < coords_count; ++j) {
+                axis_min = std::min(axis_min, coords_ptr[j]);
+                axis_max = std::max(axis_max, coords_ptr[j]);
+            }
+
+            bbox.m_minimum[i] = axis_min;
+            bbox.m_maximum[i] = axis_max;
+        }
+
+        return bbox;
+    }
+
     void build_oibvh(
         const hmesh_t& mesh,
         std::vector<bounding_box_t<vec3>>& bvhAABBs,
@@ -217,16 +785,13 @@ unsigned int __inline clz_(unsigned int value)
         face_bboxes.resize(meshFaceCount); //, bounding_box_t<vec3>());
         std::vector<vec3> face_bbox_centers(meshFaceCount, vec3());
 
+        const vertex_coordinate_arrays_t coords(mesh);
+
         // for each face in mesh
         for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
             const int faceIdx = static_cast<int>(*f);
-            const std::vector<vd_t> vertices_on_face = mesh.get_vertices_around_face(*f);
 
-            // for each vertex on face
-            for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
-                const vec3 coords = mesh.vertex(*v);
-                face_bboxes[faceIdx].expand(coords);
-            }
+            face_bboxes[faceIdx] = compute_face_bbox(mesh, coords, *f);
 
             bounding_box_t<vec3>& bbox = face_bboxes[faceIdx];
 
@@ -244,11 +809,7 @@ unsigned int __inline clz_(unsigned int value)
         bvhAABBs.resize(bvhNodeCount);
         bounding_box_t<vec3>& meshBbox = bvhAABBs.front(); // root bounding box
 
-        // for each vertex in mesh
-        for (vertex_array_iterator_t v = mesh.vertices_begin(); v != mesh.vertices_end(); ++v) {
-            const vec3& coords = mesh.vertex(*v);
-            meshBbox.expand(coords);
-        }
+        meshBbox = compute_mesh_bbox(mesh);
 
         // compute morton codes
         // ::::::::::::::::::::
@@ -379,10 +940,12 @@ unsigned int __inline clz_(unsigned int value)
 
 void intersectOIBVHs(
     std::map<fd_t, std::vector<fd_t>> &ps_face_to_potentially_intersecting_others,
-    const std::vector<bounding_box_t<vec3>> &srcMeshBvhAABBs,
-    const std::vector<fd_t> &srcMeshBvhLeafNodeFaces,
-    const std::vector<bounding_box_t<vec3>> &cutMeshBvhAABBs,
-    const std::vector<fd_t> &cutMeshBvhLeafNodeFaces)
+    const array_view_t<bounding_box_t<vec3>> &srcMeshBvhAABBs,
+    const array_view_t<fd_t> &srcMeshBvhLeafNodeFaces,
+    const array_view_t<bounding_box_t<vec3>> &cutMeshBvhAABBs,
+    const array_view_t<fd_t> &cutMeshBvhLeafNodeFaces,
+    const hmesh_t *srcMesh,
+    const hmesh_t *cutMesh)
 {
     TIMESTACK_PUSH(__FUNCTION__);
     // simultaneuosly traverse both BVHs to find intersecting pairs
@@ -400,6 +963,8 @@ void intersectOIBVHs(
     const int sm_bvh_rightmost_real_leaf = get_rightmost_real_leaf(sm_bvh_leaf_level_idx, numSrcMeshFaces);
     const int cs_bvh_rightmost_real_leaf = get_rightmost_real_leaf(cs_bvh_leaf_level_idx, numCutMeshFaces);
 
+    const bool cull_separated_faces = srcMesh != nullptr && cutMesh != nullptr;
+
     do
     {
         node_pair_t ct_front_node = traversalQueue.front();
@@ -457,10 +1022,14 @@ void intersectOIBVHs(
                 MCUT_ASSERT(cs_node_face != hmesh_t::null_face());
                 MCUT_ASSERT(sm_node_face != hmesh_t::null_face());
 
-                fd_t cs_node_face_offsetted = fd_t(cs_node_face + numSrcMeshFaces);
+                // exact narrow-phase prefilter (the faces of overlapping leaves might still not intersect)
+                if (!cull_separated_faces || !faces_are_separated_by_plane(*srcMesh, sm_node_face, *cutMesh, cs_node_face))
+                {
+                    fd_t cs_node_face_offsetted = fd_t(cs_node_face + numSrcMeshFaces);
 
-                ps_face_to_potentially_intersecting_others[sm_node_face].push_back(cs_node_face_offsetted);
-                ps_face_to_potentially_intersecting_others[cs_node_face_offsetted].push_back(sm_node_face);
+                    ps_face_to_potentially_intersecting_others[sm_node_face].push_back(cs_node_face_offsetted);
+                    ps_face_to_potentially_intersecting_others[cs_node_face_offsetted].push_back(sm_node_face);
+                }
             }
             else if (sm_bvh_node_is_leaf && !cs_bvh_node_is_leaf)
             {
@@ -539,93 +1108,509 @@ void intersectOIBVHs(
     } while (!traversalQueue.empty());
     TIMESTACK_POP();
 }
-#else
-    BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+
+// header of a file written by "save_oibvh". The header is followed by the node bounding
+// boxes, the face bounding boxes (6 doubles each: min xyz then max xyz), and then the
+// leaf-node faces (32-bit indices). The arrays are stored exactly as they are laid out in
+// memory, and each starts at a multiple of 8 bytes, so that they can be used in-place from
+// a memory mapping of the file.
+struct oibvh_file_header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order; // used to reject files written on a machine with different endianness
+    uint64_t mesh_content_hash;
+    uint32_t num_mesh_vertices;
+    uint32_t num_mesh_faces;
+    uint64_t num_bvh_nodes;
+    uint64_t num_face_bboxes;
+    uint64_t num_leaf_faces;
+};
+
+static_assert(sizeof(oibvh_file_header_t) % sizeof(double) == 0, "unaligned oibvh file arrays");
+static_assert(std::is_standard_layout<bounding_box_t<vec3>>::value && sizeof(bounding_box_t<vec3>) == 6 * sizeof(double),
+    "bounding boxes must be stored as 6 doubles");
+static_assert(sizeof(fd_t) == sizeof(uint32_t), "leaf-node faces must be stored as 32-bit indices");
+
+static const char OIBVH_FILE_MAGIC[8] = { 'M', 'C', 'U', 'T', 'B', 'V', 'H', '\0' };
+static const uint32_t OIBVH_FILE_BYTE_ORDER_MARK = 0x01020304u;
+
+// read-only memory mapping of a whole file
+class mapped_file_t {
+public:
+    mapped_file_t()
+        : m_data(nullptr)
+        , m_size(0)
+#if defined(_WIN32)
+        , m_file(INVALID_HANDLE_VALUE)
+        , m_mapping(NULL)
+#endif
     {
     }
 
-    BoundingVolumeHierarchy::~BoundingVolumeHierarchy() { }
-
-    // three stages to BVH construction
-    void BoundingVolumeHierarchy::buildTree(const hmesh_t& mesh_,
-        const fixed_precision_number_t& enlargementEps_,
-        uint32_t mp_,
-        const SplitMethod& sm_)
+    ~mapped_file_t()
     {
-        SCOPED_TIMER(__FUNCTION__);
-        mesh = &(mesh_); ///
-        MCUT_ASSERT(mesh->number_of_faces() >= 1);
-        maxPrimsInNode = (std::min(255u, mp_)); //
-        splitMethod = (sm_); //
-        enlargementEps = (enlargementEps_);
-
-        buildData.clear();
-        primitives.clear();
-        primitiveOrderedBBoxes.clear();
-        nodes.clear();
-
-        // First, bounding information about each primitive is computed and stored in an array
-        // that will be used during tree construction.
+        unmap();
+    }
 
-        // initialize buildData array for primitives
+    bool map(const std::string& fpath)
+    {
+        unmap();
+#if defined(_WIN32)
+        m_file = CreateFileA(fpath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(m_file, &file_size) || file_size.QuadPart == 0) {
+            unmap();
+            return false;
+        }
+        m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_mapping == NULL) {
+            unmap();
+            return false;
+        }
+        m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (m_data == NULL) {
+            unmap();
+            return false;
+        }
+        m_size = (size_t)file_size.QuadPart;
+#else
+        const int fd = open(fpath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd); // the mapping keeps a reference to the file
+        if (ptr == MAP_FAILED) {
+            return false;
+        }
+        m_data = ptr;
+        m_size = (size_t)st.st_size;
+#endif
+        return true;
+    }
 
-        buildData.reserve(mesh->number_of_faces());
+    void unmap()
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != NULL) {
+            CloseHandle(m_mapping);
+            m_mapping = NULL;
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data != nullptr) {
+            munmap(m_data, m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
 
-        primitiveOrderedBBoxes.resize(mesh->number_of_faces());
-        primitives.resize(mesh->number_of_faces());
+    const unsigned char* data() const
+    {
+        return reinterpret_cast<const unsigned char*>(m_data);
+    }
 
-        // TODO make this parallel
-        // for each face in mesh
-        for (face_array_iterator_t f = mesh->faces_begin(); f != mesh->faces_end(); ++f) {
-            const int i = static_cast<int>(*f);
-            primitives[i] = *f;
+    size_t size() const
+    {
+        return m_size;
+    }
 
-            const std::vector<vd_t> vertices_on_face = mesh->get_vertices_around_face(*f);
+private:
+    mapped_file_t(const mapped_file_t&) = delete;
+    mapped_file_t& operator=(const mapped_file_t&) = delete;
 
-            bounding_box_t<vec3> bbox;
-            // for each vertex on face
-            for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
-                const vec3 coords = mesh->vertex(*v);
-                bbox.expand(coords);
-            }
+    void* m_data;
+    size_t m_size;
+#if defined(_WIN32)
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif
+};
 
-            if (enlargementEps > 0.0) {
-                bbox.enlarge(enlargementEps);
-            }
+// 64-bit FNV-1a
+static inline uint64_t hash_bytes(uint64_t h, const void* bytes, size_t n)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= (uint64_t)p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t compute_mesh_content_hash(
+    const hmesh_t& mesh,
+    const double& slightEnlargmentEps)
+{
+    TIMESTACK_PUSH(__FUNCTION__);
+    uint64_t h = 14695981039346656037ull;
+
+    const uint32_t counts[2] = { (uint32_t)mesh.number_of_vertices(), (uint32_t)mesh.number_of_faces() };
+    h = hash_bytes(h, counts, sizeof(counts));
+    h = hash_bytes(h, &slightEnlargmentEps, sizeof(double));
+
+    for (vertex_array_iterator_t v = mesh.vertices_begin(); v != mesh.vertices_end(); ++v) {
+        const vec3& coords = mesh.vertex(*v);
+        const double xyz[3] = { coords.x(), coords.y(), coords.z() };
+        h = hash_bytes(h, xyz, sizeof(xyz));
+    }
+
+    std::vector<vd_t> vertices_on_face;
+    for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
+        mesh.get_vertices_around_face(vertices_on_face, *f);
+        const uint32_t face_size = (uint32_t)vertices_on_face.size();
+        h = hash_bytes(h, &face_size, sizeof(uint32_t));
+        for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+            const uint32_t idx = (uint32_t)(*v);
+            h = hash_bytes(h, &idx, sizeof(uint32_t));
+        }
+    }
+    TIMESTACK_POP();
+    return h;
+}
+
+static void write_bboxes(std::FILE* file, const std::vector<bounding_box_t<vec3>>& bboxes)
+{
+    if (!bboxes.empty()) {
+        std::fwrite(bboxes.data(), sizeof(bounding_box_t<vec3>), bboxes.size(), file);
+    }
+}
+
+bool save_oibvh(
+    const std::string& fpath,
+    const uint64_t mesh_content_hash,
+    const uint32_t num_mesh_vertices,
+    const uint32_t num_mesh_faces,
+    const std::vector<bounding_box_t<vec3>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    const std::vector<bounding_box_t<vec3>>& face_bboxes)
+{
+    TIMESTACK_PUSH(__FUNCTION__);
+
+    // unique temporary name so that processes writing the same BVH do not clobber each other
+    const unsigned long long ticks = (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count();
+    const std::string tmp_fpath = fpath + ".tmp" + std::to_string(ticks) + "_" + std::to_string((unsigned long long)(size_t)&ticks);
+
+    std::FILE* file = std::fopen(tmp_fpath.c_str(), "wb");
+
+    if (file == nullptr) {
+        TIMESTACK_POP();
+        return false;
+    }
+
+    oibvh_file_header_t header;
+    memcpy(header.magic, OIBVH_FILE_MAGIC, sizeof(header.magic));
+    header.version = MCUT_OIBVH_FILE_VERSION;
+    header.byte_order = OIBVH_FILE_BYTE_ORDER_MARK;
+    header.mesh_content_hash = mesh_content_hash;
+    header.num_mesh_vertices = num_mesh_vertices;
+    header.num_mesh_faces = num_mesh_faces;
+    header.num_bvh_nodes = bvhAABBs.size();
+    header.num_face_bboxes = face_bboxes.size();
+    header.num_leaf_faces = bvhLeafNodeFaces.size();
+
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    write_bboxes(file, bvhAABBs);
+    write_bboxes(file, face_bboxes);
+
+    if (!bvhLeafNodeFaces.empty()) {
+        std::fwrite(bvhLeafNodeFaces.data(), sizeof(fd_t), bvhLeafNodeFaces.size(), file);
+    }
+
+    const bool write_ok = (std::ferror(file) == 0);
+    const bool close_ok = (std::fclose(file) == 0);
+    bool result = write_ok && close_ok;
+
+    if (result) {
+        result = (std::rename(tmp_fpath.c_str(), fpath.c_str()) == 0);
+    }
+
+    if (!result) {
+        std::remove(tmp_fpath.c_str()); // e.g. another process created "fpath" first
+    }
+
+    TIMESTACK_POP();
+    return result;
+}
+
+bool load_oibvh(
+    const std::string& fpath,
+    const uint64_t mesh_content_hash,
+    const uint32_t num_mesh_vertices,
+    const uint32_t num_mesh_faces,
+    oibvh_view_t& bvh)
+{
+    TIMESTACK_PUSH(__FUNCTION__);
+
+    std::shared_ptr<mapped_file_t> file = std::make_shared<mapped_file_t>();
+
+    if (!file->map(fpath) || file->size() < sizeof(oibvh_file_header_t)) {
+        TIMESTACK_POP();
+        return false;
+    }
+
+    oibvh_file_header_t header;
+    memcpy(&header, file->data(), sizeof(header));
+
+    const uint64_t expected_size = sizeof(header) + //
+        (header.num_bvh_nodes + header.num_face_bboxes) * sizeof(bounding_box_t<vec3>) + //
+        header.num_leaf_faces * sizeof(fd_t);
+
+    const bool is_valid = memcmp(header.magic, OIBVH_FILE_MAGIC, sizeof(header.magic)) == 0 && //
+        header.version == MCUT_OIBVH_FILE_VERSION && //
+        header.byte_order == OIBVH_FILE_BYTE_ORDER_MARK && //
+        header.mesh_content_hash == mesh_content_hash && //
+        header.num_mesh_vertices == num_mesh_vertices && //
+        header.num_mesh_faces == num_mesh_faces && //
+        header.num_face_bboxes == num_mesh_faces && //
+        header.num_leaf_faces == num_mesh_faces && //
+        header.num_bvh_nodes == (uint64_t)get_ostensibly_implicit_bvh_size((int)header.num_leaf_faces) && //
+        expected_size == (uint64_t)file->size();
+
+    if (!is_valid) {
+        TIMESTACK_POP();
+        return false;
+    }
+
+    // NOTE: the mapping is page-aligned and the arrays start at multiples of 8 bytes (see oibvh_file_header_t)
+    const bounding_box_t<vec3>* bboxes = reinterpret_cast<const bounding_box_t<vec3>*>(file->data() + sizeof(header));
+    const fd_t* leaf_faces = reinterpret_cast<const fd_t*>(bboxes + header.num_bvh_nodes + header.num_face_bboxes);
+
+    bvh.bvhAABBs = array_view_t<bounding_box_t<vec3>>(bboxes, bboxes + header.num_bvh_nodes);
+    bvh.face_bboxes = array_view_t<bounding_box_t<vec3>>(bboxes + header.num_bvh_nodes, bboxes + header.num_bvh_nodes + header.num_face_bboxes);
+    bvh.bvhLeafNodeFaces = array_view_t<fd_t>(leaf_faces, leaf_faces + header.num_leaf_faces);
+    bvh.mapping = file;
+
+    TIMESTACK_POP();
+    return true;
+}
+#else
+    BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+        : mesh(nullptr)
+        , maxPrimsInNode(1)
+        , splitMethod(SplitMethod::SPLIT_SAH)
+        , enlargementEps(0.0)
+    {
+    }
+
+    BoundingVolumeHierarchy::~BoundingVolumeHierarchy() { }
+
+    // three stages to BVH construction
+    void BoundingVolumeHierarchy::buildTree(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool& scheduler,
+#endif
+        const hmesh_t& mesh_,
+        const double& enlargementEps_,
+        uint32_t mp_,
+        const SplitMethod& sm_)
+    {
+        SCOPED_TIMER(__FUNCTION__);
+        mesh = &(mesh_); ///
+        MCUT_ASSERT(mesh->number_of_faces() >= 1);
+        maxPrimsInNode = (std::min(255u, std::max(1u, mp_))); //
+        splitMethod = (sm_); //
+        enlargementEps = (enlargementEps_);
+
+        const uint32_t meshFaceCount = (uint32_t)mesh->number_of_faces();
+
+        // First, bounding information about each primitive is computed and stored in an array
+        // that will be used during tree construction.
+
+        buildData.resize(meshFaceCount);
+        primitiveOrderedBBoxes.resize(meshFaceCount);
+        primitives.resize(meshFaceCount);
+        nodes.clear();
+        // a binary tree with one primitive per leaf has 2n-1 nodes
+        nodes.reserve(2 * (size_t)meshFaceCount - 1);
+
+        auto fn_compute_primitive_info = [&](std::vector<BVHPrimitiveInfo>::iterator block_start_, std::vector<BVHPrimitiveInfo>::iterator block_end_) {
+            for (std::vector<BVHPrimitiveInfo>::iterator it = block_start_; it != block_end_; ++it) {
+                const int i = (int)std::distance(buildData.begin(), it);
+                const fd_t f(i);
+
+                const std::vector<vd_t> vertices_on_face = mesh->get_vertices_around_face(f);
+
+                bounding_box_t<vec3> bbox;
+                // for each vertex on face
+                for (std::vector<vd_t>::const_iterator v = vertices_on_face.cbegin(); v != vertices_on_face.cend(); ++v) {
+                    const vec3 coords = mesh->vertex(*v);
+                    bbox.expand(coords);
+                }
+
+                if (enlargementEps > 0.0) {
+                    bbox.enlarge(enlargementEps);
+                }
 
-            primitiveOrderedBBoxes[i] = bbox;
+                primitiveOrderedBBoxes[i] = bbox;
+                *it = BVHPrimitiveInfo(i, bbox);
+            }
+        };
 
-            buildData.push_back(BVHPrimitiveInfo(i, primitiveOrderedBBoxes[i]));
+#if defined(MCUT_MULTI_THREADED)
+        {
+            auto fn_compute_primitive_info_block = [&](std::vector<BVHPrimitiveInfo>::iterator block_start_, std::vector<BVHPrimitiveInfo>::iterator block_end_) -> bool {
+                fn_compute_primitive_info(block_start_, block_end_);
+                return true;
+            };
+
+            std::vector<std::future<bool>> futures;
+            bool _1;
+
+            parallel_fork_and_join(
+                scheduler,
+                buildData.begin(),
+                buildData.end(),
+                (1 << 12),
+                fn_compute_primitive_info_block,
+                _1, // out
+                futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<bool>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                f.wait(); // wait for result to be done
+            }
         }
+#else
+        fn_compute_primitive_info(buildData.begin(), buildData.end());
+#endif
 
         // Next, the tree is built via a procedure that splits the primitives into subsets and
-        // recursively builds BVHs for the subsets. The result is a binary tree where each
-        // interior node holds pointers to its children and each leaf node holds references to
-        // one or more primitives.
+        // recursively builds BVHs for the subsets. Nodes are appended directly to the flat "nodes"
+        // array, and the primitives of each leaf are a contiguous range in "buildData".
 
-        uint32_t totalNodes = 0;
-        std::vector<fd_t> orderedPrims;
-        // orderedPrims.reserve(mesh->number_of_faces());
+        nodes.push_back(LinearBVHNode()); // root
 
-        std::shared_ptr<BVHBuildNode> root = recursiveBuild(
-            buildData,
-            0,
-            /*primitives.size()*/ mesh->number_of_faces(),
-            &totalNodes,
-            orderedPrims);
+#if defined(MCUT_MULTI_THREADED)
+        {
+            // The master thread splits the upper levels of the tree (binning primitives in parallel)
+            // until there are enough independent subtrees to keep the worker threads busy.
+            struct subtree_t {
+                uint32_t nodeIndex;
+                uint32_t start;
+                uint32_t end;
+            };
+
+            const uint32_t min_subtree_count = (uint32_t)scheduler.get_num_threads() * 4;
+            const uint32_t min_subtree_primitives = (1 << 10); // small subtrees are not worth splitting on the master thread
+
+            std::vector<subtree_t> subtrees(1, { 0, 0, meshFaceCount });
+            std::vector<subtree_t> pending;
+
+            while (!subtrees.empty() && subtrees.size() + pending.size() < min_subtree_count) {
+                // split the largest subtree first
+                std::vector<subtree_t>::iterator largest = std::max_element(subtrees.begin(), subtrees.end(),
+                    [](const subtree_t& a, const subtree_t& b) { return (a.end - a.start) < (b.end - b.start); });
+
+                const subtree_t cur = *largest;
+                subtrees.erase(largest);
+
+                if ((cur.end - cur.start) < min_subtree_primitives) {
+                    pending.push_back(cur);
+                    continue;
+                }
 
-        primitives.swap(orderedPrims);
+                const uint32_t mid = splitNode(&scheduler, nodes[cur.nodeIndex], cur.start, cur.end);
 
-        // Finally, this tree is converted to a more compact (and thus more efficient) pointerless
-        // representation for use during rendering
+                if (mid != cur.end) { // interior
+                    const uint32_t firstChildOffset = (uint32_t)nodes.size();
+                    nodes[cur.nodeIndex].firstChildOffset = firstChildOffset;
+                    nodes.resize(nodes.size() + 2);
+                    subtrees.push_back({ firstChildOffset, cur.start, mid });
+                    subtrees.push_back({ firstChildOffset + 1, mid, cur.end });
+                }
+            }
+
+            pending.insert(pending.end(), subtrees.begin(), subtrees.end());
+
+            // build the remaining subtrees in parallel, each into its own node array
+            typedef std::vector<subtree_t>::const_iterator InputStorageIteratorType;
+            typedef std::vector<std::vector<LinearBVHNode>> OutputStorageType; // one node array per subtree
+
+            auto fn_build_subtrees = [&](InputStorageIteratorType block_start_, InputStorageIteratorType block_end_) -> OutputStorageType {
+                OutputStorageType subtree_nodes_local;
+                for (InputStorageIteratorType it = block_start_; it != block_end_; ++it) {
+                    subtree_nodes_local.push_back(std::vector<LinearBVHNode>(1));
+                    std::vector<LinearBVHNode>& local_nodes = subtree_nodes_local.back();
+                    local_nodes.reserve(2 * (size_t)(it->end - it->start) - 1);
+                    recursiveBuild(local_nodes, 0, it->start, it->end);
+                }
+                return subtree_nodes_local;
+            };
+
+            std::vector<std::future<OutputStorageType>> futures;
+            OutputStorageType partial_res;
+
+            parallel_fork_and_join(
+                scheduler,
+                pending.cbegin(),
+                pending.cend(),
+                1,
+                fn_build_subtrees,
+                partial_res, // output of master thread
+                futures);
+
+            // Splice the subtrees into "nodes". The root of a subtree replaces its placeholder
+            // node, and its descendants are appended (with their child offsets relocated).
+            InputStorageIteratorType subtree_iter = pending.cbegin();
+
+            auto fn_splice_subtrees = [&](const OutputStorageType& subtree_nodes) {
+                for (OutputStorageType::const_iterator it = subtree_nodes.cbegin(); it != subtree_nodes.cend(); ++it, ++subtree_iter) {
+                    const std::vector<LinearBVHNode>& local_nodes = *it;
+                    const uint32_t base = (uint32_t)nodes.size() - 1; // local index 1 maps to "nodes.size()"
+
+                    nodes.insert(nodes.end(), local_nodes.cbegin() + 1, local_nodes.cend());
+                    nodes[subtree_iter->nodeIndex] = local_nodes.front();
+
+                    const uint32_t first_relocated = (uint32_t)nodes.size() - (uint32_t)(local_nodes.size() - 1);
+                    for (uint32_t i = first_relocated; i < (uint32_t)nodes.size(); ++i) {
+                        if (nodes[i].nPrimitives == 0) {
+                            nodes[i].firstChildOffset += base;
+                        }
+                    }
+
+                    LinearBVHNode& subtree_root = nodes[subtree_iter->nodeIndex];
+                    if (subtree_root.nPrimitives == 0) {
+                        subtree_root.firstChildOffset += base;
+                    }
+                }
+            };
 
-        nodes.resize(totalNodes);
-        for (uint32_t i = 0; i < totalNodes; ++i) {
-            // new (&nodes[i]) LinearBVHNode;
-            nodes[i] = std::make_shared<LinearBVHNode>();
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<OutputStorageType>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                fn_splice_subtrees(f.get());
+            }
+
+            fn_splice_subtrees(partial_res); // master thread built the last block
+
+            MCUT_ASSERT(subtree_iter == pending.cend());
+        }
+#else
+        recursiveBuild(nodes, 0, 0, meshFaceCount);
+#endif
+
+        // Finally, record the (reordered) primitives that the leaves refer to
+        for (uint32_t i = 0; i < meshFaceCount; ++i) {
+            primitives[i] = fd_t(buildData[i].primitiveNumber);
         }
-        uint32_t offset = 0;
-        flattenBVHTree(root, &offset);
     }
 
     const BBox& BoundingVolumeHierarchy::GetPrimitiveBBox(int primitiveIndex) const
@@ -634,189 +1619,230 @@ void intersectOIBVHs(
         return primitiveOrderedBBoxes[primitiveIndex];
     }
 
-    uint32_t BoundingVolumeHierarchy::flattenBVHTree(std::shared_ptr<BVHBuildNode> node, uint32_t* offset)
+    uint32_t BoundingVolumeHierarchy::splitNode(
+#if defined(MCUT_MULTI_THREADED)
+        thread_pool* scheduler,
+#endif
+        LinearBVHNode& node,
+        uint32_t start,
+        uint32_t end)
     {
-        MCUT_ASSERT(*offset < nodes.size());
-        std::shared_ptr<LinearBVHNode> linearNode = nodes[*offset];
-        linearNode->bounds = node->bounds;
-        uint32_t myOffset = (*offset)++;
-        if (node->nPrimitives > 0) {
-            linearNode->primitivesOffset = node->firstPrimOffset;
-            linearNode->nPrimitives = node->nPrimitives;
-        } else {
-            // Creater interior flattened BVH node
-            linearNode->axis = node->splitAxis;
-            linearNode->nPrimitives = 0;
+        const uint32_t nPrimitives = end - start;
+        MCUT_ASSERT(nPrimitives >= 1);
+        MCUT_ASSERT(end <= (uint32_t)buildData.size());
+
+        // Compute bounds of all primitives in BVH node, and the bounds of their centroids
+        auto fn_compute_bounds = [&](std::vector<BVHPrimitiveInfo>::const_iterator block_start_, std::vector<BVHPrimitiveInfo>::const_iterator block_end_) -> std::pair<BBox, BBox> {
+            std::pair<BBox, BBox> bounds; // <primitive bounds, centroid bounds>
+            for (std::vector<BVHPrimitiveInfo>::const_iterator it = block_start_; it != block_end_; ++it) {
+                bounds.first.expand(it->bounds);
+                bounds.second.expand(it->centroid);
+            }
+            return bounds;
+        };
+
+        // Bin primitive centroids into SAH buckets along axis "dim"
+        int dim = 0;
+        const BBox* centroidBoundsPtr = nullptr;
+        auto fn_compute_buckets = [&](std::vector<BVHPrimitiveInfo>::const_iterator block_start_, std::vector<BVHPrimitiveInfo>::const_iterator block_end_) -> std::vector<BucketInfo> {
+            std::vector<BucketInfo> buckets(MCUT_BVH_SAH_BUCKET_COUNT);
+            for (std::vector<BVHPrimitiveInfo>::const_iterator it = block_start_; it != block_end_; ++it) {
+                BucketInfo& bucket = buckets[get_sah_bucket_index(it->centroid, dim, *centroidBoundsPtr)];
+                bucket.count++;
+                bucket.bounds.expand(it->bounds);
+            }
+            return buckets;
+        };
+
+        const std::vector<BVHPrimitiveInfo>::const_iterator range_begin = buildData.cbegin() + start;
+        const std::vector<BVHPrimitiveInfo>::const_iterator range_end = buildData.cbegin() + end;
 
-            flattenBVHTree(node->children[0], offset);
+        std::pair<BBox, BBox> bounds;
+        std::vector<BucketInfo> buckets;
 
-            linearNode->secondChildOffset = flattenBVHTree(node->children[1],
-                offset);
+#if defined(MCUT_MULTI_THREADED)
+        const bool bin_in_parallel = scheduler != nullptr && nPrimitives >= (1 << 14);
+
+        if (bin_in_parallel) {
+            std::vector<std::future<std::pair<BBox, BBox>>> futures;
+
+            parallel_fork_and_join(*scheduler, range_begin, range_end, (1 << 12), fn_compute_bounds, bounds, futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<std::pair<BBox, BBox>>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                const std::pair<BBox, BBox> future_res = f.get();
+                bounds.first.expand(future_res.first);
+                bounds.second.expand(future_res.second);
+            }
+        } else
+#endif
+        {
+            bounds = fn_compute_bounds(range_begin, range_end);
         }
-        return myOffset;
-    }
 
-    std::shared_ptr<BVHBuildNode> BoundingVolumeHierarchy::recursiveBuild(
-        std::vector<BVHPrimitiveInfo>& buildData,
-        uint32_t start,
-        uint32_t end,
-        uint32_t* totalNodes,
-        std::vector<fd_t>& orderedPrims)
-    {
-        (*totalNodes)++;
+        const BBox& bbox = bounds.first;
+        const BBox& centroidBounds = bounds.second;
+        centroidBoundsPtr = &centroidBounds;
 
-        std::shared_ptr<BVHBuildNode> node = std::make_shared<BVHBuildNode>();
+        node.bounds = bbox;
 
-        // Compute bounds of all primitives in BVH node
-        uint32_t nPrimitives = end - start;
-        MCUT_ASSERT((nPrimitives - 1) < (uint32_t)mesh->number_of_faces());
+        auto fn_make_leaf = [&]() {
+            node.primitivesOffset = start;
+            node.nPrimitives = (uint8_t)nPrimitives;
+            return end;
+        };
 
-        BBox bbox;
-        for (uint32_t i = start; i < end; ++i) {
-            MCUT_ASSERT(i < buildData.size());
-            bbox = Union(bbox, buildData[i].bounds);
+        if (nPrimitives <= (uint32_t)maxPrimsInNode) {
+            return fn_make_leaf();
         }
-        if (nPrimitives == 1) {
-            // Create leaf BVHBuildNode
-            uint32_t firstPrimOffset = orderedPrims.size();
-            for (uint32_t i = start; i < end; ++i) {
-                MCUT_ASSERT(i < buildData.size());
-                uint32_t primNum = buildData[i].primitiveNumber;
-                orderedPrims.push_back(primitives[primNum]);
+
+        // choose split dimension dim
+        dim = centroidBounds.MaximumExtent();
+        MCUT_ASSERT(dim < 3);
+
+        node.nPrimitives = 0;
+        node.axis = (uint8_t)dim;
+
+        uint32_t mid = (start + end) / 2;
+
+        if (centroidBounds.maximum()[dim] == centroidBounds.minimum()[dim]) {
+            // all centroids coincide, so any split is as good as another
+            if (nPrimitives <= 255) {
+                return fn_make_leaf();
             }
-            node->InitLeaf(firstPrimOffset, nPrimitives, bbox);
-        } else {
-            // Compute bound of primitive centroids, choose split dimension dim
-            BBox centroidBounds;
-            for (uint32_t i = start; i < end; ++i) {
-                MCUT_ASSERT(i < buildData.size());
-                centroidBounds = Union(centroidBounds, buildData[i].centroid);
-            }
-
-            int dim = centroidBounds.MaximumExtent();
-            MCUT_ASSERT(dim < 3);
-
-            //
-            // Partition primitives into two sets and build children
-            //
-            uint32_t mid = (start + end) / 2;
-            switch (this->splitMethod) {
-            case SplitMethod::SPLIT_MIDDLE: {
-                // Partition primitives through node’s midpoint
-                fixed_precision_number_t pmid = (centroidBounds.minimum()[dim] + centroidBounds.maximum()[dim]) * .5;
-#if 1
-                MCUT_ASSERT(start < buildData.size());
-                BVHPrimitiveInfo* midPtr = std::partition(&buildData[start],
-                    &buildData[end - 1] + 1,
-                    /*CompareToMid(dim, pmid)*/
-                    [dim, pmid](const BVHPrimitiveInfo& pi) {
-                        return pi.centroid[dim] < pmid;
-                    });
-                mid = midPtr - &buildData[0];
-#else
-                std::vector<BVHPrimitiveInfo>::iterator midPtr = std::partition(buildData.begin() + start,
-                    buildData.end(),
-                    CompareToMid(dim, pmid));
-                mid = std::distance(buildData.begin(), midPtr);
-#endif
-            } break;
-            case SplitMethod::SPLIT_EQUAL_COUNTS: {
+            return mid;
+        }
+
+        //
+        // Partition primitives into two sets
+        //
+        switch (this->splitMethod) {
+        case SplitMethod::SPLIT_MIDDLE: {
+            // Partition primitives through node’s midpoint
+            const double pmid = (centroidBounds.minimum()[dim] + centroidBounds.maximum()[dim]) * .5;
+            std::vector<BVHPrimitiveInfo>::iterator midPtr = std::partition(buildData.begin() + start,
+                buildData.begin() + end,
+                [dim, pmid](const BVHPrimitiveInfo& pi) {
+                    return pi.centroid[dim] < pmid;
+                });
+            mid = (uint32_t)std::distance(buildData.begin(), midPtr);
+        } break;
+        case SplitMethod::SPLIT_EQUAL_COUNTS: {
+            // Partition primitives into equally-sized subsets
+            std::nth_element(buildData.begin() + start, buildData.begin() + mid,
+                buildData.begin() + end, ComparePoints(dim));
+        } break;
+        case SplitMethod::SPLIT_SAH: {
+            // Partition primitives using approximate SAH
+            if (nPrimitives <= 4) {
                 // Partition primitives into equally-sized subsets
-                mid = (start + end) / 2;
-                std::nth_element(&buildData[start], &buildData[mid],
-                    &buildData[end - 1] + 1, ComparePoints(dim));
-            } break;
-            case SplitMethod::SPLIT_SAH: {
-                // Partition primitives using approximate SAH
-                if (nPrimitives <= 4) {
-                    // Partition primitives into equally-sized subsets
-                    mid = (start + end) / 2;
-                    std::nth_element(&buildData[start], &buildData[mid],
-                        &buildData[end - 1] + 1, ComparePoints(dim));
-                } else {
-                    // Allocate BucketInfo for SAH partition buckets
-                    const int nBuckets = 12;
-                    BucketInfo buckets[nBuckets];
-
-                    // Initialize BucketInfo for SAH partition buckets
-                    for (uint32_t i = start; i < end; ++i) {
-                        int b = nBuckets * ((buildData[i].centroid[dim] - centroidBounds.minimum()[dim]) / (centroidBounds.maximum()[dim] - centroidBounds.minimum()[dim]));
-                        if (b == nBuckets)
-                            b = nBuckets - 1;
-                        buckets[b].count++;
-                        buckets[b].bounds = Union(buckets[b].bounds, buildData[i].bounds);
-                    }
-                    // Compute costs for splitting after each bucket
+                std::nth_element(buildData.begin() + start, buildData.begin() + mid,
+                    buildData.begin() + end, ComparePoints(dim));
+                break;
+            }
 
-                    fixed_precision_number_t cost[nBuckets - 1];
+#if defined(MCUT_MULTI_THREADED)
+            if (bin_in_parallel) {
+                std::vector<std::future<std::vector<BucketInfo>>> futures;
 
-                    for (int i = 0; i < nBuckets - 1; ++i) {
-                        BBox b0, b1;
-                        int count0 = 0, count1 = 0;
-                        for (int j = 0; j <= i; ++j) {
-                            b0 = Union(b0, buckets[j].bounds);
-                            count0 += buckets[j].count;
-                        }
-                        for (int j = i + 1; j < nBuckets; ++j) {
-                            b1 = Union(b1, buckets[j].bounds);
-                            count1 += buckets[j].count;
-                        }
-                        cost[i] = .125f + (count0 * b0.SurfaceArea() + count1 * b1.SurfaceArea()) / bbox.SurfaceArea();
-                    }
-                    // Find bucket to split at that minimizes SAH metric
-                    float minCost = cost[0];
-                    uint32_t minCostSplit = 0;
-                    for (int i = 1; i < nBuckets - 1; ++i) {
-                        if (cost[i] < minCost) {
-                            minCost = cost[i];
-                            minCostSplit = i;
-                        }
-                    }
-                    // Either create leaf or split primitives at selected SAH bucket
+                parallel_fork_and_join(*scheduler, range_begin, range_end, (1 << 12), fn_compute_buckets, buckets, futures);
 
-                    if (nPrimitives > (uint32_t)maxPrimsInNode || minCost < nPrimitives) {
-                        const BVHPrimitiveInfo* pmid = std::partition(&buildData[start],
-                            &buildData[end - 1] + 1,
-                            CompareToBucket(minCostSplit, nBuckets, dim, centroidBounds));
-                        mid = pmid - &buildData[0];
-                    } else {
-                        // Create leaf BVHBuildNode
-                        uint32_t firstPrimOffset = orderedPrims.size();
-                        for (uint32_t i = start; i < end; ++i) {
-                            uint32_t primNum = buildData[i].primitiveNumber;
-                            orderedPrims.push_back(primitives[primNum]);
-                        }
-                        node->InitLeaf(firstPrimOffset, nPrimitives, bbox);
+                for (int i = 0; i < (int)futures.size(); ++i) {
+                    std::future<std::vector<BucketInfo>>& f = futures[i];
+                    MCUT_ASSERT(f.valid());
+                    const std::vector<BucketInfo> future_res = f.get();
+                    for (int b = 0; b < MCUT_BVH_SAH_BUCKET_COUNT; ++b) {
+                        buckets[b].count += future_res[b].count;
+                        buckets[b].bounds.expand(future_res[b].bounds);
                     }
                 }
-            } break;
-            default:
-                fprintf(stderr, "[MCUT]: error, unknown split method\n");
-                break;
+            } else
+#endif
+            {
+                buckets = fn_compute_buckets(range_begin, range_end);
             }
 
-            mid = (start + end) / 2;
-            if (centroidBounds.maximum()[dim] == centroidBounds.minimum()[dim]) {
-                // Create leaf BVHBuildNode
-                int32_t firstPrimOffset = orderedPrims.size();
-                for (uint32_t i = start; i < end; ++i) {
-                    uint32_t primNum = buildData[i].primitiveNumber;
-                    orderedPrims.push_back(primitives[primNum]);
+            // Compute costs for splitting after each bucket (sweeping from both ends)
+            BBox b1_suffix[MCUT_BVH_SAH_BUCKET_COUNT];
+            int count1_suffix[MCUT_BVH_SAH_BUCKET_COUNT];
+            b1_suffix[MCUT_BVH_SAH_BUCKET_COUNT - 1] = buckets[MCUT_BVH_SAH_BUCKET_COUNT - 1].bounds;
+            count1_suffix[MCUT_BVH_SAH_BUCKET_COUNT - 1] = buckets[MCUT_BVH_SAH_BUCKET_COUNT - 1].count;
+            for (int i = MCUT_BVH_SAH_BUCKET_COUNT - 2; i >= 0; --i) {
+                b1_suffix[i] = Union(b1_suffix[i + 1], buckets[i].bounds);
+                count1_suffix[i] = count1_suffix[i + 1] + buckets[i].count;
+            }
+
+            // Find bucket to split at that minimizes SAH metric
+            double minCost = std::numeric_limits<double>::max();
+            int minCostSplit = -1;
+            BBox b0;
+            int count0 = 0;
+            for (int i = 0; i < MCUT_BVH_SAH_BUCKET_COUNT - 1; ++i) {
+                b0 = Union(b0, buckets[i].bounds);
+                count0 += buckets[i].count;
+                const int count1 = count1_suffix[i + 1];
+
+                if (count0 == 0 || count1 == 0) {
+                    continue; // not a split
                 }
-                node->InitLeaf(firstPrimOffset, nPrimitives, bbox);
-                return node;
+
+                const double cost = .125 + (count0 * (double)b0.SurfaceArea() + count1 * (double)b1_suffix[i + 1].SurfaceArea()) / bbox.SurfaceArea();
+                if (cost < minCost) {
+                    minCost = cost;
+                    minCostSplit = i;
+                }
+            }
+
+            // Split primitives at selected SAH bucket. NOTE: a leaf is never made here, since nodes with
+            // at most "maxPrimsInNode" primitives are leaves already (see above) and larger ones must be split.
+            if (minCostSplit < 0) {
+                std::nth_element(buildData.begin() + start, buildData.begin() + mid,
+                    buildData.begin() + end, ComparePoints(dim));
+            } else {
+                std::vector<BVHPrimitiveInfo>::iterator pmid = std::partition(buildData.begin() + start,
+                    buildData.begin() + end,
+                    CompareToBucket(minCostSplit, dim, centroidBounds));
+                mid = (uint32_t)std::distance(buildData.begin(), pmid);
             }
+        } break;
+        default:
+            fprintf(stderr, "[MCUT]: error, unknown split method\n");
+            break;
+        }
+
+        if (mid == start || mid == end) { // degenerate partition
+            mid = (start + end) / 2;
+            std::nth_element(buildData.begin() + start, buildData.begin() + mid,
+                buildData.begin() + end, ComparePoints(dim));
+        }
+
+        return mid;
+    }
+
+    void BoundingVolumeHierarchy::recursiveBuild(
+        std::vector<LinearBVHNode>& nodes_,
+        uint32_t nodeIndex,
+        uint32_t start,
+        uint32_t end)
+    {
+        const uint32_t mid = splitNode(
+#if defined(MCUT_MULTI_THREADED)
+            nullptr,
+#endif
+            nodes_[nodeIndex], start, end);
 
-            std::shared_ptr<BVHBuildNode> leftSubTree = recursiveBuild(buildData, start, mid,
-                totalNodes, orderedPrims);
-            std::shared_ptr<BVHBuildNode> rightSubTree = recursiveBuild(buildData, mid, end,
-                totalNodes, orderedPrims);
-            // Partition primitives based on splitMethod〉
-            node->InitInterior(dim,
-                leftSubTree,
-                rightSubTree);
+        if (mid == end) {
+            return; // leaf
         }
-        return node;
+
+        // NOTE: "nodes_" may be reallocated here, so we index rather than keep references
+        const uint32_t firstChildOffset = (uint32_t)nodes_.size();
+        nodes_[nodeIndex].firstChildOffset = firstChildOffset;
+        nodes_.resize(nodes_.size() + 2);
+
+        recursiveBuild(nodes_, firstChildOffset, start, mid);
+        recursiveBuild(nodes_, firstChildOffset + 1, mid, end);
     }
 
     int BoundingVolumeHierarchy::GetNodeCount() const
@@ -824,7 +1850,7 @@ void intersectOIBVHs(
         return (int)nodes.size();
     }
 
-    const std::shared_ptr<LinearBVHNode>& BoundingVolumeHierarchy::GetNode(int idx) const
+    const LinearBVHNode& BoundingVolumeHierarchy::GetNode(int idx) const
     {
         return nodes[idx];
     }
@@ -843,45 +1869,47 @@ void intersectOIBVHs(
         const BoundingVolumeHierarchy& bvhA,
         const BoundingVolumeHierarchy& bvhB,
         const uint32_t primitiveOffsetA,
-        const uint32_t primitiveOffsetB)
+        const uint32_t primitiveOffsetB,
+        const bool cullSeparatedFaces)
     {
         SCOPED_TIMER(__FUNCTION__);
         MCUT_ASSERT(bvhA.GetNodeCount() > 0);
         MCUT_ASSERT(bvhB.GetNodeCount() > 0);
 
-        auto fn_intersectBVHTrees = [&bvhA, &bvhB, &primitiveOffsetA, &primitiveOffsetB](
+        auto fn_intersectBVHTrees = [&bvhA, &bvhB, &primitiveOffsetA, &primitiveOffsetB, &cullSeparatedFaces](
                                         std::vector<std::pair<int, int>>& worklist_,
                                         std::map<fd_t, std::vector<fd_t>>& symmetric_intersecting_pairs_,
                                         const uint32_t maxWorklistSize) {
             // Simultaneous DFS traversal
             while (worklist_.size() > 0 && worklist_.size() < maxWorklistSize) {
-                // maxTodoSz = std::max(maxTodoSz, (int)worklist_.size());
-                // std::cout << "worklist_.size()="<<worklist_.size()<<std::endl;
                 std::pair<int, int> cur = worklist_.back();
-                // TODO: try to keep an additional counter that allows us to minimize pushing and popping
-                // Might require a wrapper class over std::vector "lazy vector"
                 worklist_.pop_back();
 
                 const uint32_t nodeAIndex = cur.first;
                 const uint32_t nodeBIndex = cur.second;
-                const std::shared_ptr<LinearBVHNode> nodeA = bvhA.GetNode(nodeAIndex);
-                const std::shared_ptr<LinearBVHNode> nodeB = bvhB.GetNode(nodeBIndex);
+                const LinearBVHNode& nodeA = bvhA.GetNode(nodeAIndex);
+                const LinearBVHNode& nodeB = bvhB.GetNode(nodeBIndex);
 
-                if (!intersect_bounding_boxes(nodeA->bounds, nodeB->bounds)) {
+                if (!intersect_bounding_boxes(nodeA.bounds, nodeB.bounds)) {
                     continue;
                 }
 
-                bool nodeAIsLeaf = nodeA->nPrimitives > 0;
-                bool nodeBIsLeaf = nodeB->nPrimitives > 0;
+                bool nodeAIsLeaf = nodeA.nPrimitives > 0;
+                bool nodeBIsLeaf = nodeB.nPrimitives > 0;
 
                 if (nodeAIsLeaf) {
                     if (nodeBIsLeaf) {
-                        for (int i = 0; i < nodeA->nPrimitives; ++i) {
-                            const fd_t faceA = bvhA.GetPrimitive((uint32_t)(nodeA->primitivesOffset + i));
+                        for (int i = 0; i < nodeA.nPrimitives; ++i) {
+                            const fd_t faceA = bvhA.GetPrimitive((uint32_t)(nodeA.primitivesOffset + i));
                             const fd_t faceAOffsetted(primitiveOffsetA + faceA);
 
-                            for (int j = 0; j < nodeB->nPrimitives; ++j) {
-                                const fd_t faceB = bvhB.GetPrimitive((uint32_t)(nodeB->primitivesOffset + j));
+                            for (int j = 0; j < nodeB.nPrimitives; ++j) {
+                                const fd_t faceB = bvhB.GetPrimitive((uint32_t)(nodeB.primitivesOffset + j));
+
+                                if (cullSeparatedFaces && faces_are_separated_by_plane(*bvhA.mesh, faceA, *bvhB.mesh, faceB)) {
+                                    continue;
+                                }
+
                                 const fd_t faceBOffsetted(primitiveOffsetB + faceB);
 
                                 symmetric_intersecting_pairs_[faceAOffsetted].push_back(faceBOffsetted);
@@ -889,23 +1917,23 @@ void intersectOIBVHs(
                             }
                         }
                     } else {
-                        const uint32_t nodeBLeftChild = nodeBIndex + 1;
-                        const uint32_t nodeBRightChild = nodeB->secondChildOffset;
+                        const uint32_t nodeBLeftChild = nodeB.firstChildOffset;
+                        const uint32_t nodeBRightChild = nodeB.firstChildOffset + 1;
                         worklist_.emplace_back(nodeAIndex, nodeBLeftChild);
                         worklist_.emplace_back(nodeAIndex, nodeBRightChild);
                     }
                 } else {
                     if (nodeBIsLeaf) {
-                        const uint32_t nodeALeftChild = nodeAIndex + 1;
-                        const uint32_t nodeARightChild = nodeA->secondChildOffset;
+                        const uint32_t nodeALeftChild = nodeA.firstChildOffset;
+                        const uint32_t nodeARightChild = nodeA.firstChildOffset + 1;
                         worklist_.emplace_back(nodeALeftChild, nodeBIndex);
                         worklist_.emplace_back(nodeARightChild, nodeBIndex);
                     } else {
-                        const uint32_t nodeALeftChild = nodeAIndex + 1;
-                        const uint32_t nodeARightChild = nodeA->secondChildOffset;
+                        const uint32_t nodeALeftChild = nodeA.firstChildOffset;
+                        const uint32_t nodeARightChild = nodeA.firstChildOffset + 1;
 
-                        const uint32_t nodeBLeftChild = nodeBIndex + 1;
-                        const uint32_t nodeBRightChild = nodeB->secondChildOffset;
+                        const uint32_t nodeBLeftChild = nodeB.firstChildOffset;
+                        const uint32_t nodeBRightChild = nodeB.firstChildOffset + 1;
 
                         worklist_.emplace_back(nodeALeftChild, nodeBLeftChild);
                         worklist_.emplace_back(nodeALeftChild, nodeBRightChild);
@@ -961,14 +1989,21 @@ void intersectOIBVHs(
                     partial_res, // output of master thread
                     futures);
 
-                symmetric_intersecting_pairs.insert(partial_res.cbegin(), partial_res.cend());
+                // NOTE: the same face may have been found by several threads, so
+                // the lists of overlapping faces are merged (not replaced)
+                auto fn_merge = [&](const OutputStorageType& res) {
+                    for (OutputStorageType::const_iterator it = res.cbegin(); it != res.cend(); ++it) {
+                        std::vector<fd_t>& others = symmetric_intersecting_pairs[it->first];
+                        others.insert(others.end(), it->second.cbegin(), it->second.cend());
+                    }
+                };
+
+                fn_merge(partial_res);
 
                 for (int i = 0; i < (int)futures.size(); ++i) {
                     std::future<OutputStorageType>& f = futures[i];
                     MCUT_ASSERT(f.valid());
-                    OutputStorageType future_res = f.get();
-
-                    symmetric_intersecting_pairs.insert(future_res.cbegin(), future_res.cend());
+                    fn_merge(f.get());
                 }
             }
         }
@@ -978,3 +2013,382 @@ void intersectOIBVHs(
     }
 
 #endif
+
+// index of the axis along which the normal of triangle "abc" has its largest component. Dropping
+// this axis projects the triangle (and any point in its plane) to 2D without making it degenerate.
+static int get_dominant_normal_axis(const vec3& a, const vec3& b, const vec3& c)
+{
+    const vec3 n = cross_product(b - a, c - a);
+    const double nx = std::fabs(n.x());
+    const double ny = std::fabs(n.y());
+    const double nz = std::fabs(n.z());
+
+    if (nx >= ny && nx >= nz) {
+        return 0;
+    } else if (ny >= nz) {
+        return 1;
+    }
+    return 2;
+}
+
+static vec2 project_along_axis(const vec3& p, const int axis)
+{
+    return axis == 0 ? vec2(p.y(), p.z()) : (axis == 1 ? vec2(p.x(), p.z()) : vec2(p.x(), p.y()));
+}
+
+static bool have_opposite_signs(const double a, const double b)
+{
+    return (a > double(0.0) && b < double(0.0)) || (a < double(0.0) && b > double(0.0));
+}
+
+// "p" is assumed to be collinear with "ab"
+static bool collinear_point_on_segment(const vec2& p, const vec2& a, const vec2& b)
+{
+    return p.x() >= std::min(a.x(), b.x()) && p.x() <= std::max(a.x(), b.x()) && //
+        p.y() >= std::min(a.y(), b.y()) && p.y() <= std::max(a.y(), b.y());
+}
+
+// exact test for whether two 2D segments share a point
+static bool segments_intersect_2d(const vec2& p, const vec2& q, const vec2& a, const vec2& b)
+{
+    const double o1 = orient2d(p, q, a);
+    const double o2 = orient2d(p, q, b);
+    const double o3 = orient2d(a, b, p);
+    const double o4 = orient2d(a, b, q);
+
+    if (have_opposite_signs(o1, o2) && have_opposite_signs(o3, o4)) {
+        return true;
+    }
+
+    return (o1 == double(0.0) && collinear_point_on_segment(a, p, q)) || //
+        (o2 == double(0.0) && collinear_point_on_segment(b, p, q)) || //
+        (o3 == double(0.0) && collinear_point_on_segment(p, a, b)) || //
+        (o4 == double(0.0) && collinear_point_on_segment(q, a, b));
+}
+
+// exact test for whether a 2D point lies inside or on the boundary of a triangle
+static bool point_in_triangle_2d(const vec2& p, const vec2& a, const vec2& b, const vec2& c)
+{
+    const double o1 = orient2d(a, b, p);
+    const double o2 = orient2d(b, c, p);
+    const double o3 = orient2d(c, a, p);
+
+    const bool has_negative = o1 < double(0.0) || o2 < double(0.0) || o3 < double(0.0);
+    const bool has_positive = o1 > double(0.0) || o2 > double(0.0) || o3 > double(0.0);
+
+    return !(has_negative && has_positive);
+}
+
+// exact test for whether the segment "pq" shares a point with triangle "abc"
+static bool segment_intersects_triangle(const vec3& p, const vec3& q, const vec3& a, const vec3& b, const vec3& c)
+{
+    const double op = orient3d(a, b, c, p);
+    const double oq = orient3d(a, b, c, q);
+
+    if ((op > double(0.0) && oq > double(0.0)) || (op < double(0.0) && oq < double(0.0))) {
+        return false; // segment is strictly on one side of the triangle's plane
+    }
+
+    if (op == double(0.0) && oq == double(0.0)) { // coplanar
+        const int axis = get_dominant_normal_axis(a, b, c);
+        const vec2 p2 = project_along_axis(p, axis);
+        const vec2 q2 = project_along_axis(q, axis);
+        const vec2 a2 = project_along_axis(a, axis);
+        const vec2 b2 = project_along_axis(b, axis);
+        const vec2 c2 = project_along_axis(c, axis);
+
+        return point_in_triangle_2d(p2, a2, b2, c2) || point_in_triangle_2d(q2, a2, b2, c2) || //
+            segments_intersect_2d(p2, q2, a2, b2) || segments_intersect_2d(p2, q2, b2, c2) || segments_intersect_2d(p2, q2, c2, a2);
+    }
+
+    // the segment reaches the plane, so it intersects the triangle if its line passes through the triangle
+    const double o1 = orient3d(p, q, a, b);
+    const double o2 = orient3d(p, q, b, c);
+    const double o3 = orient3d(p, q, c, a);
+
+    const bool has_negative = o1 < double(0.0) || o2 < double(0.0) || o3 < double(0.0);
+    const bool has_positive = o1 > double(0.0) || o2 > double(0.0) || o3 > double(0.0);
+
+    return !(has_negative && has_positive);
+}
+
+// returns true if the vertices of triangle "t" are strictly on one side of the plane of triangle "tri"
+static bool triangle_is_strictly_on_one_side(const vec3* t, const vec3* tri)
+{
+    const double o0 = orient3d(tri[0], tri[1], tri[2], t[0]);
+    const double o1 = orient3d(tri[0], tri[1], tri[2], t[1]);
+    const double o2 = orient3d(tri[0], tri[1], tri[2], t[2]);
+
+    return (o0 > double(0.0) && o1 > double(0.0) && o2 > double(0.0)) || (o0 < double(0.0) && o1 < double(0.0) && o2 < double(0.0));
+}
+
+// Two triangles intersect if and only if an edge of one intersects the other.
+static bool triangles_intersect(const vec3* t0, const vec3* t1)
+{
+    if (triangle_is_strictly_on_one_side(t0, t1) || triangle_is_strictly_on_one_side(t1, t0)) {
+        return false; // common case
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        if (segment_intersects_triangle(t0[i], t0[(i + 1) % 3], t1[0], t1[1], t1[2])) {
+            return true;
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        if (segment_intersects_triangle(t1[i], t1[(i + 1) % 3], t0[0], t0[1], t0[2])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// returns true if the faces "fA" and "fB" of "mesh" share a point. Faces are tested as fans of triangles.
+static bool faces_intersect(const hmesh_t& mesh, const std::vector<vd_t>& fA_vertices, const std::vector<vd_t>& fB_vertices)
+{
+    for (int i = 1; i < (int)fA_vertices.size() - 1; ++i) {
+        const vec3 tA[3] = { mesh.vertex(fA_vertices[0]), mesh.vertex(fA_vertices[i]), mesh.vertex(fA_vertices[i + 1]) };
+
+        for (int j = 1; j < (int)fB_vertices.size() - 1; ++j) {
+            const vec3 tB[3] = { mesh.vertex(fB_vertices[0]), mesh.vertex(fB_vertices[j]), mesh.vertex(fB_vertices[j + 1]) };
+
+            if (triangles_intersect(tA, tB)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+#if defined(USE_OIBVH)
+// per-level addressing data of an Oi-BVH, which is computed once so that it need not be
+// recomputed for each node visited while traversing the tree
+struct oibvh_levels_t {
+    int leaf_level_idx;
+    int leftmost_node[32]; // implicit index of the left-most node on each level
+    int rightmost_real_node[32]; // implicit index of the right-most real node on each level
+    int mem_offset[32]; // memory index of a node on a level is "mem_offset + (node - leftmost_node)"
+};
+
+static void compute_oibvh_levels(oibvh_levels_t& levels, const int num_faces)
+{
+    levels.leaf_level_idx = get_leaf_level_from_real_leaf_count(num_faces);
+    const int rightmost_real_leaf = get_rightmost_real_leaf(levels.leaf_level_idx, num_faces);
+
+    for (int level = 0; level <= levels.leaf_level_idx; ++level) {
+        levels.leftmost_node[level] = get_level_leftmost_node(level);
+        levels.rightmost_real_node[level] = get_level_rightmost_real_node(rightmost_real_leaf, levels.leaf_level_idx, level);
+        levels.mem_offset[level] = get_node_mem_index(levels.leftmost_node[level], levels.leftmost_node[level], 0, levels.rightmost_real_node[level]);
+    }
+}
+
+// find the leaf faces of an Oi-BVH whose bounding boxes overlap "bbox"
+static void query_oibvh(
+    std::vector<fd_t>& overlapping_faces,
+    const std::vector<bounding_box_t<vec3>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    const oibvh_levels_t& levels,
+    const bounding_box_t<vec3>& bbox)
+{
+    // depth-first traversal (the stack never holds more than two nodes per level)
+    std::pair<int, int> stack[2 * 32]; // (implicit index, level)
+    int stack_size = 0;
+    stack[stack_size++] = std::make_pair(0, 0); // root
+
+    while (stack_size > 0) {
+        const int node_implicit_idx = stack[stack_size - 1].first;
+        const int node_level_idx = stack[stack_size - 1].second;
+        stack_size--;
+
+        const int node_idx_on_level = node_implicit_idx - levels.leftmost_node[node_level_idx];
+
+        if (!intersect_bounding_boxes(SAFE_ACCESS(bvhAABBs, levels.mem_offset[node_level_idx] + node_idx_on_level), bbox)) {
+            continue;
+        }
+
+        if (node_level_idx == levels.leaf_level_idx) {
+            overlapping_faces.push_back(SAFE_ACCESS(bvhLeafNodeFaces, node_idx_on_level));
+        } else {
+            const int left_child_implicit_idx = (node_implicit_idx * 2) + 1;
+            const int right_child_implicit_idx = (node_implicit_idx * 2) + 2;
+
+            stack[stack_size++] = std::make_pair(left_child_implicit_idx, node_level_idx + 1);
+
+            if (right_child_implicit_idx <= levels.rightmost_real_node[node_level_idx + 1]) {
+                stack[stack_size++] = std::make_pair(right_child_implicit_idx, node_level_idx + 1);
+            }
+        }
+    }
+}
+#else
+// find the faces in a BVH whose bounding boxes overlap "bbox"
+static void query_bvh(
+    std::vector<fd_t>& overlapping_faces,
+    const BoundingVolumeHierarchy& bvh,
+    const bounding_box_t<vec3>& bbox)
+{
+    std::vector<uint32_t> stack(1, 0); // root
+
+    while (!stack.empty()) {
+        const LinearBVHNode& node = bvh.GetNode((int)stack.back());
+        stack.pop_back();
+
+        if (!intersect_bounding_boxes(node.bounds, bbox)) {
+            continue;
+        }
+
+        if (node.nPrimitives > 0) {
+            for (int i = 0; i < node.nPrimitives; ++i) {
+                const fd_t face = bvh.GetPrimitive((int)(node.primitivesOffset + i));
+
+                if (intersect_bounding_boxes(bvh.GetPrimitiveBBox(face), bbox)) {
+                    overlapping_faces.push_back(face);
+                }
+            }
+        } else {
+            stack.push_back(node.firstChildOffset);
+            stack.push_back(node.firstChildOffset + 1);
+        }
+    }
+}
+#endif
+
+void find_self_intersecting_faces(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    const hmesh_t& mesh,
+    std::vector<std::pair<fd_t, fd_t>>& intersecting_face_pairs)
+{
+    TIMESTACK_PUSH(__FUNCTION__);
+
+    intersecting_face_pairs.clear();
+
+#if defined(USE_OIBVH)
+    std::vector<bounding_box_t<vec3>> bvhAABBs;
+    std::vector<fd_t> bvhLeafNodeFaces;
+    std::vector<bounding_box_t<vec3>> face_bboxes;
+    build_oibvh(mesh, bvhAABBs, bvhLeafNodeFaces, face_bboxes);
+
+    oibvh_levels_t levels;
+    compute_oibvh_levels(levels, mesh.number_of_faces());
+#else
+    BoundingVolumeHierarchy bvh;
+    bvh.buildTree(
+#if defined(MCUT_MULTI_THREADED)
+        scheduler,
+#endif
+        mesh);
+#endif
+
+    // the vertices of each face, which are gathered once because each face is in many pairs
+    std::vector<std::vector<vd_t>> face_vertices(mesh.number_of_faces());
+
+    auto fn_gather_face_vertices = [&](std::vector<std::vector<vd_t>>::iterator block_start_, std::vector<std::vector<vd_t>>::iterator block_end_) -> bool {
+        for (std::vector<std::vector<vd_t>>::iterator it = block_start_; it != block_end_; ++it) {
+            mesh.get_vertices_around_face(*it, fd_t((int)std::distance(face_vertices.begin(), it)));
+        }
+        return true;
+    };
+
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
+
+        parallel_fork_and_join(
+            scheduler,
+            face_vertices.begin(),
+            face_vertices.end(),
+            (1 << 12),
+            fn_gather_face_vertices,
+            _1, // out
+            futures);
+
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
+        }
+    }
+#else
+    fn_gather_face_vertices(face_vertices.begin(), face_vertices.end());
+#endif
+
+    typedef std::vector<std::pair<fd_t, fd_t>> OutputStorageType;
+
+    // Each face is queried against the BVH on its own, so that the (read-only) traversals
+    // are independent. A pair of faces is only tested by the face with the smaller index.
+    // This was measured to be faster than traversing the BVH against itself, since a query
+    // only needs a small fixed-size stack.
+    auto fn_find_intersecting_faces = [&](std::vector<std::vector<vd_t>>::const_iterator block_start_, std::vector<std::vector<vd_t>>::const_iterator block_end_) {
+        OutputStorageType pairs;
+        std::vector<fd_t> overlapping_faces;
+
+        for (std::vector<std::vector<vd_t>>::const_iterator it = block_start_; it != block_end_; ++it) {
+            const fd_t f((int)std::distance(face_vertices.cbegin(), it));
+            const std::vector<vd_t>& f_vertices = *it;
+
+            overlapping_faces.clear();
+#if defined(USE_OIBVH)
+            query_oibvh(overlapping_faces, bvhAABBs, bvhLeafNodeFaces, levels, SAFE_ACCESS(face_bboxes, f));
+#else
+            query_bvh(overlapping_faces, bvh, bvh.GetPrimitiveBBox(f));
+#endif
+            for (std::vector<fd_t>::const_iterator g = overlapping_faces.cbegin(); g != overlapping_faces.cend(); ++g) {
+                if (*g <= f) {
+                    continue;
+                }
+
+                const std::vector<vd_t>& g_vertices = SAFE_ACCESS(face_vertices, *g);
+
+                // adjacent faces touch at their shared vertices by construction
+                bool share_vertex = false;
+                for (std::vector<vd_t>::const_iterator v = f_vertices.cbegin(); v != f_vertices.cend() && !share_vertex; ++v) {
+                    share_vertex = std::find(g_vertices.cbegin(), g_vertices.cend(), *v) != g_vertices.cend();
+                }
+
+                if (!share_vertex && faces_intersect(mesh, f_vertices, g_vertices)) {
+                    pairs.emplace_back(f, *g);
+                }
+            }
+        }
+
+        return pairs;
+    };
+
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<OutputStorageType>> futures;
+        OutputStorageType partial_res;
+
+        parallel_fork_and_join(
+            scheduler,
+            face_vertices.cbegin(),
+            face_vertices.cend(),
+            (1 << 10),
+            fn_find_intersecting_faces,
+            partial_res, // output of master thread
+            futures);
+
+        // NOTE: the master thread processes the last block
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<OutputStorageType>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            const OutputStorageType future_res = f.get();
+            intersecting_face_pairs.insert(intersecting_face_pairs.end(), future_res.cbegin(), future_res.cend());
+        }
+
+        intersecting_face_pairs.insert(intersecting_face_pairs.end(), partial_res.cbegin(), partial_res.cend());
+    }
+#else
+    intersecting_face_pairs = fn_find_intersecting_faces(face_vertices.cbegin(), face_vertices.cend());
+#endif
+
+    // the order of the faces found by each query depends on the BVH
+    std::sort(intersecting_face_pairs.begin(), intersecting_face_pairs.end());
+
+    TIMESTACK_POP();
+}
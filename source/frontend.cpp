@@ -194,12 +194,67 @@ void get_info_impl(
             memcpy(pMem, reinterpret_cast<void*>(&context_uptr->flags), bytes);
         }
         break;
+    case MC_CONTEXT_BVH_CACHE_DIRECTORY: {
+        const uint64_t nbytes = context_uptr->bvhCacheDirectory.size() + 1; // include null-terminator
+        if (pMem == nullptr) {
+            *pNumBytes = nbytes;
+        } else {
+            if (bytes < nbytes) {
+                throw std::invalid_argument("invalid byte size");
+            }
+            memcpy(pMem, context_uptr->bvhCacheDirectory.c_str(), nbytes);
+        }
+    } break;
+    case MC_CONTEXT_BROAD_PHASE:
+        if (pMem == nullptr) {
+            *pNumBytes = sizeof(context_uptr->broadPhase);
+        } else {
+            if (bytes < sizeof(context_uptr->broadPhase)) {
+                throw std::invalid_argument("invalid byte size");
+            }
+            memcpy(pMem, reinterpret_cast<void*>(&context_uptr->broadPhase), sizeof(context_uptr->broadPhase));
+        }
+        break;
     default:
         throw std::invalid_argument("unknown info parameter");
         break;
     }
 }
 
+void bind_state_impl(
+    const McContext context,
+    McFlags stateInfo,
+    uint64_t bytes,
+    const void* pMem)
+{
+    std::map<McContext, std::unique_ptr<context_t>>::iterator context_entry_iter = g_contexts.find(context);
+
+    if (context_entry_iter == g_contexts.end()) {
+        throw std::invalid_argument("invalid context");
+    }
+
+    const std::unique_ptr<context_t>& context_uptr = context_entry_iter->second;
+
+    switch (stateInfo) {
+    case MC_CONTEXT_BVH_CACHE_DIRECTORY: {
+        const char* str = reinterpret_cast<const char*>(pMem);
+        // the client may or may not include the null-terminator in "bytes"
+        const size_t len = (str == nullptr) ? 0 : std::find(str, str + bytes, '\0') - str;
+        context_uptr->bvhCacheDirectory.assign(str == nullptr ? "" : str, len);
+    } break;
+    case MC_CONTEXT_BROAD_PHASE: {
+        const McBroadPhase broadPhase = *reinterpret_cast<const McBroadPhase*>(pMem);
+        if (!(broadPhase == MC_BROAD_PHASE_AUTO || broadPhase == MC_BROAD_PHASE_BVH || broadPhase == MC_BROAD_PHASE_UNIFORM_GRID)) {
+            throw std::invalid_argument("invalid broad-phase algorithm");
+        }
+        context_uptr->broadPhase = broadPhase;
+    } break;
+    default:
+        throw std::invalid_argument("unknown state parameter");
+        break;
+    }
+}
+
 void dispatch_impl(
     McContext context,
     McFlags flags,
@@ -259,9 +314,25 @@ void get_connected_components_impl(
 
     uint32_t valid_cc_counter = 0;
 
-    for (std::map<McConnectedComponent, std::unique_ptr<connected_component_t, void (*)(connected_component_t*)>>::const_iterator i = context_uptr->connected_components.cbegin();
-         i != context_uptr->connected_components.cend();
-         ++i) {
+    typedef std::map<McConnectedComponent, std::unique_ptr<connected_component_t, void (*)(connected_component_t*)>>::const_iterator cc_iterator_t;
+
+    // The connected components are stored in the order of their handles, which are addresses and so may be
+    // ordered differently in every run. If deterministic output is requested then they are instead reported
+    // in the order in which they were created.
+    std::vector<cc_iterator_t> cc_visit_order;
+    cc_visit_order.reserve(context_uptr->connected_components.size());
+
+    for (cc_iterator_t i = context_uptr->connected_components.cbegin(); i != context_uptr->connected_components.cend(); ++i) {
+        cc_visit_order.push_back(i);
+    }
+
+    if (context_uptr->dispatchFlags & MC_DISPATCH_DETERMINISTIC) {
+        std::sort(cc_visit_order.begin(), cc_visit_order.end(),
+            [](const cc_iterator_t& a, const cc_iterator_t& b) { return a->second->creation_index < b->second->creation_index; });
+    }
+
+    for (std::vector<cc_iterator_t>::const_iterator visit_iter = cc_visit_order.cbegin(); visit_iter != cc_visit_order.cend(); ++visit_iter) {
+        const cc_iterator_t& i = *visit_iter;
 
         const bool is_valid = (i->second->type & connectedComponentType) != 0;
 
@@ -241,13 +241,13 @@ vertex_descriptor_t hmesh_t::vertex(const edge_descriptor_t e, const int v) cons
 #endif
 }
 
-bool hmesh_t::is_border(const halfedge_descriptor_t h)
+bool hmesh_t::is_border(const halfedge_descriptor_t h) const
 {
     MCUT_ASSERT(h != null_halfedge());
     return face(h) == null_face();
 }
 
-bool hmesh_t::is_border(const edge_descriptor_t e)
+bool hmesh_t::is_border(const edge_descriptor_t e) const
 {
     MCUT_ASSERT(e != null_edge());
     halfedge_descriptor_t h0 = halfedge(e, 0);
@@ -284,58 +284,50 @@ halfedge_descriptor_t hmesh_t::halfedge(const edge_descriptor_t e, const int i)
 #endif
 }
 
-// TODO: maybe a caching mechanism might help with this lookup e,g. "std::unordered_map<std::pair<vertex_descriptor_t, vertex_descriptor_t>, halfedge_descriptor_t>"
-// But this cache need to be invalidated if we delete and edge
 halfedge_descriptor_t hmesh_t::halfedge(const vertex_descriptor_t s, const vertex_descriptor_t t, bool strict_check) const
 {
     MCUT_ASSERT((size_t)s < m_vertices.size()); // MCUT_ASSERT(m_vertices.count(s) == 1);
-    const vertex_data_t& svd = m_vertices[s];
-    const std::vector<halfedge_descriptor_t>& s_halfedges = svd.m_halfedges;
     MCUT_ASSERT((size_t)t < m_vertices.size()); // MCUT_ASSERT(m_vertices.count(t) == 1);
-    const vertex_data_t& tvd = m_vertices[t];
-    const std::vector<halfedge_descriptor_t>& t_halfedges = tvd.m_halfedges;
-
-    static thread_local std::vector<edge_descriptor_t> t_edges;
-    t_edges.resize(0);
-    t_edges.reserve(t_halfedges.size());
-
-    for (std::vector<halfedge_descriptor_t>::const_iterator i = t_halfedges.cbegin(); i != t_halfedges.cend(); i++) {
-        edge_descriptor_t e = edge(*i);
-        MCUT_ASSERT(e != null_edge());
-        t_edges.push_back(e);
-    }
+    const vertex_data_t& svd = m_vertices[s];
 
     halfedge_descriptor_t result = null_halfedge();
-    for (std::vector<halfedge_descriptor_t>::const_iterator i = s_halfedges.cbegin(); i != s_halfedges.cend(); ++i) {
-        edge_descriptor_t s_edge = edge(*i);
-        if (std::find(t_edges.cbegin(), t_edges.cend(), s_edge) != t_edges.cend()) // belong to same edge?
-        {
-            
 
-            // check if we need to return the opposite halfedge
-            if ((source(*i) == s && target(*i) == t) == false) {
-                MCUT_ASSERT(source(*i) == t);
-                MCUT_ASSERT(target(*i) == s);
+    // Walk the halfedges pointing to "s" and those pointing to "t" in lockstep until the edge
+    // connecting the two vertices is found from either side. This costs O(min(deg(s), deg(t))),
+    // which matters when one of them is a high-valence vertex (e.g. the apex of a fan).
+    // If either list is exhausted without a match then there is no such edge.
+    halfedge_descriptor_t hs = svd.m_halfedges_first; // ... pointing to "s"
+    halfedge_descriptor_t ht = m_vertices[t].m_halfedges_first; // ... pointing to "t"
+    halfedge_descriptor_t h = null_halfedge(); // from "s" to "t"
+
+    while (hs != null_halfedge() && ht != null_halfedge()) {
+        const halfedge_data_t& hsd = m_halfedges[hs];
+        MCUT_ASSERT(hsd.t == s);
+        if (m_halfedges[hsd.o].t == t) {
+            h = hsd.o; // the opposite halfedge i.e. the one going from "s" to "t"
+            break;
+        }
 
-                halfedge_descriptor_t h = opposite(*i);
+        const halfedge_data_t& htd = m_halfedges[ht];
+        MCUT_ASSERT(htd.t == t);
+        if (m_halfedges[htd.o].t == s) {
+            h = ht;
+            break;
+        }
 
-                if (strict_check || face(h) != null_face()) { // "strict_check" ensures that we return the halfedge matching the input vertices
-                    result = h;
-                }
-            }
-            else
-            {
-                MCUT_ASSERT(source(*i) == s); // confirm our assumption
-                MCUT_ASSERT(target(*i) == t);
+        hs = hsd.vn;
+        ht = htd.vn;
+    }
 
-                if (strict_check || face(*i) != null_face()) { // "strict_check" ensures that we return the halfedge matching the input vertices
-                    result = *i;  // assume source(*i) and target(*i) match "s" and "t"
-                }
-                
-            }
-            break;
+    if (h != null_halfedge()) {
+        MCUT_ASSERT(source(h) == s); // confirm our assumption
+        MCUT_ASSERT(target(h) == t);
+
+        if (strict_check || face(h) != null_face()) { // "strict_check" ensures that we return the halfedge matching the input vertices
+            result = h;
         }
     }
+
     return result;
 }
 
@@ -356,34 +348,37 @@ vertex_descriptor_t hmesh_t::add_vertex(const vec3& point)
 vertex_descriptor_t hmesh_t::add_vertex(const double& x, const double& y, const double& z)
 {
     vertex_descriptor_t vd = hmesh_t::null_vertex();
-    vertex_data_t* data_ptr = nullptr;
     bool reusing_removed_descr = (!m_vertices_removed.empty());
 
     if (reusing_removed_descr) // can we re-use a slot?
     {
-        std::vector<vertex_descriptor_t>::iterator it = m_vertices_removed.begin(); // take the oldest unused slot (NOTE: important for user data mapping)
-        vd = *it;
-        m_vertices_removed.erase(it);
+        vd = m_vertices_removed.front(); // take the oldest unused slot (NOTE: important for user data mapping)
+        m_vertices_removed.pop_front();
+        m_vertices_removed_flags[vd] = false;
         MCUT_ASSERT((size_t)vd < m_vertices.size()); // MCUT_ASSERT(m_vertices.find(vd) != m_vertices.cend());
-        data_ptr = &m_vertices[vd];
+        MCUT_ASSERT(m_vertices[vd].m_halfedges_first == null_halfedge());
+        m_vertex_properties.reset_element(vd);
+
+        m_vertex_coordinates[0][vd] = x;
+        m_vertex_coordinates[1][vd] = y;
+        m_vertex_coordinates[2][vd] = z;
     } else {
         vd = static_cast<vertex_descriptor_t>(number_of_vertices());
 
         // std::pair<typename std::map<vertex_descriptor_t, vertex_data_t>::iterator, bool> ret = m_vertices.insert(std::make_pair(vd, vertex_data_t()));
         // MCUT_ASSERT(ret.second == true);
         m_vertices.push_back(vertex_data_t());
+        m_vertex_properties.resize(m_vertices.size());
 
-        MCUT_ASSERT((size_t)vd <= (m_vertices.size() - 1));
+        m_vertex_coordinates[0].push_back(x);
+        m_vertex_coordinates[1].push_back(y);
+        m_vertex_coordinates[2].push_back(z);
 
-        data_ptr = &m_vertices[vd]; // &ret.first->second;
+        MCUT_ASSERT((size_t)vd <= (m_vertices.size() - 1));
     }
 
     MCUT_ASSERT(vd != hmesh_t::null_vertex());
 
-    data_ptr->p[0] = x;
-    data_ptr->p[1] = y;
-    data_ptr->p[2] = z;
-
     return vd;
 }
 
@@ -398,21 +393,23 @@ halfedge_descriptor_t hmesh_t::add_edge(const vertex_descriptor_t v0, const vert
 
     if (reusing_removed_h0_descr) // can we re-use a slot?
     {
-        std::vector<halfedge_descriptor_t>::iterator hIter = m_halfedges_removed.begin(); // take the oldest unused slot (NOTE: important for user data mapping)
-        h0_idx = *hIter;
-        m_halfedges_removed.erase(hIter);
+        h0_idx = m_halfedges_removed.front(); // take the oldest unused slot (NOTE: important for user data mapping)
+        m_halfedges_removed.pop_front();
+        m_halfedges_removed_flags[h0_idx] = false;
         MCUT_ASSERT((size_t)h0_idx < m_halfedges.size() /*m_halfedges.find(h0_idx) != m_halfedges.cend()*/);
     }
 
     halfedge_data_t* halfedge0_data_ptr = nullptr;
     if (reusing_removed_h0_descr) {
         // halfedge0_data_ptr = &m_halfedges[h0_idx);
+        m_halfedge_properties.reset_element(h0_idx);
     } else {
         // create new halfedge --> h0
         // std::pair<typename std::map<halfedge_descriptor_t, halfedge_data_t>::iterator, bool> h0_ret = m_halfedges.insert(std::make_pair(h0_idx, halfedge_data_t()));
         // MCUT_ASSERT(h0_ret.second == true);
         // halfedge0_data_ptr = &h0_ret.first->second;
         m_halfedges.emplace_back(halfedge_data_t());
+        m_halfedge_properties.resize(m_halfedges.size());
     }
 
     // second halfedge(1) of edge
@@ -421,21 +418,23 @@ halfedge_descriptor_t hmesh_t::add_edge(const vertex_descriptor_t v0, const vert
 
     if (reusing_removed_h1_descr) // can we re-use a slot?
     {
-        std::vector<halfedge_descriptor_t>::iterator hIter = m_halfedges_removed.begin() /*+ (m_halfedges_removed.size() - 1)*/; // take the most recently removed
-        h1_idx = *hIter;
-        m_halfedges_removed.erase(hIter);
+        h1_idx = m_halfedges_removed.front(); // take the oldest unused slot
+        m_halfedges_removed.pop_front();
+        m_halfedges_removed_flags[h1_idx] = false;
         MCUT_ASSERT((size_t)h1_idx < m_halfedges.size() /*m_halfedges.find(h1_idx) != m_halfedges.cend()*/);
     }
 
     halfedge_data_t* halfedge1_data_ptr = nullptr;
     if (reusing_removed_h1_descr) {
         // halfedge1_data_ptr = &m_halfedges[h1_idx);
+        m_halfedge_properties.reset_element(h1_idx);
     } else {
         // create new halfedge --> h1
         // std::pair<typename std::map<halfedge_descriptor_t, halfedge_data_t>::iterator, bool> h1_ret = m_halfedges.insert(std::make_pair(h1_idx, halfedge_data_t()));
         // MCUT_ASSERT(h1_ret.second == true);
         // halfedge1_data_ptr = &h1_ret.first->second;
         m_halfedges.emplace_back(halfedge_data_t());
+        m_halfedge_properties.resize(m_halfedges.size());
     }
 
     // https://stackoverflow.com/questions/34708189/c-vector-of-pointer-loses-the-reference-after-push-back
@@ -449,21 +448,23 @@ halfedge_descriptor_t hmesh_t::add_edge(const vertex_descriptor_t v0, const vert
 
     if (reusing_removed_edge_descr) // can we re-use a slot?
     {
-        std::vector<edge_descriptor_t>::iterator eIter = m_edges_removed.begin(); // take the oldest unused slot (NOTE: important for user data mapping)
-        e_idx = *eIter;
-        m_edges_removed.erase(eIter);
+        e_idx = m_edges_removed.front(); // take the oldest unused slot (NOTE: important for user data mapping)
+        m_edges_removed.pop_front();
+        m_edges_removed_flags[e_idx] = false;
         MCUT_ASSERT((size_t)e_idx < m_edges.size() /*m_edges.find(e_idx) != m_edges.cend()*/);
     }
 
     edge_data_t* edge_data_ptr = nullptr;
     if (reusing_removed_edge_descr) {
         edge_data_ptr = &m_edges[e_idx];
+        m_edge_properties.reset_element(e_idx);
     } else {
         // std::pair<typename std::map<edge_descriptor_t, edge_data_t>::iterator, bool> eret = m_edges.insert(std::make_pair(e_idx, edge_data_t())); // create a new edge
         // MCUT_ASSERT(eret.second == true);
         // edge_data_ptr = &eret.first->second;
         m_edges.emplace_back(edge_data_t());
         edge_data_ptr = &m_edges.back();
+        m_edge_properties.resize(m_edges.size());
     }
 
     // update incidence information
@@ -488,18 +489,10 @@ halfedge_descriptor_t hmesh_t::add_edge(const vertex_descriptor_t v0, const vert
 
     // v0
     MCUT_ASSERT((size_t)v0 < m_vertices.size()); // MCUT_ASSERT(m_vertices.count(v0) == 1);
-    vertex_data_t& v0_data = m_vertices[v0];
-    // MCUT_ASSERT();
-    if (std::find(v0_data.m_halfedges.cbegin(), v0_data.m_halfedges.cend(), h1_idx) == v0_data.m_halfedges.cend()) {
-        v0_data.m_halfedges.emplace_back(h1_idx); // halfedge whose target is v0
-    }
+    link_halfedge_to_target(h1_idx); // halfedge whose target is v0
     // v1
     MCUT_ASSERT((size_t)v1 < m_vertices.size()); // MCUT_ASSERT(m_vertices.count(v1) == 1);
-    vertex_data_t& v1_data = m_vertices[v1];
-    // MCUT_ASSERT();
-    if (std::find(v1_data.m_halfedges.cbegin(), v1_data.m_halfedges.cend(), h0_idx) == v1_data.m_halfedges.cend()) {
-        v1_data.m_halfedges.emplace_back(h0_idx); // halfedge whose target is v1
-    }
+    link_halfedge_to_target(h0_idx); // halfedge whose target is v1
 
     return static_cast<halfedge_descriptor_t>(h0_idx); // return halfedge whose target is v1
 }
@@ -510,21 +503,24 @@ face_descriptor_t hmesh_t::add_face(const std::vector<vertex_descriptor_t>& vi)
     MCUT_ASSERT(face_vertex_count >= 3);
 
     const int face_count = number_of_faces();
-    face_data_t new_face_data;
     face_descriptor_t new_face_idx(static_cast<face_descriptor_t::index_type>(face_count));
     bool reusing_removed_face_descr = (!m_faces_removed.empty());
 
     if (reusing_removed_face_descr) // can we re-use a slot?
     {
-        std::vector<face_descriptor_t>::iterator fIter = m_faces_removed.begin(); // take the oldest unused slot (NOTE: important for user data mapping)
-        new_face_idx = *fIter;
-        m_faces_removed.erase(fIter); // slot is going to be used again
+        new_face_idx = m_faces_removed.front(); // take the oldest unused slot (NOTE: important for user data mapping)
+        m_faces_removed.pop_front(); // slot is going to be used again
+        m_faces_removed_flags[new_face_idx] = false;
 
         MCUT_ASSERT((size_t)new_face_idx < m_faces.size() /*m_faces.find(new_face_idx) != m_faces.cend()*/);
     }
 
-    face_data_t* face_data_ptr = reusing_removed_face_descr ? &m_faces[new_face_idx] : &new_face_data;
-    face_data_ptr->m_halfedges.clear();
+    if (reusing_removed_face_descr) {
+        m_faces[new_face_idx].m_halfedges_count = 0;
+    }
+
+    // the halfedges of the new face are appended to the pool (a failed insertion rolls this back)
+    const std::uint32_t face_halfedges_offset = (std::uint32_t)m_face_halfedges.size();
 
     for (int i = 0; i < face_vertex_count; ++i) {
         const vertex_descriptor_t v0 = vi[i]; // i.e. src
@@ -601,26 +597,35 @@ face_descriptor_t hmesh_t::add_face(const std::vector<vertex_descriptor_t>& vi)
             printf("\n");
             printf("h%d.opp = h%d; =%d \n", (int)v1_h, (int)opposite(v1_h), (int)face(opposite(v1_h)));
             #endif
+            m_face_halfedges.resize(face_halfedges_offset);
             return null_face(); // face is incident to a non-manifold edge
         }
 
         v1_hd_ptr->f = new_face_idx; // associate halfedge with face
-        face_data_ptr->m_halfedges.emplace_back(v1_h);
+        m_face_halfedges.emplace_back(v1_h);
     }
 
     if (!reusing_removed_face_descr) {
         MCUT_ASSERT((size_t)new_face_idx == m_faces.size() /*m_faces.count(new_face_idx) == 0*/);
         // m_faces.insert(std::make_pair(new_face_idx, *face_data_ptr));
-        m_faces.emplace_back(*face_data_ptr);
+        m_faces.emplace_back(face_data_t());
+        m_face_properties.resize(m_faces.size());
+    } else {
+        m_face_properties.reset_element(new_face_idx);
     }
 
+    face_data_t& face_data = m_faces[new_face_idx];
+    face_data.m_halfedges_offset = face_halfedges_offset;
+    face_data.m_halfedges_count = (std::uint32_t)(m_face_halfedges.size() - face_halfedges_offset);
+
     // update halfedges (next halfedge)
     // const std::vector<halfedge_descriptor_t>& halfedges_around_new_face = get_halfedges_around_face(new_face_idx);
-    const int num_halfedges = static_cast<int>(face_data_ptr->m_halfedges.size());
+    const int num_halfedges = static_cast<int>(face_data.m_halfedges_count);
+    const halfedge_descriptor_t* const face_halfedges = m_face_halfedges.data() + face_halfedges_offset;
 
     for (int i = 0; i < num_halfedges; ++i) {
-        const halfedge_descriptor_t h = face_data_ptr->m_halfedges[i];
-        const halfedge_descriptor_t nh = face_data_ptr->m_halfedges[(i + 1) % num_halfedges];
+        const halfedge_descriptor_t h = face_halfedges[i];
+        const halfedge_descriptor_t nh = face_halfedges[(i + 1) % num_halfedges];
         set_next(h, nh);
     }
 
@@ -662,19 +667,24 @@ bool hmesh_t::is_insertable(const std::vector<vertex_descriptor_t>& vi) const
     return true;
 }
 
-const vec3& hmesh_t::vertex(const vertex_descriptor_t& vd) const
+vec3 hmesh_t::vertex(const vertex_descriptor_t& vd) const
 {
     MCUT_ASSERT(vd != null_vertex());
     MCUT_ASSERT((size_t)vd < m_vertices.size());
-    const vertex_data_t& vdata = m_vertices[vd];
-    return vdata.p;
+    return vec3(m_vertex_coordinates[0][vd], m_vertex_coordinates[1][vd], m_vertex_coordinates[2][vd]);
+}
+
+const std::vector<double>& hmesh_t::vertex_coordinates(const int axis) const
+{
+    MCUT_ASSERT(axis >= 0 && axis <= 2);
+    return m_vertex_coordinates[axis];
 }
 
 uint32_t hmesh_t::get_num_vertices_around_face(const face_descriptor_t f) const
 {
     MCUT_ASSERT(f != null_face());
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = get_halfedges_around_face(f);
+    const descriptor_array_view_t<halfedge_descriptor_t> halfedges_on_face = get_halfedges_around_face(f);
 
     return (uint32_t)halfedges_on_face.size();
 }
@@ -683,7 +693,7 @@ std::vector<vertex_descriptor_t> hmesh_t::get_vertices_around_face(const face_de
 {
     MCUT_ASSERT(f != null_face());
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = get_halfedges_around_face(f);
+    const descriptor_array_view_t<halfedge_descriptor_t> halfedges_on_face = get_halfedges_around_face(f);
 
     std::vector<vertex_descriptor_t> vertex_descriptors(halfedges_on_face.size());
 
@@ -700,7 +710,7 @@ void hmesh_t::get_vertices_around_face(std::vector<vertex_descriptor_t>& vertex_
 {
     MCUT_ASSERT(f != null_face());
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = get_halfedges_around_face(f);
+    const descriptor_array_view_t<halfedge_descriptor_t> halfedges_on_face = get_halfedges_around_face(f);
     vertex_descriptors.resize(halfedges_on_face.size());
 
     for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
@@ -712,33 +722,44 @@ void hmesh_t::get_vertices_around_face(std::vector<vertex_descriptor_t>& vertex_
 std::vector<vertex_descriptor_t> hmesh_t::get_vertices_around_vertex(const vertex_descriptor_t v) const
 {
     MCUT_ASSERT(v != null_vertex());
-    // halfedges whoe target is 'v'
-    const std::vector<halfedge_descriptor_t>& halfedges = get_halfedges_around_vertex(v);
+    MCUT_ASSERT((size_t)v < m_vertices.size());
     static thread_local std::vector<vertex_descriptor_t> out;
     out.resize(0);
-    out.reserve(halfedges.size());
-    for (std::vector<halfedge_descriptor_t>::const_iterator h = halfedges.cbegin(); h != halfedges.cend(); ++h) {
-        vertex_descriptor_t src = source(*h);
+    // halfedges whoe target is 'v'
+    for (halfedge_descriptor_t h = m_vertices[v].m_halfedges_first; h != null_halfedge(); h = m_halfedges[h].vn) {
+        vertex_descriptor_t src = source(h);
         out.push_back(src);
     }
     return out;
 }
 
-const std::vector<halfedge_descriptor_t>& hmesh_t::get_halfedges_around_face(const face_descriptor_t f) const
+void hmesh_t::get_vertices_around_vertex(std::vector<vertex_descriptor_t>& vertices_around_vertex, const vertex_descriptor_t v) const
+{
+    MCUT_ASSERT(v != null_vertex());
+    MCUT_ASSERT((size_t)v < m_vertices.size());
+    vertices_around_vertex.clear();
+    for (halfedge_descriptor_t h = m_vertices[v].m_halfedges_first; h != null_halfedge(); h = m_halfedges[h].vn) {
+        vertices_around_vertex.push_back(source(h));
+    }
+}
+
+descriptor_array_view_t<halfedge_descriptor_t> hmesh_t::get_halfedges_around_face(const face_descriptor_t f) const
 {
     MCUT_ASSERT(f != null_face());
     MCUT_ASSERT((size_t)f < m_faces.size() /*m_faces.count(f) == 1*/);
-    return m_faces[f].m_halfedges;
+    const face_data_t& fd = m_faces[f];
+    const halfedge_descriptor_t* const first = m_face_halfedges.data() + fd.m_halfedges_offset;
+    return descriptor_array_view_t<halfedge_descriptor_t>(first, first + fd.m_halfedges_count);
 }
 
-const std::vector<face_descriptor_t> hmesh_t::get_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
+const std::vector<face_descriptor_t> hmesh_t::get_faces_around_face(const face_descriptor_t f, const descriptor_array_view_t<halfedge_descriptor_t>* halfedges_around_face_) const
 {
     MCUT_ASSERT(f != null_face());
 
     std::vector<face_descriptor_t> faces_around_face;
     faces_around_face.clear();
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
+    const descriptor_array_view_t<halfedge_descriptor_t> halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
 
     for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
 
@@ -758,13 +779,13 @@ const std::vector<face_descriptor_t> hmesh_t::get_faces_around_face(const face_d
     return faces_around_face;
 }
 // NOTE: we have a lot of dupication here
-void hmesh_t::get_faces_around_face(std::vector<face_descriptor_t>& faces_around_face, const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
+void hmesh_t::get_faces_around_face(std::vector<face_descriptor_t>& faces_around_face, const face_descriptor_t f, const descriptor_array_view_t<halfedge_descriptor_t>* halfedges_around_face_) const
 {
     MCUT_ASSERT(f != null_face());
 
     faces_around_face.clear();
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
+    const descriptor_array_view_t<halfedge_descriptor_t> halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
 
     for (int i = 0; i < (int)halfedges_on_face.size(); ++i) {
 
@@ -783,13 +804,13 @@ void hmesh_t::get_faces_around_face(std::vector<face_descriptor_t>& faces_around
     }
 }
 
-uint32_t hmesh_t::get_num_faces_around_face(const face_descriptor_t f, const std::vector<halfedge_descriptor_t>* halfedges_around_face_) const
+uint32_t hmesh_t::get_num_faces_around_face(const face_descriptor_t f, const descriptor_array_view_t<halfedge_descriptor_t>* halfedges_around_face_) const
 {
     MCUT_ASSERT(f != null_face());
 
     uint32_t num_faces_around_face = 0;
 
-    const std::vector<halfedge_descriptor_t>& halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
+    const descriptor_array_view_t<halfedge_descriptor_t> halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
 
     for (uint32_t i = 0; i < (uint32_t)halfedges_on_face.size(); ++i) {
 
@@ -813,13 +834,66 @@ uint32_t hmesh_t::get_num_faces_around_face(const face_descriptor_t f, const std
     return num_faces_around_face;
 }
 
-const std::vector<halfedge_descriptor_t>& hmesh_t::get_halfedges_around_vertex(const vertex_descriptor_t v) const
+std::vector<halfedge_descriptor_t> hmesh_t::get_halfedges_around_vertex(const vertex_descriptor_t v) const
+{
+    std::vector<halfedge_descriptor_t> incoming_halfedges;
+    get_halfedges_around_vertex(incoming_halfedges, v);
+    return incoming_halfedges;
+}
+
+void hmesh_t::get_halfedges_around_vertex(std::vector<halfedge_descriptor_t>& incoming_halfedges, const vertex_descriptor_t v) const
 {
     MCUT_ASSERT(v != hmesh_t::null_vertex());
     MCUT_ASSERT((size_t)v < m_vertices.size());
-    const vertex_data_t& vd = m_vertices[v];
-    const std::vector<halfedge_descriptor_t>& incoming_halfedges = vd.m_halfedges;
-    return incoming_halfedges;
+    incoming_halfedges.clear();
+    for (halfedge_descriptor_t h = m_vertices[v].m_halfedges_first; h != null_halfedge(); h = m_halfedges[h].vn) {
+        incoming_halfedges.push_back(h);
+    }
+}
+
+void hmesh_t::link_halfedge_to_target(const halfedge_descriptor_t h)
+{
+    halfedge_data_t& hd = m_halfedges[h];
+    vertex_data_t& vd = m_vertices[hd.t];
+
+    hd.vn = null_halfedge();
+
+    if (vd.m_halfedges_last == null_halfedge()) {
+        MCUT_ASSERT(vd.m_halfedges_first == null_halfedge());
+        vd.m_halfedges_first = h;
+    } else {
+        m_halfedges[vd.m_halfedges_last].vn = h;
+    }
+
+    vd.m_halfedges_last = h;
+}
+
+void hmesh_t::unlink_halfedge_from_target(const halfedge_descriptor_t h)
+{
+    halfedge_data_t& hd = m_halfedges[h];
+    vertex_data_t& vd = m_vertices[hd.t];
+
+    halfedge_descriptor_t prev = null_halfedge();
+    halfedge_descriptor_t cur = vd.m_halfedges_first;
+
+    while (cur != null_halfedge() && cur != h) {
+        prev = cur;
+        cur = m_halfedges[cur].vn;
+    }
+
+    MCUT_ASSERT(cur == h); // because not yet removed h
+
+    if (prev == null_halfedge()) {
+        vd.m_halfedges_first = hd.vn;
+    } else {
+        m_halfedges[prev].vn = hd.vn;
+    }
+
+    if (vd.m_halfedges_last == h) {
+        vd.m_halfedges_last = prev;
+    }
+
+    hd.vn = null_halfedge();
 }
 
 vertex_array_iterator_t hmesh_t::vertices_begin(bool account_for_removed_elems) const
@@ -894,16 +968,13 @@ face_array_iterator_t hmesh_t::faces_end() const
 void hmesh_t::remove_face(const face_descriptor_t f)
 {
     MCUT_ASSERT(f != null_face());
-    MCUT_ASSERT(std::find(m_faces_removed.cbegin(), m_faces_removed.cend(), f) == m_faces_removed.cend());
+    MCUT_ASSERT(!is_removed(f));
 
-    face_data_t& fd = m_faces[f];
-
-    static thread_local std::vector<vertex_descriptor_t> face_vertices; // ... that are used by face
-    face_vertices.resize(0);
+    const descriptor_array_view_t<halfedge_descriptor_t> face_halfedges = get_halfedges_around_face(f);
 
     // disassociate halfedges
 
-    for (std::vector<halfedge_descriptor_t>::const_iterator it = fd.m_halfedges.cbegin(); it != fd.m_halfedges.cend(); ++it) {
+    for (descriptor_array_view_t<halfedge_descriptor_t>::const_iterator it = face_halfedges.cbegin(); it != face_halfedges.cend(); ++it) {
         halfedge_data_t& hd = m_halfedges[*it];
         MCUT_ASSERT(hd.f != null_face());
         hd.f = null_face();
@@ -928,24 +999,12 @@ void hmesh_t::remove_face(const face_descriptor_t f)
             //
             hd.p = null_halfedge();
         }
-
-        face_vertices.push_back(hd.t);
     }
 
-    // disassociate vertices
-
-    // for each vertex used by face
-    for (std::vector<vertex_descriptor_t>::const_iterator it = face_vertices.cbegin(); it != face_vertices.cend(); ++it) {
-        vertex_descriptor_t face_vertex = *it;
-        vertex_data_t& vd = m_vertices[face_vertex];
-
-        std::vector<face_descriptor_t>::iterator fIter = std::find(vd.m_faces.begin(), vd.m_faces.end(), f);
-
-        if (fIter != vd.m_faces.cend()) {
-            vd.m_faces.erase(fIter); // remove association
-        }
+    if (m_faces_removed_flags.size() < m_faces.size()) {
+        m_faces_removed_flags.resize(m_faces.size(), false);
     }
-
+    m_faces_removed_flags[f] = true;
     m_faces_removed.push_back(f);
 }
 
@@ -953,7 +1012,7 @@ void hmesh_t::remove_face(const face_descriptor_t f)
 void hmesh_t::remove_halfedge(halfedge_descriptor_t h)
 {
     MCUT_ASSERT(h != null_halfedge());
-    MCUT_ASSERT(std::find(m_halfedges_removed.cbegin(), m_halfedges_removed.cend(), h) == m_halfedges_removed.cend());
+    MCUT_ASSERT(!is_removed(h));
 
     halfedge_data_t& hd = m_halfedges[h];
 
@@ -990,13 +1049,12 @@ void hmesh_t::remove_halfedge(halfedge_descriptor_t h)
     MCUT_ASSERT(hd.t != null_vertex()); // every h has a target vertex which is effectively dependent on h
 
     // disassociate target vertex
-    vertex_data_t& htd = m_vertices[hd.t];
-    std::vector<halfedge_descriptor_t>::iterator hIter = std::find(htd.m_halfedges.begin(), htd.m_halfedges.end(), h);
-
-    MCUT_ASSERT(hIter != htd.m_halfedges.end()); // because not yet removed h
-
-    htd.m_halfedges.erase(hIter); // remove association
+    unlink_halfedge_from_target(h); // remove association
 
+    if (m_halfedges_removed_flags.size() < m_halfedges.size()) {
+        m_halfedges_removed_flags.resize(m_halfedges.size(), false);
+    }
+    m_halfedges_removed_flags[h] = true;
     m_halfedges_removed.push_back(h);
 }
 
@@ -1004,7 +1062,7 @@ void hmesh_t::remove_halfedge(halfedge_descriptor_t h)
 void hmesh_t::remove_edge(const edge_descriptor_t e, bool remove_halfedges)
 {
     MCUT_ASSERT(e != null_edge());
-    MCUT_ASSERT(std::find(m_edges_removed.cbegin(), m_edges_removed.cend(), e) == m_edges_removed.cend());
+    MCUT_ASSERT(!is_removed(e));
 
     edge_data_t& ed = m_edges[e];
     std::vector<halfedge_descriptor_t> halfedges = { ed.h, opposite(ed.h) }; // both halfedges incident to edge must be disassociated
@@ -1024,6 +1082,10 @@ void hmesh_t::remove_edge(const edge_descriptor_t e, bool remove_halfedges)
 
     ed.h = null_halfedge(); // we are removing the edge so every associated data element must be nullified
 
+    if (m_edges_removed_flags.size() < m_edges.size()) {
+        m_edges_removed_flags.resize(m_edges.size(), false);
+    }
+    m_edges_removed_flags[e] = true;
     m_edges_removed.push_back(e);
 }
 
@@ -1031,11 +1093,14 @@ void hmesh_t::remove_vertex(const vertex_descriptor_t v)
 {
     MCUT_ASSERT(v != null_vertex());
     MCUT_ASSERT((size_t)v < m_vertices.size());
-    MCUT_ASSERT(std::find(m_vertices_removed.cbegin(), m_vertices_removed.cend(), v) == m_vertices_removed.cend());
-    MCUT_ASSERT(m_vertices[v].m_faces.empty());
-    MCUT_ASSERT(m_vertices[v].m_halfedges.empty());
+    MCUT_ASSERT(!is_removed(v));
+    MCUT_ASSERT(m_vertices[v].m_halfedges_first == null_halfedge());
 
-    m_vertices_removed.emplace_back(v);
+    if (m_vertices_removed_flags.size() < m_vertices.size()) {
+        m_vertices_removed_flags.resize(m_vertices.size(), false);
+    }
+    m_vertices_removed_flags[v] = true;
+    m_vertices_removed.push_back(v);
 }
 
 void hmesh_t::remove_elements()
@@ -1057,24 +1122,248 @@ void hmesh_t::remove_elements()
     }
 }
 
+// Builds the old-to-new descriptor table for compacting an element array with "n" slots, where
+// the remaining elements are renumbered in order. "new_to_old" receives the inverse table.
+template <typename D>
+static void build_compaction_tables(const hmesh_t& m, const std::size_t n, std::vector<D>& old_to_new, std::vector<std::uint32_t>& new_to_old)
+{
+    old_to_new.resize(n);
+    new_to_old.clear();
+    new_to_old.reserve(n);
+
+    for (std::uint32_t i = 0; i < (std::uint32_t)n; ++i) {
+        if (m.is_removed(D(i))) {
+            old_to_new[i] = D(); // null
+        } else {
+            old_to_new[i] = D((std::uint32_t)new_to_old.size());
+            new_to_old.push_back(i);
+        }
+    }
+}
+
+template <typename D>
+static inline D remap_descriptor(const std::vector<D>& old_to_new, const D d)
+{
+    return d.is_valid() ? old_to_new[d] : d;
+}
+
+// calls "fn" on blocks of "elements" (in parallel if possible)
+template <typename FunctionType>
+static void for_each_block(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    const std::vector<std::uint32_t>& elements,
+    FunctionType& fn)
+{
+#if defined(MCUT_MULTI_THREADED)
+    if (elements.empty()) {
+        return;
+    }
+
+    std::vector<std::future<bool>> futures;
+    bool _1;
+
+    parallel_fork_and_join(
+        scheduler,
+        elements.cbegin(),
+        elements.cend(),
+        (1 << 14),
+        fn,
+        _1, // out
+        futures);
+
+    for (int i = 0; i < (int)futures.size(); ++i) {
+        std::future<bool>& f = futures[i];
+        MCUT_ASSERT(f.valid());
+        f.wait(); // wait for result to be done
+    }
+#else
+    fn(elements.cbegin(), elements.cend());
+#endif
+}
+
+void hmesh_t::compact(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
+    hmesh_remap_t* remap)
+{
+    hmesh_remap_t local_remap;
+    hmesh_remap_t& r = (remap != nullptr) ? *remap : local_remap;
+
+    std::vector<std::uint32_t> new_to_old_vertex;
+    std::vector<std::uint32_t> new_to_old_edge;
+    std::vector<std::uint32_t> new_to_old_halfedge;
+    std::vector<std::uint32_t> new_to_old_face;
+
+    build_compaction_tables(*this, m_vertices.size(), r.vertices, new_to_old_vertex);
+    build_compaction_tables(*this, m_edges.size(), r.edges, new_to_old_edge);
+    build_compaction_tables(*this, m_halfedges.size(), r.halfedges, new_to_old_halfedge);
+    build_compaction_tables(*this, m_faces.size(), r.faces, new_to_old_face);
+
+#if ENABLE_EDGE_DESCRIPTOR_TRICK
+    // the halfedges of an edge are removed together with it, so they stay next to each other
+    MCUT_ASSERT(new_to_old_halfedge.size() == new_to_old_edge.size() * 2);
+#endif
+
+    // The halfedges of the remaining faces are packed into a new pool. This also drops
+    // the runs of halfedges that were left behind by removed faces.
+    std::vector<std::uint32_t> face_halfedges_offsets(new_to_old_face.size() + 1, 0);
+
+    for (std::size_t i = 0; i < new_to_old_face.size(); ++i) {
+        face_halfedges_offsets[i + 1] = face_halfedges_offsets[i] + m_faces[new_to_old_face[i]].m_halfedges_count;
+    }
+
+    std::vector<vertex_data_t> vertices(new_to_old_vertex.size());
+    std::vector<double> vertex_coordinates[3] = {
+        std::vector<double>(new_to_old_vertex.size()),
+        std::vector<double>(new_to_old_vertex.size()),
+        std::vector<double>(new_to_old_vertex.size())
+    };
+    std::vector<edge_data_t> edges(new_to_old_edge.size());
+    std::vector<halfedge_data_t> halfedges(new_to_old_halfedge.size());
+    std::vector<face_data_t> faces(new_to_old_face.size());
+    std::vector<halfedge_descriptor_t> face_halfedges(face_halfedges_offsets.back());
+
+    auto fn_compact_vertices = [&](std::vector<std::uint32_t>::const_iterator block_start_, std::vector<std::uint32_t>::const_iterator block_end_) -> bool {
+        for (std::vector<std::uint32_t>::const_iterator it = block_start_; it != block_end_; ++it) {
+            const std::size_t i = std::distance(new_to_old_vertex.cbegin(), it);
+            const vertex_data_t& src = m_vertices[*it];
+            vertex_data_t& dst = vertices[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                vertex_coordinates[axis][i] = m_vertex_coordinates[axis][*it];
+            }
+            dst.m_halfedges_first = remap_descriptor(r.halfedges, src.m_halfedges_first);
+            dst.m_halfedges_last = remap_descriptor(r.halfedges, src.m_halfedges_last);
+        }
+        return true;
+    };
+
+    auto fn_compact_edges = [&](std::vector<std::uint32_t>::const_iterator block_start_, std::vector<std::uint32_t>::const_iterator block_end_) -> bool {
+        for (std::vector<std::uint32_t>::const_iterator it = block_start_; it != block_end_; ++it) {
+            const std::size_t i = std::distance(new_to_old_edge.cbegin(), it);
+            edge_data_t& dst = edges[i];
+            dst.h = remap_descriptor(r.halfedges, m_edges[*it].h);
+#if ENABLE_EDGE_DESCRIPTOR_TRICK
+            MCUT_ASSERT((std::size_t)dst.h == i * 2);
+#endif
+        }
+        return true;
+    };
+
+    auto fn_compact_halfedges = [&](std::vector<std::uint32_t>::const_iterator block_start_, std::vector<std::uint32_t>::const_iterator block_end_) -> bool {
+        for (std::vector<std::uint32_t>::const_iterator it = block_start_; it != block_end_; ++it) {
+            const halfedge_data_t& src = m_halfedges[*it];
+            halfedge_data_t& dst = halfedges[std::distance(new_to_old_halfedge.cbegin(), it)];
+            dst.o = remap_descriptor(r.halfedges, src.o);
+            dst.n = remap_descriptor(r.halfedges, src.n);
+            dst.p = remap_descriptor(r.halfedges, src.p);
+            dst.t = remap_descriptor(r.vertices, src.t);
+            dst.e = remap_descriptor(r.edges, src.e);
+            dst.f = remap_descriptor(r.faces, src.f);
+            dst.vn = remap_descriptor(r.halfedges, src.vn);
+        }
+        return true;
+    };
+
+    auto fn_compact_faces = [&](std::vector<std::uint32_t>::const_iterator block_start_, std::vector<std::uint32_t>::const_iterator block_end_) -> bool {
+        for (std::vector<std::uint32_t>::const_iterator it = block_start_; it != block_end_; ++it) {
+            const std::size_t i = std::distance(new_to_old_face.cbegin(), it);
+            const face_data_t& src = m_faces[*it];
+            face_data_t& dst = faces[i];
+            dst.m_halfedges_offset = face_halfedges_offsets[i];
+            dst.m_halfedges_count = src.m_halfedges_count;
+
+            for (std::uint32_t j = 0; j < src.m_halfedges_count; ++j) {
+                face_halfedges[dst.m_halfedges_offset + j] = remap_descriptor(r.halfedges, m_face_halfedges[src.m_halfedges_offset + j]);
+            }
+        }
+        return true;
+    };
+
+    for_each_block(
+#if defined(MCUT_MULTI_THREADED)
+        scheduler,
+#endif
+        new_to_old_vertex, fn_compact_vertices);
+    for_each_block(
+#if defined(MCUT_MULTI_THREADED)
+        scheduler,
+#endif
+        new_to_old_edge, fn_compact_edges);
+    for_each_block(
+#if defined(MCUT_MULTI_THREADED)
+        scheduler,
+#endif
+        new_to_old_halfedge, fn_compact_halfedges);
+    for_each_block(
+#if defined(MCUT_MULTI_THREADED)
+        scheduler,
+#endif
+        new_to_old_face, fn_compact_faces);
+
+    m_vertices.swap(vertices);
+    for (int axis = 0; axis < 3; ++axis) {
+        m_vertex_coordinates[axis].swap(vertex_coordinates[axis]);
+    }
+    m_edges.swap(edges);
+    m_halfedges.swap(halfedges);
+    m_faces.swap(faces);
+    m_face_halfedges.swap(face_halfedges);
+
+    m_vertices_removed.clear();
+    m_edges_removed.clear();
+    m_halfedges_removed.clear();
+    m_faces_removed.clear();
+    m_vertices_removed_flags.clear();
+    m_edges_removed_flags.clear();
+    m_halfedges_removed_flags.clear();
+    m_faces_removed_flags.clear();
+
+    m_vertex_properties.compact(new_to_old_vertex);
+    m_edge_properties.compact(new_to_old_edge);
+    m_halfedge_properties.compact(new_to_old_halfedge);
+    m_face_properties.compact(new_to_old_face);
+}
+
 void hmesh_t::reset()
 {
     m_vertices.clear();
     m_vertices.shrink_to_fit();
+    for (int axis = 0; axis < 3; ++axis) {
+        m_vertex_coordinates[axis].clear();
+        m_vertex_coordinates[axis].shrink_to_fit();
+    }
     m_vertices_removed.clear();
     m_vertices_removed.shrink_to_fit();
+    m_vertices_removed_flags.clear();
+    m_vertices_removed_flags.shrink_to_fit();
     m_halfedges.clear();
     m_halfedges.shrink_to_fit();
     m_halfedges_removed.clear();
     m_halfedges_removed.shrink_to_fit();
+    m_halfedges_removed_flags.clear();
+    m_halfedges_removed_flags.shrink_to_fit();
     m_edges.clear();
     m_edges.shrink_to_fit();
     m_edges_removed.clear();
     m_edges_removed.shrink_to_fit();
+    m_edges_removed_flags.clear();
+    m_edges_removed_flags.shrink_to_fit();
     m_faces.clear();
     m_faces.shrink_to_fit();
+    m_face_halfedges.clear();
+    m_face_halfedges.shrink_to_fit();
     m_faces_removed.clear();
     m_faces_removed.shrink_to_fit();
+    m_faces_removed_flags.clear();
+    m_faces_removed_flags.shrink_to_fit();
+    // properties stay attached to the (now empty) mesh
+    m_vertex_properties.resize(0);
+    m_edge_properties.resize(0);
+    m_halfedge_properties.resize(0);
+    m_face_properties.resize(0);
 }
 
 int hmesh_t::number_of_internal_faces() const
@@ -1118,44 +1407,32 @@ int hmesh_t::number_of_faces_removed() const
     return (int)this->m_faces_removed.size();
 }
 
-bool hmesh_t::is_removed(face_descriptor_t f) const
-{
-    return std::find(m_faces_removed.cbegin(), m_faces_removed.cend(), f) != m_faces_removed.cend();
-}
-
-bool hmesh_t::is_removed(edge_descriptor_t e) const
-{
-    return std::find(m_edges_removed.cbegin(), m_edges_removed.cend(), e) != m_edges_removed.cend();
-}
-
-bool hmesh_t::is_removed(halfedge_descriptor_t h) const
-{
-    return std::find(m_halfedges_removed.cbegin(), m_halfedges_removed.cend(), h) != m_halfedges_removed.cend();
-}
-
-bool hmesh_t::is_removed(vertex_descriptor_t v) const
-{
-    return std::find(m_vertices_removed.cbegin(), m_vertices_removed.cend(), v) != m_vertices_removed.cend();
-}
-
 void hmesh_t::reserve_for_additional_vertices(std::uint32_t n)
 {
     m_vertices.reserve((std::uint64_t)number_of_internal_vertices() + n);
+    for (int axis = 0; axis < 3; ++axis) {
+        m_vertex_coordinates[axis].reserve((std::uint64_t)number_of_internal_vertices() + n);
+    }
+    m_vertex_properties.reserve((std::uint64_t)number_of_internal_vertices() + n);
 }
 
 void hmesh_t::reserve_for_additional_edges(std::uint32_t n)
 {
     m_edges.reserve((std::uint64_t)number_of_internal_edges() + n);
+    m_edge_properties.reserve((std::uint64_t)number_of_internal_edges() + n);
 }
 
 void hmesh_t::reserve_for_additional_halfedges(std::uint32_t n)
 {
     m_halfedges.reserve((std::uint64_t)number_of_internal_halfedges() + n);
+    m_halfedge_properties.reserve((std::uint64_t)number_of_internal_halfedges() + n);
 }
 
 void hmesh_t::reserve_for_additional_faces(std::uint32_t n)
 {
     m_faces.reserve((std::uint64_t)number_of_internal_faces() + n);
+    m_face_properties.reserve((std::uint64_t)number_of_internal_faces() + n);
+    m_face_halfedges.reserve(m_face_halfedges.size() + (std::uint64_t)n * 3); // assume mostly triangles
 }
 
 void hmesh_t::reserve_for_additional_elements(std::uint32_t n)
@@ -1170,42 +1447,42 @@ void hmesh_t::reserve_for_additional_elements(std::uint32_t n)
     reserve_for_additional_halfedges(nh);
 }
 
-const std::vector<vertex_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<vertex_array_t>>) const
+const std::deque<vertex_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<vertex_array_t>>) const
 {
     return get_removed_vertices();
 }
 
-const std::vector<edge_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<edge_array_t>>) const
+const std::deque<edge_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<edge_array_t>>) const
 {
     return get_removed_edges();
 }
 
-const std::vector<halfedge_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<halfedge_array_t>>) const
+const std::deque<halfedge_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<halfedge_array_t>>) const
 {
     return get_removed_halfedges();
 }
 
-const std::vector<face_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<face_array_t>>) const
+const std::deque<face_descriptor_t>& hmesh_t::get_removed_elements(id_<array_iterator_t<face_array_t>>) const
 {
     return get_removed_faces();
 }
 
-const std::vector<vertex_descriptor_t>& hmesh_t::get_removed_vertices() const
+const std::deque<vertex_descriptor_t>& hmesh_t::get_removed_vertices() const
 {
     return m_vertices_removed;
 }
 
-const std::vector<edge_descriptor_t>& hmesh_t::get_removed_edges() const
+const std::deque<edge_descriptor_t>& hmesh_t::get_removed_edges() const
 {
     return m_edges_removed;
 }
 
-const std::vector<halfedge_descriptor_t>& hmesh_t::get_removed_halfedges() const
+const std::deque<halfedge_descriptor_t>& hmesh_t::get_removed_halfedges() const
 {
     return m_halfedges_removed;
 }
 
-const std::vector<face_descriptor_t>& hmesh_t::get_removed_faces() const
+const std::deque<face_descriptor_t>& hmesh_t::get_removed_faces() const
 {
     return m_faces_removed;
 }
@@ -1230,6 +1507,162 @@ const face_array_iterator_t hmesh_t::elements_begin_(id_<array_iterator_t<face_a
     return faces_begin(account_for_removed_elems);
 }
 
+polygon_soup_view_t::polygon_soup_view_t(const hmesh_t& sm, const hmesh_t& cm)
+    : m_sm(&sm)
+    , m_cm(&cm)
+    , m_sm_vertices((std::uint32_t)sm.number_of_internal_vertices())
+    , m_sm_halfedges((std::uint32_t)sm.number_of_internal_halfedges())
+    , m_sm_edges((std::uint32_t)sm.number_of_internal_edges())
+    , m_sm_faces((std::uint32_t)sm.number_of_internal_faces())
+    , m_cm_to_soup_edge(cm.number_of_internal_edges(), hmesh_t::null_edge())
+    , m_cm_to_soup_halfedge(cm.number_of_internal_halfedges(), hmesh_t::null_halfedge())
+{
+    MCUT_ASSERT(m_sm_halfedges == 2 * m_sm_edges);
+
+    m_soup_to_cm_edge.reserve(cm.number_of_edges());
+    m_soup_to_cm_halfedge.reserve(cm.number_of_halfedges());
+
+    // number the cut-mesh edges in the order that they are visited by "get_halfedges_around_face"
+    for (face_array_iterator_t f = cm.faces_begin(); f != cm.faces_end(); ++f) {
+        const descriptor_array_view_t<halfedge_descriptor_t> halfedges_around_face = cm.get_halfedges_around_face(*f);
+        const std::size_t n = halfedges_around_face.size();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const halfedge_descriptor_t h = halfedges_around_face[(i + 1) % n]; // rotated (see "get_halfedges_around_face")
+            const edge_descriptor_t e = cm.edge(h);
+
+            if (m_cm_to_soup_edge[e] != hmesh_t::null_edge()) {
+                continue; // already visited from a neighbouring face
+            }
+
+            const std::uint32_t soup_edge = m_sm_edges + (std::uint32_t)m_soup_to_cm_edge.size();
+            m_cm_to_soup_edge[e] = edge_descriptor_t(soup_edge);
+            m_soup_to_cm_edge.push_back(e);
+
+            // the halfedge of the face that first visits the edge is the edge's primary halfedge
+            const halfedge_descriptor_t opp = cm.opposite(h);
+            m_cm_to_soup_halfedge[h] = halfedge_descriptor_t(2 * soup_edge);
+            m_cm_to_soup_halfedge[opp] = halfedge_descriptor_t(2 * soup_edge + 1);
+            m_soup_to_cm_halfedge.push_back(h);
+            m_soup_to_cm_halfedge.push_back(opp);
+        }
+    }
+}
+
+vec3 polygon_soup_view_t::vertex(const vertex_descriptor_t& v) const
+{
+    return is_cut_mesh_element(v) ? m_cm->vertex(to_cut_mesh(v)) : m_sm->vertex(v);
+}
+
+vertex_descriptor_t polygon_soup_view_t::vertex(const edge_descriptor_t e, const int v) const
+{
+    return is_cut_mesh_element(e) ? from_cut_mesh(m_cm->vertex(to_cut_mesh(e), v)) : m_sm->vertex(e, v);
+}
+
+vertex_descriptor_t polygon_soup_view_t::source(const halfedge_descriptor_t& h) const
+{
+    return is_cut_mesh_element(h) ? from_cut_mesh(m_cm->source(to_cut_mesh(h))) : m_sm->source(h);
+}
+
+vertex_descriptor_t polygon_soup_view_t::target(const halfedge_descriptor_t& h) const
+{
+    return is_cut_mesh_element(h) ? from_cut_mesh(m_cm->target(to_cut_mesh(h))) : m_sm->target(h);
+}
+
+halfedge_descriptor_t polygon_soup_view_t::opposite(const halfedge_descriptor_t& h) const
+{
+    return is_cut_mesh_element(h) ? from_cut_mesh(m_cm->opposite(to_cut_mesh(h))) : m_sm->opposite(h);
+}
+
+edge_descriptor_t polygon_soup_view_t::edge(const halfedge_descriptor_t& h) const
+{
+    return is_cut_mesh_element(h) ? from_cut_mesh(m_cm->edge(to_cut_mesh(h))) : m_sm->edge(h);
+}
+
+face_descriptor_t polygon_soup_view_t::face(const halfedge_descriptor_t& h) const
+{
+    return is_cut_mesh_element(h) ? from_cut_mesh(m_cm->face(to_cut_mesh(h))) : m_sm->face(h);
+}
+
+halfedge_descriptor_t polygon_soup_view_t::halfedge(const edge_descriptor_t e, const int i) const
+{
+    return is_cut_mesh_element(e) ? from_cut_mesh(m_cm->halfedge(to_cut_mesh(e), i)) : m_sm->halfedge(e, i);
+}
+
+halfedge_descriptor_t polygon_soup_view_t::halfedge(const vertex_descriptor_t s, const vertex_descriptor_t t, bool strict_check) const
+{
+    const bool s_in_cm = is_cut_mesh_element(s);
+
+    if (s_in_cm != is_cut_mesh_element(t)) {
+        return hmesh_t::null_halfedge(); // the input meshes do not share any edges
+    }
+
+    return s_in_cm ? from_cut_mesh(m_cm->halfedge(to_cut_mesh(s), to_cut_mesh(t), strict_check)) : m_sm->halfedge(s, t, strict_check);
+}
+
+bool polygon_soup_view_t::is_border(const halfedge_descriptor_t h) const
+{
+    return is_cut_mesh_element(h) ? m_cm->is_border(to_cut_mesh(h)) : m_sm->is_border(h);
+}
+
+bool polygon_soup_view_t::is_border(const edge_descriptor_t e) const
+{
+    return is_cut_mesh_element(e) ? m_cm->is_border(to_cut_mesh(e)) : m_sm->is_border(e);
+}
+
+polygon_soup_view_t::halfedge_array_view_t polygon_soup_view_t::get_halfedges_around_face(const face_descriptor_t f) const
+{
+    MCUT_ASSERT(f != hmesh_t::null_face());
+
+    if (is_cut_mesh_element(f)) {
+        // NOTE: the sequence starts at the second halfedge of the cut-mesh face, which is the first
+        // halfedge that a face gets when it is re-added from its vertex list (see "hmesh_t::add_face").
+        // The kernel's results depend on this (i.e. the order of the vertices used to compute e.g. face
+        // normals) and it is kept for consistency with when the polygon soup was built by copying.
+        return halfedge_array_view_t(m_cm->get_halfedges_around_face(to_cut_mesh(f)), m_cm_to_soup_halfedge.data(), 1);
+    }
+
+    return halfedge_array_view_t(m_sm->get_halfedges_around_face(f));
+}
+
+void polygon_soup_view_t::get_vertices_around_face(std::vector<vertex_descriptor_t>& vertex_descriptors, const face_descriptor_t f) const
+{
+    MCUT_ASSERT(f != hmesh_t::null_face());
+
+    if (is_cut_mesh_element(f)) {
+        m_cm->get_vertices_around_face(vertex_descriptors, to_cut_mesh(f), m_sm_vertices);
+        std::rotate(vertex_descriptors.begin(), vertex_descriptors.begin() + 1, vertex_descriptors.end()); // see "get_halfedges_around_face"
+    } else {
+        m_sm->get_vertices_around_face(vertex_descriptors, f);
+    }
+}
+
+std::vector<face_descriptor_t> polygon_soup_view_t::get_faces_around_face(const face_descriptor_t f, const halfedge_array_view_t* halfedges_around_face_) const
+{
+    MCUT_ASSERT(f != hmesh_t::null_face());
+
+    if (!is_cut_mesh_element(f)) {
+        return m_sm->get_faces_around_face(f, halfedges_around_face_ != nullptr ? &halfedges_around_face_->base() : nullptr);
+    }
+
+    const halfedge_array_view_t halfedges_on_face = (halfedges_around_face_ != nullptr) ? *halfedges_around_face_ : get_halfedges_around_face(f);
+    std::vector<face_descriptor_t> faces_around_face;
+
+    for (halfedge_array_view_t::const_iterator h = halfedges_on_face.cbegin(); h != halfedges_on_face.cend(); ++h) {
+        const halfedge_descriptor_t opp = opposite(*h);
+
+        if (opp != hmesh_t::null_halfedge()) {
+            const face_descriptor_t opp_face = face(opp);
+
+            if (opp_face != hmesh_t::null_face()) {
+                faces_around_face.push_back(opp_face);
+            }
+        }
+    }
+
+    return faces_around_face;
+}
+
 void write_off(const char* fpath, const hmesh_t& mesh)
 {
 
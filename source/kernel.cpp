@@ -29,9 +29,11 @@
 #include <unordered_map>
 
 #include "mcut/internal/bvh.h"
+#include "mcut/internal/disjoint_set.h"
 #include "mcut/internal/hmesh.h"
 #include "mcut/internal/kernel.h"
 #include "mcut/internal/math.h"
+#include "mcut/internal/radix_sort.h"
 #include "mcut/internal/utils.h"
 
 #ifndef LICENSE_PURCHASED
@@ -171,13 +173,13 @@ void dump_mesh(const hmesh_t& mesh, const char* fbasename)
 
     for (face_array_iterator_t face_iter = mesh.faces_begin(); face_iter != mesh.faces_end(); ++face_iter) {
 
-        const std::vector<halfedge_descriptor_t>& halfedges_around_face = mesh.get_halfedges_around_face(*face_iter);
+        const descriptor_array_view_t<halfedge_descriptor_t> halfedges_around_face = mesh.get_halfedges_around_face(*face_iter);
 
         // int num_halfedges = ;
         MCUT_ASSERT((int)halfedges_around_face.size());
 
         //
-        for (std::vector<halfedge_descriptor_t>::const_iterator h = halfedges_around_face.cbegin();
+        for (descriptor_array_view_t<halfedge_descriptor_t>::const_iterator h = halfedges_around_face.cbegin();
              h != halfedges_around_face.cend();
              ++h) {
         }
@@ -216,24 +218,18 @@ bool point_on_face_plane(const hmesh_t& m, const fd_t& f, const vec3& p, int& fv
 #endif
 
 /*
-    dfs(node u)
-        for each node v connected to u :
-            if v is not visited :
-                visited[v] = true
-                dfs(v)
-*/
-void dfs_cc(vd_t u, const hmesh_t& mesh, std::vector<int>& visited, int connected_component_id)
-{
-    std::vector<vd_t> verts = mesh.get_vertices_around_vertex(u);
-    for (std::vector<vd_t>::const_iterator v = verts.cbegin(); v != verts.cend(); ++v) {
-        if (SAFE_ACCESS(visited, *v) == -1) {
-            visited[*v] = connected_component_id;
-            dfs_cc(*v, mesh, visited, connected_component_id);
-        }
-    }
-}
+    Labels the connected components of "mesh" with a union-find over its edges.
 
+    The unions (and then the look-up of the root of each vertex) are done in parallel in the
+    multi-threaded build. The root of a set is always its smallest vertex (see disjoint_set_t), and
+    the components are numbered in the order of their roots, so a component's id is the same as the
+    one it would get from a breadth-first search that starts at each unvisited vertex in order.
+    Isolated vertices are components without faces.
+*/
 int find_connected_components(
+#if defined(MCUT_MULTI_THREADED)
+    thread_pool& scheduler,
+#endif
     std::vector<int>& fccmap,
     const hmesh_t& mesh,
     std::vector<int>& cc_to_vertex_count,
@@ -243,74 +239,99 @@ int find_connected_components(
     MCUT_ASSERT(mesh.number_of_edges() >= 3);
     MCUT_ASSERT(mesh.number_of_faces() >= 1);
 
-    /*
-        for each node u:
-            if u is not visited :
-                visited[u] = true
-                connected_component += 1
-                dfs(u)
-    */
-    std::vector<int> visited(mesh.number_of_vertices(), -1); // if vertex does not exist, then its not visited
-    int connected_component_id = -1;
-    std::vector<bool> queued(mesh.number_of_vertices(), false);
-    std::queue<vd_t> queue; // .. to discover all vertices of current connected component
+    disjoint_set_t vertex_sets((std::uint32_t)mesh.number_of_internal_vertices());
 
-    for (vertex_array_iterator_t u = mesh.vertices_begin(); u != mesh.vertices_end(); ++u) {
-        if (visited[*u] == -1) {
-            connected_component_id += 1;
-            visited[*u] = connected_component_id;
-            queued[*u] = true;
+    // merge the two vertices of each edge
+    auto fn_unite_edge_vertices = [&](edge_array_iterator_t block_start_, edge_array_iterator_t block_end_) -> bool {
+        for (edge_array_iterator_t e = block_start_; e != block_end_; ++e) {
+            vertex_sets.unite((std::uint32_t)mesh.vertex(*e, 0), (std::uint32_t)mesh.vertex(*e, 1));
+        }
+        return true;
+    };
 
-            cc_to_vertex_count.push_back(1); // each discovered cc has at least one vertex
+    // root of each vertex (i.e. its smallest connected vertex)
+    std::vector<std::uint32_t> vertex_to_root(mesh.number_of_internal_vertices());
 
-            std::vector<vd_t> vertices_of_u = mesh.get_vertices_around_vertex(*u);
-            
-            
-            for (int i = 0; i < (int)vertices_of_u.size(); ++i) {
-                vd_t vou = vertices_of_u[i];
-                queue.push(vou);
-                queued[vou] = true;
-            }
+    auto fn_find_vertex_roots = [&](vertex_array_iterator_t block_start_, vertex_array_iterator_t block_end_) -> bool {
+        for (vertex_array_iterator_t v = block_start_; v != block_end_; ++v) {
+            vertex_to_root[*v] = vertex_sets.find((std::uint32_t)*v);
+        }
+        return true;
+    };
 
-            while (!queue.empty()) {
-                vd_t v = queue.front(); // current
-                queue.pop();
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
 
-                if (visited[v] == -1) // v not yet associated with a cc
-                {
-                    visited[v] = connected_component_id;
-                    cc_to_vertex_count[connected_component_id] += 1;
-                    std::vector<vd_t> vertices_of_v = mesh.get_vertices_around_vertex(v);
-
-                    for (int i = 0; i < (int)vertices_of_v.size(); ++i) {
-                        vd_t vov = vertices_of_v[i];
-                        if (visited[vov] == -1 || queued[vov] == false) {
-                            queue.push(vertices_of_v[i]);
-                            queued[vov] = true;
-                        }
-                    }
-                }
-            }
+        parallel_fork_and_join(
+            scheduler,
+            mesh.edges_begin(),
+            mesh.edges_end(),
+            (1 << 12),
+            fn_unite_edge_vertices,
+            _1, // out
+            futures);
+
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
+        }
+    }
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
+
+        parallel_fork_and_join(
+            scheduler,
+            mesh.vertices_begin(),
+            mesh.vertices_end(),
+            (1 << 12),
+            fn_find_vertex_roots,
+            _1, // out
+            futures);
 
-            // dfs_cc(*u, mesh, visited, connected_component_id);
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
         }
     }
+#else
+    fn_unite_edge_vertices(mesh.edges_begin(), mesh.edges_end());
+    fn_find_vertex_roots(mesh.vertices_begin(), mesh.vertices_end());
+#endif
 
-    fccmap.clear();
-    fccmap.resize(mesh.number_of_faces());
-    int num_connected_components = (connected_component_id + 1); // number of CCs
-    cc_to_face_count.resize(num_connected_components);
-    for (int i = 0; i < (int)cc_to_face_count.size(); ++i) {
-        cc_to_face_count[i] = 0;
+    // number the components in the order of their roots. A vertex is never visited
+    // before its root, since the root is the smallest vertex of the component.
+    std::vector<int> vertex_to_cc(mesh.number_of_internal_vertices(), -1);
+    int num_connected_components = 0;
+
+    for (vertex_array_iterator_t v = mesh.vertices_begin(); v != mesh.vertices_end(); ++v) {
+        const std::uint32_t root = vertex_to_root[*v];
+
+        if (root == (std::uint32_t)*v) {
+            vertex_to_cc[*v] = num_connected_components++;
+            cc_to_vertex_count.push_back(0);
+        }
+
+        const int cc_id = vertex_to_cc[root];
+        MCUT_ASSERT(cc_id != -1);
+        vertex_to_cc[*v] = cc_id;
+        cc_to_vertex_count[cc_id] += 1;
     }
 
+    fccmap.clear();
+    fccmap.resize(mesh.number_of_internal_faces());
+    cc_to_face_count.assign(num_connected_components, 0);
+
     // map each face to a connected component
     for (face_array_iterator_t f = mesh.faces_begin(); f != mesh.faces_end(); ++f) {
-        const std::vector<vertex_descriptor_t> vertices = mesh.get_vertices_around_face(*f);
-
-        int face_cc_id = SAFE_ACCESS(visited, vertices.front());
+        const vd_t first_vertex = mesh.target(mesh.get_halfedges_around_face(*f).front());
 
         // all vertices belong to the same conn comp
+        const int face_cc_id = SAFE_ACCESS(vertex_to_cc, first_vertex);
         fccmap[*f] = face_cc_id;
 
         cc_to_face_count[face_cc_id] += 1;
@@ -327,6 +348,49 @@ struct connected_component_info_t {
     output_mesh_data_maps_t data_maps;
 };
 
+// The pairs of polygon-soup edges and faces that are tested for intersection, in compressed sparse row
+// form: "edges" is sorted and the (sorted) faces tested against "edges[i]" are those in the range
+// [faces[offsets[i]], faces[offsets[i + 1]]).
+struct edge_face_pairs_t {
+    std::vector<ed_t> edges;
+    std::vector<std::uint32_t> offsets; // one more than the number of edges
+    std::vector<fd_t> faces;
+
+    std::size_t size() const
+    {
+        return edges.size();
+    }
+
+    array_view_t<fd_t> faces_of(const std::size_t i) const
+    {
+        return array_view_t<fd_t>(faces.data() + SAFE_ACCESS(offsets, i), faces.data() + SAFE_ACCESS(offsets, i + 1));
+    }
+};
+
+// Returns iterators to the elements of an unordered map in the order in which they are visited, which is
+// the order of the hash table unless "sort_by_key" is true. The order of a hash table depends on the
+// standard library implementation, so loops whose order decides how new elements are numbered use this
+// function to visit the elements in key order when deterministic output is requested.
+template <typename MapType>
+std::vector<typename MapType::const_iterator> get_map_visit_order(const MapType& map, const bool sort_by_key)
+{
+    std::vector<typename MapType::const_iterator> visit_order;
+    visit_order.reserve(map.size());
+
+    for (typename MapType::const_iterator it = map.cbegin(); it != map.cend(); ++it) {
+        visit_order.push_back(it);
+    }
+
+    if (sort_by_key) {
+        std::sort(visit_order.begin(), visit_order.end(),
+            [](const typename MapType::const_iterator& a, const typename MapType::const_iterator& b) {
+                return a->first < b->first;
+            });
+    }
+
+    return visit_order;
+}
+
 // a seam vertex is simply an intersection point, including a duplicated instance if it exists as determined by the
 // parameters "ps_num_vertices" and "m1_num_vertices_after_srcmesh_partitioning"
 void mark_seam_vertices(
@@ -351,7 +415,9 @@ hmesh_t extract_connected_components(
 #endif
     // key = cc-id; value = list of cc copies each differing by one newly stitched polygon
     std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>& connected_components,
-    const hmesh_t& in,
+    // taken by value, so that a caller which no longer needs the mesh can move it in (instead of
+    // having it copied) e.g. to keep the memory used by the last extraction of a dispatch call down
+    hmesh_t in,
     const int traced_polygons_base_offset,
     const std::vector<std::vector<hd_t>>& mX_traced_polygons, // "m0" or "m1" (dependent on function-call location)
     const std::vector<int>& sm_polygons_below_cs,
@@ -361,18 +427,12 @@ hmesh_t extract_connected_components(
     // const std::map<vd_t /*"m1" ovtx in sm*/, vd_t /*"m0" ovtx in sm*/> &m1_to_m0_sm_ovtx_colored,
     const std::vector<vd_t /*"m1" ovtx in sm*/>& m1_to_m0_sm_ovtx_colored,
     const std::unordered_map<vd_t /*"m1" ovtx*/, vd_t /*"m0" ovtx in cm*/>& m1_to_m0_cm_ovtx_colored,
-    /*const*/ std::unordered_map<int /*"m0" face idx*/, int /*"m1" face idx*/>& m1_to_m0_face_colored,
+    /*const*/ arena_unordered_map_t<int /*"m0" face idx*/, int /*"m1" face idx*/>& m1_to_m0_face_colored,
     // const std::map<vd_t /*"m0" ovtx*/, vd_t /*"ps" ovtx*/> &m0_to_ps_vtx,
     const std::vector<vd_t>& m0_to_ps_vtx,
-    /*const*/ std::unordered_map<int /*"m0" face idx*/, fd_t /*"ps" face*/>& m0_to_ps_face,
-    // const std::map<vd_t /*"sm" vtx*/, vd_t /*"ps" vtx*/> &ps_to_sm_vtx,
-    const std::vector<vd_t>& ps_to_sm_vtx,
-    // const std::map<fd_t /*"sm" face*/, fd_t /*"ps" face*/> &ps_to_sm_face,
-    const std::vector<fd_t>& ps_to_sm_face,
-    // const std::map<vd_t /*"cm" vtx*/, vd_t /*"ps" vtx*/> &ps_to_cm_vtx,
-    const std::vector<vd_t>& ps_to_cm_vtx,
-    // const std::map<fd_t /*"cs" face*/, fd_t /*"ps" face*/> &ps_to_cm_face,
-    const std::vector<fd_t>& ps_to_cm_face,
+    /*const*/ arena_unordered_map_t<int /*"m0" face idx*/, fd_t /*"ps" face*/>& m0_to_ps_face,
+    // maps "ps" vertices and faces to the source-mesh or cut-mesh
+    const polygon_soup_view_t& ps,
     const int sm_vtx_cnt,
     const int sm_face_count,
     bool popuplate_vertex_maps,
@@ -383,7 +443,7 @@ hmesh_t extract_connected_components(
 {
 
     // the auxilliary halfedge mesh containing vertices and edges referenced by the traced polygons
-    hmesh_t mesh = in; // copy
+    hmesh_t mesh = std::move(in);
     mesh.reserve_for_additional_elements((std::uint32_t)mX_traced_polygons.size() / 2);
 
     ///////////////////////////////////////////////////////////////////////////
@@ -442,6 +502,7 @@ hmesh_t extract_connected_components(
                  ++face_iter) {
                 const fd_t f = mesh.add_face(*face_iter);
                 MCUT_ASSERT(f != hmesh_t::null_face());
+                (void)f;
             }
         };
 
@@ -490,6 +551,7 @@ hmesh_t extract_connected_components(
         // rules probably because we are refering to a halfedge
         // and its opposite in one polygon
         MCUT_ASSERT(f != hmesh_t::null_face());
+        (void)f;
     }
 #endif
     TIMESTACK_POP();
@@ -498,437 +560,211 @@ hmesh_t extract_connected_components(
     // find connected components in "mesh"
     ///////////////////////////////////////////////////////////////////////////
 
-    // connected components
-    std::map<std::size_t, hmesh_t> ccID_to_mesh;
-    // location of each connected component w.r.t cut-mesh (above | below | undefined)
-    std::map<std::size_t, sm_frag_location_t> ccID_to_cs_descriptor;
-    // for each component, we have a map which relates the vertex descriptors (indices) in the
-    // auxilliary halfedge data structure "mesh" to the (local) vertex descriptors in
-    // the connected-component.
-    //
-    // the "X" in "...mX_..." stands for "0" or "1" depending on where the current function is called from!
-    // Before "m1" is created in "dispatch", X = "0". Afterwards, X == "1" to signify the fact that the
-    // input paramater called "in" (in this function) represents "m0" or "m1"
-    std::map<std::size_t, std::unordered_map<vd_t, vd_t>> ccID_to_mX_to_cc_vertex;
-    // std::map<std::size_t, std::unordered_map<vd_t, vd_t>> ccID_to_cc_to_mX_vertex;
-    std::map<std::size_t, std::vector<vd_t>> ccID_to_cc_to_mX_vertex;
-    // the vertex descriptors [in the cc] which are seam vertices!
-    std::map<std::size_t, std::vector<vd_t>> cc_to_seam_vertices;
     // here we create a map to tag each polygon in "mesh" with the connected component it belongs to.
     std::vector<int> fccmap;
 
     TIMESTACK_PUSH("Extract CC: find connected components");
     std::vector<int> cc_to_vertex_count;
     std::vector<int> cc_to_face_count;
-    find_connected_components(fccmap, mesh, cc_to_vertex_count, cc_to_face_count);
-    TIMESTACK_POP();
-
-    //
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Map vertex descriptors to each connected component
-    ///////////////////////////////////////////////////////////////////////////
-
-    // NOTE: even if the number of connected components is one, we proceed anyway
-    // because each connected connected excludes unused vertices in "mesh"
-
-    TIMESTACK_PUSH("Extract CC: Map vertices");
-
-    // for each face in the auxilliary mesh (i.e. traced polygon)
-    for (face_array_iterator_t face_iter = mesh.faces_begin(); face_iter != mesh.faces_end(); ++face_iter) {
-
-        face_descriptor_t fd = *face_iter;
-        const int face_cc_id = SAFE_ACCESS(fccmap, fd); // get connected component of face
-
-        std::map<std::size_t, hmesh_t>::iterator ccID_to_mesh_fiter = ccID_to_mesh.find(face_cc_id);
-        if (ccID_to_mesh_fiter == ccID_to_mesh.end()) {
-            // create new mesh to store connected component
-            std::pair<std::map<std::size_t, hmesh_t>::iterator, bool> p = ccID_to_mesh.insert(std::make_pair(face_cc_id, hmesh_t()));
-            ccID_to_mesh_fiter = p.first;
-        }
+    const int num_connected_components = find_connected_components(
+#if defined(MCUT_MULTI_THREADED)
+        scheduler,
+#endif
+        fccmap, mesh, cc_to_vertex_count, cc_to_face_count);
 
-        hmesh_t& cc_mesh = ccID_to_mesh_fiter->second;
+    // the faces of each connected component (in the order of "mesh") in compressed sparse row form i.e.
+    // the faces of component "i" are in the range [cc_to_faces[cc_to_faces_offsets[i]], cc_to_faces[cc_to_faces_offsets[i + 1]])
+    std::vector<std::uint32_t> cc_to_faces_offsets(num_connected_components + 1, 0);
+    // the connected components which have faces (isolated vertices in "mesh" are components without faces)
+    std::vector<int> cc_ids;
 
-        std::map<std::size_t, std::unordered_map<vd_t, vd_t>>::iterator ccID_to_mX_to_cc_vertex_fiter = ccID_to_mX_to_cc_vertex.find(face_cc_id);
+    for (int i = 0; i < num_connected_components; ++i) {
+        cc_to_faces_offsets[i + 1] = cc_to_faces_offsets[i] + SAFE_ACCESS(cc_to_face_count, i);
 
-        if (ccID_to_mX_to_cc_vertex_fiter == ccID_to_mX_to_cc_vertex.end()) {
-            // create new component descriptor map
-            std::pair<std::map<std::size_t, std::unordered_map<vd_t, vd_t>>::iterator, bool> p = ccID_to_mX_to_cc_vertex.insert(std::make_pair(face_cc_id, std::unordered_map<vd_t, vd_t>()));
-            ccID_to_mX_to_cc_vertex_fiter = p.first;
+        if (SAFE_ACCESS(cc_to_face_count, i) > 0) {
+            cc_ids.push_back(i);
         }
+    }
 
-        std::unordered_map<vd_t, vd_t>& mX_to_cc_vertex = ccID_to_mX_to_cc_vertex_fiter->second;
+    std::vector<fd_t> cc_to_faces(cc_to_faces_offsets.back());
 
-        std::map<std::size_t, std::vector<vd_t>>::iterator ccID_to_cc_to_mX_vertex_fiter = ccID_to_cc_to_mX_vertex.find(face_cc_id);
+    {
+        std::vector<std::uint32_t> cc_to_next_face(cc_to_faces_offsets.cbegin(), cc_to_faces_offsets.cend() - 1);
 
-        if (ccID_to_cc_to_mX_vertex_fiter == ccID_to_cc_to_mX_vertex.end()) {
-            std::pair<std::map<std::size_t, std::vector<vd_t>>::iterator, bool> p = ccID_to_cc_to_mX_vertex.insert(std::make_pair(face_cc_id, std::vector<vd_t>()));
-            ccID_to_cc_to_mX_vertex_fiter = p.first;
+        for (face_array_iterator_t face_iter = mesh.faces_begin(); face_iter != mesh.faces_end(); ++face_iter) {
+            const int face_cc_id = SAFE_ACCESS(fccmap, *face_iter);
+            cc_to_faces[cc_to_next_face[face_cc_id]++] = *face_iter;
         }
+    }
 
-        std::vector<vd_t>& cc_to_mX_vertex = ccID_to_cc_to_mX_vertex_fiter->second;
-
-        std::map<std::size_t, std::vector<vd_t>>::iterator cc_to_seam_vertices_fiter = cc_to_seam_vertices.find(face_cc_id);
-
-        if (cc_to_seam_vertices_fiter == cc_to_seam_vertices.end()) {
-            std::pair<std::map<std::size_t, std::vector<vd_t>>::iterator, bool> p = cc_to_seam_vertices.insert(std::make_pair(face_cc_id, std::vector<vd_t>()));
-            cc_to_seam_vertices_fiter = p.first;
-        }
+    TIMESTACK_POP();
 
-        std::vector<vd_t>& cc_seam_vertices = cc_to_seam_vertices_fiter->second;
+    ///////////////////////////////////////////////////////////////////////////
+    // Build each connected component (and its data maps) as an independent task
+    ///////////////////////////////////////////////////////////////////////////
 
-        //
-        // Determine the location of the connected component w.r.t the cut-mesh (above/below/undefined)
-        //
+    // NOTE: even if the number of connected components is one, we proceed anyway
+    // because each connected connected excludes unused vertices in "mesh"
 
-        // check if the current face is already marked as "below" (w.r.t the cut-mesh).
-        const bool cc_is_below_cs = std::binary_search(sm_polygons_below_cs.cbegin(), sm_polygons_below_cs.cend(), static_cast<int>(fd));
-
-        if (cc_is_below_cs) {
-            // try to save the fact that the current connected component is "below"
-            std::pair<std::map<std::size_t, sm_frag_location_t>::iterator, bool> p = ccID_to_cs_descriptor.insert(std::make_pair(face_cc_id, sm_frag_location_t::BELOW));
-            // if 1) insertion did not take place (connected component already registered), and
-            // 2) the existing connected component at that entry is marked as "above":
-            //  --> partial cut: thus, the notion "above"/"below" is undefined
-            if (p.second == false && p.first->second == sm_frag_location_t::ABOVE) {
-                // polygon classed as both above and below cs
-                // this is because the connected component contains polygons which are both "above"
-                // and "below" the cutting surface (we have a partial cut)
-                p.first->second = sm_frag_location_t::UNDEFINED;
-            }
-        }
+    TIMESTACK_PUSH("Extract CC: build connected components");
 
-        // check if connected component is marked as "above"
-        const bool cc_is_above_cs = std::binary_search(sm_polygons_above_cs.cbegin(), sm_polygons_above_cs.cend(), static_cast<int>(fd));
-
-        if (cc_is_above_cs) {
-            // try to save the fact that the current connected component is tagged "above"
-            std::pair<std::map<std::size_t, sm_frag_location_t>::iterator, bool> p = ccID_to_cs_descriptor.insert(std::make_pair(face_cc_id, sm_frag_location_t::ABOVE));
-            // if 1) insertion did not take place (connected component is already registered), and
-            // 2) the existing connected component at that entry is marked as "below":
-            //--> partial cut: connected component has polygon whch are both "above" and "below"
-            if (p.second == false && p.first->second == sm_frag_location_t::BELOW) {
-                p.first->second = sm_frag_location_t::UNDEFINED; // polygon classed as both above and below cs
-            }
-        }
+    // maps the vertex descriptors in the auxilliary halfedge data structure "mesh" to the (local)
+    // vertex descriptors in the connected-component. Each vertex belongs to exactly one component,
+    // so the tasks write to disjoint elements.
+    //
+    // the "X" in "...mX_..." stands for "0" or "1" depending on where the current function is called from!
+    // Before "m1" is created in "dispatch", X = "0". Afterwards, X == "1" to signify the fact that the
+    // input paramater called "in" (in this function) represents "m0" or "m1"
+    std::vector<vd_t> mX_to_cc_vertex(mesh.number_of_internal_vertices(), hmesh_t::null_vertex());
 
-        //
-        // We now map the vertices of the current face from the auxilliary data
-        // structure "mesh" to the (local) connected-component
-        //
+    struct extracted_connected_component_t {
+        bool save = false; // false if the user does not want the component or it is a duplicate
+        hmesh_t cc;
+        connected_component_info_t ccinfo;
+    };
 
-        // for each vertex around the current face
-        const std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(fd);
+    std::vector<extracted_connected_component_t> ccID_to_extracted_cc(num_connected_components);
 
-        for (std::vector<vertex_descriptor_t>::const_iterator face_vertex_iter = vertices_around_face.cbegin();
-             face_vertex_iter != vertices_around_face.cend();
-             ++face_vertex_iter) {
+    auto fn_extract_connected_components = [&](std::vector<int>::const_iterator block_start_, std::vector<int>::const_iterator block_end_) -> bool {
+        std::vector<vd_t> vertices_around_face; // reused across iterations
+        std::vector<vd_t> remapped_face; // using remapped cc descriptors
 
-            MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(face_cc_id) != ccID_to_mX_to_cc_vertex.cend());
+        for (std::vector<int>::const_iterator cc_id_iter = block_start_; cc_id_iter != block_end_; ++cc_id_iter) {
+            const int cc_id = *cc_id_iter;
+            const array_view_t<fd_t> cc_faces(
+                cc_to_faces.data() + SAFE_ACCESS(cc_to_faces_offsets, cc_id),
+                cc_to_faces.data() + SAFE_ACCESS(cc_to_faces_offsets, cc_id + 1));
 
-            // if vertex is not already mapped from "mesh" to connected component
-            if (mX_to_cc_vertex.find(*face_vertex_iter) == mX_to_cc_vertex.end()) {
+            //
+            // Determine the location of the connected component w.r.t the cut-mesh (above/below/undefined)
+            //
 
-                // MCUT_ASSERT(ccID_to_mesh.find(face_cc_id) != ccID_to_mesh.cend());
+            bool location_is_known = false; // true if any polygon of the component is marked as "above" or "below"
+            sm_frag_location_t location = sm_frag_location_t::UNDEFINED;
 
-                // copy vertex from auxilliary data structure "mesh", add it into connected component mesh,
-                // and save the vertex's descriptor in the conected component mesh.
-                const vd_t cc_descriptor = cc_mesh.add_vertex(mesh.vertex(*face_vertex_iter));
+            for (array_view_t<fd_t>::const_iterator face_iter = cc_faces.cbegin(); face_iter != cc_faces.cend(); ++face_iter) {
+                const fd_t fd = *face_iter;
+
+                // check if the current face is marked as "below" (w.r.t the cut-mesh).
+                if (std::binary_search(sm_polygons_below_cs.cbegin(), sm_polygons_below_cs.cend(), static_cast<int>(fd))) {
+                    if (!location_is_known) {
+                        location = sm_frag_location_t::BELOW;
+                        location_is_known = true;
+                    } else if (location == sm_frag_location_t::ABOVE) {
+                        // the connected component contains polygons which are both "above"
+                        // and "below" the cutting surface (we have a partial cut)
+                        location = sm_frag_location_t::UNDEFINED;
+                    }
+                }
 
-                // map vertex
-                mX_to_cc_vertex.insert(std::make_pair(*face_vertex_iter, cc_descriptor));
-                if (popuplate_vertex_maps) {
-                    // SAFE_ACCESS(ccID_to_cc_to_mX_vertex, face_cc_id).insert(std::make_pair(cc_descriptor, *face_vertex_iter));
-                    cc_to_mX_vertex.push_back(*face_vertex_iter);
+                // check if the current face is marked as "above"
+                if (std::binary_search(sm_polygons_above_cs.cbegin(), sm_polygons_above_cs.cend(), static_cast<int>(fd))) {
+                    if (!location_is_known) {
+                        location = sm_frag_location_t::ABOVE;
+                        location_is_known = true;
+                    } else if (location == sm_frag_location_t::BELOW) {
+                        location = sm_frag_location_t::UNDEFINED; // polygon classed as both above and below cs
+                    }
                 }
-                // check if we need to save vertex as being a seam vertex
-                // std::vector<bool>::const_iterator fiter = mesh_vertex_to_seam_flag.find(*face_vertex_iter);
-                bool is_seam_vertex = (size_t)(*face_vertex_iter) < mesh_vertex_to_seam_flag.size() && SAFE_ACCESS(mesh_vertex_to_seam_flag, *face_vertex_iter); //(size_t)(*face_vertex_iter) < mesh_vertex_to_seam_flag.size(); //fiter != mesh_vertex_to_seam_flag.cend() && fiter->second == true;
-                if (is_seam_vertex) {
-                    cc_seam_vertices.push_back(cc_descriptor);
+
+                if (location_is_known && location == sm_frag_location_t::UNDEFINED) {
+                    break; // the location cannot change anymore
                 }
             }
-        }
-    } // for (face_array_iterator_t face_iter = mesh.faces_begin(); face_iter != mesh.faces_end(); ++face_iter)
-
-    TIMESTACK_POP();
-
-    // bool extractingSeams = (m1_num_vertices_after_srcmesh_partitioning == -1);
-
-    // stores a flag per connected component indicating whether we should
-    // keep this CC or throw it away, as per user flags.
-    std::map<size_t, bool> ccID_to_keepFlag;
-    for (std::map<size_t, hmesh_t>::const_iterator it = ccID_to_mesh.cbegin(); it != ccID_to_mesh.cend(); ++it) {
-        int ccID = (int)it->first;
-        std::map<std::size_t, sm_frag_location_t>::iterator fiter = ccID_to_cs_descriptor.find(ccID);
-        const bool isSeam = (fiter == ccID_to_cs_descriptor.cend()); // Seams have no notion of "location"
-        ccID_to_keepFlag[ccID] = isSeam || ((keep_fragments_above_cutmesh && fiter->second == sm_frag_location_t::ABOVE) || //
-                                     (keep_fragments_below_cutmesh && fiter->second == sm_frag_location_t::BELOW) || //
-                                     (keep_fragments_partially_cut && fiter->second == sm_frag_location_t::UNDEFINED));
-    }
 
-    ///////////////////////////////////////////////////////////////////////////
-    // TODO: shift the logic to add vertices into CC to here (like for face below)
-    ///////////////////////////////////////////////////////////////////////////
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Insert faces into connected components using mapped vertex descriptors
-    ///////////////////////////////////////////////////////////////////////////
-
-    std::map<size_t, std::vector<fd_t>> ccID_to_cc_to_mX_face;
-    for (std::map<size_t, hmesh_t>::const_iterator it = ccID_to_mesh.cbegin(); it != ccID_to_mesh.cend(); ++it) {
-        bool userWantsCC = SAFE_ACCESS(ccID_to_keepFlag, it->first);
-
-        if (!userWantsCC) {
-            continue;
-        }
+            // check whether we should keep this CC or throw it away, as per user flags.
+            const bool isSeam = !location_is_known; // Seams have no notion of "location"
+            const bool userWantsCC = isSeam || ((keep_fragments_above_cutmesh && location == sm_frag_location_t::ABOVE) || //
+                                                   (keep_fragments_below_cutmesh && location == sm_frag_location_t::BELOW) || //
+                                                   (keep_fragments_partially_cut && location == sm_frag_location_t::UNDEFINED));
 
-        ccID_to_cc_to_mX_face[it->first] = std::vector<fd_t>();
-    }
+            if (!userWantsCC) {
+                continue;
+            }
 
-    TIMESTACK_PUSH("Extract CC: Map faces");
-#if defined(MCUT_MULTI_THREADED)
-    {
-        typedef std::tuple<
-            std::vector<std::vector<vd_t>>, // remapped_faces, // using remapped cc descriptors
-            std::vector<int>, // the cc id of each remapped
-            std::vector<fd_t> // the mX mesh i.e. the halfedge data structure we call "mesh" that is remapped
-            >
-            OutputStorageTypesTuple;
-        typedef face_array_iterator_t InputStorageIteratorType;
+            // The boolean is needed to prevent saving duplicate connected components into the vector "connected_components[cc_id]".
+            // This can happen because the current function is called for each new cut-mesh polygon that is stitched, during the
+            // polygon stitching phases. In the other times when the current function is called, we are guarranteed that
+            // "connected_components[cc_id]" is empty.
+            //
+            // The above has the implication that the newly stitched polygon (during the stitching phase) is added to just [one] of the
+            // discovered connected components (which are of a particular color tag), thus leaving the other connected components to be
+            // discovered as having exactly the same number of polygons as before since no new polygon has been added to them.
+            // So to prevent this connected component dupliction issue, a connected component is only added into "connected_components[cc_id]"
+            // if the following hold:
+            // 1) "connected_components[cc_id]" is empty (making the added connected component new and unique)
+            // 2) the most-recent connected component instance at "connected_components[cc_id].back()" has less faces (in which case, always differing by one)
+            //    than the new connected component we wish to add i.e. "cc"
+            //
+            // NOTE: "connected_components" is only read by the tasks, and it is updated once all of them are done
+            auto cc_fiter = connected_components.find(cc_id);
+            bool proceed_to_save_mesh = cc_fiter == connected_components.cend() || cc_fiter->second.back().first.number_of_faces() != (int)cc_faces.size();
 
-        auto fn_compute_remapped_cc_faces = [&](InputStorageIteratorType block_start_, InputStorageIteratorType block_end_) -> OutputStorageTypesTuple {
-            OutputStorageTypesTuple local_output;
-            std::vector<std::vector<vd_t>>& remapped_faces_LOCAL = std::get<0>(local_output);
-            std::vector<int>& local_remapped_face_to_ccID = std::get<1>(local_output);
-            std::vector<fd_t>& local_remapped_face_to_mX_face = std::get<2>(local_output);
-            for (face_array_iterator_t face_iter = block_start_; face_iter != block_end_; ++face_iter) {
-                face_descriptor_t fd = *face_iter;
-                const size_t cc_id = fccmap[fd]; // the connected component which contains the current face
+            if (!proceed_to_save_mesh) {
+                continue;
+            }
 
-                bool userWantsCC = SAFE_ACCESS(ccID_to_keepFlag, cc_id);
+            extracted_connected_component_t& extracted_cc = SAFE_ACCESS(ccID_to_extracted_cc, cc_id);
+            hmesh_t& cc = extracted_cc.cc;
+            connected_component_info_t& ccinfo = extracted_cc.ccinfo;
 
-                if (!userWantsCC) {
-                    continue;
-                }
+            if (!sm_polygons_below_cs.empty() && !sm_polygons_above_cs.empty()) {
+                MCUT_ASSERT(location_is_known);
+                ccinfo.location = location;
+            }
 
-                remapped_faces_LOCAL.push_back(std::vector<vd_t>());
-                std::vector<vd_t>& remapped_face = remapped_faces_LOCAL.back(); // using remapped cc descriptors
-                local_remapped_face_to_ccID.push_back((int)cc_id);
-                local_remapped_face_to_mX_face.push_back(fd);
+            cc.reserve_for_additional_vertices((std::uint32_t)SAFE_ACCESS(cc_to_vertex_count, cc_id));
+            cc.reserve_for_additional_faces((std::uint32_t)cc_faces.size());
 
-                // std::map<size_t, std::vector<fd_t>>::iterator ccID_to_cc_to_mX_face_fiter = ccID_to_cc_to_mX_face.find(cc_id);
+            // maps the vertex and face descriptors in the connected-component to those in "mesh"
+            std::vector<vd_t> cc_to_mX_vertex;
+            std::vector<fd_t> cc_to_mX_face;
 
-                MCUT_ASSERT(ccID_to_cc_to_mX_face.find(cc_id) != ccID_to_cc_to_mX_face.cend());
-                // std::vector<fd_t> &cc_to_mX_face = ccID_to_cc_to_mX_face_fiter->second;
+            //
+            // Copy the vertices (in the order that they are first referenced) and faces of the
+            // component from the auxilliary data structure "mesh" into the connected component mesh
+            //
 
-                // std::map<std::size_t, std::unordered_map<vd_t, vd_t>>::iterator ccID_to_mX_to_cc_vertex_fiter = ;
-                MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(cc_id) != ccID_to_mX_to_cc_vertex.end());
-                std::unordered_map<vd_t, vd_t>& mX_to_cc_vertex = SAFE_ACCESS(ccID_to_mX_to_cc_vertex, cc_id);
+            for (array_view_t<fd_t>::const_iterator face_iter = cc_faces.cbegin(); face_iter != cc_faces.cend(); ++face_iter) {
+                const fd_t fd = *face_iter;
 
-                // for each vertex around face
-                const std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(fd);
+                mesh.get_vertices_around_face(vertices_around_face, fd);
+                remapped_face.clear();
 
-                for (std::vector<vertex_descriptor_t>::const_iterator face_vertex_iter = vertices_around_face.cbegin();
+                for (std::vector<vd_t>::const_iterator face_vertex_iter = vertices_around_face.cbegin();
                      face_vertex_iter != vertices_around_face.cend();
                      ++face_vertex_iter) {
-                    MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(cc_id) != ccID_to_mX_to_cc_vertex.cend());
 
-                    /*const*/ std::unordered_map<vd_t, vd_t>& vertex_map = mX_to_cc_vertex;
-                    const vd_t m1_sm_descr = *face_vertex_iter;
+                    vd_t& cc_descriptor = SAFE_ACCESS(mX_to_cc_vertex, *face_vertex_iter);
 
-                    MCUT_ASSERT(vertex_map.find(m1_sm_descr) != vertex_map.cend());
+                    // if vertex is not already mapped from "mesh" to connected component
+                    if (cc_descriptor == hmesh_t::null_vertex()) {
+                        cc_descriptor = cc.add_vertex(mesh.vertex(*face_vertex_iter));
 
-                    const vd_t cc_descr = SAFE_ACCESS(vertex_map, m1_sm_descr);
-                    remapped_face.push_back(cc_descr);
-                }
-            }
-
-            return local_output;
-        };
+                        if (popuplate_vertex_maps) {
+                            cc_to_mX_vertex.push_back(*face_vertex_iter);
+                        }
 
-        std::vector<std::future<OutputStorageTypesTuple>> futures;
-        OutputStorageTypesTuple partial_res;
+                        // check if we need to save vertex as being a seam vertex
+                        bool is_seam_vertex = (size_t)(*face_vertex_iter) < mesh_vertex_to_seam_flag.size() && SAFE_ACCESS(mesh_vertex_to_seam_flag, *face_vertex_iter);
+                        if (is_seam_vertex) {
+                            ccinfo.seam_vertices.push_back(cc_descriptor);
+                        }
+                    }
 
-        parallel_fork_and_join(
-            scheduler,
-            mesh.faces_begin(),
-            mesh.faces_end(),
-            (1 << 8),
-            fn_compute_remapped_cc_faces,
-            partial_res, // output computed by master thread
-            futures);
+                    remapped_face.push_back(cc_descriptor);
+                }
 
-        // remapped_faces
-        const std::vector<std::vector<vd_t>>& remapped_faces_MASTER_THREAD_LOCAL = std::get<0>(partial_res);
-        const std::vector<int>& local_remapped_face_to_ccID_MASTER_THREAD_LOCAL = std::get<1>(partial_res);
-        const std::vector<fd_t>& local_remapped_face_to_mX_face_MASTER_THREAD_LOCAL = std::get<2>(partial_res);
-
-        auto merge_local_remapped_cc_faces = [](
-                                                 const std::vector<std::vector<vd_t>>& remapped_faces_,
-                                                 const std::vector<int>& local_remapped_face_to_ccID_,
-                                                 const std::vector<fd_t>& local_remapped_face_to_mX_face_,
-                                                 const bool popuplate_face_maps,
-                                                 std::map<size_t, hmesh_t>& ccID_to_mesh,
-                                                 std::map<size_t, std::vector<fd_t>>& ccID_to_cc_to_mX_face) {
-            for (std::vector<std::vector<vd_t>>::const_iterator remapped_face_iter = remapped_faces_.cbegin();
-                 remapped_face_iter != remapped_faces_.cend();
-                 ++remapped_face_iter) {
-                uint32_t idx = (uint32_t)std::distance(remapped_faces_.cbegin(), remapped_face_iter);
-                uint32_t remapped_face_cc_id = SAFE_ACCESS(local_remapped_face_to_ccID_, idx);
-
-                MCUT_ASSERT(ccID_to_mesh.find(remapped_face_cc_id) != ccID_to_mesh.end());
-
-                hmesh_t& cc_mesh = SAFE_ACCESS(ccID_to_mesh, remapped_face_cc_id);
-                fd_t f = cc_mesh.add_face(*remapped_face_iter); // insert the face
+                fd_t f = cc.add_face(remapped_face); // insert the face
 
                 MCUT_ASSERT(f != hmesh_t::null_face());
+                (void)f;
 
                 if (popuplate_face_maps) {
-                    // NOTE: "mX" refers to our halfedge data structure called "mesh" (see single threaded code)
-                    std::vector<fd_t>& cc_to_mX_face = SAFE_ACCESS(ccID_to_cc_to_mX_face, remapped_face_cc_id);
-                    MCUT_ASSERT((size_t)f == cc_to_mX_face.size() /*cc_to_mX_face.count(f) == 0*/);
-                    const fd_t fd = local_remapped_face_to_mX_face_[idx];
-                    // cc_to_mX_face[f] = fd;
+                    MCUT_ASSERT((size_t)f == cc_to_mX_face.size());
                     cc_to_mX_face.push_back(fd);
                 }
             }
-        };
-
-        merge_local_remapped_cc_faces(
-            remapped_faces_MASTER_THREAD_LOCAL,
-            local_remapped_face_to_ccID_MASTER_THREAD_LOCAL,
-            local_remapped_face_to_mX_face_MASTER_THREAD_LOCAL,
-            popuplate_face_maps,
-            ccID_to_mesh,
-            ccID_to_cc_to_mX_face);
-
-        // merge thread-local output into global data structures
-        for (int i = 0; i < (int)futures.size(); ++i) {
-            std::future<OutputStorageTypesTuple>& f = futures[i];
-            MCUT_ASSERT(f.valid());
-            OutputStorageTypesTuple future_result = f.get(); // "get()" is a blocking function
-
-            const std::vector<std::vector<vd_t>>& remapped_faces_FUTURE = std::get<0>(future_result);
-            const std::vector<int>& local_remapped_face_to_ccID_FUTURE = std::get<1>(future_result);
-            const std::vector<fd_t>& local_remapped_face_to_mX_face_FUTURE = std::get<2>(future_result);
-
-            merge_local_remapped_cc_faces(
-                remapped_faces_FUTURE,
-                local_remapped_face_to_ccID_FUTURE,
-                local_remapped_face_to_mX_face_FUTURE,
-                popuplate_face_maps,
-                ccID_to_mesh,
-                ccID_to_cc_to_mX_face);
-        }
-
-    } // end of parallel scope
-#else
-    // for each face in the auxilliary data structure "mesh" (traced polygon)
-    for (face_array_iterator_t face_iter = mesh.faces_begin(); face_iter != mesh.faces_end(); ++face_iter) {
-        face_descriptor_t fd = *face_iter;
-        const size_t cc_id = SAFE_ACCESS(fccmap, fd); // the connected component which contains the current face
-
-        bool userWantsCC = SAFE_ACCESS(ccID_to_keepFlag, cc_id);
-
-        if (!userWantsCC) {
-            continue;
-        }
-
-        std::vector<vd_t> remapped_face; // using remapped cc descriptors
-        std::map<size_t, std::vector<fd_t>>::iterator ccID_to_cc_to_mX_face_fiter = ccID_to_cc_to_mX_face.find(cc_id);
-        MCUT_ASSERT(ccID_to_cc_to_mX_face_fiter != ccID_to_cc_to_mX_face.cend());
-        std::vector<fd_t>& cc_to_mX_face = ccID_to_cc_to_mX_face_fiter->second;
-
-        // std::map<std::size_t, std::unordered_map<vd_t, vd_t>>::iterator ccID_to_mX_to_cc_vertex_fiter = ;
-        MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(cc_id) != ccID_to_mX_to_cc_vertex.end());
-        std::unordered_map<vd_t, vd_t>& mX_to_cc_vertex = SAFE_ACCESS(ccID_to_mX_to_cc_vertex, cc_id);
-
-        // for each vertex around face
-        /*const*/ std::vector<vertex_descriptor_t> vertices_around_face = mesh.get_vertices_around_face(fd);
-
-        for (std::vector<vertex_descriptor_t>::/*const_*/iterator face_vertex_iter = vertices_around_face.begin();
-             face_vertex_iter != vertices_around_face.end();
-             ++face_vertex_iter) {
-            MCUT_ASSERT(ccID_to_mX_to_cc_vertex.find(cc_id) != ccID_to_mX_to_cc_vertex.cend());
-
-            /*const*/ std::unordered_map<vd_t, vd_t>& vertex_map = mX_to_cc_vertex;
-            const vd_t m1_sm_descr = *face_vertex_iter;
-
-            MCUT_ASSERT(vertex_map.find(m1_sm_descr) != vertex_map.cend());
-
-            const vd_t cc_descr = SAFE_ACCESS(vertex_map, m1_sm_descr);
-            remapped_face.push_back(cc_descr);
-        }
-
-        MCUT_ASSERT(ccID_to_mesh.find(cc_id) != ccID_to_mesh.end());
-
-        hmesh_t& cc_mesh = SAFE_ACCESS(ccID_to_mesh, cc_id);
-        fd_t f = cc_mesh.add_face(remapped_face); // insert the face
-
-        MCUT_ASSERT(f != hmesh_t::null_face());
-
-        if (popuplate_face_maps) {
-            MCUT_ASSERT((size_t)f == cc_to_mX_face.size() /*cc_to_mX_face.count(f) == 0*/);
-            // cc_to_mX_face[f] = fd;
-            cc_to_mX_face.push_back(fd);
-        }
-    }
-#endif
-
-    TIMESTACK_POP();
-
-    // Note: at this stage we have our connected components (meshes) with their
-    // vertices and faces defined
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Save the output connected components marked with location
-    ///////////////////////////////////////////////////////////////////////////
-
-    TIMESTACK_PUSH("Extract CC: save CCs with location properties");
-
-    // for each connected component
-    for (std::map<std::size_t, hmesh_t>::const_iterator cc_iter = ccID_to_mesh.cbegin();
-         cc_iter != ccID_to_mesh.cend();
-         ++cc_iter) {
-
-        const std::size_t& cc_id = cc_iter->first;
-        bool userWantsCC = SAFE_ACCESS(ccID_to_keepFlag, cc_id);
-
-        if (!userWantsCC) {
-            continue;
-        }
-
-        const hmesh_t& cc = cc_iter->second;
-
-        // The boolean is needed to prevent saving duplicate connected components into the vector "connected_components[cc_id]".
-        // This can happen because the current function is called for each new cut-mesh polygon that is stitched, during the
-        // polygon stitching phases. In the other times when the current function is called, we are guarranteed that
-        // "connected_components[cc_id]" is empty.
-        //
-        // The above has the implication that the newly stitched polygon (during the stitching phase) is added to just [one] of the
-        // discovered connected components (which are of a particular color tag), thus leaving the other connected components to be
-        // discovered as having exactly the same number of polygons as before since no new polygon has been added to them.
-        // So to prevent this connected component dupliction issue, a connected component is only added into "connected_components[cc_id]"
-        // if the following hold:
-        // 1) "connected_components[cc_id]" is empty (making the added connected component new and unique)
-        // 2) the most-recent connected component instance at "connected_components[cc_id].back()" has less faces (in which case, always differing by one)
-        //    than the new connected component we wish to add i.e. "cc"
-        auto cc_fiter = connected_components.find(cc_id);
-        bool proceed_to_save_mesh = cc_fiter == connected_components.cend() || cc_fiter->second.back().first.number_of_faces() != cc.number_of_faces();
-
-        if (proceed_to_save_mesh) {
-
-            sm_frag_location_t location = sm_frag_location_t::UNDEFINED;
-
-            if (!sm_polygons_below_cs.empty() && !sm_polygons_above_cs.empty()) {
-                MCUT_ASSERT(ccID_to_cs_descriptor.find(cc_id) != ccID_to_cs_descriptor.cend());
-                location = SAFE_ACCESS(ccID_to_cs_descriptor, cc_id);
-            }
-
-            connected_component_info_t ccinfo;
-            ccinfo.location = location;
-            ccinfo.seam_vertices = std::move(SAFE_ACCESS(cc_to_seam_vertices, cc_id));
 
             //
             // Map vertex and face descriptors to original values in the input source- and cut-mesh
@@ -936,25 +772,21 @@ hmesh_t extract_connected_components(
             // the mapped-to value is undefined (hmesh_t::null_vertex())
             //
 
-            const std::vector<vd_t>& cc_to_mX_vertex = SAFE_ACCESS(ccID_to_cc_to_mX_vertex, cc_id);
-
             if (popuplate_vertex_maps) {
                 // map cc vertices to original input mesh
                 // -----------------------------------
                 ccinfo.data_maps.vertex_map.resize(cc.number_of_vertices());
                 for (vertex_array_iterator_t i = cc.vertices_begin(); i != cc.vertices_end(); ++i) {
                     const vd_t cc_descr = *i;
-                    MCUT_ASSERT((size_t)cc_descr < cc_to_mX_vertex.size() /*cc_to_mX_vertex.count(cc_descr) == 1*/);
+                    MCUT_ASSERT((size_t)cc_descr < cc_to_mX_vertex.size());
                     const vd_t mX_descr = SAFE_ACCESS(cc_to_mX_vertex, cc_descr);
 
                     // NOTE: "m1_to_m0_sm_ovtx_colored" contains only non-intersection points from the source mesh
-                    // std::vector<vd_t>::const_iterator m1_to_m0_sm_ovtx_colored_fiter = m1_to_m0_sm_ovtx_colored.find(mX_descr);
-
-                    bool is_m1_sm_overtex = (size_t)mX_descr < m1_to_m0_sm_ovtx_colored.size(); // m1_to_m0_sm_ovtx_colored_fiter != m1_to_m0_sm_ovtx_colored.cend();
+                    bool is_m1_sm_overtex = (size_t)mX_descr < m1_to_m0_sm_ovtx_colored.size();
                     vd_t m0_descr = hmesh_t::null_vertex(); // NOTE: two cut-mesh "m1" original vertices may map to one "m0" vertex (due to winding order duplication)
 
                     if (is_m1_sm_overtex) {
-                        m0_descr = SAFE_ACCESS(m1_to_m0_sm_ovtx_colored, mX_descr); // m1_to_m0_sm_ovtx_colored_fiter->second;
+                        m0_descr = SAFE_ACCESS(m1_to_m0_sm_ovtx_colored, mX_descr);
                     } else if (!m1_to_m0_cm_ovtx_colored.empty()) { // are we in the stitching stage..? (calling with "m1")
                         // Lets search through the map "m1_to_m0_cm_ovtx_colored"
 
@@ -975,25 +807,23 @@ hmesh_t extract_connected_components(
                     const bool vertex_is_in_input_mesh_or_is_intersection_point = (m0_descr != hmesh_t::null_vertex()); // i.e. is it an original vertex (its not an intersection point/along cut-path)
 
                     if (vertex_is_in_input_mesh_or_is_intersection_point) {
-                        // std::map<vd_t, vd_t>::const_iterator m0_to_ps_vtx_fiter = m0_to_ps_vtx.find(m0_descr);
-                        bool vertex_is_in_input_mesh = (int)m0_descr < (int)m0_to_ps_vtx.size(); // m0_to_ps_vtx_fiter != m0_to_ps_vtx.cend();
+                        bool vertex_is_in_input_mesh = (int)m0_descr < (int)m0_to_ps_vtx.size();
                         vd_t input_mesh_descr = hmesh_t::null_vertex(); // i.e. source-mesh or cut-mesh
 
                         if (vertex_is_in_input_mesh) {
-                            // MCUT_ASSERT(m0_to_ps_vtx.count(m0_descr) == 1);
-                            const vd_t ps_descr = SAFE_ACCESS(m0_to_ps_vtx, m0_descr); // m0_to_ps_vtx_fiter->second; // SAFE_ACCESS(m0_to_ps_vtx, m0_descr);
+                            const vd_t ps_descr = SAFE_ACCESS(m0_to_ps_vtx, m0_descr);
                             // we don't know whether it belongs to cut-mesh patch or source-mesh, so check
                             const bool is_cutmesh_vtx = ps_is_cutmesh_vertex(ps_descr, sm_vtx_cnt);
                             if (is_cutmesh_vtx) {
-                                input_mesh_descr = SAFE_ACCESS(ps_to_cm_vtx, ps_descr);
+                                input_mesh_descr = ps.to_cut_mesh(ps_descr);
                                 // add an offset which allows users to deduce which birth/origin mesh (source or cut mesh) a vertex (map value) belongs to.
                                 input_mesh_descr = static_cast<vd_t>(input_mesh_descr + sm_vtx_cnt);
                             } else { // source-mesh vertex
-                                input_mesh_descr = SAFE_ACCESS(ps_to_sm_vtx, ps_descr);
+                                input_mesh_descr = ps_descr; // source-mesh descriptors are the same in "ps"
                             }
                         }
 
-                        MCUT_ASSERT(SAFE_ACCESS(ccinfo.data_maps.vertex_map, cc_descr) == hmesh_t::null_vertex() /*ccinfo.data_maps.vertex_map.count(cc_descr) == 0*/);
+                        MCUT_ASSERT(SAFE_ACCESS(ccinfo.data_maps.vertex_map, cc_descr) == hmesh_t::null_vertex());
                         ccinfo.data_maps.vertex_map[cc_descr] = input_mesh_descr;
                     }
                 }
@@ -1002,59 +832,98 @@ hmesh_t extract_connected_components(
             if (popuplate_face_maps) {
                 // map face to original input mesh
                 // -----------------------------------
-                MCUT_ASSERT(ccID_to_cc_to_mX_face.count(cc_id) == 1);
-
-                std::vector<fd_t>& cc_to_mX_face = SAFE_ACCESS(ccID_to_cc_to_mX_face, cc_id);
                 ccinfo.data_maps.face_map.resize(cc.number_of_faces());
                 for (face_array_iterator_t f = cc.faces_begin(); f != cc.faces_end(); ++f) {
                     const fd_t cc_descr = *f;
                     // account for the fact that the parameter "mX_traced_polygons" may contain only a subset of traced polygons
                     // need this to compute correct polygon index to access std::maps
-                    // const fd_t cc_descr_offsetted(traced_polygons_base_offset + static_cast<int>(cc_descr));
-                    MCUT_ASSERT((size_t)cc_descr < cc_to_mX_face.size() /*cc_to_mX_face.count(cc_descr) == 1*/);
+                    MCUT_ASSERT((size_t)cc_descr < cc_to_mX_face.size());
                     const fd_t mX_descr = SAFE_ACCESS(cc_to_mX_face, cc_descr);
                     const fd_t offsetted_mX_descr(traced_polygons_base_offset + static_cast<int>(mX_descr)); // global traced polygon index
                     int m0_descr = -1;
 
+                    // NOTE: the maps are searched with "find()" since the tasks must not insert elements
                     if (m1_to_m0_face_colored.size() > 0) { // are we calling from during the patch stitching phase..?
                         const fd_t m1_descr = offsetted_mX_descr;
-                        MCUT_ASSERT(m1_to_m0_face_colored.count(mX_descr) == 1);
-                        m0_descr = SAFE_ACCESS(m1_to_m0_face_colored, m1_descr);
+                        const auto m1_to_m0_face_colored_fiter = m1_to_m0_face_colored.find(m1_descr);
+                        MCUT_ASSERT(m1_to_m0_face_colored_fiter != m1_to_m0_face_colored.cend());
+                        m0_descr = m1_to_m0_face_colored_fiter->second;
                     } else {
                         m0_descr = static_cast<int>(offsetted_mX_descr);
                     }
 
-                    MCUT_ASSERT(m0_to_ps_face.count(m0_descr) == 1);
-                    const fd_t ps_descr = SAFE_ACCESS(m0_to_ps_face, m0_descr); // every traced polygon can be mapped back to an input mesh polygon
+                    const auto m0_to_ps_face_fiter = m0_to_ps_face.find(m0_descr);
+                    MCUT_ASSERT(m0_to_ps_face_fiter != m0_to_ps_face.cend());
+                    const fd_t ps_descr = m0_to_ps_face_fiter->second; // every traced polygon can be mapped back to an input mesh polygon
                     fd_t input_mesh_descr = hmesh_t::null_face();
 
                     const bool from_cutmesh_face = ps_is_cutmesh_face(ps_descr, sm_face_count);
                     if (from_cutmesh_face) {
-                        MCUT_ASSERT((int)ps_descr < (int)ps_to_cm_face.size());
-                        input_mesh_descr = SAFE_ACCESS(ps_to_cm_face, ps_descr);
+                        input_mesh_descr = ps.to_cut_mesh(ps_descr);
                         // add an offset which allows users to deduce which birth/origin mesh (source or cut mesh) a face (map value) belongs to.
                         input_mesh_descr = static_cast<fd_t>(input_mesh_descr + sm_face_count);
                     } else {
-                        MCUT_ASSERT((int)ps_descr < (int)ps_to_sm_face.size());
-                        input_mesh_descr = SAFE_ACCESS(ps_to_sm_face, ps_descr);
+                        input_mesh_descr = ps_descr; // source-mesh descriptors are the same in "ps"
                     }
 
                     // map to input mesh face
-                    MCUT_ASSERT(SAFE_ACCESS(ccinfo.data_maps.face_map, cc_descr) == hmesh_t::null_face() /* (ccinfo.data_maps.face_map.count(cc_descr) == 0*/);
+                    MCUT_ASSERT(SAFE_ACCESS(ccinfo.data_maps.face_map, cc_descr) == hmesh_t::null_face());
                     ccinfo.data_maps.face_map[cc_descr] = input_mesh_descr;
                 }
             } // if (popuplate_face_maps) {
 
-            connected_components[cc_id].emplace_back(cc, std::move(ccinfo));
+            extracted_cc.save = true;
+        }
+
+        return true;
+    };
+
+#if defined(MCUT_MULTI_THREADED)
+    if (!cc_ids.empty()) {
+        std::vector<std::future<bool>> futures;
+        bool _1;
+
+        // the components are usually few and of very different sizes, so we use small blocks
+        const std::ptrdiff_t block_size = std::max((std::ptrdiff_t)1, (std::ptrdiff_t)(cc_ids.size() / (scheduler.get_num_threads() * 4)));
+
+        parallel_fork_and_join(
+            scheduler,
+            cc_ids.cbegin(),
+            cc_ids.cend(),
+            block_size,
+            fn_extract_connected_components,
+            _1, // out
+            futures);
+
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
         }
     }
+#else
+    fn_extract_connected_components(cc_ids.cbegin(), cc_ids.cend());
+#endif
+
     TIMESTACK_POP();
 
-    return mesh;
-}
+    ///////////////////////////////////////////////////////////////////////////
+    // Save the output connected components marked with location
+    ///////////////////////////////////////////////////////////////////////////
 
-bool is_virtual_face(const fd_t& face)
-{
+    for (std::vector<int>::const_iterator cc_id_iter = cc_ids.cbegin(); cc_id_iter != cc_ids.cend(); ++cc_id_iter) {
+        extracted_connected_component_t& extracted_cc = SAFE_ACCESS(ccID_to_extracted_cc, *cc_id_iter);
+
+        if (extracted_cc.save) {
+            connected_components[*cc_id_iter].emplace_back(std::move(extracted_cc.cc), std::move(extracted_cc.ccinfo));
+        }
+    }
+
+    return mesh;
+}
+
+bool is_virtual_face(const fd_t& face)
+{
     return (face == hmesh_t::null_face());
 }
 
@@ -1111,7 +980,7 @@ inline bool m0_is_polygon_boundary_edge(const ed_t& e, uint32_t m0_num_cutpath_e
 
 // point an intersection halfedge to the correct instance of an intersection point
 vd_t resolve_intersection_point_descriptor(
-    const hmesh_t& ps,
+    const polygon_soup_view_t& ps,
     const hmesh_t& m0,
     hmesh_t& m1,
     const hd_t& m0_h,
@@ -1122,7 +991,7 @@ vd_t resolve_intersection_point_descriptor(
     /*const*/ std::unordered_map<vd_t, std::vector<hd_t>>& ivtx_to_incoming_hlist,
     /*const*/ std::unordered_map<hd_t, bool>& m0_sm_ihe_to_flag,
     const std::vector<std::pair<ed_t, fd_t>>& m0_ivtx_to_intersection_registry_entry,
-    /*const*/ std::unordered_map<hd_t, hd_t>& m0_to_m1_ihe,
+    /*const*/ arena_unordered_map_t<hd_t, hd_t>& m0_to_m1_ihe,
     // const std::map<vd_t, vd_t> &m0_to_ps_vtx,
     const std::vector<vd_t>& m0_to_ps_vtx,
     const int ps_vtx_cnt,
@@ -1325,7 +1194,7 @@ vd_t resolve_intersection_point_descriptor(
     return resolved_inst;
 };
 
-inline std::vector<fd_t> ps_get_ivtx_registry_entry_faces(const hmesh_t& ps, const std::pair<ed_t, fd_t>& ivtx_registry_entry)
+inline std::vector<fd_t> ps_get_ivtx_registry_entry_faces(const polygon_soup_view_t& ps, const std::pair<ed_t, fd_t>& ivtx_registry_entry)
 {
     const hd_t h0 = ps.halfedge(ivtx_registry_entry.first, 0);
     const hd_t h1 = ps.halfedge(ivtx_registry_entry.first, 1);
@@ -1341,7 +1210,7 @@ inline std::vector<fd_t> ps_get_ivtx_registry_entry_faces(const hmesh_t& ps, con
 void update_neighouring_ps_iface_m0_edge_list(
     const vd_t& src_vertex,
     const vd_t& tgt_vertex,
-    const hmesh_t& ps,
+    const polygon_soup_view_t& ps,
     const fd_t sm_face,
     const fd_t cs_face,
     const std::vector<std::pair<ed_t, fd_t>>& m0_ivtx_to_intersection_registry_entry,
@@ -1476,6 +1345,18 @@ void dispatch(output_t& output, const input_t& input)
     lg.reset();
     lg.set_verbose(input.verbose);
 
+    // Temporaries allocated from "input.arena" are released in bulk when this function returns.
+    // NOTE: the guard is declared before any arena-backed container so that it is destroyed last.
+    struct arena_reset_guard_t {
+        arena_t* arena;
+        ~arena_reset_guard_t()
+        {
+            if (arena != nullptr) {
+                arena->reset();
+            }
+        }
+    } arena_reset_guard = { input.arena };
+
 #if defined(MCUT_MULTI_THREADED)
     output.status.store(status_t::SUCCESS);
 #endif
@@ -1507,79 +1388,17 @@ void dispatch(output_t& output, const input_t& input)
     ///////////////////////////////////////////////////////////////////////////
 
     TIMESTACK_PUSH("Create ps");
-    hmesh_t ps = sm; // copy
-
-    ps.reserve_for_additional_elements(cs.number_of_vertices()); // hint
-
-    // std::map<vd_t, vd_t> ps_to_sm_vtx;
-    std::vector<vd_t> ps_to_sm_vtx((std::size_t)sm_vtx_cnt + cs.number_of_vertices());
-#if 1
-    std::iota(std::begin(ps_to_sm_vtx), std::end(ps_to_sm_vtx), vd_t(0));
-#else
-    for (vertex_array_iterator_t v = sm.vertices_begin(); v != sm.vertices_end(); ++v) {
-        ps_to_sm_vtx[*v] = *v; // one to one mapping since ps is initially a copy of sm!
-    }
-#endif
-    // std::map<fd_t, fd_t> ps_to_sm_face;
-    std::vector<fd_t> ps_to_sm_face((std::size_t)sm.number_of_faces() + cs.number_of_faces());
-#if 1
-    std::iota(std::begin(ps_to_sm_face), std::end(ps_to_sm_face), fd_t(0));
-#else
-    for (face_array_iterator_t f = sm.faces_begin(); f != sm.faces_end(); ++f) {
-        ps_to_sm_face[*f] = *f; // one to one mapping since ps is initially a copy of sm!
-    }
-#endif
-    // std::map<vd_t, vd_t> cs_to_ps_vtx;
-    // std::map<vd_t, vd_t> ps_to_cm_vtx;
-    // std::vector<vd_t> cs_to_ps_vtx(cs.number_of_vertices());
-    std::vector<vd_t> ps_to_cm_vtx((std::size_t)sm_vtx_cnt + cs.number_of_vertices());
-
-    // merge cm vertices
-    for (auto i = cs.vertices_begin(); i != cs.vertices_end(); ++i) {
-        const vd_t v = ps.add_vertex(cs.vertex(*i));
-
-        MCUT_ASSERT(v != hmesh_t::null_vertex());
-
-        // cs_to_ps_vtx.insert(std::make_pair(*i, v));
-        // cs_to_ps_vtx[*i] = v;
-        ps_to_cm_vtx[v] = *i;
-    }
-
-    // std::map<fd_t, fd_t> ps_to_cm_face;
-    std::vector<fd_t> ps_to_cm_face((std::size_t)sm_face_count + cs_face_count);
-
-    // merge cm faces
-    {
-        std::vector<vd_t> remapped_face_vertices_tmp;
-        for (face_array_iterator_t i = cs.faces_begin(); i != cs.faces_end(); ++i) {
-            // std::vector<vd_t> fv = get_vertices_on_face(cs, *i);
-#if 1
-            cs.get_vertices_around_face(remapped_face_vertices_tmp, *i, sm_vtx_cnt);
-            const std::vector<vd_t>& remapped_face_vertices = remapped_face_vertices_tmp;
-#else
-            const std::vector<vd_t> fv = cs.get_vertices_around_face(*i);
-            std::vector<vd_t> remapped_face_vertices;
-
-            for (std::vector<vd_t>::const_iterator j = fv.cbegin(); j != fv.cend(); ++j) {
-                remapped_face_vertices.push_back(vd_t(sm_vtx_cnt + (*j)));
-            }
-#endif
-            const fd_t f = ps.add_face(remapped_face_vertices);
-
-            MCUT_ASSERT(f != hmesh_t::null_face());
-
-            ps_to_cm_face[f] = *i;
-        }
-    }
-
+    // NOTE: "ps" is only a view of "sm" and "cs" (nothing is copied). The descriptors of
+    // source-mesh elements are unchanged in "ps", and those of cut-mesh elements are offsetted
+    // by the number of source-mesh elements of the same type (see "ps_is_cutmesh_vertex" etc.)
+    // The input meshes are dense (preproc compacts them after partitioning floating polygons).
+    MCUT_ASSERT(sm.number_of_vertices_removed() == 0);
+    MCUT_ASSERT(sm.number_of_edges_removed() == 0);
+    MCUT_ASSERT(sm.number_of_faces_removed() == 0);
+    MCUT_ASSERT(cs.number_of_edges_removed() == 0);
+    const polygon_soup_view_t ps(sm, cs);
     TIMESTACK_POP();
 
-    // cs_to_ps_vtx.clear();
-
-    if (input.verbose) {
-        dump_mesh(ps, "polygon-soup");
-    }
-
     const int ps_vtx_cnt = ps.number_of_vertices();
     //const int ps_face_cnt = ps.number_of_faces();
 
@@ -1599,9 +1418,12 @@ void dispatch(output_t& output, const input_t& input)
     // copy ps vertices into the auxilliary mesh (map is used to maintain original vertex order)
     // std::map<vd_t, vd_t> m0_to_ps_vtx;
     std::vector<vd_t> m0_to_ps_vtx; // NOTE: only ps vertices are stored here
+    m0_to_ps_vtx.reserve(ps_vtx_cnt);
     // std::map<vd_t, vd_t> ps_to_m0_vtx;
-    std::vector<vd_t> ps_to_m0_vtx((std::size_t)sm_vtx_cnt + cs.number_of_vertices());
-    for (auto i = ps.vertices_begin(); i != ps.vertices_end(); ++i) {
+    std::vector<vd_t> ps_to_m0_vtx((std::size_t)ps.number_of_internal_vertices());
+    m0.reserve_for_additional_vertices(ps_vtx_cnt);
+    // NOTE: this is the only copy of the input mesh vertices made by the kernel
+    for (polygon_soup_view_t::vertex_iterator_t i = ps.vertices_begin(); i != ps.vertices_end(); ++i) {
         const vd_t v = m0.add_vertex(ps.vertex(*i));
 
         MCUT_ASSERT(v != hmesh_t::null_vertex());
@@ -1619,392 +1441,124 @@ void dispatch(output_t& output, const input_t& input)
     // Calculate polygon intersection points
     ///////////////////////////////////////////////////////////////////////////
 
-    std::unordered_map<ed_t, std::vector<fd_t>> ps_edge_face_intersection_pairs;
-
     TIMESTACK_PUSH("Prepare edge-to-face pairs");
 
-#if defined(MCUT_MULTI_THREADED)
-    { // NOTE: parallel implementation is different from sequential one
-        typedef std::unordered_map<ed_t, std::vector<fd_t>> OutputStorageType;
-        typedef std::map<fd_t, std::vector<fd_t>>::const_iterator InputStorageIteratorType;
-
-        std::vector<std::future<OutputStorageType>> futures;
-
-        auto fn_compute_ps_edge_to_faces_map = [&](InputStorageIteratorType block_start_, InputStorageIteratorType block_end_) {
-            std::unordered_map<ed_t, std::vector<fd_t>> ps_edge_face_intersection_pairs_local;
-
-            for (InputStorageIteratorType iter = block_start_; iter != block_end_; ++iter) {
-                // the face with the intersecting edges (i.e. the edges to be tested against the other face)
-                const fd_t& intersecting_edge_face = iter->first; // sm_face != hmesh_t::null_face() ? sm_face : cm_face;
-                const std::vector<hd_t>& halfedges = ps.get_halfedges_around_face(intersecting_edge_face);
-
-                for (std::vector<hd_t>::const_iterator hIter = halfedges.cbegin(); hIter != halfedges.cend(); ++hIter) {
-                    const ed_t edge = ps.edge(*hIter);
-                    std::vector<fd_t>& edge_ifaces = ps_edge_face_intersection_pairs_local[edge];
-                    if (edge_ifaces.empty()) {
-                        edge_ifaces = iter->second;
-                        if (edge_ifaces.size() > 1) {
-                            std::sort(edge_ifaces.begin(), edge_ifaces.end()); // alows us to do binary search (std::lower_bound)
-                        }
-                    } else {
-                        for (std::vector<fd_t>::const_iterator iface_iter = iter->second.cbegin();
-                             iface_iter != iter->second.cend();
-                             ++iface_iter) {
-                            std::vector<fd_t>::iterator fiter = std::lower_bound(edge_ifaces.begin(), edge_ifaces.end(), *iface_iter);
-                            bool exists = fiter != edge_ifaces.end() && (*fiter == *iface_iter);
-                            if (!exists) {
-                                edge_ifaces.insert(fiter, *iface_iter); // insert and maintain sorted order
-                            }
-                        }
-                    }
-                }
-            }
-            return ps_edge_face_intersection_pairs_local;
-        };
-
-        parallel_fork_and_join(
-            *input.scheduler,
-            input.ps_face_to_potentially_intersecting_others->cbegin(),
-            input.ps_face_to_potentially_intersecting_others->cend(),
-            (1 << 6),
-            fn_compute_ps_edge_to_faces_map,
-            ps_edge_face_intersection_pairs, // out
-            futures);
-
-        // merge results from other threads
-
-        for (int fi = 0; fi < (int)futures.size(); ++fi) {
-            std::future<OutputStorageType>& f = futures[fi];
-            MCUT_ASSERT(f.valid()); // The behavior is undefined if valid()== false before the call to wait_for
+    //
+    // Each edge of a face that is potentially intersecting others is paired with those other faces, except
+    // for the faces whose bounding box does not overlap the bounding box of the edge (such pairs are
+    // merely the result of the faces being close, as found by the BVH proximity search).
+    //
+    // Each pair is encoded as a 64-bit key (the edge in the upper half and the face in the lower half)
+    // which allows all pairs to be collected in flat arrays, and then ordered and deduplicated (an edge is
+    // shared by two faces) with a radix sort.
+    //
 
-            OutputStorageType future_res = f.get();
-            // merge results for current block
-            for (OutputStorageType::const_iterator i = future_res.cbegin(); i != future_res.cend(); ++i) {
-                OutputStorageType::iterator fiter = ps_edge_face_intersection_pairs.find(i->first);
-                if (fiter == ps_edge_face_intersection_pairs.cend()) {
-                    ps_edge_face_intersection_pairs[i->first] = i->second;
-                } else {
-                    for (std::vector<fd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                        std::vector<fd_t>::iterator lb_iter = std::lower_bound(fiter->second.begin(), fiter->second.end(), *j);
-                        bool exists = lb_iter != fiter->second.end() && (*lb_iter == *j);
-                        if (!exists) {
-                            fiter->second.insert(lb_iter, *j); // insert and maintain sorted order
-                        }
-                    }
-                }
-            }
-        }
-    } // end of parallel code
+    // returns the bounding box of a face in the polygon soup
+    auto get_ps_face_bbox = [&](const fd_t f) -> const bounding_box_t<vec3>& {
+        const bool is_sm_face = (size_t)f < (size_t)sm_face_count;
+        if (is_sm_face) {
+#if defined(USE_OIBVH)
+            return SAFE_ACCESS((*input.source_hmesh_face_aabb_array_ptr), f);
 #else
-    {
-
-        std::vector<fd_t> unvisited_ps_ifaces; //= *input.ps_face_to_potentially_intersecting_others;
-        unvisited_ps_ifaces.reserve(input.ps_face_to_potentially_intersecting_others->size());
-        // NOTE: the elements of "unvisited_ps_ifaces" are already sorted because they come directly from
-        // "input.ps_face_to_potentially_intersecting_others", which is an std::map (keys are always sorted)
-        std::transform(
-            input.ps_face_to_potentially_intersecting_others->cbegin(),
-            input.ps_face_to_potentially_intersecting_others->cend(),
-            std::back_inserter(unvisited_ps_ifaces),
-            [](const std::pair<fd_t, std::vector<fd_t>>& kv) { return kv.first; });
-
-        std::vector<bool> ps_iface_enqueued(ps.number_of_faces(), false);
-
-        std::vector<bool> ps_edge_visited(ps.number_of_edges(), false);
-        // initially null
-        std::map<fd_t, std::vector<fd_t>>::const_iterator cur_ps_cc_face = input.ps_face_to_potentially_intersecting_others->cend();
-        // start with any face, but we choose the first
-        std::map<fd_t, std::vector<fd_t>>::const_iterator next_ps_cc_face = input.ps_face_to_potentially_intersecting_others->cbegin();
-        ps_iface_enqueued[next_ps_cc_face->first] = true;
-
-         // an element of this queue is an iterator/ptr to an element of "input.ps_face_to_potentially_intersecting_others"
-            std::queue<std::map<fd_t, std::vector<fd_t>>::const_iterator> adj_ps_face_queue;
-
-        do { // each iteration will find a set of edges that belong to a connected-component patch of intersectng faces (of sm or cm) in ps
-            cur_ps_cc_face = next_ps_cc_face;
-            next_ps_cc_face = input.ps_face_to_potentially_intersecting_others->cend(); // set null
-
-            // register unique edges of current face, and the add the neighbouring faces to queue
+            return input.source_hmesh_BVH->GetPrimitiveBBox(f);
+#endif
+        } else {
+#if defined(USE_OIBVH)
+            return SAFE_ACCESS((*input.cut_hmesh_face_aabb_array_ptr), (size_t)f - sm_face_count);
+#else
+            return input.cut_hmesh_BVH->GetPrimitiveBBox((size_t)f - sm_face_count);
+#endif
+        }
+    };
 
-           
-            adj_ps_face_queue.push(cur_ps_cc_face);
+    auto fn_compute_ps_edge_face_pair_keys = [&](std::map<fd_t, std::vector<fd_t>>::const_iterator block_start_, std::map<fd_t, std::vector<fd_t>>::const_iterator block_end_) {
+        std::vector<std::uint64_t> ps_edge_face_pair_keys_local;
 
-            do { // each interation will add unregistered edges of current face, and add unvisited faces to queue
+        for (std::map<fd_t, std::vector<fd_t>>::const_iterator iter = block_start_; iter != block_end_; ++iter) {
+            // the face with the intersecting edges (i.e. the edges to be tested against the other faces)
+            const fd_t& intersecting_edge_face = iter->first;
+            const polygon_soup_view_t::halfedge_array_view_t halfedges = ps.get_halfedges_around_face(intersecting_edge_face);
 
-                const std::map<fd_t, std::vector<fd_t>>::const_iterator cc_iface = adj_ps_face_queue.front(); // current face of connected-component patch
-                adj_ps_face_queue.pop();
+            for (polygon_soup_view_t::halfedge_array_view_t::const_iterator hIter = halfedges.cbegin(); hIter != halfedges.cend(); ++hIter) {
+                const ed_t edge = ps.edge(*hIter);
 
-                { // face is now visisted so we remove it
-                    std::vector<fd_t>::iterator fiter = std::lower_bound(
-                        unvisited_ps_ifaces.begin(),
-                        unvisited_ps_ifaces.end(),
-                        cc_iface->first);
-                    MCUT_ASSERT(fiter != unvisited_ps_ifaces.cend());
-                    unvisited_ps_ifaces.erase(fiter); // NOTE: list remains sorted
-                }
+                bounding_box_t<vec3> edge_bbox;
+                edge_bbox.expand(ps.vertex(ps.vertex(edge, 0)));
+                edge_bbox.expand(ps.vertex(ps.vertex(edge, 1)));
 
-                std::vector<fd_t> cur_ps_face_ifaces_sorted = cc_iface->second; // copy
-                if (cur_ps_face_ifaces_sorted.size() > 1) {
-                    std::sort(cur_ps_face_ifaces_sorted.begin(), cur_ps_face_ifaces_sorted.end()); // allows quick binary search
-                }
-                // bool is_sm_face = cc_iface->first < sm_face_count;
-                //  const fd_t cc_iface_descr = is_sm_face ? cc_iface->first - sm_face_count : sm_face_count;
-
-                const std::vector<hd_t>& cur_ps_face_halfedges = ps.get_halfedges_around_face(cc_iface->first);
-                // all neighbours
-                const std::vector<fd_t> cur_ps_face_neigh_faces = ps.get_faces_around_face(cc_iface->first, &cur_ps_face_halfedges);
-                // neighbours [which are intersecting faces]
-                std::vector<fd_t> cur_ps_face_neigh_ifaces;
-                cur_ps_face_neigh_ifaces.reserve(cur_ps_face_neigh_faces.size());
-
-                for (std::vector<fd_t>::const_iterator face_iter = cur_ps_face_neigh_faces.cbegin();
-                     face_iter != cur_ps_face_neigh_faces.cend();
-                     ++face_iter) {
-                    bool is_iface = input.ps_face_to_potentially_intersecting_others->find(*face_iter) != input.ps_face_to_potentially_intersecting_others->cend();
-                    if (is_iface) {
-                        cur_ps_face_neigh_ifaces.push_back(*face_iter);
+                for (std::vector<fd_t>::const_iterator iface_iter = iter->second.cbegin(); iface_iter != iter->second.cend(); ++iface_iter) {
+                    if (intersect_bounding_boxes(edge_bbox, get_ps_face_bbox(*iface_iter))) {
+                        ps_edge_face_pair_keys_local.push_back(((std::uint64_t)(std::uint32_t)edge << 32) | (std::uint32_t)(*iface_iter));
                     }
                 }
-
-                if (cur_ps_face_neigh_ifaces.size() > 1) {
-                    std::sort(cur_ps_face_neigh_ifaces.begin(), cur_ps_face_neigh_ifaces.end());
-                }
-
-                // for each halfedge of current iface
-                for (std::vector<hd_t>::const_iterator hiter = cur_ps_face_halfedges.cbegin(); hiter != cur_ps_face_halfedges.cend(); ++hiter) {
-                    const ed_t halfedge_edge = ps.edge(*hiter);
-                    const hd_t opp_he = ps.opposite(*hiter);
-                    // Here we simply access corresponding element in "cur_ps_face_neigh_faces" based on
-                    // how "ps.get_faces_around_face" populates "cur_ps_face_neigh_faces", given "cur_ps_face_halfedges"
-                    // as done above
-
-                    if (ps_edge_visited[halfedge_edge] == false) {
-                        ps_edge_face_intersection_pairs.insert(std::make_pair(halfedge_edge, cur_ps_face_ifaces_sorted)); // add edge
-                        ps_edge_visited[halfedge_edge] = true;
-
-                        bool is_border_ps_face = cur_ps_face_neigh_faces.size() != cur_ps_face_halfedges.size();
-                        const size_t idx = std::distance(cur_ps_face_halfedges.cbegin(), hiter);
-                        fd_t opp_he_face = is_border_ps_face ? ps.face(opp_he) : SAFE_ACCESS(cur_ps_face_neigh_faces, idx);
-
-                        if (!is_virtual_face(opp_he_face) && ps_iface_enqueued[opp_he_face] == false) { // two neighbouring faces might share more that 1 edge (case of non-triangulated mesh)
-                            bool is_iface = std::binary_search(cur_ps_face_neigh_ifaces.cbegin(), cur_ps_face_neigh_ifaces.cend(), opp_he_face);
-                            if (is_iface) {
-                                std::map<fd_t, std::vector<fd_t>>::const_iterator fiter = input.ps_face_to_potentially_intersecting_others->find(opp_he_face);
-                                adj_ps_face_queue.push(fiter);
-                                ps_iface_enqueued[opp_he_face] = true;
-                            }
-                        }
-                    } else {
-                        MCUT_ASSERT(ps_edge_face_intersection_pairs.find(halfedge_edge) != ps_edge_face_intersection_pairs.cend());
-                        // merge shared "intersected" faces.
-                        // Two intersecting faces that share an edge will share intersected faces. The shared faces
-                        // are those intersected by the shared edge.
-                        std::vector<fd_t>& existing_edge_ifaces = ps_edge_face_intersection_pairs[halfedge_edge]; // sorted list
-
-                        for (std::vector<fd_t>::const_iterator i = cur_ps_face_ifaces_sorted.cbegin(); i != cur_ps_face_ifaces_sorted.cend(); ++i) {
-                            std::vector<fd_t>::iterator iter = std::lower_bound(existing_edge_ifaces.begin(), existing_edge_ifaces.end(), *i);
-
-                            bool found = iter != existing_edge_ifaces.end() && iter != existing_edge_ifaces.end() && (*iter == *i);
-                            if (!found) {
-                                existing_edge_ifaces.insert(iter, *i); // insert into sorted list (i.e. possibly shifts some elements forward)
-                            }
-                        }
-                    }
-                } // for each halfedge of current iface
-
-            } while (adj_ps_face_queue.empty() == false);
-
-            // find "next_ps_cc_face" as any face in "input.ps_face_to_potentially_intersecting_others" that is not visited
-            if (unvisited_ps_ifaces.size() > 0) {
-                fd_t next_face = unvisited_ps_ifaces.back(); // pick any unvisited iface (we choose the last for faster elemt removal from std::vector)
-                next_ps_cc_face = input.ps_face_to_potentially_intersecting_others->find(next_face);
-                MCUT_ASSERT(next_ps_cc_face != input.ps_face_to_potentially_intersecting_others->cend());
             }
+        }
 
-        } while (next_ps_cc_face != input.ps_face_to_potentially_intersecting_others->cend());
-    }
-    // std::unordered_map<ed_t, std::vector<fd_t>> ps_edge_face_intersection_pairs;
-#endif // #if defined(MCUT_MULTI_THREADED)
-    TIMESTACK_POP();
-
-    //
-    // build bounding boxes for each intersecting edge
-    //
-
-    TIMESTACK_PUSH("Build edge bounding boxes");
+        return ps_edge_face_pair_keys_local;
+    };
 
-    // http://gamma.cs.unc.edu/RTRI/i3d08_RTRI.pdf
-    std::unordered_map<ed_t, bounding_box_t<vec3>> ps_edge_to_bbox;
+    std::vector<std::uint64_t> ps_edge_face_pair_keys;
 
 #if defined(MCUT_MULTI_THREADED)
     {
-        typedef std::unordered_map<ed_t, bounding_box_t<vec3>> OutputStorageType;
-        typedef std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator InputStorageIteratorType;
-
-        auto fn_compute_ps_edge_bbox = [&](InputStorageIteratorType block_start_, InputStorageIteratorType block_end_) {
-            OutputStorageType ps_edge_to_bbox_local;
-
-            for (std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator iedge_iter = block_start_; iedge_iter != block_end_; iedge_iter++) {
-                const ed_t edge = iedge_iter->first;
-                const vd_t v0 = ps.vertex(edge, 0);
-                const vd_t v1 = ps.vertex(edge, 1);
-                bounding_box_t<vec3>& edge_bbox = ps_edge_to_bbox_local[edge];
-                edge_bbox.expand(ps.vertex(v0));
-                edge_bbox.expand(ps.vertex(v1));
-            }
-
-            return ps_edge_to_bbox_local;
-        };
+        typedef std::vector<std::uint64_t> OutputStorageType;
 
         std::vector<std::future<OutputStorageType>> futures;
 
         parallel_fork_and_join(
             *input.scheduler,
-            ps_edge_face_intersection_pairs.cbegin(),
-            ps_edge_face_intersection_pairs.cend(),
-            (1 << 8),
-            fn_compute_ps_edge_bbox,
-            ps_edge_to_bbox, // out
+            input.ps_face_to_potentially_intersecting_others->cbegin(),
+            input.ps_face_to_potentially_intersecting_others->cend(),
+            (1 << 6),
+            fn_compute_ps_edge_face_pair_keys,
+            ps_edge_face_pair_keys, // out
             futures);
 
         // merge results from other threads
 
-        for (int i = 0; i < (int)futures.size(); ++i) {
-            std::future<OutputStorageType>& f = futures[i];
+        for (int fi = 0; fi < (int)futures.size(); ++fi) {
+            std::future<OutputStorageType>& f = futures[fi];
             MCUT_ASSERT(f.valid()); // The behavior is undefined if valid()== false before the call to wait_for
 
-            OutputStorageType future_res = f.get();
-
-            ps_edge_to_bbox.insert(future_res.cbegin(), future_res.cend());
+            const OutputStorageType future_res = f.get();
+            ps_edge_face_pair_keys.insert(ps_edge_face_pair_keys.end(), future_res.cbegin(), future_res.cend());
         }
     }
 #else
-    for (std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator iedge_iter = ps_edge_face_intersection_pairs.cbegin();
-         iedge_iter != ps_edge_face_intersection_pairs.cend();
-         iedge_iter++) {
-        MCUT_ASSERT(iedge_iter->second.size() >= 1);
-        const ed_t edge = iedge_iter->first;
-        const vd_t v0 = ps.vertex(edge, 0);
-        const vd_t v1 = ps.vertex(edge, 1);
-        bounding_box_t<vec3>& edge_bbox = ps_edge_to_bbox[edge];
-        edge_bbox.expand(ps.vertex(v0));
-        edge_bbox.expand(ps.vertex(v1));
-    }
+    ps_edge_face_pair_keys = fn_compute_ps_edge_face_pair_keys(
+        input.ps_face_to_potentially_intersecting_others->cbegin(),
+        input.ps_face_to_potentially_intersecting_others->cend());
 #endif // #if defined(MCUT_MULTI_THREADED)
 
-    TIMESTACK_POP();
-
-    //
-    // cull redundant edge to face pairs
-    //
-    TIMESTACK_PUSH("Cull redundant edge-face pairs");
-
+    radix_sort(
 #if defined(MCUT_MULTI_THREADED)
-    {
-        typedef std::unordered_map<ed_t, std::vector<fd_t>>::iterator InputStorageIteratorType;
-
-        auto fn_compute_edgefair_pair_culling = [&](InputStorageIteratorType block_start_, InputStorageIteratorType block_end_) {
-            for (std::unordered_map<ed_t, std::vector<fd_t>>::iterator iedge_iter = block_start_; iedge_iter != block_end_; iedge_iter++) {
-                const ed_t edge = iedge_iter->first;
-                const bounding_box_t<vec3>& edge_bbox = ps_edge_to_bbox[edge];
-                std::vector<fd_t>& edge_ifaces = iedge_iter->second;
-
-                for (std::vector<fd_t>::iterator iface_iter = edge_ifaces.begin(); iface_iter != edge_ifaces.end(); /*increment inside loop*/) {
-                    const bounding_box_t<vec3>* iface_bbox = nullptr;
-                    bool is_sm_face = (size_t)(*iface_iter) < (size_t)sm_face_count;
-                    if (is_sm_face) {
-#if defined(USE_OIBVH)
-                        iface_bbox = &(SAFE_ACCESS((*input.source_hmesh_face_aabb_array_ptr), *iface_iter));
-
-#else
-                        iface_bbox = &input.source_hmesh_BVH->GetPrimitiveBBox(*iface_iter); // SAFE_ACCESS(((*input.source_hmesh_face_aabb_array_ptr), *iface_iter));
-#endif
-                    } else {
-#if defined(USE_OIBVH)
-                        iface_bbox = &(SAFE_ACCESS((*input.cut_hmesh_face_aabb_array_ptr), (size_t)(*iface_iter) - sm_face_count));
-#else
-                        iface_bbox = &input.cut_hmesh_BVH->GetPrimitiveBBox((size_t)(*iface_iter) - sm_face_count); // SAFE_ACCESS(((*input.cut_hmesh_face_aabb_array_ptr), ((size_t)(*iface_iter) - sm_face_count)));
-
+        *input.scheduler,
 #endif
-                    }
-
-                    bool intersect = intersect_bounding_boxes(edge_bbox, *iface_bbox);
+        ps_edge_face_pair_keys);
 
-                    if (!intersect) {
-                        // remove because "iface_iter" was paired with a coincident face (of "edge") based on
-                        // the mere fact that the coincident face was found to be in close proximity with
-                        // "iface_iter" (from BVH tree proximity search)
-                        iface_iter = edge_ifaces.erase(iface_iter); // NOTE: "erase" return iterator to next after
-                    } else {
-                        iface_iter++;
-                    }
-                }
-            }
-            return 0;
-        };
+    ps_edge_face_pair_keys.erase(std::unique(ps_edge_face_pair_keys.begin(), ps_edge_face_pair_keys.end()), ps_edge_face_pair_keys.end());
 
-        std::vector<std::future<int>> futures;
-        int _1;
+    // group the faces by edge
+    edge_face_pairs_t ps_edge_face_intersection_pairs;
+    ps_edge_face_intersection_pairs.faces.reserve(ps_edge_face_pair_keys.size());
 
-        parallel_fork_and_join(
-            *input.scheduler,
-            ps_edge_face_intersection_pairs.begin(),
-            ps_edge_face_intersection_pairs.end(),
-            (1 << 8),
-            fn_compute_edgefair_pair_culling,
-            _1, // out
-            futures);
+    for (std::vector<std::uint64_t>::const_iterator i = ps_edge_face_pair_keys.cbegin(); i != ps_edge_face_pair_keys.cend(); ++i) {
+        const ed_t edge((std::uint32_t)(*i >> 32));
 
-        for (int i = 0; i < (int)futures.size(); ++i) {
-            std::future<int>& f = futures[i];
-            MCUT_ASSERT(f.valid());
-            f.wait(); // simply wait for result to be done
+        if (ps_edge_face_intersection_pairs.edges.empty() || ps_edge_face_intersection_pairs.edges.back() != edge) {
+            ps_edge_face_intersection_pairs.edges.push_back(edge);
+            ps_edge_face_intersection_pairs.offsets.push_back((std::uint32_t)ps_edge_face_intersection_pairs.faces.size());
         }
-    }
-#else
-    for (std::unordered_map<ed_t, std::vector<fd_t>>::iterator iedge_iter = ps_edge_face_intersection_pairs.begin();
-         iedge_iter != ps_edge_face_intersection_pairs.end();
-         iedge_iter++) {
-        const ed_t edge = iedge_iter->first;
-        const bounding_box_t<vec3>& edge_bbox = ps_edge_to_bbox[edge];
-        std::vector<fd_t>& edge_ifaces = iedge_iter->second;
-
-        for (std::vector<fd_t>::iterator iface_iter = edge_ifaces.begin(); iface_iter != edge_ifaces.end(); /*increment inside loop*/) {
-            const bounding_box_t<vec3>* iface_bbox = nullptr;
-            bool is_sm_face = (size_t)(*iface_iter) < (size_t)sm_face_count;
-            if (is_sm_face) {
-#if defined(USE_OIBVH)
-                iface_bbox = SAFE_ACCESS(&((*input.source_hmesh_face_aabb_array_ptr)), *iface_iter);
 
-#else
-                iface_bbox = &input.source_hmesh_BVH->GetPrimitiveBBox(*iface_iter); // SAFE_ACCESS(((*input.source_hmesh_face_aabb_array_ptr), *iface_iter));
-#endif
-            } else {
-#if defined(USE_OIBVH)
-                iface_bbox = SAFE_ACCESS(&((*input.cut_hmesh_face_aabb_array_ptr)), ((size_t)(*iface_iter) - sm_face_count));
-#else
-                iface_bbox = &input.cut_hmesh_BVH->GetPrimitiveBBox((size_t)(*iface_iter) - sm_face_count); // SAFE_ACCESS(((*input.cut_hmesh_face_aabb_array_ptr), ((size_t)(*iface_iter) - sm_face_count)));
+        ps_edge_face_intersection_pairs.faces.push_back(fd_t((std::uint32_t)(*i & 0xFFFFFFFF)));
+    }
 
-#endif
-            }
+    ps_edge_face_intersection_pairs.offsets.push_back((std::uint32_t)ps_edge_face_intersection_pairs.faces.size());
 
-            bool intersect = intersect_bounding_boxes(edge_bbox, *iface_bbox);
+    ps_edge_face_pair_keys.clear();
 
-            if (!intersect) {
-                // remove because "iface_iter" was paired with a coincident face (of "edge") based on
-                // the mere fact that the coincident face was found to be in close proximity with
-                // "iface_iter" (from BVH tree proximity search)
-                iface_iter = edge_ifaces.erase(iface_iter); // NOTE: "erase" return iterator to next after
-            } else {
-                iface_iter++;
-            }
-        }
-    }
-#endif // #if defined(MCUT_MULTI_THREADED)
     TIMESTACK_POP();
 
-    ps_edge_to_bbox.clear();
-
     // assuming each edge will produce a new vertex
     m0.reserve_for_additional_elements((std::uint32_t)ps_edge_face_intersection_pairs.size());
 
@@ -2015,7 +1569,11 @@ void dispatch(output_t& output, const input_t& input)
     std::unordered_map<fd_t, vec3> ps_tested_face_to_plane_normal;
     std::unordered_map<fd_t, double> ps_tested_face_to_plane_normal_d_param;
     std::unordered_map<fd_t, int> ps_tested_face_to_plane_normal_max_comp;
-    std::unordered_map<fd_t, std::vector<vec3>> ps_tested_face_to_vertices;
+    // NOTE: the vertices of the tested faces are not stored in a vector per face but contiguously in
+    // "ps_tested_face_vertex_arrays" (one array per block of faces), which the views point into.
+    // The arrays are only moved after they are filled, which keeps the views valid.
+    std::unordered_map<fd_t, array_view_t<vec3>> ps_tested_face_to_vertices;
+    std::vector<std::vector<vec3>> ps_tested_face_vertex_arrays;
 
 #if defined(MCUT_MULTI_THREADED)
     {
@@ -2023,7 +1581,8 @@ void dispatch(output_t& output, const input_t& input)
             std::unordered_map<fd_t, vec3>, // ps_tested_face_to_plane_normal;
             std::unordered_map<fd_t, double>, // ps_tested_face_to_plane_normal_d_param;
             std::unordered_map<fd_t, int>, // ps_tested_face_to_plane_normal_max_comp;
-            std::unordered_map<fd_t, std::vector<vec3>> // ps_tested_face_to_vertices;
+            std::unordered_map<fd_t, array_view_t<vec3>>, // ps_tested_face_to_vertices;
+            std::vector<vec3> // element of ps_tested_face_vertex_arrays
             >
             OutputStorageTypesTuple;
         typedef std::map<fd_t, std::vector<fd_t>>::const_iterator InputStorageIteratorType;
@@ -2033,7 +1592,16 @@ void dispatch(output_t& output, const input_t& input)
             std::unordered_map<fd_t, vec3>& ps_tested_face_to_plane_normal_LOCAL = std::get<0>(output_res);
             std::unordered_map<fd_t, double>& ps_tested_face_to_plane_normal_d_param_LOCAL = std::get<1>(output_res);
             std::unordered_map<fd_t, int>& ps_tested_face_to_plane_normal_max_comp_LOCAL = std::get<2>(output_res);
-            std::unordered_map<fd_t, std::vector<vec3>>& ps_tested_face_to_vertices_LOCAL = std::get<3>(output_res);
+            std::unordered_map<fd_t, array_view_t<vec3>>& ps_tested_face_to_vertices_LOCAL = std::get<3>(output_res);
+            std::vector<vec3>& ps_tested_face_vertex_array_LOCAL = std::get<4>(output_res);
+
+            // reserve the whole array first since views into it are created while it is filled
+            std::size_t block_vertex_count = 0;
+            for (std::map<fd_t, std::vector<fd_t>>::const_iterator tested_faces_iter = block_start_; tested_faces_iter != block_end_; tested_faces_iter++) {
+                block_vertex_count += ps.get_halfedges_around_face(tested_faces_iter->first).size();
+            }
+            ps_tested_face_vertex_array_LOCAL.reserve(block_vertex_count);
+
             std::vector<vd_t> tested_face_descriptors_tmp;
             for (std::map<fd_t, std::vector<fd_t>>::const_iterator tested_faces_iter = block_start_;
                  tested_faces_iter != block_end_;
@@ -2041,13 +1609,19 @@ void dispatch(output_t& output, const input_t& input)
                 // get the vertices of tested_face (used to estimate its normal etc.)
                 ps.get_vertices_around_face(tested_face_descriptors_tmp, tested_faces_iter->first);
                 std::vector<vd_t> &tested_face_descriptors = tested_face_descriptors_tmp;
-                std::vector<vec3>& tested_face_vertices = ps_tested_face_to_vertices_LOCAL[tested_faces_iter->first]; // insert and get reference
+                const std::size_t tested_face_vertices_offset = ps_tested_face_vertex_array_LOCAL.size();
 
                 for (std::vector<vd_t>::const_iterator it = tested_face_descriptors.cbegin(); it != tested_face_descriptors.cend(); ++it) {
                     const vec3& vertex = ps.vertex(*it);
-                    tested_face_vertices.push_back(vertex);
+                    ps_tested_face_vertex_array_LOCAL.push_back(vertex);
                 }
 
+                MCUT_ASSERT(ps_tested_face_vertex_array_LOCAL.size() <= block_vertex_count); // i.e. no reallocation
+                const array_view_t<vec3> tested_face_vertices(
+                    ps_tested_face_vertex_array_LOCAL.data() + tested_face_vertices_offset,
+                    ps_tested_face_vertex_array_LOCAL.data() + ps_tested_face_vertex_array_LOCAL.size());
+                ps_tested_face_to_vertices_LOCAL[tested_faces_iter->first] = tested_face_vertices;
+
                 vec3& tested_face_plane_normal = ps_tested_face_to_plane_normal_LOCAL[tested_faces_iter->first];
                 double& tested_face_plane_param_d = ps_tested_face_to_plane_normal_d_param_LOCAL[tested_faces_iter->first];
                 int& tested_face_plane_normal_max_comp = ps_tested_face_to_plane_normal_max_comp_LOCAL[tested_faces_iter->first];
@@ -2055,7 +1629,7 @@ void dispatch(output_t& output, const input_t& input)
                 tested_face_plane_normal_max_comp = compute_polygon_plane_coefficients(
                     tested_face_plane_normal,
                     tested_face_plane_param_d,
-                    tested_face_vertices.data(),
+                    tested_face_vertices.begin(),
                     (int)tested_face_vertices.size());
             }
             return output_res;
@@ -2077,8 +1651,10 @@ void dispatch(output_t& output, const input_t& input)
             ps_tested_face_to_plane_normal,
             ps_tested_face_to_plane_normal_d_param,
             ps_tested_face_to_plane_normal_max_comp,
-            ps_tested_face_to_vertices)
+            ps_tested_face_to_vertices,
+            std::ignore)
             = partial_res;
+        ps_tested_face_vertex_arrays.push_back(std::move(std::get<4>(partial_res))); // NOTE: moving keeps the views valid
         // merge results from other threads
 
         for (int i = 0; i < (int)futures.size(); ++i) {
@@ -2091,7 +1667,7 @@ void dispatch(output_t& output, const input_t& input)
             std::unordered_map<fd_t, vec3>& ps_tested_face_to_plane_normal_FUTURE = std::get<0>(future_res);
             std::unordered_map<fd_t, double>& ps_tested_face_to_plane_normal_d_param_FUTURE = std::get<1>(future_res);
             std::unordered_map<fd_t, int>& ps_tested_face_to_plane_normal_max_comp_FUTURE = std::get<2>(future_res);
-            std::unordered_map<fd_t, std::vector<vec3>>& ps_tested_face_to_vertices_FUTURE = std::get<3>(future_res);
+            std::unordered_map<fd_t, array_view_t<vec3>>& ps_tested_face_to_vertices_FUTURE = std::get<3>(future_res);
 
             ps_tested_face_to_plane_normal.insert(
                 ps_tested_face_to_plane_normal_FUTURE.cbegin(),
@@ -2108,6 +1684,8 @@ void dispatch(output_t& output, const input_t& input)
             ps_tested_face_to_vertices.insert(
                 ps_tested_face_to_vertices_FUTURE.cbegin(),
                 ps_tested_face_to_vertices_FUTURE.cend());
+
+            ps_tested_face_vertex_arrays.push_back(std::move(std::get<4>(future_res)));
         }
 
     } // end of parallel scope
@@ -2116,6 +1694,18 @@ void dispatch(output_t& output, const input_t& input)
     // NOTE: the keys of input.ps_face_to_potentially_intersecting_others are the potentially colliding polygons
     // that we get after BVH traversal
     {
+        ps_tested_face_vertex_arrays.resize(1);
+        std::vector<vec3>& ps_tested_face_vertex_array = ps_tested_face_vertex_arrays.back();
+
+        // reserve the whole array first since views into it are created while it is filled
+        std::size_t vertex_count = 0;
+        for (std::map<fd_t, std::vector<fd_t>>::const_iterator tested_faces_iter = input.ps_face_to_potentially_intersecting_others->cbegin();
+             tested_faces_iter != input.ps_face_to_potentially_intersecting_others->cend();
+             tested_faces_iter++) {
+            vertex_count += ps.get_halfedges_around_face(tested_faces_iter->first).size();
+        }
+        ps_tested_face_vertex_array.reserve(vertex_count);
+
         std::vector<vd_t> tested_face_descriptors_tmp ;
     for (std::map<fd_t, std::vector<fd_t>>::const_iterator tested_faces_iter = input.ps_face_to_potentially_intersecting_others->cbegin();
          tested_faces_iter != input.ps_face_to_potentially_intersecting_others->cend();
@@ -2123,13 +1713,19 @@ void dispatch(output_t& output, const input_t& input)
         // get the vertices of tested_face (used to estimate its normal etc.)
         ps.get_vertices_around_face(tested_face_descriptors_tmp, tested_faces_iter->first);
         const std::vector<vd_t> &tested_face_descriptors = tested_face_descriptors_tmp;
-        std::vector<vec3>& tested_face_vertices = ps_tested_face_to_vertices[tested_faces_iter->first]; // insert and get reference
+        const std::size_t tested_face_vertices_offset = ps_tested_face_vertex_array.size();
 
         for (std::vector<vd_t>::const_iterator it = tested_face_descriptors.cbegin(); it != tested_face_descriptors.cend(); ++it) {
             const vec3& vertex = ps.vertex(*it);
-            tested_face_vertices.push_back(vertex);
+            ps_tested_face_vertex_array.push_back(vertex);
         }
 
+        MCUT_ASSERT(ps_tested_face_vertex_array.size() <= vertex_count); // i.e. no reallocation
+        const array_view_t<vec3> tested_face_vertices(
+            ps_tested_face_vertex_array.data() + tested_face_vertices_offset,
+            ps_tested_face_vertex_array.data() + ps_tested_face_vertex_array.size());
+        ps_tested_face_to_vertices[tested_faces_iter->first] = tested_face_vertices;
+
         vec3& tested_face_plane_normal = ps_tested_face_to_plane_normal[tested_faces_iter->first];
         double& tested_face_plane_param_d = ps_tested_face_to_plane_normal_d_param[tested_faces_iter->first];
         int& tested_face_plane_normal_max_comp = ps_tested_face_to_plane_normal_max_comp[tested_faces_iter->first];
@@ -2137,7 +1733,7 @@ void dispatch(output_t& output, const input_t& input)
         tested_face_plane_normal_max_comp = compute_polygon_plane_coefficients(
             tested_face_plane_normal,
             tested_face_plane_param_d,
-            tested_face_vertices.data(),
+            tested_face_vertices.begin(),
             (int)tested_face_vertices.size());
     }
     }
@@ -2218,8 +1814,8 @@ void dispatch(output_t& output, const input_t& input)
             OutputStorageTypesTuple;
 
         auto fn_compute_intersection_points = [&](
-                                                  std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator block_start_,
-                                                  std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator block_end_) -> OutputStorageTypesTuple {
+                                                  std::vector<ed_t>::const_iterator block_start_,
+                                                  std::vector<ed_t>::const_iterator block_end_) -> OutputStorageTypesTuple {
             OutputStorageTypesTuple local_output;
 
             std::vector<std::pair<ed_t, fd_t>>& m0_ivtx_to_intersection_registry_entry_LOCAL = std::get<0>(local_output);
@@ -2242,14 +1838,14 @@ void dispatch(output_t& output, const input_t& input)
             }
 
             // for each edge
-            for (std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator ps_edge_face_intersection_pairs_iter = block_start_;
+            for (std::vector<ed_t>::const_iterator ps_edge_face_intersection_pairs_iter = block_start_;
                  ps_edge_face_intersection_pairs_iter != block_end_;
                  ps_edge_face_intersection_pairs_iter++) {
 
                 // our edge that we test for intersection with other faces
-                const ed_t tested_edge = ps_edge_face_intersection_pairs_iter->first;
+                const ed_t tested_edge = *ps_edge_face_intersection_pairs_iter;
                 // the faces against which the edge is tested for intersection
-                const std::vector<fd_t>& tested_faces = ps_edge_face_intersection_pairs_iter->second;
+                const array_view_t<fd_t> tested_faces = ps_edge_face_intersection_pairs.faces_of((std::size_t)std::distance(ps_edge_face_intersection_pairs.edges.cbegin(), ps_edge_face_intersection_pairs_iter));
 
                 // the halfedges of our edge
                 const hd_t tested_edge_h0 = ps.halfedge(tested_edge, 0);
@@ -2269,7 +1865,7 @@ void dispatch(output_t& output, const input_t& input)
                 const bool tested_edge_belongs_to_cm = ps_is_cutmesh_face(tested_edge_face, sm_face_count);
 
                 // for each face that is to be intersected with the tested-edge
-                for (std::vector<fd_t>::const_iterator tested_faces_iter = tested_faces.cbegin();
+                for (array_view_t<fd_t>::const_iterator tested_faces_iter = tested_faces.cbegin();
                      tested_faces_iter != tested_faces.cend();
                      ++tested_faces_iter) {
                     const fd_t tested_face = *tested_faces_iter;
@@ -2279,7 +1875,7 @@ void dispatch(output_t& output, const input_t& input)
 
                     // get the vertices of tested_face (used to estimate its normal etc.)
                     MCUT_ASSERT(ps_tested_face_to_vertices.find(tested_face) != ps_tested_face_to_vertices.end());
-                    const std::vector<vec3>& tested_face_vertices = SAFE_ACCESS(ps_tested_face_to_vertices, tested_face);
+                    const array_view_t<vec3>& tested_face_vertices = SAFE_ACCESS(ps_tested_face_to_vertices, tested_face);
 
                     // compute plane of tested_face
                     // -----------------------
@@ -2296,7 +1892,8 @@ void dispatch(output_t& output, const input_t& input)
                     char segment_intersection_type = compute_segment_plane_intersection_type( // exact**
                         tested_edge_h0_source_vertex,
                         tested_edge_h0_target_vertex,
-                        tested_face_vertices,
+                        tested_face_vertices.begin(),
+                        (int)tested_face_vertices.size(),
                         tested_face_plane_normal,
                         tested_face_plane_normal_max_comp);
 
@@ -2318,7 +1915,8 @@ void dispatch(output_t& output, const input_t& input)
                                 const vec3& point = (*(*i));
                                 char result = compute_point_in_polygon_test(
                                     point,
-                                    tested_face_vertices,
+                                    tested_face_vertices.begin(),
+                                    (int)tested_face_vertices.size(),
                                     tested_face_plane_normal,
                                     tested_face_plane_normal_max_comp);
                                 if (result == 'i' || (result == 'v' || result == 'e')) {
@@ -2352,7 +1950,8 @@ void dispatch(output_t& output, const input_t& input)
 
                         char in_poly_test_intersection_type = compute_point_in_polygon_test(
                             intersection_point,
-                            tested_face_vertices,
+                            tested_face_vertices.begin(),
+                            (int)tested_face_vertices.size(),
                             //#if 1
                             tested_face_plane_normal,
                             //#else
@@ -2376,7 +1975,6 @@ void dispatch(output_t& output, const input_t& input)
                         if (have_point_in_polygon) {
 
                             fd_t face_pqr = tested_edge_face;
-                            fd_t face_xyz = tested_face;
                             fd_t face_pqs = tested_edge_face == tested_edge_h0_face ? tested_edge_h1_face : hmesh_t::null_face();
 
                             vd_t new_vertex_descr((vd_t::index_type)intersection_points_LOCAL.size());
@@ -2388,9 +1986,6 @@ void dispatch(output_t& output, const input_t& input)
 
                             ps_intersecting_edges_LOCAL[tested_edge].push_back(new_vertex_descr);
 
-                            const fd_t cm_face = tested_edge_belongs_to_cm ? tested_edge_face : tested_face;
-                            const fd_t sm_face = tested_edge_belongs_to_cm ? tested_face : tested_edge_face;
-
                             if (tested_edge_belongs_to_cm) {
                                 // NOTE: std::pair format/order is {source-mesh-face, cut-mesh-face}
                                 cutpath_edge_creation_info_LOCAL[make_pair(tested_face, face_pqr)].push_back(new_vertex_descr);
@@ -2430,7 +2025,7 @@ void dispatch(output_t& output, const input_t& input)
                         } // if (have_point_in_polygon)
                     } // if (have_plane_intersection) {
                 } // for (std::vector<fd_t>::const_iterator intersected_faces_iter = intersected_faces.cbegin(); intersected_faces_iter != intersected_faces.cend(); ++intersected_faces_iter) {
-            } // for (std::map<ed_t, std::vector<fd_t>>::const_iterator ps_edge_face_intersection_pairs_iter = ps_edge_face_intersection_pairs.cbegin(); ps_edge_face_intersection_pairs_iter != ps_edge_face_intersection_pairs.cend(); ps_edge_face_intersection_pairs_iter++) {
+            } // for each edge
 
             return local_output;
         };
@@ -2439,209 +2034,136 @@ void dispatch(output_t& output, const input_t& input)
         OutputStorageTypesTuple partial_res;
         parallel_fork_and_join(
             *input.scheduler,
-            ps_edge_face_intersection_pairs.cbegin(),
-            ps_edge_face_intersection_pairs.cend(),
+            ps_edge_face_intersection_pairs.edges.cbegin(),
+            ps_edge_face_intersection_pairs.edges.cend(),
             (1 << 6),
             fn_compute_intersection_points,
             partial_res, // output computed by master thread
             futures);
 
-        std::vector<vec3> intersection_points;
-        std::tie(
-            m0_ivtx_to_intersection_registry_entry,
-            cm_border_reentrant_ivtx_list,
-            ps_intersecting_edges,
-            cutpath_edge_creation_info,
-            ps_iface_to_ivtx_list,
-            partial_cut_detected,
-            intersection_points)
-            = partial_res;
-
-        // Add intersection points computed by master thread in to "m0" and
-        // account for intersection point offsets
-        for (std::vector<vec3>::const_iterator i = intersection_points.cbegin(); i != intersection_points.cend(); ++i) {
-            const vd_t stored_descr = m0.add_vertex(*i);
-            MCUT_ASSERT(stored_descr != hmesh_t::null_vertex());
-        }
+        // descriptor of the first intersection point of the next merged result
+        vd_t intersection_point_descr_baseoffset(m0.number_of_vertices());
+
+        // This lambda adds the intersection points computed for a block of edges into "m0" and merges
+        // the local data structures of the block (whose descriptors are relative to the block) into
+        // their corresponding global data structures.
+        auto merge_local_intersection_points = [&](const OutputStorageTypesTuple& local_result) {
+            const std::vector<std::pair<ed_t, fd_t>>& m0_ivtx_to_intersection_registry_entry_FUTURE = std::get<0>(local_result);
+            const std::vector<vd_t>& cm_border_reentrant_ivtx_list_FUTURE = std::get<1>(local_result);
+            const std::unordered_map<ed_t, std::vector<vd_t>>& ps_intersecting_edges_FUTURE = std::get<2>(local_result);
+            const std::map<pair<fd_t>, std::vector<vd_t>>& cutpath_edge_creation_info_FUTURE = std::get<3>(local_result);
+            const std::unordered_map<fd_t, std::vector<vd_t>>& ps_iface_to_ivtx_list_FUTURE = std::get<4>(local_result);
+            const bool& partial_cut_detected_FUTURE = std::get<5>(local_result);
+            const std::vector<vec3>& intersection_points_FUTURE = std::get<6>(local_result);
+            const uint32_t intersection_points_in_future = (uint32_t)intersection_points_FUTURE.size();
+
+            MCUT_ASSERT(intersection_points_FUTURE.size() == m0_ivtx_to_intersection_registry_entry_FUTURE.size());
+
+            // add intersection point corresponding to the current future
+            for (std::vector<vec3>::const_iterator it = intersection_points_FUTURE.cbegin();
+                 it != intersection_points_FUTURE.cend();
+                 ++it) {
+                const vd_t stored_descr = m0.add_vertex(*it);
+                MCUT_ASSERT(stored_descr != hmesh_t::null_vertex());
+                (void)stored_descr;
+            }
 
-        for (int i = 0; i < (int)cm_border_reentrant_ivtx_list.size(); ++i) {
-            cm_border_reentrant_ivtx_list[i] += ps_vtx_cnt;
-        }
+            // merge m0_ivtx_to_intersection_registry_entry_FUTURE
+            m0_ivtx_to_intersection_registry_entry.insert(
+                m0_ivtx_to_intersection_registry_entry.end(),
+                m0_ivtx_to_intersection_registry_entry_FUTURE.cbegin(),
+                m0_ivtx_to_intersection_registry_entry_FUTURE.cend());
 
-        for (std::unordered_map<ed_t, std::vector<vd_t>>::iterator i = ps_intersecting_edges.begin();
-             i != ps_intersecting_edges.end(); ++i) {
-            for (std::vector<vd_t>::iterator j = i->second.begin(); j != i->second.end(); j++) {
-                *j += ps_vtx_cnt;
+            // merge cm_border_reentrant_ivtx_list_FUTURE
+            for (std::vector<vd_t>::const_iterator it = cm_border_reentrant_ivtx_list_FUTURE.cbegin();
+                 it != cm_border_reentrant_ivtx_list_FUTURE.cend();
+                 ++it) {
+                const vd_t rel_descr = (*it);
+                const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
+                cm_border_reentrant_ivtx_list.push_back(actual_descr);
             }
-        }
 
-        for (std::unordered_map<fd_t, std::vector<vd_t>>::iterator i = ps_iface_to_ivtx_list.begin();
-             i != ps_iface_to_ivtx_list.end(); ++i) {
-            for (std::vector<vd_t>::iterator j = i->second.begin(); j != i->second.end(); j++) {
-                *j += ps_vtx_cnt;
+            // merge ps_intersecting_edges_FUTURE
+            for (std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator i = ps_intersecting_edges_FUTURE.cbegin();
+                 i != ps_intersecting_edges_FUTURE.cend();
+                 ++i) {
+                std::vector<vd_t>& ivertices = ps_intersecting_edges[i->first]; // another block may also have encountered the same edge
+                for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
+                    const vd_t rel_descr = (*j);
+                    const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
+                    ivertices.push_back(actual_descr);
+                }
             }
-        }
 
-        for (std::map<pair<fd_t>, std::vector<vd_t>>::iterator i = cutpath_edge_creation_info.begin();
-             i != cutpath_edge_creation_info.end(); ++i) {
-            for (std::vector<vd_t>::iterator j = i->second.begin(); j != i->second.end(); j++) {
-                *j += ps_vtx_cnt;
+            // merge cutpath_edge_creation_info_FUTURE
+            for (std::map<pair<fd_t>, std::vector<vd_t>>::const_iterator i = cutpath_edge_creation_info_FUTURE.cbegin();
+                 i != cutpath_edge_creation_info_FUTURE.cend();
+                 ++i) {
+                std::vector<vd_t>& ivertices = cutpath_edge_creation_info[i->first]; // another block may also have encountered the same key
+                for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
+                    const vd_t rel_descr = (*j);
+                    const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
+                    ivertices.push_back(actual_descr);
+                }
             }
-        }
-
-        //
-        // Now we merge the results from futures
-
-        bool status_is_okay = true;
 
-        if (futures.empty()) { // only master thred
-            status_is_okay = (output.status.load() == status_t::SUCCESS);
-            if (!status_is_okay) {
-                return;
+            // merge ps_iface_to_ivtx_list_FUTURE
+            for (std::unordered_map<fd_t, std::vector<vd_t>>::const_iterator i = ps_iface_to_ivtx_list_FUTURE.cbegin();
+                 i != ps_iface_to_ivtx_list_FUTURE.cend();
+                 ++i) {
+                std::vector<vd_t>& ivertices = ps_iface_to_ivtx_list[i->first]; // another block may also have encountered the same face
+                for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
+                    const vd_t rel_descr = (*j);
+                    const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
+                    ivertices.push_back(actual_descr);
+                }
             }
-        } else { // one or more worker threads
-
-            //
-            // This scope is executed by the master thread, which will merge results from other threads via std::futures
-            //
-            vd_t intersection_point_descr_baseoffset(m0.number_of_vertices());
 
-            // iterate through all available future so that we can 1) get their results
-            // and 2) ensure that all scheduled jobs are completed before exiting (or returning from)
-            // the kernel
-            for (int i_ = 0; i_ < (int)futures.size(); ++i_) {
+            // merge (i.e. boolean-wise OR) partial_cut_detected_FUTURE
+            partial_cut_detected = (partial_cut_detected || partial_cut_detected_FUTURE) ? true : false;
 
-                std::future<OutputStorageTypesTuple>& f = futures[i_];
-                MCUT_ASSERT(f.valid()); // The behavior is undefined if valid()== false before the call to wait_for
+            // shift to account for the (number of) intersection points computed in the current future
+            intersection_point_descr_baseoffset += intersection_points_in_future;
+        };
 
-                OutputStorageTypesTuple future_result = f.get(); // "get()" is a blocking function
+        //
+        // Now we merge the results in the order of the blocks of edges i.e. the futures first and then
+        // the output of the master thread (which computed the last block). Thus, intersection points
+        // are numbered as in the single-threaded build regardless of how many threads there are.
 
-                // As the master thread works to merge the partial results, it is possible that one of the
-                // worker threads detected a violation of general position. In this case, the current dispatch call
-                // needs to be stopped so that the front-end will be able to perturb the cut-mesh.
-                //
-                // Thus, we ask "did any worker-thread encounter a GP violation?" If so, we must stop all merging
-                // of partial results [and] wait for the currently running jobs (futures) to finish. Waiting is
-                // done automatically by calling f.get()
-                status_is_okay = (output.status.load() == status_t::SUCCESS);
+        bool status_is_okay = true;
 
-                if (!status_is_okay) {
-                    continue; // skip future result
-                }
+        // iterate through all available future so that we can 1) get their results
+        // and 2) ensure that all scheduled jobs are completed before exiting (or returning from)
+        // the kernel
+        for (int i_ = 0; i_ < (int)futures.size(); ++i_) {
 
-                const std::vector<std::pair<ed_t, fd_t>>& m0_ivtx_to_intersection_registry_entry_FUTURE = std::get<0>(future_result);
-                const std::vector<vd_t>& cm_border_reentrant_ivtx_list_FUTURE = std::get<1>(future_result);
-                const std::unordered_map<ed_t, std::vector<vd_t>>& ps_intersecting_edges_FUTURE = std::get<2>(future_result);
-                const std::map<pair<fd_t>, std::vector<vd_t>>& cutpath_edge_creation_info_FUTURE = std::get<3>(future_result);
-                const std::unordered_map<fd_t, std::vector<vd_t>>& ps_iface_to_ivtx_list_FUTURE = std::get<4>(future_result);
-                const bool& partial_cut_detected_FUTURE = std::get<5>(future_result);
-                const std::vector<vec3>& intersection_points_FUTURE = std::get<6>(future_result);
-                const uint32_t intersection_points_in_future = (uint32_t)intersection_points_FUTURE.size();
-
-                MCUT_ASSERT(intersection_points_FUTURE.size() == m0_ivtx_to_intersection_registry_entry_FUTURE.size());
-
-                // add intersection point corresponding to the current future
-                for (std::vector<vec3>::const_iterator it = intersection_points_FUTURE.cbegin();
-                     it != intersection_points_FUTURE.cend();
-                     ++it) {
-                    const vd_t stored_descr = m0.add_vertex(*it);
-                    MCUT_ASSERT(stored_descr != hmesh_t::null_vertex());
-                }
+            std::future<OutputStorageTypesTuple>& f = futures[i_];
+            MCUT_ASSERT(f.valid()); // The behavior is undefined if valid()== false before the call to wait_for
 
-                // merge m0_ivtx_to_intersection_registry_entry_FUTURE
-                m0_ivtx_to_intersection_registry_entry.insert(
-                    m0_ivtx_to_intersection_registry_entry.end(),
-                    m0_ivtx_to_intersection_registry_entry_FUTURE.cbegin(),
-                    m0_ivtx_to_intersection_registry_entry_FUTURE.cend());
-
-                // merge cm_border_reentrant_ivtx_list_FUTURE
-                for (std::vector<vd_t>::const_iterator it = cm_border_reentrant_ivtx_list_FUTURE.cbegin();
-                     it != cm_border_reentrant_ivtx_list_FUTURE.cend();
-                     ++it) {
-                    const vd_t rel_descr = (*it);
-                    const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                    cm_border_reentrant_ivtx_list.push_back(actual_descr);
-                }
+            OutputStorageTypesTuple future_result = f.get(); // "get()" is a blocking function
 
-                // merge ps_intersecting_edges_FUTURE
-                for (std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator i = ps_intersecting_edges_FUTURE.cbegin();
-                     i != ps_intersecting_edges_FUTURE.cend();
-                     ++i) {
-                    std::unordered_map<ed_t, std::vector<vd_t>>::iterator fiter = ps_intersecting_edges.find(i->first);
-                    bool collision = (fiter != ps_intersecting_edges.end());
-                    if (collision) { // another thread also encounter the same edge
-                        for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                            const vd_t rel_descr = (*j);
-                            const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                            if (std::find(fiter->second.cbegin(), fiter->second.cend(), *j) == fiter->second.cend()) {
-                                fiter->second.push_back(actual_descr);
-                            }
-                        }
-                    } else {
-                        // just insert and account for offset
-                        for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                            const vd_t rel_descr = (*j);
-                            const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                            ps_intersecting_edges[i->first].push_back(actual_descr);
-                        }
-                    }
-                }
+            // As the master thread works to merge the partial results, it is possible that one of the
+            // worker threads detected a violation of general position. In this case, the current dispatch call
+            // needs to be stopped so that the front-end will be able to perturb the cut-mesh.
+            //
+            // Thus, we ask "did any worker-thread encounter a GP violation?" If so, we must stop all merging
+            // of partial results [and] wait for the currently running jobs (futures) to finish. Waiting is
+            // done automatically by calling f.get()
+            status_is_okay = (output.status.load() == status_t::SUCCESS);
 
-                // merge cutpath_edge_creation_info_FUTURE
-                for (std::map<pair<fd_t>, std::vector<vd_t>>::const_iterator i = cutpath_edge_creation_info_FUTURE.cbegin();
-                     i != cutpath_edge_creation_info_FUTURE.cend();
-                     ++i) {
-                    std::map<pair<fd_t>, std::vector<vd_t>>::iterator fiter = cutpath_edge_creation_info.find(i->first);
-                    bool collision = (fiter != cutpath_edge_creation_info.end());
-                    if (collision) { // another thread also encounter the same key
-                        for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                            const vd_t rel_descr = (*j);
-                            const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                            if (std::find(fiter->second.cbegin(), fiter->second.cend(), actual_descr) == fiter->second.cend()) {
-                                fiter->second.push_back(actual_descr);
-                            }
-                        }
-                    } else {
-                        // just insert and account for offset
-                        for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                            const vd_t rel_descr = (*j);
-                            const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                            cutpath_edge_creation_info[i->first].push_back(actual_descr);
-                        }
-                    }
-                }
+            if (!status_is_okay) {
+                continue; // skip future result
+            }
 
-                // merge ps_iface_to_ivtx_list_FUTURE
-                for (std::unordered_map<fd_t, std::vector<vd_t>>::const_iterator i = ps_iface_to_ivtx_list_FUTURE.cbegin();
-                     i != ps_iface_to_ivtx_list_FUTURE.cend();
-                     ++i) {
-                    std::unordered_map<fd_t, std::vector<vd_t>>::iterator fiter = ps_iface_to_ivtx_list.find(i->first);
-                    bool collision = (fiter != ps_iface_to_ivtx_list.end());
-                    if (collision) { // another thread also encounter the same face
-                        for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                            const vd_t rel_descr = (*j);
-                            const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                            if (std::find(fiter->second.cbegin(), fiter->second.cend(), actual_descr) == fiter->second.cend()) {
-                                fiter->second.push_back(actual_descr);
-                            }
-                        }
-                    } else {
-                        // just insert and account for offset
-                        for (std::vector<vd_t>::const_iterator j = i->second.cbegin(); j != i->second.cend(); ++j) {
-                            const vd_t rel_descr = (*j);
-                            const vd_t actual_descr = vd_t(intersection_point_descr_baseoffset + rel_descr);
-                            ps_iface_to_ivtx_list[i->first].push_back(actual_descr);
-                        }
-                    }
-                }
+            merge_local_intersection_points(future_result);
+        }
 
-                // merge (i.e. boolean-wise OR) partial_cut_detected_FUTURE
-                partial_cut_detected = (partial_cut_detected || partial_cut_detected_FUTURE) ? true : false;
+        status_is_okay = (output.status.load() == status_t::SUCCESS);
 
-                // shift to account for the (number of) intersection points computed in the current future
-                intersection_point_descr_baseoffset += intersection_points_in_future;
-            } // while(!futures.empty()) {
-        } // if(num_blocks > 1)
+        if (status_is_okay) {
+            merge_local_intersection_points(partial_res);
+        }
 
         if (!status_is_okay) {
             // Safely return to the front-end since all jobs are now successively finished/cancelled.
@@ -2653,14 +2175,14 @@ void dispatch(output_t& output, const input_t& input)
         }
     } // end of parallel execution scope
 #else
-    for (std::unordered_map<ed_t, std::vector<fd_t>>::const_iterator ps_edge_face_intersection_pairs_iter = ps_edge_face_intersection_pairs.cbegin();
-         ps_edge_face_intersection_pairs_iter != ps_edge_face_intersection_pairs.cend();
-         ps_edge_face_intersection_pairs_iter++) {
+    for (std::size_t ps_edge_face_intersection_pairs_idx = 0;
+         ps_edge_face_intersection_pairs_idx < ps_edge_face_intersection_pairs.size();
+         ps_edge_face_intersection_pairs_idx++) {
 
         // our edge that we test for intersection with other faces
-        const ed_t tested_edge = ps_edge_face_intersection_pairs_iter->first;
+        const ed_t tested_edge = SAFE_ACCESS(ps_edge_face_intersection_pairs.edges, ps_edge_face_intersection_pairs_idx);
         // the faces against which the edge is tested for intersection
-        const std::vector<fd_t>& tested_faces = ps_edge_face_intersection_pairs_iter->second;
+        const array_view_t<fd_t> tested_faces = ps_edge_face_intersection_pairs.faces_of(ps_edge_face_intersection_pairs_idx);
 
         // the halfedges of our edge
         const hd_t tested_edge_h0 = ps.halfedge(tested_edge, 0);
@@ -2680,7 +2202,7 @@ void dispatch(output_t& output, const input_t& input)
         const bool tested_edge_belongs_to_cm = ps_is_cutmesh_face(tested_edge_face, sm_face_count);
 
         // for each face that is to be intersected with the tested-edge
-        for (std::vector<fd_t>::const_iterator tested_faces_iter = tested_faces.cbegin();
+        for (array_view_t<fd_t>::const_iterator tested_faces_iter = tested_faces.cbegin();
              tested_faces_iter != tested_faces.cend();
              ++tested_faces_iter) {
             const fd_t tested_face = *tested_faces_iter;
@@ -2691,7 +2213,7 @@ void dispatch(output_t& output, const input_t& input)
             // get the vertices of tested_face (used to estimate its normal etc.)
             // std::vector<vd_t> tested_face_descriptors = ps.get_vertices_around_face(tested_face);
             MCUT_ASSERT(ps_tested_face_to_vertices.find(tested_face) != ps_tested_face_to_vertices.end());
-            const std::vector<vec3>& tested_face_vertices = SAFE_ACCESS(ps_tested_face_to_vertices, tested_face);
+            const array_view_t<vec3>& tested_face_vertices = SAFE_ACCESS(ps_tested_face_to_vertices, tested_face);
 
             // compute plane of tested_face
             // -----------------------
@@ -2712,7 +2234,7 @@ void dispatch(output_t& output, const input_t& input)
                 intersection_point,
                 tested_edge_h0_source_vertex,
                 tested_edge_h0_target_vertex,
-                tested_face_vertices.data(),
+                tested_face_vertices.begin(),
                 tested_face_vertices.size(),
                 tested_face_plane_normal_max_comp,
                 tested_face_plane_normal,
@@ -2721,7 +2243,8 @@ void dispatch(output_t& output, const input_t& input)
             char segment_intersection_type = compute_segment_plane_intersection_type( // exact**
                 tested_edge_h0_source_vertex,
                 tested_edge_h0_target_vertex,
-                tested_face_vertices,
+                tested_face_vertices.begin(),
+                (int)tested_face_vertices.size(),
                 tested_face_plane_normal,
                 tested_face_plane_normal_max_comp);
 #endif
@@ -2751,7 +2274,8 @@ void dispatch(output_t& output, const input_t& input)
                         const vec3& point = (*(*i));
                         char result = compute_point_in_polygon_test(
                             point,
-                            tested_face_vertices,
+                            tested_face_vertices.begin(),
+                            (int)tested_face_vertices.size(),
                             tested_face_plane_normal,
                             tested_face_plane_normal_max_comp);
                         if (
@@ -2802,7 +2326,8 @@ void dispatch(output_t& output, const input_t& input)
                 // is our intersection point in the polygon?
                 char in_poly_test_intersection_type = compute_point_in_polygon_test(
                     intersection_point,
-                    tested_face_vertices,
+                    tested_face_vertices.begin(),
+                    (int)tested_face_vertices.size(),
                     tested_face_plane_normal,
                     tested_face_plane_normal_max_comp);
 
@@ -2845,6 +2370,7 @@ void dispatch(output_t& output, const input_t& input)
                     // hd_t halfedge_pq_opp = tested_edge_h1; // ps.opposite(halfedge_pq);
                     fd_t face_pqr = tested_edge_face; // the face which is incident to halfedge-pq
                     fd_t face_xyz = tested_face; // the face which is intersected with halfedge-pq
+                    (void)face_xyz; // only used by the disabled code below
                     fd_t face_pqs = tested_edge_face == tested_edge_h0_face ? tested_edge_h1_face : hmesh_t::null_face(); // ps.face(halfedge_pq_opp); // the face which is incident to the halfedge opposite to halfedge-pq
                                                                                                                           // fd_t face_pqX = hmesh_t::null_face(); // a virtual face pqX (where X denotes an unspecified auxiliary point)
 
@@ -2917,9 +2443,6 @@ void dispatch(output_t& output, const input_t& input)
 
                     // intersection_test_ivtx_list.push_back(new_vertex_descr);
 
-                    const fd_t cm_face = tested_edge_belongs_to_cm ? tested_edge_face : tested_face;
-                    const fd_t sm_face = tested_edge_belongs_to_cm ? tested_face : tested_edge_face;
-
                     if (tested_edge_belongs_to_cm) {
                         // "tested_face" is from the source mesh
 
@@ -2978,7 +2501,7 @@ void dispatch(output_t& output, const input_t& input)
             } // if (have_plane_intersection) {
         } // for (std::vector<fd_t>::const_iterator intersected_faces_iter = intersected_faces.cbegin(); intersected_faces_iter != intersected_faces.cend(); ++intersected_faces_iter) {
 
-    } // for (std::map<ed_t, std::vector<fd_t>>::const_iterator ps_edge_face_intersection_pairs_iter = ps_edge_face_intersection_pairs.cbegin(); ps_edge_face_intersection_pairs_iter != ps_edge_face_intersection_pairs.cend(); ps_edge_face_intersection_pairs_iter++) {
+    } // for each edge
 #endif
 
     // Create edges from the new intersection points
@@ -3127,9 +2650,7 @@ void dispatch(output_t& output, const input_t& input)
          cutpath_edge_creation_info_iter != cutpath_edge_creation_info.cend();
          ++cutpath_edge_creation_info_iter) {
 
-        const fd_t sm_face = cutpath_edge_creation_info_iter->first.first;
-        const fd_t cm_face = cutpath_edge_creation_info_iter->first.second;
-        MCUT_ASSERT(!ps_is_cutmesh_face(sm_face, sm_face_count));
+        MCUT_ASSERT(!ps_is_cutmesh_face(cutpath_edge_creation_info_iter->first.first, sm_face_count));
         const std::vector<vd_t>& intersection_test_ivtx_list = cutpath_edge_creation_info_iter->second;
         if ((int)intersection_test_ivtx_list.size() < 2) {
             const vd_t ivtx = intersection_test_ivtx_list.back();
@@ -3318,11 +2839,12 @@ void dispatch(output_t& output, const input_t& input)
                         int shared_face_normal_max_comp = SAFE_ACCESS(ps_tested_face_to_plane_normal_max_comp, shared_face);
 
                         MCUT_ASSERT(ps_tested_face_to_vertices.find(shared_face) != ps_tested_face_to_vertices.cend());
-                        const std::vector<vec3>& shared_face_vertices = SAFE_ACCESS(ps_tested_face_to_vertices, shared_face);
+                        const array_view_t<vec3>& shared_face_vertices = SAFE_ACCESS(ps_tested_face_to_vertices, shared_face);
 
                         char in_poly_test_intersection_type = compute_point_in_polygon_test(
                             midpoint,
-                            shared_face_vertices,
+                            shared_face_vertices.begin(),
+                            (int)shared_face_vertices.size(),
                             shared_face_plane_normal,
                             shared_face_normal_max_comp);
 
@@ -3407,172 +2929,247 @@ void dispatch(output_t& output, const input_t& input)
     //... every intersection point is connected to at least onecut-path edge
     MCUT_ASSERT(m0_ivtx_to_cutpath_edges.empty() == false);
 
-    // build implicit cut-path sequences (a sorted set of connected edges)
-    // -----------------------------------------------------------------------
+    // label the connected components of the cut-path edges
+    // ----------------------------------------------------
 
-    // An "implicit" cut-path sequence is a list of cut-path edges that are sorted (i.e.
-    // this means that in memory, edges are placed next to others they connect to).
+    // Each connected set of cut-path edges forms one cut-path. We find these sets with
+    // a union-find over the intersection points (the edges can be merged in parallel).
 
-    std::vector<std::vector<ed_t>> m0_cutpath_sequences;
-    std::unordered_map<vd_t, int> m0_ivtx_to_cutpath_sequence;
-    std::unordered_map<ed_t, int> m0_edge_to_cutpath_sequence;
+    const uint32_t m0_ivtx_count = (uint32_t)m0.number_of_vertices() - (uint32_t)ps_vtx_cnt;
+    disjoint_set_t m0_ivtx_components(m0_ivtx_count);
 
-    do { // an iteration will build a cut-path sequence
+    auto fn_unite_cutpath_edge_vertices = [&](std::vector<ed_t>::const_iterator block_start_, std::vector<ed_t>::const_iterator block_end_) -> bool {
+        for (std::vector<ed_t>::const_iterator cutpath_edge_iter = block_start_; cutpath_edge_iter != block_end_; ++cutpath_edge_iter) {
+            const vd_t vertex0 = m0.vertex(*cutpath_edge_iter, 0);
+            const vd_t vertex1 = m0.vertex(*cutpath_edge_iter, 1);
+            MCUT_ASSERT(m0_is_intersection_point(vertex0, ps_vtx_cnt) && m0_is_intersection_point(vertex1, ps_vtx_cnt));
+            m0_ivtx_components.unite((uint32_t)vertex0 - ps_vtx_cnt, (uint32_t)vertex1 - ps_vtx_cnt);
+        }
+        return true;
+    };
 
-        // const int diff = (int)m0_ivtx_to_cutpath_edges.size() - (int)m0_ivtx_to_cutpath_sequence.size();
-        MCUT_ASSERT((int)m0_ivtx_to_cutpath_edges.size() - (int)m0_ivtx_to_cutpath_sequence.size() >= 2); // need a minimum of 2 intersection points (one edge) to form a sequence
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
 
-        int cur_cutpath_sequence_index = (int)m0_cutpath_sequences.size();
+        parallel_fork_and_join(
+            *input.scheduler,
+            m0_cutpath_edges.cbegin(),
+            m0_cutpath_edges.cend(),
+            (1 << 12),
+            fn_unite_cutpath_edge_vertices,
+            _1, // out
+            futures);
 
-        // start from an intersection point that is not yet mapped-to/associated-with a
-        //  sequence in "cur_cutpath_sequence"
-        // pick the vertex which is a terminal vertex (to start search from beginning of sequence)
-        // or any vertex (if there are not terminal vertices)
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
+        }
+    }
+#else
+    fn_unite_cutpath_edge_vertices(m0_cutpath_edges.cbegin(), m0_cutpath_edges.cend());
+#endif
 
-        // find any intersection point which is not associated with a cut-path and is connected to one edge (terminal vertex)
-        std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator m0_ivtx_to_cutpath_edges_iter = std::find_if(
-            m0_ivtx_to_cutpath_edges.cbegin(), m0_ivtx_to_cutpath_edges.cend(),
-            [&](const std::pair<vd_t, std::vector<ed_t>>& elem) {
-                bool is_mapped = m0_ivtx_to_cutpath_sequence.find(elem.first) != m0_ivtx_to_cutpath_sequence.cend();
-                bool is_connected_to_one_edge = elem.second.size() == 1;
-                return (!is_mapped && is_connected_to_one_edge);
-            });
+    // build implicit cut-path sequences (a sorted set of connected edges)
+    // -----------------------------------------------------------------------
 
-        if (m0_ivtx_to_cutpath_edges_iter == m0_ivtx_to_cutpath_edges.cend()) { // we could not find any intersection point from above
-            // find any intersection point which is not mapped to a cut-path (less strict condition that above)
-            m0_ivtx_to_cutpath_edges_iter = std::find_if(
-                m0_ivtx_to_cutpath_edges.cbegin(), m0_ivtx_to_cutpath_edges.cend(),
-                [&](const std::pair<vd_t, std::vector<ed_t>>& elem) {
-                    bool is_mapped = m0_ivtx_to_cutpath_sequence.find(elem.first) != m0_ivtx_to_cutpath_sequence.cend();
-                    return !is_mapped;
-                });
+    // An "implicit" cut-path sequence is a list of cut-path edges that are sorted (i.e.
+    // this means that in memory, edges are placed next to others they connect to).
+
+    // Choose where each sequence starts. A linear cut-path starts from a terminal
+    // vertex (i.e. one that is connected to one edge) and a circular one from any
+    // vertex. Sequences are numbered in the order in which "m0_ivtx_to_cutpath_edges"
+    // visits their starting vertex, with the linear sequences first.
+
+    // MapKey=component label (see "m0_ivtx_components")
+    // MapValue=intersection point at which the sequence of the component starts
+    std::vector<vd_t> m0_component_to_first_terminal_ivtx(m0_ivtx_count, hmesh_t::null_vertex());
+    std::vector<vd_t> m0_component_to_first_ivtx(m0_ivtx_count, hmesh_t::null_vertex());
+    std::vector<uint32_t> m0_linear_components; // ... in order of their first terminal vertex
+    std::vector<uint32_t> m0_components; // ... in order of their first vertex
+
+    const std::vector<std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator> m0_ivtx_to_cutpath_edges_visit_order = get_map_visit_order(m0_ivtx_to_cutpath_edges, input.deterministic);
+
+    for (std::vector<std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator>::const_iterator visit_iter = m0_ivtx_to_cutpath_edges_visit_order.cbegin();
+         visit_iter != m0_ivtx_to_cutpath_edges_visit_order.cend();
+         ++visit_iter) {
+        const std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator& m0_ivtx_to_cutpath_edges_iter = *visit_iter;
+        const vd_t ivtx = m0_ivtx_to_cutpath_edges_iter->first;
+        const uint32_t component = m0_ivtx_components.find((uint32_t)ivtx - ps_vtx_cnt);
+
+        if (m0_component_to_first_ivtx[component] == hmesh_t::null_vertex()) {
+            m0_component_to_first_ivtx[component] = ivtx;
+            m0_components.push_back(component);
         }
 
-        if (m0_ivtx_to_cutpath_edges_iter == m0_ivtx_to_cutpath_edges.cend()) { // still could not find any unmapped intersection point
-            break; // done (found all implicit cut paths)
+        const bool is_connected_to_one_edge = m0_ivtx_to_cutpath_edges_iter->second.size() == 1;
+
+        if (is_connected_to_one_edge && m0_component_to_first_terminal_ivtx[component] == hmesh_t::null_vertex()) {
+            m0_component_to_first_terminal_ivtx[component] = ivtx;
+            m0_linear_components.push_back(component);
         }
+    }
 
-        // start new sequence of edges
-        // ---------------------------
-
-        m0_cutpath_sequences.emplace_back(std::vector<ed_t>());
-        std::vector<ed_t>& cur_cutpath_sequence = m0_cutpath_sequences.back();
-
-        // vertex at the beginning of the sequence
-        const vd_t& first_vertex_of_sequence = m0_ivtx_to_cutpath_edges_iter->first;
-
-        // the edges connected to our first intersection point
-        const std::vector<ed_t>& cutpath_edges_connected_to_first_vertex = m0_ivtx_to_cutpath_edges_iter->second;
-
-        // pick the edge that is not yet mapped-to/associated-with a  cut-path
-        // sequence in "cur_cutpath_sequence". Note: if the current sequence
-        // is linear, then there is no possibility that one of the edges
-        // in "cutpath_edges_connected_to_first_vertex" has already been mapped-to/associated-with
-        // a disjoint cut-path sequence in "cur_cutpath_sequence".
-        // This is because sequence discovery starts by first searching from terminal vertices/edges
-        // (see above conditions).
-        std::vector<ed_t>::const_iterator incident_edge_find_iter = std::find_if(
-            cutpath_edges_connected_to_first_vertex.cbegin(),
-            cutpath_edges_connected_to_first_vertex.cend(),
-            [&](const ed_t& incident_edge) {
-                return m0_edge_to_cutpath_sequence.find(incident_edge) == m0_edge_to_cutpath_sequence.cend();
-            });
+    // the vertex and edge from which each sequence starts
+    std::vector<std::pair<vd_t, ed_t>> m0_cutpath_sequence_seeds;
+    m0_cutpath_sequence_seeds.reserve(m0_components.size());
+
+    for (std::vector<uint32_t>::const_iterator it = m0_linear_components.cbegin(); it != m0_linear_components.cend(); ++it) {
+        const vd_t first_vertex_of_sequence = m0_component_to_first_terminal_ivtx[*it];
+        const std::vector<ed_t>& cutpath_edges_connected_to_first_vertex = SAFE_ACCESS(m0_ivtx_to_cutpath_edges, first_vertex_of_sequence);
+        m0_cutpath_sequence_seeds.emplace_back(first_vertex_of_sequence, cutpath_edges_connected_to_first_vertex.front());
+    }
 
-        MCUT_ASSERT(incident_edge_find_iter != cutpath_edges_connected_to_first_vertex.cend());
+    for (std::vector<uint32_t>::const_iterator it = m0_components.cbegin(); it != m0_components.cend(); ++it) {
+        if (m0_component_to_first_terminal_ivtx[*it] != hmesh_t::null_vertex()) {
+            continue; // linear
+        }
 
-        const ed_t& first_edge = *incident_edge_find_iter;
+        const vd_t first_vertex_of_sequence = m0_component_to_first_ivtx[*it];
+        const std::vector<ed_t>& cutpath_edges_connected_to_first_vertex = SAFE_ACCESS(m0_ivtx_to_cutpath_edges, first_vertex_of_sequence);
+        m0_cutpath_sequence_seeds.emplace_back(first_vertex_of_sequence, cutpath_edges_connected_to_first_vertex.front());
+    }
 
-        // now we will iteratively add edges into the current sequence, starting from "first_edge".
-        // the next added edge is alway one which share's the "next_vertex" with the current.
-        // ----------------------------------------------------------------------------------------
+    MCUT_ASSERT(m0_cutpath_sequence_seeds.size() == m0_components.size());
 
-        vd_t current_vertex = hmesh_t::null_vertex();
-        ed_t current_edge = hmesh_t::null_edge();
-        vd_t next_vertex = first_vertex_of_sequence; // ... initial intersection point
-        ed_t next_edge = first_edge;
+    m0_component_to_first_terminal_ivtx.clear(); // free
+    m0_component_to_first_ivtx.clear(); // free
 
-        do { // an iteration will add an edge to the current cut-path sequence
+    std::vector<std::vector<ed_t>> m0_cutpath_sequences(m0_cutpath_sequence_seeds.size());
+    // index of the sequence that each intersection point and cut-path edge is mapped to (-1 if none)
+    property_map_t<vd_t, int> m0_ivtx_to_cutpath_sequence = m0.add_property_map<vd_t, int>(-1);
+    property_map_t<ed_t, int> m0_edge_to_cutpath_sequence = m0.add_property_map<ed_t, int>(-1);
 
-            // update state
-            current_vertex = next_vertex;
-            current_edge = next_edge;
+    // Now we build each sequence by iteratively adding edges, starting from the seed
+    // edge. The next added edge is alway one which share's the "next_vertex" with the
+    // current. The sequences are disjoint, so they are built in parallel.
+    auto fn_build_cutpath_sequences = [&](std::vector<std::pair<vd_t, ed_t>>::const_iterator block_start_, std::vector<std::pair<vd_t, ed_t>>::const_iterator block_end_) -> bool {
+        for (std::vector<std::pair<vd_t, ed_t>>::const_iterator seed_iter = block_start_; seed_iter != block_end_; ++seed_iter) {
 
-            // add edge
-            cur_cutpath_sequence.emplace_back(current_edge);
+            const int cur_cutpath_sequence_index = (int)std::distance(m0_cutpath_sequence_seeds.cbegin(), seed_iter);
+            std::vector<ed_t>& cur_cutpath_sequence = m0_cutpath_sequences[cur_cutpath_sequence_index];
 
-            // map vertex to current disjoint implicit cut-path sequence
-            MCUT_ASSERT(m0_ivtx_to_cutpath_sequence.count(current_vertex) == 0);
-            m0_ivtx_to_cutpath_sequence[current_vertex] = cur_cutpath_sequence_index;
-            MCUT_ASSERT(m0_ivtx_to_cutpath_sequence.count(current_vertex) == 1);
+            vd_t current_vertex = hmesh_t::null_vertex();
+            ed_t current_edge = hmesh_t::null_edge();
+            vd_t next_vertex = seed_iter->first; // ... initial intersection point
+            ed_t next_edge = seed_iter->second;
 
-            // map edge to current disjoint implicit cut-path sequence
-            MCUT_ASSERT(m0_edge_to_cutpath_sequence.count(current_edge) == 0);
-            m0_edge_to_cutpath_sequence[current_edge] = cur_cutpath_sequence_index;
-            MCUT_ASSERT(m0_edge_to_cutpath_sequence.count(current_edge) == 1);
+            MCUT_ASSERT(m0_edge_to_cutpath_sequence[next_edge] == -1);
 
-            // reset state
-            next_vertex = hmesh_t::null_vertex();
-            next_edge = hmesh_t::null_edge();
+            do { // an iteration will add an edge to the current cut-path sequence
 
-            // resolve next vertex (..since we don't know whether vertex0 or vertex1 is "current_vertex")
-            const vd_t current_edge_vertex0 = m0.vertex(current_edge, 0);
-            const vd_t current_edge_vertex1 = m0.vertex(current_edge, 1);
+                // update state
+                current_vertex = next_vertex;
+                current_edge = next_edge;
 
-            // "next_vertex" is whichever vertex of the current edge that is not
-            // equal to the "current_vertex"
-            if (current_vertex == current_edge_vertex0) {
-                next_vertex = current_edge_vertex1;
-            } else {
-                next_vertex = current_edge_vertex0;
-            }
+                // add edge
+                cur_cutpath_sequence.emplace_back(current_edge);
 
-            // now that we have the next vertex, we can determine the next edge
-            // ----------------------------------------------------------------
+                // map vertex to current disjoint implicit cut-path sequence
+                MCUT_ASSERT(m0_ivtx_to_cutpath_sequence[current_vertex] == -1);
+                m0_ivtx_to_cutpath_sequence[current_vertex] = cur_cutpath_sequence_index;
 
-            // check if next vertex has already been associated with the cut-path sequence.
-            bool reached_end_of_sequence = m0_ivtx_to_cutpath_sequence.find(next_vertex) != m0_ivtx_to_cutpath_sequence.cend();
+                // map edge to current disjoint implicit cut-path sequence
+                MCUT_ASSERT(m0_edge_to_cutpath_sequence[current_edge] == -1);
+                m0_edge_to_cutpath_sequence[current_edge] = cur_cutpath_sequence_index;
 
-            if (!reached_end_of_sequence) {
-                // get the other edge connected to "next_vertex" i.e. the edge which is not the "current_edge"
-                m0_ivtx_to_cutpath_edges_iter = m0_ivtx_to_cutpath_edges.find(next_vertex);
-                MCUT_ASSERT(m0_ivtx_to_cutpath_edges_iter != m0_ivtx_to_cutpath_edges.cend());
+                // reset state
+                next_vertex = hmesh_t::null_vertex();
+                next_edge = hmesh_t::null_edge();
 
-                const std::vector<ed_t>& cutpath_edges_connected_to_next_vertex = m0_ivtx_to_cutpath_edges_iter->second;
-                MCUT_ASSERT(cutpath_edges_connected_to_next_vertex.size() <= 2);
+                // resolve next vertex (..since we don't know whether vertex0 or vertex1 is "current_vertex")
+                const vd_t current_edge_vertex0 = m0.vertex(current_edge, 0);
+                const vd_t current_edge_vertex1 = m0.vertex(current_edge, 1);
 
-                bool current_edge_is_terminal = (cutpath_edges_connected_to_next_vertex.size() == 1);
+                // "next_vertex" is whichever vertex of the current edge that is not
+                // equal to the "current_vertex"
+                if (current_vertex == current_edge_vertex0) {
+                    next_vertex = current_edge_vertex1;
+                } else {
+                    next_vertex = current_edge_vertex0;
+                }
 
-                if (current_edge_is_terminal == false) {
-                    const ed_t& edge0 = cutpath_edges_connected_to_next_vertex.front();
-                    const ed_t& edge1 = cutpath_edges_connected_to_next_vertex.back();
-                    const ed_t& other_edge = (current_edge == edge0) ? edge1 : edge0;
+                // now that we have the next vertex, we can determine the next edge
+                // ----------------------------------------------------------------
 
-                    // check that "other_edge" has not already been mapped to a disjoint implicit cutpath sequence
-                    std::unordered_map<ed_t, int>::const_iterator find_iter = m0_edge_to_cutpath_sequence.find(other_edge);
-                    bool other_edge_is_already_mapped = (find_iter != m0_edge_to_cutpath_sequence.cend());
+                // check if next vertex has already been associated with the cut-path sequence.
+                bool reached_end_of_sequence = m0_ivtx_to_cutpath_sequence[next_vertex] != -1;
 
-                    if (other_edge_is_already_mapped == false) {
-                        next_edge = other_edge; // set sext edge
-                    } else {
-                        // reached end of sequence
-                        MCUT_ASSERT(m0_ivtx_to_cutpath_sequence.count(next_vertex) == 0);
-                        // need to update this state here because we wont jump back up to the top of the loop as in the normal case.
-                        // This is because "next_edge" is null, and the do-while loop continues iff "next_edge != hmesh_t::null_edge()"
-                        m0_ivtx_to_cutpath_sequence[next_vertex] = cur_cutpath_sequence_index;
+                if (!reached_end_of_sequence) {
+                    // get the other edge connected to "next_vertex" i.e. the edge which is not the "current_edge"
+                    std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator m0_ivtx_to_cutpath_edges_iter = m0_ivtx_to_cutpath_edges.find(next_vertex);
+                    MCUT_ASSERT(m0_ivtx_to_cutpath_edges_iter != m0_ivtx_to_cutpath_edges.cend());
 
-                        MCUT_ASSERT(m0_ivtx_to_cutpath_sequence.count(next_vertex) == 1);
+                    const std::vector<ed_t>& cutpath_edges_connected_to_next_vertex = m0_ivtx_to_cutpath_edges_iter->second;
+                    MCUT_ASSERT(cutpath_edges_connected_to_next_vertex.size() <= 2);
+
+                    bool current_edge_is_terminal = (cutpath_edges_connected_to_next_vertex.size() == 1);
+
+                    if (current_edge_is_terminal == false) {
+                        const ed_t& edge0 = cutpath_edges_connected_to_next_vertex.front();
+                        const ed_t& edge1 = cutpath_edges_connected_to_next_vertex.back();
+                        const ed_t& other_edge = (current_edge == edge0) ? edge1 : edge0;
+
+                        // check that "other_edge" has not already been mapped to a disjoint implicit cutpath sequence
+                        bool other_edge_is_already_mapped = m0_edge_to_cutpath_sequence[other_edge] != -1;
+
+                        if (other_edge_is_already_mapped == false) {
+                            next_edge = other_edge; // set sext edge
+                        } else {
+                            // reached end of sequence
+                            MCUT_ASSERT(m0_ivtx_to_cutpath_sequence[next_vertex] == -1);
+                            // need to update this state here because we wont jump back up to the top of the loop as in the normal case.
+                            // This is because "next_edge" is null, and the do-while loop continues iff "next_edge != hmesh_t::null_edge()"
+                            m0_ivtx_to_cutpath_sequence[next_vertex] = cur_cutpath_sequence_index;
+                        }
+                    } // if (current_edge_is_terminal == false) {
+                    else {
+                        m0_ivtx_to_cutpath_sequence[next_vertex] = cur_cutpath_sequence_index;
                     }
-                } // if (current_edge_is_terminal == false) {
-                else {
-                    m0_ivtx_to_cutpath_sequence[next_vertex] = cur_cutpath_sequence_index;
-                }
-            } // if (!reached_end_of_sequence) {
+                } // if (!reached_end_of_sequence) {
+
+                // while there is another edge to added to the current disjoint implicit cutpath sequence
+            } while (next_edge != hmesh_t::null_edge());
+        }
+        return true;
+    };
+
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
+
+        parallel_fork_and_join(
+            *input.scheduler,
+            m0_cutpath_sequence_seeds.cbegin(),
+            m0_cutpath_sequence_seeds.cend(),
+            (1 << 4),
+            fn_build_cutpath_sequences,
+            _1, // out
+            futures);
 
-            // while there is another edge to added to the current disjoint implicit cutpath sequence
-        } while (next_edge != hmesh_t::null_edge());
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
+        }
+    }
+#else
+    fn_build_cutpath_sequences(m0_cutpath_sequence_seeds.cbegin(), m0_cutpath_sequence_seeds.cend());
+#endif
 
-        // while not all intersection-points have been mapped to a disjoint implicit cutpath sequence
-    } while (m0_edge_to_cutpath_sequence.size() != m0_cutpath_edges.size());
+#ifndef NDEBUG
+    {
+        // every cut-path edge is now mapped to exactly one sequence
+        std::size_t m0_num_edges_mapped_to_cutpath_sequence = 0;
+        for (std::vector<std::vector<ed_t>>::const_iterator it = m0_cutpath_sequences.cbegin(); it != m0_cutpath_sequences.cend(); ++it) {
+            m0_num_edges_mapped_to_cutpath_sequence += it->size();
+        }
+        MCUT_ASSERT(m0_num_edges_mapped_to_cutpath_sequence == m0_cutpath_edges.size());
+    }
+#endif
 
     MCUT_ASSERT(m0_cutpath_sequences.empty() == false);
 
@@ -3581,7 +3178,7 @@ void dispatch(output_t& output, const input_t& input)
 
     m0_cutpath_edges.clear(); // free
 
-    m0_edge_to_cutpath_sequence.clear(); // free
+    m0.remove_property_map(m0_edge_to_cutpath_sequence); // free
     // m0_ivtx_to_cutpath_edges.clear();      // free
     // m0_cutpath_sequences.clear(); // free
 
@@ -3632,148 +3229,178 @@ void dispatch(output_t& output, const input_t& input)
     // if is_circular is true, then the cutpath is always severing.
     std::map<int, std::tuple<bool, bool, bool>> m0_cutpath_sequence_to_properties;
 
-    for (std::vector<std::vector<ed_t>>::const_iterator iter = m0_cutpath_sequences.cbegin();
-         iter != m0_cutpath_sequences.cend();
-         ++iter) {
+    // NOTE: all entries are created here so that the map is not modified (only its
+    // values) while the cutpaths are processed in parallel
+    for (int cutpath_index = 0; cutpath_index < (int)m0_cutpath_sequences.size(); ++cutpath_index) {
+        m0_cutpath_sequence_to_properties.emplace_hint(m0_cutpath_sequence_to_properties.cend(), cutpath_index, std::tuple<bool, bool, bool>());
+    }
 
-        const int cutpath_index = (int)std::distance(m0_cutpath_sequences.cbegin(), iter);
+    auto fn_infer_cutpath_properties = [&](std::vector<std::vector<ed_t>>::const_iterator block_start_, std::vector<std::vector<ed_t>>::const_iterator block_end_) -> bool {
+        for (std::vector<std::vector<ed_t>>::const_iterator iter = block_start_;
+             iter != block_end_;
+             ++iter) {
 
-        const std::vector<ed_t>& cutpath = *iter;
+            const int cutpath_index = (int)std::distance(m0_cutpath_sequences.cbegin(), iter);
 
-        MCUT_ASSERT(m0_cutpath_sequence_to_properties.count(cutpath_index) == 0);
-        m0_cutpath_sequence_to_properties[cutpath_index] = std::tuple<bool, bool, bool>();
+            const std::vector<ed_t>& cutpath = *iter;
 
-        MCUT_ASSERT(m0_cutpath_sequence_to_properties.count(cutpath_index) == 1);
+            MCUT_ASSERT(m0_cutpath_sequence_to_properties.count(cutpath_index) == 1);
 
-        std::tuple<bool, bool, bool>& properties = m0_cutpath_sequence_to_properties[cutpath_index];
-        bool& cutpath_is_linear = std::get<0>(properties);
-        bool& cutpath_is_hole = std::get<1>(properties);
-        bool& cutpath_is_srcmesh_severing = std::get<2>(properties); // i.e. the cutpath severs/partitions the src-mesh into two parts
+            std::tuple<bool, bool, bool>& properties = m0_cutpath_sequence_to_properties.find(cutpath_index)->second;
+            bool& cutpath_is_linear = std::get<0>(properties);
+            bool& cutpath_is_hole = std::get<1>(properties);
+            bool& cutpath_is_srcmesh_severing = std::get<2>(properties); // i.e. the cutpath severs/partitions the src-mesh into two parts
 
-        cutpath_is_linear = false;
-        cutpath_is_hole = false;
-        cutpath_is_srcmesh_severing = true;
+            cutpath_is_linear = false;
+            cutpath_is_hole = false;
+            cutpath_is_srcmesh_severing = true;
 
-        // check if it is a linear cut path
+            // check if it is a linear cut path
 
-        const ed_t& first_edge = cutpath.front();
-        const vd_t first_edge_vertex0 = m0.vertex(first_edge, 0);
-        const vd_t first_edge_vertex1 = m0.vertex(first_edge, 1);
-        bool first_edge_vertex0_is_terminal = m0_cutpath_terminal_vertices.find(first_edge_vertex0) != m0_cutpath_terminal_vertices.cend();
+            const ed_t& first_edge = cutpath.front();
+            const vd_t first_edge_vertex0 = m0.vertex(first_edge, 0);
+            const vd_t first_edge_vertex1 = m0.vertex(first_edge, 1);
+            bool first_edge_vertex0_is_terminal = m0_cutpath_terminal_vertices.find(first_edge_vertex0) != m0_cutpath_terminal_vertices.cend();
 
-        bool first_edge_is_terminal = first_edge_vertex0_is_terminal;
+            bool first_edge_is_terminal = first_edge_vertex0_is_terminal;
 
-        if (first_edge_vertex0_is_terminal == false) {
-            // check if vertex1 is terminal
-            bool first_edge_vertex1_is_terminal = m0_cutpath_terminal_vertices.find(first_edge_vertex1) != m0_cutpath_terminal_vertices.cend();
-            first_edge_is_terminal = first_edge_vertex1_is_terminal;
-        }
+            if (first_edge_vertex0_is_terminal == false) {
+                // check if vertex1 is terminal
+                bool first_edge_vertex1_is_terminal = m0_cutpath_terminal_vertices.find(first_edge_vertex1) != m0_cutpath_terminal_vertices.cend();
+                first_edge_is_terminal = first_edge_vertex1_is_terminal;
+            }
 
-        // note: by construction, if the first edge is terminal then the
-        // last edge will also be terminal (thus we could have used the
-        // last edge for the above tests too!)
-        cutpath_is_linear = first_edge_is_terminal;
+            // note: by construction, if the first edge is terminal then the
+            // last edge will also be terminal (thus we could have used the
+            // last edge for the above tests too!)
+            cutpath_is_linear = first_edge_is_terminal;
 
-        bool cutpath_is_circular = !cutpath_is_linear;
-        // check if a hole is created by the cutpath (which will need sealing later)
-        if (cutpath_is_circular) {
-            cutpath_is_hole = true;
-        } else {
-            // current cut path is [linear]. it creates a hole (in the source mesh) if both terminal vertices
-            // have a cut-mesh halfedge in their registry
+            bool cutpath_is_circular = !cutpath_is_linear;
+            // check if a hole is created by the cutpath (which will need sealing later)
+            if (cutpath_is_circular) {
+                cutpath_is_hole = true;
+            } else {
+                // current cut path is [linear]. it creates a hole (in the source mesh) if both terminal vertices
+                // have a cut-mesh halfedge in their registry
+
+                const vd_t& first_edge_terminal_vertex = (first_edge_vertex0_is_terminal ? first_edge_vertex0 : first_edge_vertex1);
+
+                // get the halfedge and check where is comes from (cut-mesh/source-mesh)
 
-            const vd_t& first_edge_terminal_vertex = (first_edge_vertex0_is_terminal ? first_edge_vertex0 : first_edge_vertex1);
+                std::map<vd_t, std::vector<std::pair<ed_t, fd_t>>::const_iterator>::const_iterator find_iter = m0_cutpath_terminal_vertices.cend();
+                find_iter = m0_cutpath_terminal_vertices.find(first_edge_terminal_vertex);
 
-            // get the halfedge and check where is comes from (cut-mesh/source-mesh)
+                MCUT_ASSERT(find_iter != m0_cutpath_terminal_vertices.cend());
 
-            std::map<vd_t, std::vector<std::pair<ed_t, fd_t>>::const_iterator>::const_iterator find_iter = m0_cutpath_terminal_vertices.cend();
-            find_iter = m0_cutpath_terminal_vertices.find(first_edge_terminal_vertex);
+                // TODO: These variable names are outdated
+                const ed_t& first_edge_terminal_vertex_edge = find_iter->second->first;
+                const hd_t first_edge_terminal_vertex_edge_h0 = ps.halfedge(first_edge_terminal_vertex_edge, 0);
+                fd_t ps_face_of_first_edge_terminal_vertex_he = ps.face(first_edge_terminal_vertex_edge_h0);
+                if (ps_face_of_first_edge_terminal_vertex_he == hmesh_t::null_face()) {
+                    hd_t first_edge_terminal_vertex_edge_h1 = ps.opposite(first_edge_terminal_vertex_edge_h0);
+                    ps_face_of_first_edge_terminal_vertex_he = ps.face(first_edge_terminal_vertex_edge_h1);
+                }
+
+                MCUT_ASSERT(ps_face_of_first_edge_terminal_vertex_he != hmesh_t::null_face());
 
-            MCUT_ASSERT(find_iter != m0_cutpath_terminal_vertices.cend());
+                bool is_from_cut_mesh = ps_is_cutmesh_face(ps_face_of_first_edge_terminal_vertex_he, sm_face_count);
+                bool is_from_src_mesh = !is_from_cut_mesh;
 
-            // TODO: These variable names are outdated
-            const ed_t& first_edge_terminal_vertex_edge = find_iter->second->first;
-            const hd_t first_edge_terminal_vertex_edge_h0 = ps.halfedge(first_edge_terminal_vertex_edge, 0);
-            fd_t ps_face_of_first_edge_terminal_vertex_he = ps.face(first_edge_terminal_vertex_edge_h0);
-            if (ps_face_of_first_edge_terminal_vertex_he == hmesh_t::null_face()) {
-                hd_t first_edge_terminal_vertex_edge_h1 = ps.opposite(first_edge_terminal_vertex_edge_h0);
-                ps_face_of_first_edge_terminal_vertex_he = ps.face(first_edge_terminal_vertex_edge_h1);
+                const bool first_vtx_is_from_src_mesh = is_from_src_mesh;
+                /*
+            if (is_from_src_mesh) {
+                cutpath_is_hole = false;
             }
+            else
+            {*/
+                // ... so the halfedge in the registry of "first_edge_terminal_vertex"
+                // belongs to the cut-mesh. Now let us repeat the same test but this
+                // time for the "last_edge_terminal_vertex"
+
+                const ed_t& last_edge = cutpath.back();
+                const vd_t last_edge_vertex0 = m0.vertex(last_edge, 0);
+                const vd_t last_edge_vertex1 = m0.vertex(last_edge, 1);
+                bool last_edge_vertex0_is_terminal = m0_cutpath_terminal_vertices.find(last_edge_vertex0) != m0_cutpath_terminal_vertices.cend();
+
+                // bool last_edge_is_terminal = last_edge_vertex0_is_terminal;
+
+                // if (last_edge_vertex0_is_terminal == false)
+                //{
+                //  check if vertex1 is terminal
+                // bool last_edge_vertex1_is_terminal = m0_cutpath_terminal_vertices.find(last_edge_vertex1) != m0_cutpath_terminal_vertices.cend();
+                // last_edge_is_terminal = last_edge_vertex1_is_terminal;
+                //}
 
-            MCUT_ASSERT(ps_face_of_first_edge_terminal_vertex_he != hmesh_t::null_face());
+                bool last_vtx_is_from_src_mesh = first_vtx_is_from_src_mesh; // ... we will use this to determine whether we have a severing cutpath or not (the current one)
 
-            bool is_from_cut_mesh = ps_is_cutmesh_face(ps_face_of_first_edge_terminal_vertex_he, sm_face_count);
-            bool is_from_src_mesh = !is_from_cut_mesh;
+                // MCUT_ASSERT(last_edge_is_terminal); // i.e. we have a linear cut path
+                vd_t last_edge_terminal_vertex = hmesh_t::null_vertex();
 
-            const bool first_vtx_is_from_src_mesh = is_from_src_mesh;
-            /*
-        if (is_from_src_mesh) {
-            cutpath_is_hole = false;
-        }
-        else
-        {*/
-            // ... so the halfedge in the registry of "first_edge_terminal_vertex"
-            // belongs to the cut-mesh. Now let us repeat the same test but this
-            // time for the "last_edge_terminal_vertex"
-
-            const ed_t& last_edge = cutpath.back();
-            const vd_t last_edge_vertex0 = m0.vertex(last_edge, 0);
-            const vd_t last_edge_vertex1 = m0.vertex(last_edge, 1);
-            bool last_edge_vertex0_is_terminal = m0_cutpath_terminal_vertices.find(last_edge_vertex0) != m0_cutpath_terminal_vertices.cend();
-
-            // bool last_edge_is_terminal = last_edge_vertex0_is_terminal;
-
-            // if (last_edge_vertex0_is_terminal == false)
-            //{
-            //  check if vertex1 is terminal
-            // bool last_edge_vertex1_is_terminal = m0_cutpath_terminal_vertices.find(last_edge_vertex1) != m0_cutpath_terminal_vertices.cend();
-            // last_edge_is_terminal = last_edge_vertex1_is_terminal;
-            //}
+                if (last_edge == first_edge) // sequence has one edge
+                {
+                    last_edge_terminal_vertex = (first_edge_terminal_vertex == last_edge_vertex0) ? last_edge_vertex1 : last_edge_vertex0;
+                } else {
+                    last_edge_terminal_vertex = (last_edge_vertex0_is_terminal ? last_edge_vertex0 : last_edge_vertex1);
+                }
 
-            bool last_vtx_is_from_src_mesh = first_vtx_is_from_src_mesh; // ... we will use this to determine whether we have a severing cutpath or not (the current one)
+                // get the halfedge and check where is comes from (cut-mesh/src-mesh)
 
-            // MCUT_ASSERT(last_edge_is_terminal); // i.e. we have a linear cut path
-            vd_t last_edge_terminal_vertex = hmesh_t::null_vertex();
+                // std::map<vd_t, std::map<vd_t, hd_t>::const_iterator>::const_iterator find_iter = m0_cutpath_terminal_vertices.cend();
+                find_iter = m0_cutpath_terminal_vertices.find(last_edge_terminal_vertex);
+                MCUT_ASSERT(find_iter != m0_cutpath_terminal_vertices.cend());
+                const ed_t& last_edge_terminal_vertex_e = find_iter->second->first;
+                const hd_t last_edge_terminal_vertex_e_h0 = ps.halfedge(last_edge_terminal_vertex_e, 0);
+                fd_t ps_face_of_last_edge_terminal_vertex_he = ps.face(last_edge_terminal_vertex_e_h0);
 
-            if (last_edge == first_edge) // sequence has one edge
-            {
-                last_edge_terminal_vertex = (first_edge_terminal_vertex == last_edge_vertex0) ? last_edge_vertex1 : last_edge_vertex0;
-            } else {
-                last_edge_terminal_vertex = (last_edge_vertex0_is_terminal ? last_edge_vertex0 : last_edge_vertex1);
-            }
+                if (ps_face_of_last_edge_terminal_vertex_he == hmesh_t::null_face()) {
+                    const hd_t last_edge_terminal_vertex_e_h1 = ps.opposite(last_edge_terminal_vertex_e_h0);
+                    ps_face_of_last_edge_terminal_vertex_he = ps.face(last_edge_terminal_vertex_e_h1);
+                }
 
-            // get the halfedge and check where is comes from (cut-mesh/src-mesh)
+                // must exist because "ivtx_ps_he" came from an intersecting face in the
+                // polygon soup
+                MCUT_ASSERT(ps_face_of_last_edge_terminal_vertex_he != hmesh_t::null_face());
 
-            // std::map<vd_t, std::map<vd_t, hd_t>::const_iterator>::const_iterator find_iter = m0_cutpath_terminal_vertices.cend();
-            find_iter = m0_cutpath_terminal_vertices.find(last_edge_terminal_vertex);
-            MCUT_ASSERT(find_iter != m0_cutpath_terminal_vertices.cend());
-            const ed_t& last_edge_terminal_vertex_e = find_iter->second->first;
-            const hd_t last_edge_terminal_vertex_e_h0 = ps.halfedge(last_edge_terminal_vertex_e, 0);
-            fd_t ps_face_of_last_edge_terminal_vertex_he = ps.face(last_edge_terminal_vertex_e_h0);
+                is_from_cut_mesh = ps_is_cutmesh_face(ps_face_of_last_edge_terminal_vertex_he, sm_face_count);
+                is_from_src_mesh = !is_from_cut_mesh;
 
-            if (ps_face_of_last_edge_terminal_vertex_he == hmesh_t::null_face()) {
-                const hd_t last_edge_terminal_vertex_e_h1 = ps.opposite(last_edge_terminal_vertex_e_h0);
-                ps_face_of_last_edge_terminal_vertex_he = ps.face(last_edge_terminal_vertex_e_h1);
-            }
+                last_vtx_is_from_src_mesh = is_from_src_mesh;
 
-            // must exist because "ivtx_ps_he" came from an intersecting face in the
-            // polygon soup
-            MCUT_ASSERT(ps_face_of_last_edge_terminal_vertex_he != hmesh_t::null_face());
+                // if (is_from_cut_mesh) {
+                //     cutpath_is_hole = true;
+                // }
+                //  }
+                cutpath_is_hole = (!last_vtx_is_from_src_mesh && !first_vtx_is_from_src_mesh);
+                cutpath_is_srcmesh_severing = (first_vtx_is_from_src_mesh && (last_vtx_is_from_src_mesh /* == first_vtx_is_from_src_mesh*/));
+                //}
+            }
+        }
+        return true;
+    };
 
-            is_from_cut_mesh = ps_is_cutmesh_face(ps_face_of_last_edge_terminal_vertex_he, sm_face_count);
-            is_from_src_mesh = !is_from_cut_mesh;
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
 
-            last_vtx_is_from_src_mesh = is_from_src_mesh;
+        parallel_fork_and_join(
+            *input.scheduler,
+            m0_cutpath_sequences.cbegin(),
+            m0_cutpath_sequences.cend(),
+            (1 << 6),
+            fn_infer_cutpath_properties,
+            _1, // out
+            futures);
 
-            // if (is_from_cut_mesh) {
-            //     cutpath_is_hole = true;
-            // }
-            //  }
-            cutpath_is_hole = (!last_vtx_is_from_src_mesh && !first_vtx_is_from_src_mesh);
-            cutpath_is_srcmesh_severing = (first_vtx_is_from_src_mesh && (last_vtx_is_from_src_mesh /* == first_vtx_is_from_src_mesh*/));
-            //}
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
         }
     }
+#else
+    fn_infer_cutpath_properties(m0_cutpath_sequences.cbegin(), m0_cutpath_sequences.cend());
+#endif
 
     m0_cutpath_terminal_vertices.clear(); // free
 
@@ -3908,6 +3535,11 @@ void dispatch(output_t& output, const input_t& input)
             std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator cur = ivtx_to_cp_edges.cend();
             std::unordered_map<vd_t, std::vector<ed_t>>::const_iterator next = ivtx_to_cp_edges.cbegin();
 
+            if (input.deterministic) { // start from the vertex with the smallest descriptor instead of the first vertex in the hash table
+                next = std::min_element(ivtx_to_cp_edges.cbegin(), ivtx_to_cp_edges.cend(),
+                    [](const std::pair<const vd_t, std::vector<ed_t>>& a, const std::pair<const vd_t, std::vector<ed_t>>& b) { return a.first < b.first; });
+            }
+
             ed_t prev_edge = hmesh_t::null_edge();
             do {
                 cur = next;
@@ -4164,9 +3796,12 @@ void dispatch(output_t& output, const input_t& input)
         ps_to_m0_edges;
 
     // for each ps-edge with more than 3 coincindent vertices
-    for (std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator ps_edge_coincident_vertices_iter = ps_edge_to_sorted_descriptors.begin();
-         ps_edge_coincident_vertices_iter != ps_edge_to_sorted_descriptors.end();
-         ++ps_edge_coincident_vertices_iter) {
+    const std::vector<std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator> ps_edge_to_sorted_descriptors_visit_order = get_map_visit_order(ps_edge_to_sorted_descriptors, input.deterministic);
+
+    for (std::vector<std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator>::const_iterator visit_iter = ps_edge_to_sorted_descriptors_visit_order.cbegin();
+         visit_iter != ps_edge_to_sorted_descriptors_visit_order.cend();
+         ++visit_iter) {
+        const std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator& ps_edge_coincident_vertices_iter = *visit_iter;
 
         // get sorted list of vertices on edge
         const std::vector<vd_t>& coincident_sorted_vertices = ps_edge_coincident_vertices_iter->second;
@@ -4257,11 +3892,11 @@ void dispatch(output_t& output, const input_t& input)
 
     // a map between edge ids in "ps" and in "m0", which is the data structure we are progressively
     // defining to hold data for the new mesh containing clipped polygons
-    std::unordered_map<ed_t, ed_t> ps_to_m0_non_intersecting_edge;
+    arena_unordered_map_t<ed_t, ed_t> ps_to_m0_non_intersecting_edge = make_arena_unordered_map<ed_t, ed_t>(input.arena);
 
 #if defined(MCUT_MULTI_THREADED)
     {
-        typedef edge_array_iterator_t InputStorageIteratorType;
+        typedef polygon_soup_view_t::edge_iterator_t InputStorageIteratorType;
         typedef std::tuple<
             std::unordered_map<ed_t, ed_t>, // ps_to_m0_non_intersecting_edge
             std::unordered_map<fd_t, std::vector<ed_t>>, // ps_iface_to_m0_edge_list
@@ -4284,7 +3919,7 @@ void dispatch(output_t& output, const input_t& input)
             const uint32_t rough_number_of_edges = (uint32_t)std::distance(block_start_, block_end_);
             edges_LOCAL.reserve((uint32_t)(rough_number_of_edges * 1.2)); // most edges are original
 
-            for (edge_array_iterator_t iter_ps_edge = block_start_; iter_ps_edge != block_end_; ++iter_ps_edge) {
+            for (InputStorageIteratorType iter_ps_edge = block_start_; iter_ps_edge != block_end_; ++iter_ps_edge) {
                 // std::cout << (uint32_t)(*iter_ps_edge) << std::endl;
                 if (ps_edge_to_vertices.find(*iter_ps_edge) != ps_edge_to_vertices.end()) {
                     continue; // the case of more than 3 vertices (handled above)
@@ -4295,9 +3930,7 @@ void dispatch(output_t& output, const input_t& input)
                 const vd_t ps_v1 = ps.vertex(ps_edge, 1);
 
                 MCUT_ASSERT((int)(ps_v0) < (int)ps_to_m0_vtx.size());
-                const vd_t m0_v0 = ps_to_m0_vtx[ps_v0];
                 MCUT_ASSERT((int)(ps_v1) < (int)ps_to_m0_vtx.size());
-                const vd_t m0_v1 = ps_to_m0_vtx[ps_v1];
 
                 std::vector<vd_t> vertices_on_ps_edge = { ps_v0, ps_v1 };
                 std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator ps_intersecting_edges_iter = ps_intersecting_edges.find(ps_edge);
@@ -4456,7 +4089,7 @@ void dispatch(output_t& output, const input_t& input)
                                         const std::unordered_map<fd_t, std::vector<ed_t>>& ps_iface_to_m0_edge_list_FUTURE,
                                         const std::unordered_map<vd_t, std::vector<hd_t>>& ivtx_to_incoming_hlist_FUTURE,
                                         const std::vector<std::pair<vd_t, vd_t>>& edge_create_info_FUTURE,
-                                        std::unordered_map<ed_t, ed_t>& ps_to_m0_non_intersecting_edge,
+                                        arena_unordered_map_t<ed_t, ed_t>& ps_to_m0_non_intersecting_edge,
                                         std::unordered_map<fd_t, std::vector<ed_t>>& ps_iface_to_m0_edge_list,
                                         std::unordered_map<vd_t, std::vector<hd_t>>& ivtx_to_incoming_hlist) {
             std::vector<ed_t> emap(edge_create_info_FUTURE.size());
@@ -4500,17 +4133,6 @@ void dispatch(output_t& output, const input_t& input)
             }
         };
 
-        // add edges computed by master thread and update local edge (and halfedge) descriptors
-        merge_local_m0_edges(
-            m0,
-            ps_to_m0_non_intersecting_edge_MASTER_THREAD_LOCAL,
-            ps_iface_to_m0_edge_list_MASTER_THREAD_LOCAL,
-            ivtx_to_incoming_hlist_MASTER_THREAD_LOCAL,
-            edge_create_info_MASTER_THREAD_LOCAL,
-            ps_to_m0_non_intersecting_edge,
-            ps_iface_to_m0_edge_list,
-            ivtx_to_incoming_hlist);
-
         // merge thread-local output into global data structures
         for (int i = 0; i < (int)futures.size(); ++i) {
             std::future<OutputStorageTypesTuple>& f = futures[i];
@@ -4533,12 +4155,24 @@ void dispatch(output_t& output, const input_t& input)
                 ivtx_to_incoming_hlist);
         }
 
+        // add edges computed by master thread (i.e. the last block of ps-edges) and update local edge
+        // (and halfedge) descriptors. This is done last so that the edges are added in the same order
+        // as in the single-threaded build.
+        merge_local_m0_edges(
+            m0,
+            ps_to_m0_non_intersecting_edge_MASTER_THREAD_LOCAL,
+            ps_iface_to_m0_edge_list_MASTER_THREAD_LOCAL,
+            ivtx_to_incoming_hlist_MASTER_THREAD_LOCAL,
+            edge_create_info_MASTER_THREAD_LOCAL,
+            ps_to_m0_non_intersecting_edge,
+            ps_iface_to_m0_edge_list,
+            ivtx_to_incoming_hlist);
     } // end of parallel scope
 
 #else
 
     // for each ps-edge
-    for (edge_array_iterator_t iter_ps_edge = ps.edges_begin(); iter_ps_edge != ps.edges_end(); ++iter_ps_edge) {
+    for (polygon_soup_view_t::edge_iterator_t iter_ps_edge = ps.edges_begin(); iter_ps_edge != ps.edges_end(); ++iter_ps_edge) {
 
         if (ps_edge_to_vertices.empty() == false && ps_edge_to_vertices.find(*iter_ps_edge) != ps_edge_to_vertices.end()) {
             continue; // the case of more than 3 vertices (handled above)
@@ -4549,9 +4183,7 @@ void dispatch(output_t& output, const input_t& input)
         const vd_t ps_v1 = ps.vertex(ps_edge, 1);
 
         MCUT_ASSERT((int)(ps_v0) < (int)ps_to_m0_vtx.size() /*ps_to_m0_vtx.find(ps_v0) != ps_to_m0_vtx.cend())*/);
-        const vd_t m0_v0 = ps_to_m0_vtx[ps_v0];
         MCUT_ASSERT((int)(ps_v1) < (int)ps_to_m0_vtx.size() /*ps_to_m0_vtx.find(ps_v1) != ps_to_m0_vtx.cend()*/);
-        const vd_t m0_v1 = ps_to_m0_vtx[ps_v1];
 
         std::vector<vd_t> vertices_on_ps_edge = { ps_v0, ps_v1 }; // get_vertices_on_ps_edge(*iter_ps_edge, m0_ivtx_to_ps_edge, ps, m0_to_ps_vtx);
         std::unordered_map<ed_t, std::vector<vd_t>>::const_iterator ps_intersecting_edges_iter = ps_intersecting_edges.find(ps_edge);
@@ -4689,11 +4321,11 @@ void dispatch(output_t& output, const input_t& input)
 
     int traced_sm_polygon_count = 0;
 
-    std::unordered_map<int, fd_t> m0_to_ps_face; // (we'll later also include reversed polygon patches)
+    arena_unordered_map_t<int, fd_t> m0_to_ps_face = make_arena_unordered_map<int, fd_t>(input.arena); // (we'll later also include reversed polygon patches)
 
 #if defined(MCUT_MULTI_THREADED)
     {
-        typedef face_array_iterator_t InputStorageIteratorType;
+        typedef polygon_soup_view_t::face_iterator_t InputStorageIteratorType;
         typedef std::tuple<
             std::vector<traced_polygon_t>, // m0_polygons;
             std::vector<int>, // m0_sm_cutpath_adjacent_polygons
@@ -4715,7 +4347,7 @@ void dispatch(output_t& output, const input_t& input)
 
             traced_sm_polygon_count_LOCAL = 0;
 
-            for (face_array_iterator_t ps_face_iter = block_start_; ps_face_iter != block_end_; ++ps_face_iter) {
+            for (InputStorageIteratorType ps_face_iter = block_start_; ps_face_iter != block_end_; ++ps_face_iter) {
                 const fd_t& ps_face = *ps_face_iter;
 
                 // get all the edges that lie on "ps_face", including the new one after partiting acording to intersection
@@ -4730,11 +4362,11 @@ void dispatch(output_t& output, const input_t& input)
                 if (is_intersecting_ps_face == false) { // non-intersecting face
 
                     traced_polygon_t retraced_poly; // ordered sequence of halfedges defining the unchanged polygon
-                    std::vector<hd_t> halfedges_around_face = ps.get_halfedges_around_face(ps_face);
+                    const polygon_soup_view_t::halfedge_array_view_t halfedges_around_face = ps.get_halfedges_around_face(ps_face);
                     retraced_poly.reserve(halfedges_around_face.size()); // minimum 3 (triangle)
 
                     // for each halfedge in the current polygon
-                    for (std::vector<hd_t>::const_iterator hbegin = halfedges_around_face.cbegin(); hbegin != halfedges_around_face.cend(); ++hbegin) {
+                    for (polygon_soup_view_t::halfedge_array_view_t::const_iterator hbegin = halfedges_around_face.cbegin(); hbegin != halfedges_around_face.cend(); ++hbegin) {
                         // get the source and target vertex descriptors in the polygon soup
                         const vd_t ps_h_src = ps.source(*hbegin);
                         const vd_t ps_h_tgt = ps.target(*hbegin);
@@ -5236,7 +4868,7 @@ void dispatch(output_t& output, const input_t& input)
                                             std::vector<int>& m0_sm_cutpath_adjacent_polygons,
                                             std::vector<int>& m0_cm_cutpath_adjacent_polygons,
                                             int& traced_sm_polygon_count,
-                                            std::unordered_map<int, fd_t>& m0_to_ps_face) {
+                                            arena_unordered_map_t<int, fd_t>& m0_to_ps_face) {
             int base_offset = (int)m0_polygons.size();
             m0_polygons.reserve(m0_polygons.size() + m0_polygons_FUTURE.size());
             m0_polygons.insert(m0_polygons.end(), m0_polygons_FUTURE.cbegin(), m0_polygons_FUTURE.cend());
@@ -5312,7 +4944,7 @@ void dispatch(output_t& output, const input_t& input)
     } // end of parallel scope
 #else
     // for each face in the polygon-soup mesh
-    for (face_array_iterator_t ps_face_iter = ps.faces_begin(); ps_face_iter != ps.faces_end(); ++ps_face_iter) {
+    for (polygon_soup_view_t::face_iterator_t ps_face_iter = ps.faces_begin(); ps_face_iter != ps.faces_end(); ++ps_face_iter) {
 
         const fd_t& ps_face = *ps_face_iter;
 
@@ -5333,7 +4965,7 @@ void dispatch(output_t& output, const input_t& input)
             traced_polygon_t retraced_poly; // ordered sequence of halfedges defining the unchanged polygon
 
             // query the halfedge sequence in the polygon soup that defines our polygon
-            std::vector<hd_t> halfedges_around_face = ps.get_halfedges_around_face(ps_face);
+            const polygon_soup_view_t::halfedge_array_view_t halfedges_around_face = ps.get_halfedges_around_face(ps_face);
 
             retraced_poly.reserve(halfedges_around_face.size()); // minimum 3 (triangle)
 
@@ -5343,7 +4975,7 @@ void dispatch(output_t& output, const input_t& input)
             // ----------------------------------------------------------------------------------------
 
             // for each halfedge in the current polygon
-            for (std::vector<hd_t>::const_iterator hbegin = halfedges_around_face.cbegin(); hbegin != halfedges_around_face.cend(); ++hbegin) {
+            for (polygon_soup_view_t::halfedge_array_view_t::const_iterator hbegin = halfedges_around_face.cbegin(); hbegin != halfedges_around_face.cend(); ++hbegin) {
 
                 // get the source and target vertex descriptors in the polygon soup
                 const vd_t ps_h_src = ps.source(*hbegin);
@@ -6071,7 +5703,7 @@ void dispatch(output_t& output, const input_t& input)
         if (cm_is_watertight || (all_cutpaths_are_circular || all_cutpaths_linear_and_without_making_holes)) {
 
             std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>> separated_src_mesh_fragments;
-            std::unordered_map<int, int> _1;
+            arena_unordered_map_t<int, int> _1;
             // NOTE: The result is a mesh identical to the original source mesh except at the edges introduced by the cut..
             extract_connected_components(
 #if defined(MCUT_MULTI_THREADED)
@@ -6089,10 +5721,7 @@ void dispatch(output_t& output, const input_t& input)
                 _1, // Unused ... because we are extracting from "m0"
                 m0_to_ps_vtx,
                 m0_to_ps_face,
-                ps_to_sm_vtx,
-                ps_to_sm_face,
-                ps_to_cm_vtx,
-                ps_to_cm_face,
+                ps,
                 sm_vtx_cnt,
                 sm_face_count,
                 input.populate_vertex_maps,
@@ -6120,7 +5749,7 @@ void dispatch(output_t& output, const input_t& input)
 
         if (sm_is_watertight || (all_cutpaths_are_circular || all_cutpaths_linear_and_make_holes)) {
             std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>> separated_cut_mesh_fragments;
-            std::unordered_map<int, int> _1; 
+            arena_unordered_map_t<int, int> _1; 
             hmesh_t merged = extract_connected_components(
 #if defined(MCUT_MULTI_THREADED)
                 *input.scheduler,
@@ -6137,10 +5766,7 @@ void dispatch(output_t& output, const input_t& input)
                 _1, // Unused ... because we are extracting from "m0"
                 m0_to_ps_vtx,
                 m0_to_ps_face,
-                ps_to_sm_vtx,
-                ps_to_sm_face,
-                ps_to_cm_vtx,
-                ps_to_cm_face,
+                ps,
                 sm_vtx_cnt,
                 sm_face_count,
                 input.populate_vertex_maps,
@@ -6308,7 +5934,8 @@ void dispatch(output_t& output, const input_t& input)
                 }
 
                 // check that the target vertex is along a cut-path making a hole
-                const int tgt_explicit_cutpath_sequence_idx = SAFE_ACCESS(m0_ivtx_to_cutpath_sequence, cs_poly_he_tgt);
+                const int tgt_explicit_cutpath_sequence_idx = m0_ivtx_to_cutpath_sequence[cs_poly_he_tgt];
+                MCUT_ASSERT(tgt_explicit_cutpath_sequence_idx != -1);
                 bool cutpath_makes_a_hole = std::find(explicit_cutpaths_making_holes.cbegin(),
                                                 explicit_cutpaths_making_holes.cend(),
                                                 tgt_explicit_cutpath_sequence_idx)
@@ -6435,7 +6062,7 @@ void dispatch(output_t& output, const input_t& input)
     }
 
     // cm_nonborder_reentrant_ivtx_list.clear(); // free
-    m0_ivtx_to_cutpath_sequence.clear(); // free
+    m0.remove_property_map(m0_ivtx_to_cutpath_sequence); // free
 
     TIMESTACK_POP();
 
@@ -6820,7 +6447,7 @@ void dispatch(output_t& output, const input_t& input)
     // lost after duplicating intersection points and transforming all halfedges
     // along the cut-path.
 
-    std::unordered_map<hd_t, hd_t> m0_to_m1_he;
+    property_map_t<hd_t, hd_t> m0_to_m1_he = m0.add_property_map<hd_t, hd_t>(hmesh_t::null_halfedge());
 
     for (edge_array_iterator_t e = m0.edges_begin(); e != m0.edges_end(); ++e) {
         const ed_t& m0_edge = (*e);
@@ -6838,14 +6465,13 @@ void dispatch(output_t& output, const input_t& input)
             const vd_t m0_h0_src = m0.source(m0_h0);
             const hd_t m0_h1 = m0.halfedge(m0_edge, 1);
             const vd_t m1_halfedge_src = m1.source(m1_halfedge);
-            const vd_t m1_halfedge_tgt = m1.target(m1_halfedge);
 
             if (SAFE_ACCESS(m0_to_m1_vtx, m0_h0_src) == m1_halfedge_src) { // i.e. "is the m0_h0 equivalent to m1_halfedge?"
-                m0_to_m1_he.insert(std::make_pair(m0_h0, m1_halfedge));
-                m0_to_m1_he.insert(std::make_pair(m0_h1, m1.opposite(m1_halfedge)));
+                m0_to_m1_he[m0_h0] = m1_halfedge;
+                m0_to_m1_he[m0_h1] = m1.opposite(m1_halfedge);
             } else {
-                m0_to_m1_he.insert(std::make_pair(m0_h1, m1_halfedge));
-                m0_to_m1_he.insert(std::make_pair(m0_h0, m1.opposite(m1_halfedge)));
+                m0_to_m1_he[m0_h1] = m1_halfedge;
+                m0_to_m1_he[m0_h0] = m1.opposite(m1_halfedge);
             }
         }
     }
@@ -6924,11 +6550,11 @@ void dispatch(output_t& output, const input_t& input)
     // This data structure will map the descriptors of intersection-halfedges in "m0"
     // to their descriptor in "m1". Thus, some halfedges (in "m0") will be mapped to
     // new halfedges which are not in "m0" but will be added into "m1".
-    std::unordered_map<
+    arena_unordered_map_t<
         hd_t, // "m0" halfedge
         hd_t // "m1" version
         >
-        m0_to_m1_ihe;
+        m0_to_m1_ihe = make_arena_unordered_map<hd_t, hd_t>(input.arena);
 
     // lamda checks the intersection halfedge that has not been transformed/processed already
     std::function<bool(const std::pair<hd_t, bool>&)> check_if_halfedge_is_transformed = [&](const std::pair<hd_t, bool>& e) {
@@ -6997,12 +6623,28 @@ void dispatch(output_t& output, const input_t& input)
         return false;
     };
 
+    // the order in which the searches below visit the src-mesh intersection halfedges
+    typedef std::vector<std::unordered_map<hd_t, bool>::const_iterator> ihe_visit_order_t;
+    const ihe_visit_order_t m0_sm_ihe_visit_order = get_map_visit_order(m0_sm_ihe_to_flag, input.deterministic);
+
     // our routine will start from an untransformed class-1 intersection-halfedge. We do this because it makes
     // transformation process easier for us by reducing the number of steps.
-    std::unordered_map<hd_t, bool>::iterator m0_1st_sm_ihe_fiter = std::find_if( // for each src-mesh intersection halfedge
-        m0_sm_ihe_to_flag.begin(),
-        m0_sm_ihe_to_flag.end(),
-        check_if_halfedge_is_transformed);
+    ihe_visit_order_t::const_iterator m0_1st_sm_ihe_fiter = std::find_if( // for each src-mesh intersection halfedge
+        m0_sm_ihe_visit_order.cbegin(),
+        m0_sm_ihe_visit_order.cend(),
+        [&](const std::unordered_map<hd_t, bool>::const_iterator& e) { return check_if_halfedge_is_transformed(*e); });
+
+    // Where the searches for the next untransformed class-1 (o-->x) and class-3 (x-->x) halfedge
+    // resume from. A halfedge that is skipped by a search will also be skipped by all later
+    // searches, since halfedges are only ever marked as transformed (and nothing else that the
+    // searches depend on changes). So, each search can continue from where the last one stopped
+    // rather than scanning "m0_sm_ihe_to_flag" from the beginning every time.
+    // NOTE: "m0_sm_ihe_to_flag" must not be modified (other than its values) during the walks.
+    ihe_visit_order_t::const_iterator m0_class1_ihe_search_start = m0_1st_sm_ihe_fiter;
+    ihe_visit_order_t::const_iterator m0_class3_ihe_search_start = m0_sm_ihe_visit_order.cbegin();
+#ifndef NDEBUG
+    const std::size_t m0_sm_ihe_count = m0_sm_ihe_to_flag.size();
+#endif
 
     // Here we have queue of intersection halfedges which will be used to begin a transformation walk/traversal
     // around the polygon of each contained halfedge. For each polygon along the cut path there will ever be at
@@ -7040,9 +6682,9 @@ void dispatch(output_t& output, const input_t& input)
     do {
         //
 
-        MCUT_ASSERT((m0_1st_sm_ihe_fiter != m0_sm_ihe_to_flag.end())); // their must be at least one halfedge from which we can start walking!
+        MCUT_ASSERT((m0_1st_sm_ihe_fiter != m0_sm_ihe_visit_order.cend())); // their must be at least one halfedge from which we can start walking!
 
-        m0_ox_hlist.push_back(m0_1st_sm_ihe_fiter->first); // add to queue
+        m0_ox_hlist.push_back((*m0_1st_sm_ihe_fiter)->first); // add to queue
 
         // The following do-while loop will transform/process the halfedges which belong
         // to exactly one SCBS
@@ -7087,7 +6729,7 @@ void dispatch(output_t& output, const input_t& input)
                     //
 
                     // can we find the m1 version of the next halfedge
-                    std::unordered_map<hd_t, hd_t>::const_iterator m1_nxt_h_fiter = m0_to_m1_ihe.find(m0_nxt_h);
+                    arena_unordered_map_t<hd_t, hd_t>::const_iterator m1_nxt_h_fiter = m0_to_m1_ihe.find(m0_nxt_h);
                     const bool nxt_is_processed = m1_nxt_h_fiter != m0_to_m1_ihe.cend();
 
                     if (nxt_is_processed) {
@@ -7236,7 +6878,6 @@ void dispatch(output_t& output, const input_t& input)
                     // here, we have an exterior halfedge whose "m1" version has already been created.
                     //
                     MCUT_ASSERT(m0_to_m1_ihe.find(m0_cur_h) != m0_to_m1_ihe.cend());
-                    const hd_t m1_cur_h = SAFE_ACCESS(m0_to_m1_ihe, m0_cur_h);
                 }
 
                 //
@@ -7278,14 +6919,17 @@ void dispatch(output_t& output, const input_t& input)
         // find next class1 halfedge which has not been transformed ( possibly in the same connected ccsponent )
         //
 
+        MCUT_ASSERT(m0_sm_ihe_to_flag.size() == m0_sm_ihe_count); // i.e. the search iterators are still valid
+
         m0_1st_sm_ihe_fiter = std::find_if( // find o-->x halfedge
-            m0_sm_ihe_to_flag.begin(),
-            m0_sm_ihe_to_flag.end(),
-            check_if_halfedge_is_transformed);
+            m0_class1_ihe_search_start,
+            m0_sm_ihe_visit_order.cend(),
+            [&](const std::unordered_map<hd_t, bool>::const_iterator& e) { return check_if_halfedge_is_transformed(*e); });
+        m0_class1_ihe_search_start = m0_1st_sm_ihe_fiter;
 
         // True only if there exists a src-mesh ps-edge which has [at least] two intersection points
         // This means that the source-mesh has a scoop cut (see example 19)
-        const bool class1_ihalfedge_found = (m0_1st_sm_ihe_fiter != m0_sm_ihe_to_flag.end());
+        const bool class1_ihalfedge_found = (m0_1st_sm_ihe_fiter != m0_sm_ihe_visit_order.cend());
 
         if (!class1_ihalfedge_found) { // The above search failed to find an untransformed class-1 halfedge.
 
@@ -7294,8 +6938,9 @@ void dispatch(output_t& output, const input_t& input)
             //
 
             m0_1st_sm_ihe_fiter = std::find_if( // for each intersection halfedge
-                m0_sm_ihe_to_flag.begin(), m0_sm_ihe_to_flag.end(),
-                [&](const std::pair<hd_t, bool>& e) {
+                m0_class3_ihe_search_start, m0_sm_ihe_visit_order.cend(),
+                [&](const std::unordered_map<hd_t, bool>::const_iterator& e_iter) {
+                    const std::pair<const hd_t, bool>& e = *e_iter;
                     const bool is_transformed = e.second; // has it already been transformed..?
 
                     if (is_transformed) {
@@ -7346,11 +6991,12 @@ void dispatch(output_t& output, const input_t& input)
                         return false;
                     }
                 });
+            m0_class3_ihe_search_start = m0_1st_sm_ihe_fiter;
         }
 
         // loop while there exists a "non-transformed" exterior intersection-halfedge
         // from which we can start building a SCBS
-    } while (m0_1st_sm_ihe_fiter != m0_sm_ihe_to_flag.end());
+    } while (m0_1st_sm_ihe_fiter != m0_sm_ihe_visit_order.cend());
 
 #if 0
     // dump
@@ -7406,58 +7052,90 @@ void dispatch(output_t& output, const input_t& input)
     // We do this because cut-mesh polygon will have two version each, where
     // a version corresponds to those that are stitched on the exterior and those interior.
     // We will duplicate the "m1" mesh later into two copies.
-    std::unordered_map<int, int> m0_to_m1_face; // std::map<int, int> m0_to_m1_face;
-    std::unordered_map<int, int> m1_to_m0_face;
+    arena_unordered_map_t<int, int> m0_to_m1_face = make_arena_unordered_map<int, int>(input.arena); // std::map<int, int> m0_to_m1_face;
+    arena_unordered_map_t<int, int> m1_to_m0_face = make_arena_unordered_map<int, int>(input.arena);
+
+    // NOTE: each polygon is re-traced independently of the others (using the halfedge
+    // mappings computed during partitioning) so this is done in parallel.
+    auto fn_update_traced_polygons = [&](std::vector<traced_polygon_t>::const_iterator block_start_, std::vector<traced_polygon_t>::const_iterator block_end_) -> bool {
+        // for each traced polygon (in "m0")
+        for (std::vector<traced_polygon_t>::const_iterator m0_traced_sm_polygon_iter = block_start_;
+             m0_traced_sm_polygon_iter != block_end_;
+             ++m0_traced_sm_polygon_iter) {
+            const traced_polygon_t& m0_sm_polygon = *m0_traced_sm_polygon_iter; // m0 version (unpartitioned)
+            // get index of polygon
+            const int polygon_index = (int)std::distance(m0_polygons.cbegin(), m0_traced_sm_polygon_iter);
 
-    // for each traced polygon (in "m0")
-    for (std::vector<traced_polygon_t>::const_iterator m0_traced_sm_polygon_iter = m0_polygons.cbegin();
-         m0_traced_sm_polygon_iter != m0_traced_sm_polygons_iter_cend;
-         ++m0_traced_sm_polygon_iter) {
-        const traced_polygon_t& m0_sm_polygon = *m0_traced_sm_polygon_iter; // m0 version (unpartitioned)
-        // get index of polygon
-        const int polygon_index = (int)std::distance(m0_polygons.cbegin(), m0_traced_sm_polygon_iter);
+            MCUT_ASSERT(polygon_index < (int)m1_polygons.size()); // sanity check
 
-        MCUT_ASSERT(polygon_index < (int)m1_polygons.size()); // sanity check
+            traced_polygon_t& m1_sm_polygon = SAFE_ACCESS(m1_polygons, polygon_index); // m1 version (partitioned)
+            m1_sm_polygon.resize(m0_sm_polygon.size()); // resize to match
 
-        traced_polygon_t& m1_sm_polygon = SAFE_ACCESS(m1_polygons, polygon_index); // m1 version (partitioned)
-        m1_sm_polygon.resize(m0_sm_polygon.size()); // resize to match
+            // for each halfedge of current polygon
+            for (traced_polygon_t::const_iterator m0_traced_sm_polygon_halfedge_iter = m0_sm_polygon.cbegin();
+                 m0_traced_sm_polygon_halfedge_iter != m0_sm_polygon.cend();
+                 ++m0_traced_sm_polygon_halfedge_iter) {
 
-        // for each halfedge of current polygon
-        for (traced_polygon_t::const_iterator m0_traced_sm_polygon_halfedge_iter = m0_sm_polygon.cbegin();
-             m0_traced_sm_polygon_halfedge_iter != m0_sm_polygon.cend();
-             ++m0_traced_sm_polygon_halfedge_iter) {
+                const hd_t& m0_he = *m0_traced_sm_polygon_halfedge_iter;
+                const bool m0_he_src_is_ivertex = m0_is_intersection_point(m0.source(m0_he), ps_vtx_cnt);
+                const bool m0_he_tgt_is_ivertex = m0_is_intersection_point(m0.target(m0_he), ps_vtx_cnt);
+                // is the halfedge connected to an intersection point...?
+                const bool is_ihalfedge = m0_he_src_is_ivertex || m0_he_tgt_is_ivertex;
 
-            const hd_t& m0_he = *m0_traced_sm_polygon_halfedge_iter;
-            const bool m0_he_src_is_ivertex = m0_is_intersection_point(m0.source(m0_he), ps_vtx_cnt);
-            const bool m0_he_tgt_is_ivertex = m0_is_intersection_point(m0.target(m0_he), ps_vtx_cnt);
-            // is the halfedge connected to an intersection point...?
-            const bool is_ihalfedge = m0_he_src_is_ivertex || m0_he_tgt_is_ivertex;
+                hd_t m1_he = hmesh_t::null_halfedge();
 
-            hd_t m1_he = hmesh_t::null_halfedge();
+                if (is_ihalfedge) { // its an intersection halfedge
+                    arena_unordered_map_t<hd_t, hd_t>::const_iterator m0_to_m1_ihe_fiter = m0_to_m1_ihe.find(m0_he);
+                    MCUT_ASSERT(m0_to_m1_ihe_fiter != m0_to_m1_ihe.cend()); // must have been walked/traversed
 
-            if (is_ihalfedge) { // its an intersection halfedge
-                MCUT_ASSERT(m0_to_m1_ihe.find(m0_he) != m0_to_m1_ihe.cend()); // must have been walked/traversed
+                    m1_he = m0_to_m1_ihe_fiter->second; // m1 version
+                } else {
+                    m1_he = m0_to_m1_he[m0_he]; // m1 version
 
-                m1_he = SAFE_ACCESS(m0_to_m1_ihe, m0_he); // m1 version
-            } else {
-                MCUT_ASSERT(m0_to_m1_he.find(m0_he) != m0_to_m1_he.cend());
+                    MCUT_ASSERT(m1_he != hmesh_t::null_halfedge());
+                }
 
-                m1_he = SAFE_ACCESS(m0_to_m1_he, m0_he); // m1 version
+                // get halfedge index in polygon
+                const int halfedge_index = (int)std::distance(m0_sm_polygon.cbegin(), m0_traced_sm_polygon_halfedge_iter);
+
+                MCUT_ASSERT(halfedge_index < (int)m1_sm_polygon.size()); // array was resized with the same capacity as m0 polygon
+
+                SAFE_ACCESS(m1_sm_polygon, halfedge_index) = m1_he;
             }
+        }
+        return true;
+    };
 
-            // get halfedge index in polygon
-            const int halfedge_index = (int)std::distance(m0_sm_polygon.cbegin(), m0_traced_sm_polygon_halfedge_iter);
+#if defined(MCUT_MULTI_THREADED)
+    {
+        std::vector<std::future<bool>> futures;
+        bool _1;
 
-            MCUT_ASSERT(halfedge_index < (int)m1_sm_polygon.size()); // array was resized with the same capacity as m0 polygon
+        parallel_fork_and_join(
+            *input.scheduler,
+            m0_polygons.cbegin(),
+            m0_traced_sm_polygons_iter_cend,
+            (1 << 10),
+            fn_update_traced_polygons,
+            _1, // out
+            futures);
 
-            SAFE_ACCESS(m1_sm_polygon, halfedge_index) = m1_he;
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
         }
+    }
+#else
+    fn_update_traced_polygons(m0_polygons.cbegin(), m0_traced_sm_polygons_iter_cend);
+#endif
 
+    for (int polygon_index = 0; polygon_index < traced_sm_polygon_count; ++polygon_index) {
         m0_to_m1_face[polygon_index] = polygon_index; // one to one mapping because we are only dealing with source-mesh traced polygons
         m1_to_m0_face[polygon_index] = polygon_index;
     }
 
-    m0_to_m1_he.clear();
+    m0.remove_property_map(m0_to_m1_he);
 
     TIMESTACK_POP();
 
@@ -7501,10 +7179,7 @@ void dispatch(output_t& output, const input_t& input)
             m1_to_m0_face,
             m0_to_ps_vtx,
             m0_to_ps_face,
-            ps_to_sm_vtx,
-            ps_to_sm_face,
-            ps_to_cm_vtx,
-            ps_to_cm_face,
+            ps,
             sm_vtx_cnt,
             sm_face_count,
             input.populate_vertex_maps,
@@ -7718,7 +7393,11 @@ void dispatch(output_t& output, const input_t& input)
         char, // color value (representing the notion of "interior"/"exterior")
         hmesh_t // the mesh (copy of "m1") to which corresponding patch(es) will be stitched
         >
-        color_to_m1 = { { 'A' /*e.g. "red"*/, m1 }, { 'B' /*e.g. "blue"*/, m1 } };
+        color_to_m1;
+
+    // "m1" is no longer needed, so the second version takes its data instead of copying it
+    color_to_m1.emplace('A' /*e.g. "red"*/, m1);
+    color_to_m1.emplace('B' /*e.g. "blue"*/, std::move(m1));
 
     m1.reset(); // clear data
 
@@ -7742,166 +7421,171 @@ void dispatch(output_t& output, const input_t& input)
     //    >
     //    patch_to_floating_flag;
 
-    // tracks how many cut-mesh polygons have been stitched. Used only for naming damped meshes
-    int global_cm_poly_stitch_counter = 0;
-
     // keeps track of the total number of default-winding-order (e.g. CCW) patches which has been identified
     // NOTE: not all will be CCW if we have floating patches (in this case winding could be flipped)
     int total_ccw_patch_count = 0;
-    std::vector<bool> patch_poly_enqueued(m0_polygons.size(), false);
-     std::queue<int> flood_fill_queue; // for building patch using BFS
-
-    do {
-        ///////////////////////////////////////////////////////////////////////////
-        // Associate cut-mesh polygons with patches of the graph
-        ///////////////////////////////////////////////////////////////////////////
-
-        int graph_cur_patch_idx = (int)patches.size();
-        
-        // counter to keep track of the number of patches discovered for
-        // the current SCS
-
-        //
-        // Here, we will pick an interior intersection halfedge (and its polygon) from
-        // which we can identify the [first patch] of the graph
-        std::tuple<int, int, int> graph_interior_ihalfedge_pool;
-        std::get<0>(graph_interior_ihalfedge_pool) = -1;
-
-        // find the [first] interior intersection-halfedge of a cut-mesh polygon
-        // which has not already been associated with a patch
-        while (!primary_interior_ihalfedge_pool.empty()) { // while seeds are not found
-
-            // pull an interior intersection-halfedge from the queue
-            std::vector<std::pair<int, int>>::iterator primary_interior_ihalfedge_pool_citer = primary_interior_ihalfedge_pool.end() - 1; // last element
-            // halfedge polygon index
-            const int potential_seed_poly_idx = primary_interior_ihalfedge_pool_citer->first;
-            // halfedge index in polygon
-            const int potential_seed_poly_he_idx = primary_interior_ihalfedge_pool_citer->second;
-            // check if the polygon has already been associated with a patch
-            const bool poly_patch_is_known = m0_cm_poly_to_patch_idx.find(potential_seed_poly_idx) != m0_cm_poly_to_patch_idx.cend();
-            primary_interior_ihalfedge_pool_citer = primary_interior_ihalfedge_pool.erase(primary_interior_ihalfedge_pool_citer);
-
-            if (!poly_patch_is_known) {
-                // we can use the halfedge as a seed from which to starting point to build [a] patch
-                std::get<0>(graph_interior_ihalfedge_pool) = graph_cur_patch_idx;
-                std::get<1>(graph_interior_ihalfedge_pool) = potential_seed_poly_idx;
-                std::get<2>(graph_interior_ihalfedge_pool) = potential_seed_poly_he_idx;
-                break; // start patch discovery with the current seed
-            }
-        }
-
-        if (std::get<0>(graph_interior_ihalfedge_pool) == -1) {
-            break; // done
-        }
+    {
+        // Patches are bounded by cut-paths, which means that they are independent of each other and
+        // each one can be built as a separate task. The cut-mesh polygons are first labelled with the
+        // patch containing them (by merging polygons which share an edge that is not on a cut-path).
+        // Each patch is then built by flood-fill from its seed, so the order of the patches and of
+        // their polygons is the same in single- and multi-threaded builds.
 
-        ///////////////////////////////////////////////////////////////////////////
-        // build the patch by flood-fill (BFS)
-        ///////////////////////////////////////////////////////////////////////////
+        const int m0_polygon_count = (int)m0_polygons.size();
+        disjoint_set_t m0_cm_polygon_sets((std::uint32_t)m0_polygon_count);
 
-        MCUT_ASSERT(patch_to_seed_interior_ihalfedge_idx.count(graph_cur_patch_idx) == 0);
-        patch_to_seed_interior_ihalfedge_idx[graph_cur_patch_idx] = std::get<2>(graph_interior_ihalfedge_pool);
+        typedef std::vector<traced_polygon_t>::const_iterator InputStorageIteratorType;
 
-        MCUT_ASSERT(patch_to_seed_poly_idx.count(graph_cur_patch_idx) == 0);
-        patch_to_seed_poly_idx[graph_cur_patch_idx] = std::get<1>(graph_interior_ihalfedge_pool);
+        auto fn_unite_adjacent_cm_polygons = [&](InputStorageIteratorType block_start_, InputStorageIteratorType block_end_) -> bool {
+            for (InputStorageIteratorType poly_iter = block_start_; poly_iter != block_end_; ++poly_iter) {
+                const int poly_idx = (int)std::distance(m0_polygons.cbegin(), poly_iter);
 
-        std::vector<int>& patch = patches[graph_cur_patch_idx]; // patch_insertion.first->second; // polygons of patch
-        patch.reserve(cs_face_count);
-       
-        flood_fill_queue.push(std::get<1>(graph_interior_ihalfedge_pool)); // first polygon
-        patch_poly_enqueued[std::get<1>(graph_interior_ihalfedge_pool)] = true;
+                for (traced_polygon_t::const_iterator poly_he_iter = poly_iter->cbegin(); poly_he_iter != poly_iter->cend(); ++poly_he_iter) {
+                    if (m0_is_polygon_boundary_halfedge((*poly_he_iter), m0_num_cutpath_halfedges)) {
+                        // polygon traced with the opposite halfedge (if any)
+                        const std::vector<int>& opp_polygons = SAFE_ACCESS(m0_h_to_ply, m0.opposite(*poly_he_iter));
 
-        do { // each interation adds a polygon to the patch
+                        if (!opp_polygons.empty()) {
+                            MCUT_ASSERT(opp_polygons.size() == 1);
+                            m0_cm_polygon_sets.unite((std::uint32_t)poly_idx, (std::uint32_t)opp_polygons.front());
+                        }
+                    }
+                }
+            }
+            return true;
+        };
 
-            // get the polygon at the front of the queue
-            const int graph_patch_poly_idx = flood_fill_queue.front();
-            flood_fill_queue.pop(); // graph_patch_poly_idx
+#if defined(MCUT_MULTI_THREADED)
+        if (traced_sm_polygon_count < m0_polygon_count) {
+            std::vector<std::future<bool>> futures;
+            bool _1;
 
-            // add polygon to patch
-            patch.push_back(graph_patch_poly_idx);
+            parallel_fork_and_join(
+                *input.scheduler,
+                m0_polygons.cbegin() + traced_sm_polygon_count,
+                m0_polygons.cend(),
+                (1 << 10),
+                fn_unite_adjacent_cm_polygons,
+                _1, // out
+                futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<bool>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                f.wait(); // wait for result to be done
+            }
+        }
+#else
+        fn_unite_adjacent_cm_polygons(m0_polygons.cbegin() + traced_sm_polygon_count, m0_polygons.cend());
+#endif
 
-            // relate polygon to patch
-            MCUT_ASSERT(m0_cm_poly_to_patch_idx.count(graph_patch_poly_idx) == 0);
-            m0_cm_poly_to_patch_idx[graph_patch_poly_idx] = graph_cur_patch_idx;
-            // std::pair<std::map<int, int>::const_iterator, bool> pair = m0_cm_poly_to_patch_idx.insert(std::make_pair(graph_patch_poly_idx, graph_cur_patch_idx)); // signifies that polygon has been associated with a patch
-            // MCUT_ASSERT(pair.second == true);
-            MCUT_ASSERT(m0_cm_poly_to_patch_idx.count(graph_patch_poly_idx) == 1);
+        // the seed (polygon and halfedge index) of each patch. Seeds are pulled from the back of
+        // the pool, and a seed starts a new patch if its polygon is not in a known patch.
+        std::vector<std::pair<int, int>> patch_seeds;
+        std::vector<int> m0_cm_polygon_set_to_patch(m0_polygon_count, -1);
 
-            //
-            // find adjacent polygons which share class 0,1,2 (o-->o, o-->x, x-->o) halfedges, and
-            // the class 3 (x-->x) halfedges which are [exterior/boundary] intersection-halfedges.
-            //
+        for (std::vector<std::pair<int, int>>::const_reverse_iterator seed_iter = primary_interior_ihalfedge_pool.crbegin();
+             seed_iter != primary_interior_ihalfedge_pool.crend();
+             ++seed_iter) {
+            int& set_patch_idx = m0_cm_polygon_set_to_patch[m0_cm_polygon_sets.find((std::uint32_t)seed_iter->first)];
 
-            // the current polygon
-            const traced_polygon_t& graph_patch_poly = SAFE_ACCESS(m0_polygons, graph_patch_poly_idx);
+            if (set_patch_idx == -1) {
+                set_patch_idx = (int)patch_seeds.size();
+                patch_seeds.push_back(*seed_iter);
+            }
+        }
 
-            // for each halfedge of the current polygon
-            for (traced_polygon_t::const_iterator poly_he_iter = graph_patch_poly.cbegin();
-                 poly_he_iter != graph_patch_poly.cend();
-                 ++poly_he_iter) {
+        primary_interior_ihalfedge_pool.clear(); // all seeds are used
 
-#if 0
-                    const vd_t src_vertex = m0.source(*poly_he_iter);
-                    const vd_t tgt_vertex = m0.target(*poly_he_iter);
-                    bool is_ambiguious_boundary_edge_case = m0_is_intersection_point(src_vertex, ps_vtx_cnt) && m0_is_intersection_point(tgt_vertex, ps_vtx_cnt);
-                    bool is_valid_ambiguious_boundary_edge = false;
+        std::vector<std::vector<int>> patch_polygons(patch_seeds.size());
+        // the patch of each cut-mesh polygon, which is set when the polygon is enqueued. Each polygon
+        // belongs to one patch, so the tasks write to disjoint elements.
+        std::vector<int> m0_poly_to_patch(m0_polygon_count, -1);
 
-                    if (is_ambiguious_boundary_edge_case)
-                    { // exterior edge with two intersection vertices (ambigious case arising from concave polyhedron cut)
+        auto fn_build_patches = [&](std::vector<std::pair<int, int>>::const_iterator block_start_, std::vector<std::pair<int, int>>::const_iterator block_end_) -> bool {
+            std::queue<int> flood_fill_queue; // for building patch using BFS
 
-                        //const hd_t src_coincident_ps_halfedge = SAFE_ACCESS(m0_ivtx_to_ps_edge, src_vertex);
-                        //const hd_t tgt_ps_h = SAFE_ACCESS(m0_ivtx_to_ps_edge, tgt_vertex);
-                        MCUT_ASSERT((size_t)src_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(src_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                        const std::pair<ed_t, fd_t> &src_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, src_vertex - ps_vtx_cnt);
-                        const ed_t src_ps_edge = src_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, src_vertex); //ps.edge(src_coincident_ps_halfedge);
+            for (std::vector<std::pair<int, int>>::const_iterator seed_iter = block_start_; seed_iter != block_end_; ++seed_iter) {
+                const int graph_cur_patch_idx = (int)std::distance(patch_seeds.cbegin(), seed_iter);
+                std::vector<int>& patch = patch_polygons[graph_cur_patch_idx];
 
-                        MCUT_ASSERT((size_t)tgt_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(tgt_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                        const std::pair<ed_t, fd_t> &tgt_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, tgt_vertex - ps_vtx_cnt);
-                        const ed_t tgt_ps_edge = tgt_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, tgt_vertex); //ps.edge(tgt_ps_h);
+                flood_fill_queue.push(seed_iter->first); // first polygon
+                m0_poly_to_patch[seed_iter->first] = graph_cur_patch_idx;
 
-                        is_valid_ambiguious_boundary_edge = (src_ps_edge == tgt_ps_edge);
-                    }
-#endif
-                const bool is_boundary_halfedge = m0_is_polygon_boundary_halfedge((*poly_he_iter), m0_num_cutpath_halfedges);
+                do { // each interation adds a polygon to the patch
+                    const int graph_patch_poly_idx = flood_fill_queue.front();
+                    flood_fill_queue.pop();
 
-                // "is the halfdge not along the cut-path"
-                if (is_boundary_halfedge /*!is_ambiguious_boundary_edge_case || is_valid_ambiguious_boundary_edge*/) {
-                    // get the opposite halfedge which is used to trace the adjacent polygon
-                    const hd_t poly_he_opp = m0.opposite(*poly_he_iter);
-                    // get the coincident polygons (if any)
-                    std::vector<std::vector<int>>::const_iterator find_iter = m0_h_to_ply.cbegin() + poly_he_opp; // m0_h_to_ply.find(poly_he_opp);
+                    patch.push_back(graph_patch_poly_idx);
 
-                    // check if "poly_he_opp" is used to trace a polygon i.e its not a border halfedge
-                    if (find_iter->size() > 0 /*find_iter != m0_h_to_ply.cend()*/) {
+                    const traced_polygon_t& graph_patch_poly = SAFE_ACCESS(m0_polygons, graph_patch_poly_idx);
 
-                        MCUT_ASSERT(find_iter->size() == 1); // only used to trace a CCW cut-mesh polygon
+                    // find adjacent polygons which share class 0,1,2 (o-->o, o-->x, x-->o) halfedges, and
+                    // the class 3 (x-->x) halfedges which are [exterior/boundary] intersection-halfedges.
+                    for (traced_polygon_t::const_iterator poly_he_iter = graph_patch_poly.cbegin();
+                         poly_he_iter != graph_patch_poly.cend();
+                         ++poly_he_iter) {
 
-                        // get the polygon which is traced with "poly_he_opp" i.e. the adjacent polygon we are looking for!
-                        const int incident_poly = find_iter->front();
+                        if (m0_is_polygon_boundary_halfedge((*poly_he_iter), m0_num_cutpath_halfedges)) {
+                            const std::vector<int>& opp_polygons = SAFE_ACCESS(m0_h_to_ply, m0.opposite(*poly_he_iter));
 
-                        // mustbe  cut-mesh polygon since we are only dealing with such polygons when building patches
-                        MCUT_ASSERT(incident_poly >= traced_sm_polygon_count);
+                            if (!opp_polygons.empty()) {
+                                const int incident_poly = opp_polygons.front();
+                                MCUT_ASSERT(incident_poly >= traced_sm_polygon_count);
 
-                        // if (!poly_already_in_patch)
-                        {
-                            // std::unordered_map<int, bool>::const_iterator qmap_fiter = patch_poly_enqueued.find(incident_poly);
-                            const bool poly_already_queued = patch_poly_enqueued[incident_poly]; // qmap_fiter != patch_poly_enqueued.cend(); //std::find(flood_fill_queue.crbegin(), flood_fill_queue.crend(), incident_poly) != flood_fill_queue.crend();
-                            if (!poly_already_queued) {
-                                flood_fill_queue.push(incident_poly); // add adjacent polygon to bfs-queue
-                                patch_poly_enqueued[incident_poly] = true;
+                                if (m0_poly_to_patch[incident_poly] == -1) {
+                                    flood_fill_queue.push(incident_poly); // add adjacent polygon to bfs-queue
+                                    m0_poly_to_patch[incident_poly] = graph_cur_patch_idx;
+                                }
                             }
                         }
                     }
-                }
+                } while (!flood_fill_queue.empty());
+
+                MCUT_ASSERT(!patch.empty()); // there has to be at least one polygon
+            }
+            return true;
+        };
+
+#if defined(MCUT_MULTI_THREADED)
+        if (!patch_seeds.empty()) {
+            std::vector<std::future<bool>> futures;
+            bool _1;
+
+            parallel_fork_and_join(
+                *input.scheduler,
+                patch_seeds.cbegin(),
+                patch_seeds.cend(),
+                1, // one patch per task
+                fn_build_patches,
+                _1, // out
+                futures);
+
+            for (int i = 0; i < (int)futures.size(); ++i) {
+                std::future<bool>& f = futures[i];
+                MCUT_ASSERT(f.valid());
+                f.wait(); // wait for result to be done
             }
+        }
+#else
+        fn_build_patches(patch_seeds.cbegin(), patch_seeds.cend());
+#endif
 
-        } while (!flood_fill_queue.empty()); // while there are more adjacent polygons for building current patch
+        // merge the patches in the order of their index
+        for (int graph_cur_patch_idx = 0; graph_cur_patch_idx < (int)patch_seeds.size(); ++graph_cur_patch_idx) {
+            patch_to_seed_interior_ihalfedge_idx[graph_cur_patch_idx] = patch_seeds[graph_cur_patch_idx].second;
+            patch_to_seed_poly_idx[graph_cur_patch_idx] = patch_seeds[graph_cur_patch_idx].first;
 
-        MCUT_ASSERT(!patch.empty()); // there has to be at least one polygon
+            std::vector<int>& patch = patch_polygons[graph_cur_patch_idx];
 
-        // NOTE: at this stage, all patches/nodes of the current graph have been coloured i.e. we have bipartite graph of the patches (except if there is only one patch i.e. a floating patch).
-    } while (!primary_interior_ihalfedge_pool.empty()); // while there are more interior ihalfedges coincident to polygons which have not been associated with a patch (hence, there are remaining graphs of patches to be stitched)
+            for (std::vector<int>::const_iterator patch_poly_iter = patch.cbegin(); patch_poly_iter != patch.cend(); ++patch_poly_iter) {
+                MCUT_ASSERT(m0_cm_poly_to_patch_idx.count(*patch_poly_iter) == 0);
+                m0_cm_poly_to_patch_idx[*patch_poly_iter] = graph_cur_patch_idx;
+            }
 
-    patch_poly_enqueued.clear();
+            patches.emplace_hint(patches.end(), graph_cur_patch_idx, std::move(patch));
+        }
+    }
 
     // NOTE: At this stage, we have identified all patches of the current graph
 
@@ -7941,36 +7625,62 @@ void dispatch(output_t& output, const input_t& input)
 
     //
     // We will now sort the patches into two sets - interior and exterior.
-    // We do this by building an adjacency matrix and its square (^2) to produce
-    // a bipartite graph via coloring. The adjacency matrix represents the
-    // adjacency between patches (sharing a cut path).
+    // We do this by building the adjacency graph of the patches (two patches
+    // are adjacent if they share a cut path) and coloring it via the 2-walks
+    // of the graph (i.e. the neighbours of neighbours), which produces a
+    // bipartite graph.
     //
+    // NOTE: the graph is stored as compressed adjacency lists (CSR) rather than
+    // as a dense matrix, whose square would cost O(P^3) time and O(P^2) memory
+    // for P patches.
 
-    matrix_t<> scs_adj_matrix((int)patches.size(), (int)patches.size()); // square
+    const int graph_patch_count = (int)patches.size();
+    MCUT_ASSERT(graph_patch_count > 0);
 
-    for (std::unordered_map<int, std::vector<int>>::const_iterator patch_iter = graph_patch_to_adj_list.cbegin();
-         patch_iter != graph_patch_to_adj_list.cend();
-         ++patch_iter) {
+    // offsets into "graph_adj_patches" (the neighbours of patch "i" are in
+    // [graph_adj_offsets[i], graph_adj_offsets[i + 1]))
+    std::vector<int> graph_adj_offsets((std::size_t)graph_patch_count + 1, 0);
+    std::vector<int> graph_adj_patches;
 
-        const int row_id = patch_iter->first; // same as patch index
+    {
+        // sorted and unique neighbours per patch (like a row of an adjacency matrix)
+        std::vector<std::vector<int>> patch_neighbours(graph_patch_count);
 
-        for (std::vector<int>::const_iterator adj_patch_iter = patch_iter->second.cbegin();
-             adj_patch_iter != patch_iter->second.cend();
-             ++adj_patch_iter) {
+        for (std::unordered_map<int, std::vector<int>>::const_iterator patch_iter = graph_patch_to_adj_list.cbegin();
+             patch_iter != graph_patch_to_adj_list.cend();
+             ++patch_iter) {
 
-            const int col_id = *adj_patch_iter;
+            const int patch_idx = patch_iter->first;
+            MCUT_ASSERT(patch_idx >= 0 && patch_idx < graph_patch_count);
+            std::vector<int>& neighbours = patch_neighbours[patch_idx];
 
-            if (row_id == col_id) {
-                // our adjacency matrix is no self referent because patches
-                // do not connect to themselves!
-                continue;
+            for (std::vector<int>::const_iterator adj_patch_iter = patch_iter->second.cbegin();
+                 adj_patch_iter != patch_iter->second.cend();
+                 ++adj_patch_iter) {
+
+                if (*adj_patch_iter == patch_idx) {
+                    // the graph is not self referent because patches do not
+                    // connect to themselves!
+                    continue;
+                }
+
+                neighbours.push_back(*adj_patch_iter);
             }
 
-            scs_adj_matrix(row_id, col_id) = 1; // mark adjacent
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
         }
-    }
 
-    const matrix_t<> scs_adj_matrix_sqrd = scs_adj_matrix * scs_adj_matrix;
+        for (int i = 0; i < graph_patch_count; ++i) {
+            graph_adj_offsets[(std::size_t)i + 1] = graph_adj_offsets[i] + (int)patch_neighbours[i].size();
+        }
+
+        graph_adj_patches.reserve(graph_adj_offsets.back());
+
+        for (int i = 0; i < graph_patch_count; ++i) {
+            graph_adj_patches.insert(graph_adj_patches.end(), patch_neighbours[i].cbegin(), patch_neighbours[i].cend());
+        }
+    }
 
     // Here we do graph coloring using BFS
     // NOTE: coloring is used to mark patches as either interior or exterior.
@@ -7983,40 +7693,46 @@ void dispatch(output_t& output, const input_t& input)
     // intersection-halfedges.
 
     std::deque<int> graph_patch_coloring_queue;
+    // whether a patch has been pushed onto the queue (i.e. it is either queued or already colored)
+    std::vector<bool> graph_patch_is_enqueued(graph_patch_count, false);
+    // patches which can be reached from the current patch with a 2-walk
+    std::vector<int> graph_two_walk_patches;
+
     // start coloring with the first patch
     graph_patch_coloring_queue.push_back(0);
+    graph_patch_is_enqueued[0] = true;
     // "red" chosen arbitrarilly
     std::vector<int>& red_nodes = SAFE_ACCESS(color_to_patch, 'A');
 
     do { // color the current node/patch of the red set
         const int graph_cur_colored_patch_idx = graph_patch_coloring_queue.front();
+        graph_patch_coloring_queue.pop_front();
         red_nodes.push_back(graph_cur_colored_patch_idx);
 
-        const int row_id = graph_cur_colored_patch_idx; // NOTE: no need to account for the fact that the number of patches accumulates since graph_1st_patch_idx == 0
-
-        // find adjacent patch using A^2 and push adj patch onto queue (if not already colored)
-        for (int col_id = 0; col_id < scs_adj_matrix_sqrd.cols(); ++col_id) {
+        // find the patches at the end of a 2-walk, and push them onto the queue
+        // (if not already colored) in ascending order of their index
+        graph_two_walk_patches.clear();
 
-            if (row_id == col_id) {
-                continue; // we dont care about two-walks from a node back to itself
-            }
-
-            const unsigned int entry = scs_adj_matrix_sqrd(row_id, col_id);
+        for (int i = graph_adj_offsets[graph_cur_colored_patch_idx]; i < graph_adj_offsets[(std::size_t)graph_cur_colored_patch_idx + 1]; ++i) {
+            const int adj_patch_idx = graph_adj_patches[i];
 
-            if (entry > 0) // two-walk exists
-            {
-                const int graph_next_colored_patch_idx = col_id;
+            for (int j = graph_adj_offsets[adj_patch_idx]; j < graph_adj_offsets[(std::size_t)adj_patch_idx + 1]; ++j) {
+                const int two_walk_patch_idx = graph_adj_patches[j];
 
-                if ( // not already colored
-                    std::find(red_nodes.cbegin(), red_nodes.cend(), graph_next_colored_patch_idx) == red_nodes.cend() &&
-                    // not in queue
-                    std::find(graph_patch_coloring_queue.cbegin(), graph_patch_coloring_queue.cend(), graph_next_colored_patch_idx) == graph_patch_coloring_queue.cend()) {
-                    graph_patch_coloring_queue.push_back(graph_next_colored_patch_idx);
+                if (two_walk_patch_idx != graph_cur_colored_patch_idx && // we dont care about two-walks from a node back to itself
+                    !graph_patch_is_enqueued[two_walk_patch_idx]) {
+                    graph_two_walk_patches.push_back(two_walk_patch_idx);
                 }
             }
         }
 
-        graph_patch_coloring_queue.pop_front(); // rm graph_cur_colored_patch_idx
+        std::sort(graph_two_walk_patches.begin(), graph_two_walk_patches.end());
+        graph_two_walk_patches.erase(std::unique(graph_two_walk_patches.begin(), graph_two_walk_patches.end()), graph_two_walk_patches.end());
+
+        for (std::vector<int>::const_iterator it = graph_two_walk_patches.cbegin(); it != graph_two_walk_patches.cend(); ++it) {
+            graph_patch_coloring_queue.push_back(*it);
+            graph_patch_is_enqueued[*it] = true;
+        }
 
     } while (!graph_patch_coloring_queue.empty());
 
@@ -8027,13 +7743,17 @@ void dispatch(output_t& output, const input_t& input)
          patch_iter != graph_patch_to_adj_list.cend();
          ++patch_iter) {
 
-        const bool is_red = std::find(red_nodes.cbegin(), red_nodes.cend(), patch_iter->first) != red_nodes.cend();
+        const bool is_red = graph_patch_is_enqueued[patch_iter->first]; // every enqueued patch ends up "red"
 
         if (!is_red) {
             blue_nodes.push_back(patch_iter->first);
         }
     }
 
+    if (input.deterministic) {
+        std::sort(blue_nodes.begin(), blue_nodes.end()); // instead of the order of the hash table
+    }
+
     TIMESTACK_POP(); // &&&&&
 
     // NOTE: at this stage, all strongly-connected-sets have been identified and colored (i.e via coloring, all nodes/patches have been associated with a side : interior or exterior)
@@ -8078,6 +7798,7 @@ void dispatch(output_t& output, const input_t& input)
 
             // pull any re-entrant vertex from queue
             const vd_t current_reentrant_ivertex = reentrant_ivertex_queue.front();
+            (void)current_reentrant_ivertex;
 
             hd_t current_cs_border_he = hmesh_t::null_halfedge();
             hd_t next_cs_border_he = hmesh_t::null_halfedge();
@@ -8384,7 +8105,12 @@ void dispatch(output_t& output, const input_t& input)
 
 #if 1
         // std::vector<std::pair<int /*poly*/, int /*he idx*/>> known_exterior_cm_polygons;
-        const std::unordered_map<int /*poly*/, int /*he idx*/>::const_iterator known_exterior_cm_polygon = known_exterior_cm_polygons.cbegin();
+        std::unordered_map<int /*poly*/, int /*he idx*/>::const_iterator known_exterior_cm_polygon = known_exterior_cm_polygons.cbegin();
+
+        if (input.deterministic) { // use the polygon with the smallest index instead of the first polygon in the hash table
+            known_exterior_cm_polygon = std::min_element(known_exterior_cm_polygons.cbegin(), known_exterior_cm_polygons.cend(),
+                [](const std::pair<const int, int>& a, const std::pair<const int, int>& b) { return a.first < b.first; });
+        }
         MCUT_ASSERT(m0_cm_poly_to_patch_idx.find(known_exterior_cm_polygon->first) != m0_cm_poly_to_patch_idx.cend());
 
         // get the patch containing the polygon
@@ -8854,8 +8580,8 @@ void dispatch(output_t& output, const input_t& input)
                 // compute vertex mapping
                 // ----------------------
 
-                omi.data_maps.vertex_map.resize(patch_mesh.number_of_vertices());
-                for (vertex_array_iterator_t v = patch_mesh.vertices_begin(); v != patch_mesh.vertices_end(); ++v) {
+                omi.data_maps.vertex_map.resize(omi.mesh.number_of_vertices());
+                for (vertex_array_iterator_t v = omi.mesh.vertices_begin(); v != omi.mesh.vertices_end(); ++v) {
                     MCUT_ASSERT(patch_to_m0_vertex.count(*v) == 1);
                     const vd_t as_m0_descr = SAFE_ACCESS(patch_to_m0_vertex, *v);
                     vd_t as_cm_descr = hmesh_t::null_vertex();
@@ -8863,8 +8589,8 @@ void dispatch(output_t& output, const input_t& input)
                     if ((int)as_m0_descr < (int)m0_to_ps_vtx.size() /*m0_to_ps_vtx.count(as_m0_descr) == 1*/) {
                         vd_t as_ps_descr = SAFE_ACCESS(patch_to_m0_vertex, *v);
 
-                        MCUT_ASSERT((int)as_ps_descr < (int)ps_to_cm_vtx.size() /*ps_to_cm_vtx.count(as_ps_descr) == 1*/);
-                        as_cm_descr = SAFE_ACCESS(ps_to_cm_vtx, as_ps_descr);
+                        MCUT_ASSERT(ps.is_cut_mesh_element(as_ps_descr));
+                        as_cm_descr = ps.to_cut_mesh(as_ps_descr);
 
                         // add an offset which allows users to deduce which birth/origin mesh (source or cut mesh) a face (map value) belongs to.
                         as_cm_descr = static_cast<vd_t>(as_cm_descr + sm_vtx_cnt);
@@ -8879,16 +8605,16 @@ void dispatch(output_t& output, const input_t& input)
                 // compute face mapping
                 // ----------------------
 
-                omi.data_maps.face_map.resize(patch_mesh.number_of_faces());
-                for (face_array_iterator_t f = patch_mesh.faces_begin(); f != patch_mesh.faces_end(); ++f) {
+                omi.data_maps.face_map.resize(omi.mesh.number_of_faces());
+                for (face_array_iterator_t f = omi.mesh.faces_begin(); f != omi.mesh.faces_end(); ++f) {
                     MCUT_ASSERT(patch_to_m0_face.count(*f) == 1);
                     const int as_m0_descr = SAFE_ACCESS(patch_to_m0_face, *f);
 
                     MCUT_ASSERT(m0_to_ps_face.count(as_m0_descr) == 1);
                     const fd_t as_ps_descr = SAFE_ACCESS(m0_to_ps_face, as_m0_descr);
 
-                    MCUT_ASSERT((int)as_ps_descr < (int)ps_to_cm_face.size() /*ps_to_cm_face.count(as_ps_descr) == 1*/);
-                    fd_t as_cm_descr = SAFE_ACCESS(ps_to_cm_face, as_ps_descr);
+                    MCUT_ASSERT(ps.is_cut_mesh_element(as_ps_descr));
+                    fd_t as_cm_descr = ps.to_cut_mesh(as_ps_descr);
 
                     // add an offset which allows users to deduce which birth/origin mesh (source or cut mesh) a face (map value) belongs to.
                     as_cm_descr = static_cast<fd_t>(as_cm_descr + sm_face_count);
@@ -9080,7 +8806,7 @@ void dispatch(output_t& output, const input_t& input)
 
     std::map<
         char, // color value
-        std::unordered_map<int, int> // copy of m0_to_m1_face (initially containing mappings just for traced source-mesh polygon)
+        arena_unordered_map_t<int, int> // copy of m0_to_m1_face (initially containing mappings just for traced source-mesh polygon)
         >
         color_to_m0_to_m1_face = { { 'A', m0_to_m1_face }, { 'B', m0_to_m1_face } };
 
@@ -9088,7 +8814,7 @@ void dispatch(output_t& output, const input_t& input)
 
     std::map<
         char, // color value
-        std::unordered_map<int, int> // copy of m1_to_m0_face (initially containing mappings just for traced source-mesh polygon)
+        arena_unordered_map_t<int, int> // copy of m1_to_m0_face (initially containing mappings just for traced source-mesh polygon)
         >
         color_to_m1_to_m0_face = { { 'A', m1_to_m0_face }, { 'B', m1_to_m0_face } };
 
@@ -9107,13 +8833,19 @@ void dispatch(output_t& output, const input_t& input)
 
     m1_to_m0_ovtx.clear();
 
-    // this queue contains information identifying the patch polygons next-in-queue
-            // to be stitched into the inferred connected component
-            std::deque<std::tuple<hd_t /*m1*/, int /*m0 poly*/, int /*m0 he*/>> patch_poly_stitching_queue;
-            
-    // enough space for cut-mesh polygons
-            std::vector<bool> m0_poly_already_enqueued(m0_polygons.size() - traced_sm_polygon_count, false); // i.e. in "patch_poly_stitching_queue"
-            const int m0_poly_already_enqueued_size = (int)m0_poly_already_enqueued.size();
+    // Whether every instance of the connected components with the given color is kept while
+    // stitching (i.e. one copy after each stitched cut-mesh polygon) to produce partially sealed
+    // fragments. Otherwise, only the final (fully sealed) connected components are created, once
+    // all patches of the color have been stitched.
+    auto keep_partially_sealed_fragments = [&](const char color_id) -> bool {
+        const cm_patch_location_t& location = SAFE_ACCESS(patch_color_label_to_location, color_id);
+        return (location == cm_patch_location_t::INSIDE && input.keep_fragments_sealed_inside_exhaustive) || //
+            (location == cm_patch_location_t::OUTSIDE && input.keep_fragments_sealed_outside_exhaustive);
+    };
+
+    // the colors whose patches will be stitched
+    std::vector<char> colors_to_stitch;
+    bool have_partially_sealed_fragments = false;
 
     // for each color  ("interior" / "exterior")
     for (std::map<char, std::vector<int>>::const_iterator color_to_patches_iter = color_to_patch.cbegin();
@@ -9129,1064 +8861,1115 @@ void dispatch(output_t& output, const input_t& input)
             continue; // skip stitching of exterior/ interior patches as user desires.
         }
 
-        MCUT_ASSERT(color_to_m1.count(color_id) == 1);
-        // get the reference to the copy of "m1" to which patches of the current color will be stitched
-        hmesh_t& m1_colored = SAFE_ACCESS(color_to_m1, color_id);
-
-        m1_colored.reserve_for_additional_elements(cs_face_count);
+        colors_to_stitch.push_back(color_id);
+        have_partially_sealed_fragments = have_partially_sealed_fragments || keep_partially_sealed_fragments(color_id);
 
-        m1_colored.reserve_for_additional_elements(cs_face_count);
-
-        // create entry
+        // create the entries of the current color now so that the maps are not
+        // modified while the colors are stitched (which may happen in parallel)
         color_to_m0_to_m1_he_instances.insert(std::make_pair(color_id, std::unordered_map<hd_t, std::map<int, hd_t>>()));
-        // ref to entry
-        std::unordered_map<hd_t, std::map<int, hd_t>>& m0_to_m1_he_instances = SAFE_ACCESS(color_to_m0_to_m1_he_instances, color_id);
-        // copy all of the "m1_polygons" that were created before we got to the stitching stage
-        // Note: Before stitching has began, "m1_polygons" contains only source-mesh polygons,
-        // which have been partition to allow separation of unsealed connected components
-        std::pair<std::map<char, std::vector<traced_polygon_t>>::iterator, bool> color_to_m1_polygons_insertion = color_to_m1_polygons.insert(std::make_pair(color_id, m1_polygons)); // copy!
-
-        MCUT_ASSERT(color_to_m1_polygons_insertion.second == true);
-
-        // ref to "m1_polygons" i.e. the source-mesh polygons with partitioning
-        std::vector<traced_polygon_t>& m1_polygons_colored = color_to_m1_polygons_insertion.first->second;
-        m1_polygons_colored.reserve(m1_polygons_colored.size() + cs_face_count);
-
-        // reference to the list connected components (see declaration for details)
-        std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>& separated_stitching_CCs = color_to_separated_connected_ccsponents[color_id]; // insert
-
-        std::unordered_map<int, int>& m0_to_m1_face_colored = SAFE_ACCESS(color_to_m0_to_m1_face, color_id); // note: containing mappings only for traced source mesh polygons initially!
-        std::unordered_map<int, int>& m1_to_m0_face_colored = SAFE_ACCESS(color_to_m1_to_m0_face, color_id);
-        MCUT_ASSERT(!m0_to_m1_face_colored.empty());
-        MCUT_ASSERT(!m1_to_m0_face_colored.empty());
-
-        std::vector<vd_t>& m1_to_m0_sm_ovtx_colored = SAFE_ACCESS(color_to_m1_to_m0_sm_ovtx, color_id);
-        // MCUT_ASSERT(!m0_to_m1_sm_ovtx_colored.empty());
-        MCUT_ASSERT(!m1_to_m0_sm_ovtx_colored.empty());
-
-        // An original in "m0" that is used to trace a cut-mesh polygon will have
-        // two "m1" versions - one for the ccw/normal patch and the other for the
-        // cw/reversed patch.
-        //
-        // This map works like "color_to_m0_to_m1_sm_ovtx" but the difference is that each
-        // "m0" vertex has two "m1" copies because we generate ccw & cw patches.
+        color_to_m1_polygons.insert(std::make_pair(color_id, std::vector<traced_polygon_t>()));
+        color_to_separated_connected_ccsponents.insert(std::make_pair(color_id, std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>()));
+        colour_to_m1_to_m0_cm_ovtx.insert(std::make_pair(color_id, std::unordered_map<vd_t, vd_t>()));
+    }
 
-        MCUT_ASSERT(colour_to_m1_to_m0_cm_ovtx.count(color_id) == 0);
-        std::unordered_map<vd_t, // "m1" cut-mesh vtx instance
-            vd_t // "m0" cut-mesh ovtx instance
-            >& m1_to_m0_cm_ovtx_colored
-            = colour_to_m1_to_m0_cm_ovtx[color_id];
+    //
+    // The patches of a color are stitched into the same copy of "m1" one after the other
+    // (the descriptors of the elements added to it depend on the order of stitching).
+    // However, interior and exterior patches are stitched into separate copies of "m1"
+    // and share no other mutable state, so the two colors are stitched in parallel.
+    //
+    auto fn_stitch_colored_patches = [&](std::vector<char>::const_iterator block_start_, std::vector<char>::const_iterator block_end_) -> bool {
+        for (std::vector<char>::const_iterator color_iter = block_start_; color_iter != block_end_; ++color_iter) {
 
-        // keeps track of the total number of cut-mesh polygons for the current color tag (interior/ext)
-        int stitched_poly_counter = 0;
+            const char color_id = *color_iter;
 
-        // for each patch with current color
-        for (std::vector<int>::const_iterator patch_iter = color_to_patches_iter->second.cbegin();
-             patch_iter != color_to_patches_iter->second.cend();
-             ++patch_iter) {
+            // the patches with the current color
+            const std::vector<int>& colored_patches = SAFE_ACCESS(color_to_patch, color_id);
 
-            // get patch index
-            const int cur_patch_idx = *patch_iter;
+            MCUT_ASSERT(color_to_m1.count(color_id) == 1);
+            // get the reference to the copy of "m1" to which patches of the current color will be stitched
+            hmesh_t& m1_colored = SAFE_ACCESS(color_to_m1, color_id);
 
-            // is it a ccw/normal patch i.e. not the cw/reversed version
-            // NOTE: ccw/normal patches are created/traced before reversed counterparts (hence the modulo trick)
-            const bool is_ccw_patch = ((cur_patch_idx % total_ccw_patch_count) == cur_patch_idx);
+            m1_colored.reserve_for_additional_elements(cs_face_count);
 
-            MCUT_ASSERT(patches.find(cur_patch_idx) != patches.cend());
-            ///////////////////////////////////////////////////////////////////////////
-            // stitch patch into a connected component stored in "m1_colored"
-            ///////////////////////////////////////////////////////////////////////////
+            m1_colored.reserve_for_additional_elements(cs_face_count);
 
-            //
-            // We are basically going to search for the connected component (in "m1_colored") to which
-            // the current patch will be stitched/glued.
-            //
-            // PERSONAL NOTE REGARDING `NORMAL` PATCHES:
-            // Interior patches are stitched to the connected components which "naturally"
-            // match their winding order (i.e. they are stitched to the connected component
-            // "below" the patch).
-            // Exterior patches are stitched to connected components which DO NOT share
-            // the "natural" winding order (i.e. they are stitched to the connected component
-            // "above" the patch).
-            //
+            // ref to entry
+            std::unordered_map<hd_t, std::map<int, hd_t>>& m0_to_m1_he_instances = SAFE_ACCESS(color_to_m0_to_m1_he_instances, color_id);
+            // copy all of the "m1_polygons" that were created before we got to the stitching stage
+            // Note: Before stitching has began, "m1_polygons" contains only source-mesh polygons,
+            // which have been partition to allow separation of unsealed connected components
+            std::vector<traced_polygon_t>& m1_polygons_colored = SAFE_ACCESS(color_to_m1_polygons, color_id);
+            m1_polygons_colored = m1_polygons; // copy!
+            m1_polygons_colored.reserve(m1_polygons_colored.size() + cs_face_count);
 
-            MCUT_ASSERT(patch_to_seed_poly_idx.find(cur_patch_idx) != patch_to_seed_poly_idx.cend());
+            // reference to the list connected components (see declaration for details)
+            std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>& separated_stitching_CCs = SAFE_ACCESS(color_to_separated_connected_ccsponents, color_id);
 
-            // get the seed polygon from which to begin the stitching
-            // this polygon will be on the patch boundary/border
-            const int m0_patch_seed_poly_idx = SAFE_ACCESS(patch_to_seed_poly_idx, cur_patch_idx);
+            arena_unordered_map_t<int, int>& m0_to_m1_face_colored = SAFE_ACCESS(color_to_m0_to_m1_face, color_id); // note: containing mappings only for traced source mesh polygons initially!
+            arena_unordered_map_t<int, int>& m1_to_m0_face_colored = SAFE_ACCESS(color_to_m1_to_m0_face, color_id);
+            MCUT_ASSERT(!m0_to_m1_face_colored.empty());
+            MCUT_ASSERT(!m1_to_m0_face_colored.empty());
 
-            // patch must contain the polygon
-            MCUT_ASSERT(std::find(SAFE_ACCESS(patches, cur_patch_idx).cbegin(), SAFE_ACCESS(patches, cur_patch_idx).cend(), m0_patch_seed_poly_idx) != SAFE_ACCESS(patches, cur_patch_idx).cend());
-            // the seed polygon must be from the ones that were traced in "m0" (see graph discovery stage above)
-            MCUT_ASSERT(m0_patch_seed_poly_idx < (int)m0_polygons.size());
+            std::vector<vd_t>& m1_to_m0_sm_ovtx_colored = SAFE_ACCESS(color_to_m1_to_m0_sm_ovtx, color_id);
+            // MCUT_ASSERT(!m0_to_m1_sm_ovtx_colored.empty());
+            MCUT_ASSERT(!m1_to_m0_sm_ovtx_colored.empty());
 
-            // get the seed polygon of the patch
-            const traced_polygon_t& m0_patch_seed_poly = SAFE_ACCESS(m0_polygons, m0_patch_seed_poly_idx);
+            // An original in "m0" that is used to trace a cut-mesh polygon will have
+            // two "m1" versions - one for the ccw/normal patch and the other for the
+            // cw/reversed patch.
+            //
+            // This map works like "color_to_m0_to_m1_sm_ovtx" but the difference is that each
+            // "m0" vertex has two "m1" copies because we generate ccw & cw patches.
 
-            // patch must have a seed halfedge (the one used to traced the seed polygon)
-            MCUT_ASSERT(patch_to_seed_interior_ihalfedge_idx.find(cur_patch_idx) != patch_to_seed_interior_ihalfedge_idx.cend());
+            MCUT_ASSERT(colour_to_m1_to_m0_cm_ovtx.count(color_id) == 1);
+            std::unordered_map<vd_t, // "m1" cut-mesh vtx instance
+                vd_t // "m0" cut-mesh ovtx instance
+                >& m1_to_m0_cm_ovtx_colored
+                = SAFE_ACCESS(colour_to_m1_to_m0_cm_ovtx, color_id);
 
-            // get the index of the seed interior intersection halfedge of the patch
-            // this is a halfedge defining the border of the patch and is used to trace
-            // the seed polygon
-            const int m0_patch_seed_poly_he_idx = SAFE_ACCESS(patch_to_seed_interior_ihalfedge_idx, cur_patch_idx);
+            // keeps track of the total number of cut-mesh polygons for the current color tag (interior/ext)
+            int stitched_poly_counter = 0;
 
-            // must be within the range of the number of halfedge defining the seed polygon
-            MCUT_ASSERT(m0_patch_seed_poly_he_idx < (int)m0_patch_seed_poly.size());
+            const bool keep_partially_sealed_ccs = keep_partially_sealed_fragments(color_id);
 
-            // get the seed halfedge descriptor
-            const hd_t& m0_patch_seed_poly_he = SAFE_ACCESS(m0_patch_seed_poly, m0_patch_seed_poly_he_idx);
+            // this queue contains information identifying the patch polygons next-in-queue
+            // to be stitched into the inferred connected component
+            std::deque<std::tuple<hd_t /*m1*/, int /*m0 poly*/, int /*m0 he*/>> patch_poly_stitching_queue;
 
-            //
-            // Here, we now deduce the connected component to which the current patch will be stitched.
-            // To do this we can use the opposite halfedge of the seed halfedge. This opposite halfedge
-            // is used to trace a source-mesh polygon next to the cut-path.
-            //
+            // enough space for cut-mesh polygons
+            std::vector<bool> m0_poly_already_enqueued(m0_polygons.size() - traced_sm_polygon_count, false); // i.e. in "patch_poly_stitching_queue"
+            const int m0_poly_already_enqueued_size = (int)m0_poly_already_enqueued.size();
 
-            // get opposite halfedge of the seed halfedge of the current patch
-            const hd_t m0_patch_seed_poly_he_opp = m0.opposite(m0_patch_seed_poly_he);
+            // for each patch with current color
+            for (std::vector<int>::const_iterator patch_iter = colored_patches.cbegin();
+                 patch_iter != colored_patches.cend();
+                 ++patch_iter) {
 
-            // an "m1" version of this opposite halfedge must exist from the halfedge
-            // partitioning problem we solved when duplicating intersection points to
-            // partition the source-mesh
-            MCUT_ASSERT(m0_to_m1_ihe.find(m0_patch_seed_poly_he_opp) != m0_to_m1_ihe.cend());
+                // get patch index
+                const int cur_patch_idx = *patch_iter;
 
-            // get the "m1" version of the opposite-halfedge of the seed-halfedge.
-            // Note that this halfedge has already been used to trace a source-mesh polygon
-            // in "m1"....
-            const hd_t m1_seed_interior_ihe_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_patch_seed_poly_he_opp);
-            // .... thus, we have to use its opposite, which will be the "m1" version of the
-            // seed halfedge of the current patch.
-            // PERSONAL NOTE: this probably requires a visual example to properly understand
-            const hd_t m1_seed_interior_ihe_opp_opp = m1_colored.opposite(m1_seed_interior_ihe_opp); // i.e. m1 instance of m0_patch_seed_poly_he_opp
+                // is it a ccw/normal patch i.e. not the cw/reversed version
+                // NOTE: ccw/normal patches are created/traced before reversed counterparts (hence the modulo trick)
+                const bool is_ccw_patch = ((cur_patch_idx % total_ccw_patch_count) == cur_patch_idx);
 
-            
-            patch_poly_stitching_queue.clear();
-            
-            // reset
-            for(int i =0; i < m0_poly_already_enqueued_size;++i)
-            {
-                m0_poly_already_enqueued[i] = false;
-            }
+                MCUT_ASSERT(patches.find(cur_patch_idx) != patches.cend());
+                ///////////////////////////////////////////////////////////////////////////
+                // stitch patch into a connected component stored in "m1_colored"
+                ///////////////////////////////////////////////////////////////////////////
+
+                //
+                // We are basically going to search for the connected component (in "m1_colored") to which
+                // the current patch will be stitched/glued.
+                //
+                // PERSONAL NOTE REGARDING `NORMAL` PATCHES:
+                // Interior patches are stitched to the connected components which "naturally"
+                // match their winding order (i.e. they are stitched to the connected component
+                // "below" the patch).
+                // Exterior patches are stitched to connected components which DO NOT share
+                // the "natural" winding order (i.e. they are stitched to the connected component
+                // "above" the patch).
+                //
 
-            // thus, the first element is the seed polygon and the seed halfedge
-            patch_poly_stitching_queue.push_back(
-                std::make_tuple(
-                    m1_seed_interior_ihe_opp_opp,
-                    m0_patch_seed_poly_idx,
-                    m0_patch_seed_poly_he_idx));
+                MCUT_ASSERT(patch_to_seed_poly_idx.find(cur_patch_idx) != patch_to_seed_poly_idx.cend());
 
-            //
-            // In the following loop, we will stitch patch polygons iteratively as we
-            // discover adjacent ones starting from the seed polygon. In each interation,
-            // we process halfedges of the current polygon so that they reference the
-            // correct vertex descriptors (src and tgt) in order to fill holes.
-            //
-            do {
+                // get the seed polygon from which to begin the stitching
+                // this polygon will be on the patch boundary/border
+                const int m0_patch_seed_poly_idx = SAFE_ACCESS(patch_to_seed_poly_idx, cur_patch_idx);
 
-                // the first processed/stitched of halfedge the current polygon (our starting point)
-                hd_t m1_cur_patch_cur_poly_1st_he = hmesh_t::null_halfedge();
-                int m0_cur_patch_cur_poly_idx = -1; // index into m0_polygons
-                int m0_cur_patch_cur_poly_1st_he_idx = -1; // index into m0_polygon
+                // patch must contain the polygon
+                MCUT_ASSERT(std::find(SAFE_ACCESS(patches, cur_patch_idx).cbegin(), SAFE_ACCESS(patches, cur_patch_idx).cend(), m0_patch_seed_poly_idx) != SAFE_ACCESS(patches, cur_patch_idx).cend());
+                // the seed polygon must be from the ones that were traced in "m0" (see graph discovery stage above)
+                MCUT_ASSERT(m0_patch_seed_poly_idx < (int)m0_polygons.size());
 
-                // pop element from queue (the next polygon to stitch)
-                std::tie(
-                    m1_cur_patch_cur_poly_1st_he,
-                    m0_cur_patch_cur_poly_idx,
-                    m0_cur_patch_cur_poly_1st_he_idx)
-                    = patch_poly_stitching_queue.front();
+                // get the seed polygon of the patch
+                const traced_polygon_t& m0_patch_seed_poly = SAFE_ACCESS(m0_polygons, m0_patch_seed_poly_idx);
 
-                m0_poly_already_enqueued[(std::size_t)m0_cur_patch_cur_poly_idx - traced_sm_polygon_count] = true;
+                // patch must have a seed halfedge (the one used to traced the seed polygon)
+                MCUT_ASSERT(patch_to_seed_interior_ihalfedge_idx.find(cur_patch_idx) != patch_to_seed_interior_ihalfedge_idx.cend());
 
-                // must be within the range of the traced polygons (include the reversed ones)
-                MCUT_ASSERT(m0_cur_patch_cur_poly_idx < (int)m0_polygons.size());
+                // get the index of the seed interior intersection halfedge of the patch
+                // this is a halfedge defining the border of the patch and is used to trace
+                // the seed polygon
+                const int m0_patch_seed_poly_he_idx = SAFE_ACCESS(patch_to_seed_interior_ihalfedge_idx, cur_patch_idx);
 
-                // get the current polygon of the patch
-                const traced_polygon_t& m0_cur_patch_cur_poly = SAFE_ACCESS(m0_polygons, m0_cur_patch_cur_poly_idx);
+                // must be within the range of the number of halfedge defining the seed polygon
+                MCUT_ASSERT(m0_patch_seed_poly_he_idx < (int)m0_patch_seed_poly.size());
 
-                // the index of the starting halfedge must be within range of the polygon
-                MCUT_ASSERT(m0_cur_patch_cur_poly_1st_he_idx < (int)m0_cur_patch_cur_poly.size());
+                // get the seed halfedge descriptor
+                const hd_t& m0_patch_seed_poly_he = SAFE_ACCESS(m0_patch_seed_poly, m0_patch_seed_poly_he_idx);
 
-                // get the descriptor of the starting halfedge
-                const hd_t& m0_cur_patch_cur_poly_1st_he = SAFE_ACCESS(m0_cur_patch_cur_poly, m0_cur_patch_cur_poly_1st_he_idx);
+                //
+                // Here, we now deduce the connected component to which the current patch will be stitched.
+                // To do this we can use the opposite halfedge of the seed halfedge. This opposite halfedge
+                // is used to trace a source-mesh polygon next to the cut-path.
+                //
+
+                // get opposite halfedge of the seed halfedge of the current patch
+                const hd_t m0_patch_seed_poly_he_opp = m0.opposite(m0_patch_seed_poly_he);
 
-                // the processed/stitched version of the current polygon
-                m1_polygons_colored.emplace_back(traced_polygon_t());
-                traced_polygon_t& m1_poly = m1_polygons_colored.back(); // stitched/"m1" version of polygon
-                m1_poly.reserve(m0_cur_patch_cur_poly.size());
-                m1_poly.push_back(m1_cur_patch_cur_poly_1st_he);
+                // an "m1" version of this opposite halfedge must exist from the halfedge
+                // partitioning problem we solved when duplicating intersection points to
+                // partition the source-mesh
+                MCUT_ASSERT(m0_to_m1_ihe.find(m0_patch_seed_poly_he_opp) != m0_to_m1_ihe.cend());
 
-                // save mapping
-                MCUT_ASSERT(m0_to_m1_face_colored.count(m0_cur_patch_cur_poly_idx) == 0);
-                const int m1_cur_patch_cur_poly_idx = (int)(m1_polygons_colored.size() - 1);
-                m0_to_m1_face_colored[m0_cur_patch_cur_poly_idx] = m1_cur_patch_cur_poly_idx;
-                MCUT_ASSERT(m1_to_m0_face_colored.count(m1_cur_patch_cur_poly_idx) == 0);
-                m1_to_m0_face_colored[m1_cur_patch_cur_poly_idx] = m0_cur_patch_cur_poly_idx;
+                // get the "m1" version of the opposite-halfedge of the seed-halfedge.
+                // Note that this halfedge has already been used to trace a source-mesh polygon
+                // in "m1"....
+                const hd_t m1_seed_interior_ihe_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_patch_seed_poly_he_opp);
+                // .... thus, we have to use its opposite, which will be the "m1" version of the
+                // seed halfedge of the current patch.
+                // PERSONAL NOTE: this probably requires a visual example to properly understand
+                const hd_t m1_seed_interior_ihe_opp_opp = m1_colored.opposite(m1_seed_interior_ihe_opp); // i.e. m1 instance of m0_patch_seed_poly_he_opp
 
-                // the number of halfedges in the current polygon that have been processed
-                // Note: we start from "1" because the initial halfedge (m0_cur_patch_cur_poly_1st_he) has already been processed.
-                // That is, we already have an "m1" version of it thanks to the halfedge transformation step (intersection point
-                // dupication step) which occurs along the cutpath.
-                int transformed_he_counter = 1; //
+
+                patch_poly_stitching_queue.clear();
+
+                // reset
+                for(int i =0; i < m0_poly_already_enqueued_size;++i)
+                {
+                    m0_poly_already_enqueued[i] = false;
+                }
+
+                // thus, the first element is the seed polygon and the seed halfedge
+                patch_poly_stitching_queue.push_back(
+                    std::make_tuple(
+                        m1_seed_interior_ihe_opp_opp,
+                        m0_patch_seed_poly_idx,
+                        m0_patch_seed_poly_he_idx));
 
                 //
-                // In the following loop, we will process polygon-halfedges iteratively as we
-                // advance onto the "next" ones in the sequence starting from the initial. In each interation,
-                // we create an "m1" version of the of the current "m0" halfedge so that it references the
-                // correct vertex descriptors (src and tgt). The next iteration moves onto the
-                // next halfedge, and so on...
+                // In the following loop, we will stitch patch polygons iteratively as we
+                // discover adjacent ones starting from the seed polygon. In each interation,
+                // we process halfedges of the current polygon so that they reference the
+                // correct vertex descriptors (src and tgt) in order to fill holes.
                 //
+                do {
 
-                do { // for each remaining halfedge of current polygon being stitched
+                    // the first processed/stitched of halfedge the current polygon (our starting point)
+                    hd_t m1_cur_patch_cur_poly_1st_he = hmesh_t::null_halfedge();
+                    int m0_cur_patch_cur_poly_idx = -1; // index into m0_polygons
+                    int m0_cur_patch_cur_poly_1st_he_idx = -1; // index into m0_polygon
 
-                    if (transformed_he_counter == 1) { // are we processing the second halfedge?
-                                                       // log
-                                                       // TODO: proper printing functions
+                    // pop element from queue (the next polygon to stitch)
+                    std::tie(
+                        m1_cur_patch_cur_poly_1st_he,
+                        m0_cur_patch_cur_poly_idx,
+                        m0_cur_patch_cur_poly_1st_he_idx)
+                        = patch_poly_stitching_queue.front();
 
-                        //  << m1_colored.source(m1_cur_patch_cur_poly_1st_he) << " " << m1_colored.target(m1_cur_patch_cur_poly_1st_he) << ">" << std::endl;);
-                    }
+                    m0_poly_already_enqueued[(std::size_t)m0_cur_patch_cur_poly_idx - traced_sm_polygon_count] = true;
 
-                    // index of current halfedge index to be processed
-                    const int m0_cur_patch_cur_poly_cur_he_idx = wrap_integer(m0_cur_patch_cur_poly_1st_he_idx + transformed_he_counter, 0, (int)m0_cur_patch_cur_poly.size() - 1);
+                    // must be within the range of the traced polygons (include the reversed ones)
+                    MCUT_ASSERT(m0_cur_patch_cur_poly_idx < (int)m0_polygons.size());
 
-                    // must be in range of polygon size
-                    MCUT_ASSERT(m0_cur_patch_cur_poly_cur_he_idx < (int)m0_cur_patch_cur_poly.size());
+                    // get the current polygon of the patch
+                    const traced_polygon_t& m0_cur_patch_cur_poly = SAFE_ACCESS(m0_polygons, m0_cur_patch_cur_poly_idx);
 
-                    // descriptor of current halfedge
-                    const hd_t m0_cur_patch_cur_poly_cur_he = SAFE_ACCESS(m0_cur_patch_cur_poly, m0_cur_patch_cur_poly_cur_he_idx); // current untransformed
-                    // opposite of current halfedge
-                    const hd_t m0_cur_patch_cur_poly_cur_he_opp = m0.opposite(m0_cur_patch_cur_poly_cur_he);
-                    // target of the current halfedge
-                    vd_t m0_cur_patch_cur_poly_cur_he_tgt = m0.target(m0_cur_patch_cur_poly_cur_he);
-                    vd_t m0_cur_patch_cur_poly_cur_he_src = m0.source(m0_cur_patch_cur_poly_cur_he);
-                    const bool src_is_ivertex = m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_src, ps_vtx_cnt);
-                    const bool tgt_is_ivertex = m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_tgt, ps_vtx_cnt);
+                    // the index of the starting halfedge must be within range of the polygon
+                    MCUT_ASSERT(m0_cur_patch_cur_poly_1st_he_idx < (int)m0_cur_patch_cur_poly.size());
 
-                    // is the current halfedge the last to be processed in the current polygon?
-                    const bool cur_is_last_to_be_transformed = ((transformed_he_counter + 1) == (int)m0_cur_patch_cur_poly.size()); // i.e. current he is last one to be transform
-                    // enumerator of previously processed halfedge
-                    const int m1_cur_patch_cur_poly_prev_he_idx = transformed_he_counter - 1; // note: transformed_he_counter is init to 1
+                    // get the descriptor of the starting halfedge
+                    const hd_t& m0_cur_patch_cur_poly_1st_he = SAFE_ACCESS(m0_cur_patch_cur_poly, m0_cur_patch_cur_poly_1st_he_idx);
 
-                    // must be in current polygon's range
-                    MCUT_ASSERT(m1_cur_patch_cur_poly_prev_he_idx >= 0 && m1_cur_patch_cur_poly_prev_he_idx < (int)m1_poly.size());
+                    // the processed/stitched version of the current polygon
+                    m1_polygons_colored.emplace_back(traced_polygon_t());
+                    traced_polygon_t& m1_poly = m1_polygons_colored.back(); // stitched/"m1" version of polygon
+                    m1_poly.reserve(m0_cur_patch_cur_poly.size());
+                    m1_poly.push_back(m1_cur_patch_cur_poly_1st_he);
 
-                    // get descriptor of the processed copy of the preceeding halfedge in the current polygon
-                    const hd_t m1_cur_patch_cur_poly_prev_he = SAFE_ACCESS(m1_poly, m1_cur_patch_cur_poly_prev_he_idx); // previously transformed
-                    // get target of transformed previous
-                    const vd_t m1_cur_patch_cur_poly_prev_he_tgt = m1_colored.target(m1_cur_patch_cur_poly_prev_he); // transformed target of previous
+                    // save mapping
+                    MCUT_ASSERT(m0_to_m1_face_colored.count(m0_cur_patch_cur_poly_idx) == 0);
+                    const int m1_cur_patch_cur_poly_idx = (int)(m1_polygons_colored.size() - 1);
+                    m0_to_m1_face_colored[m0_cur_patch_cur_poly_idx] = m1_cur_patch_cur_poly_idx;
+                    MCUT_ASSERT(m1_to_m0_face_colored.count(m1_cur_patch_cur_poly_idx) == 0);
+                    m1_to_m0_face_colored[m1_cur_patch_cur_poly_idx] = m0_cur_patch_cur_poly_idx;
 
-                    ///////////////////////////////////////////////////////////////////////////
-                    // create "m1" version of current halfedge
-                    ///////////////////////////////////////////////////////////////////////////
+                    // the number of halfedges in the current polygon that have been processed
+                    // Note: we start from "1" because the initial halfedge (m0_cur_patch_cur_poly_1st_he) has already been processed.
+                    // That is, we already have an "m1" version of it thanks to the halfedge transformation step (intersection point
+                    // dupication step) which occurs along the cutpath.
+                    int transformed_he_counter = 1; //
 
-                    // Note that the source of the processed/"m1" version of the current halfedge is the same as
-                    // the target of the processed/"m1" version of the previous halfedge in the current polygon
-                    vd_t m1_cs_cur_patch_polygon_he_src = m1_cur_patch_cur_poly_prev_he_tgt; // known from previous halfedge
-                    // This initialization assumes the target of the processed/"m1" version of the current halfedge
-                    // is the same descriptor as the unprocessed/"m0" version (this is generally true
-                    // when processing non-boundary/border halfedges and the current patch is a normal patch).
-                    vd_t m1_cs_cur_patch_polygon_he_tgt = m0_cur_patch_cur_poly_cur_he_tgt;
+                    //
+                    // In the following loop, we will process polygon-halfedges iteratively as we
+                    // advance onto the "next" ones in the sequence starting from the initial. In each interation,
+                    // we create an "m1" version of the of the current "m0" halfedge so that it references the
+                    // correct vertex descriptors (src and tgt). The next iteration moves onto the
+                    // next halfedge, and so on...
+                    //
 
-                    // flag whether to insert new edge into "m1_colored"
-                    // bool create_new_edge = false;
+                    do { // for each remaining halfedge of current polygon being stitched
 
-                    hd_t m1_cur_patch_cur_poly_cur_he = hmesh_t::null_halfedge();
+                        if (transformed_he_counter == 1) { // are we processing the second halfedge?
+                                                           // log
+                                                           // TODO: proper printing functions
 
-                    // is the current halfedge the last one to be process in the current polygon?
-                    if (cur_is_last_to_be_transformed) {
+                            //  << m1_colored.source(m1_cur_patch_cur_poly_1st_he) << " " << m1_colored.target(m1_cur_patch_cur_poly_1st_he) << ">" << std::endl;);
+                        }
 
-                        // we can infer the updated version of the target vertex from the halfedge
-                        // which is already updated. Update tgt will be the source of the first
-                        // updated halfedge of the current polygon.
-                        m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_poly[0]);
+                        // index of current halfedge index to be processed
+                        const int m0_cur_patch_cur_poly_cur_he_idx = wrap_integer(m0_cur_patch_cur_poly_1st_he_idx + transformed_he_counter, 0, (int)m0_cur_patch_cur_poly.size() - 1);
+
+                        // must be in range of polygon size
+                        MCUT_ASSERT(m0_cur_patch_cur_poly_cur_he_idx < (int)m0_cur_patch_cur_poly.size());
+
+                        // descriptor of current halfedge
+                        const hd_t m0_cur_patch_cur_poly_cur_he = SAFE_ACCESS(m0_cur_patch_cur_poly, m0_cur_patch_cur_poly_cur_he_idx); // current untransformed
+                        // opposite of current halfedge
+                        const hd_t m0_cur_patch_cur_poly_cur_he_opp = m0.opposite(m0_cur_patch_cur_poly_cur_he);
+                        // target of the current halfedge
+                        vd_t m0_cur_patch_cur_poly_cur_he_tgt = m0.target(m0_cur_patch_cur_poly_cur_he);
+                        vd_t m0_cur_patch_cur_poly_cur_he_src = m0.source(m0_cur_patch_cur_poly_cur_he);
+                        const bool src_is_ivertex = m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_src, ps_vtx_cnt);
+                        const bool tgt_is_ivertex = m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_tgt, ps_vtx_cnt);
+
+                        // is the current halfedge the last to be processed in the current polygon?
+                        const bool cur_is_last_to_be_transformed = ((transformed_he_counter + 1) == (int)m0_cur_patch_cur_poly.size()); // i.e. current he is last one to be transform
+                        // enumerator of previously processed halfedge
+                        const int m1_cur_patch_cur_poly_prev_he_idx = transformed_he_counter - 1; // note: transformed_he_counter is init to 1
+
+                        // must be in current polygon's range
+                        MCUT_ASSERT(m1_cur_patch_cur_poly_prev_he_idx >= 0 && m1_cur_patch_cur_poly_prev_he_idx < (int)m1_poly.size());
+
+                        // get descriptor of the processed copy of the preceeding halfedge in the current polygon
+                        const hd_t m1_cur_patch_cur_poly_prev_he = SAFE_ACCESS(m1_poly, m1_cur_patch_cur_poly_prev_he_idx); // previously transformed
+                        // get target of transformed previous
+                        const vd_t m1_cur_patch_cur_poly_prev_he_tgt = m1_colored.target(m1_cur_patch_cur_poly_prev_he); // transformed target of previous
+
+                        ///////////////////////////////////////////////////////////////////////////
+                        // create "m1" version of current halfedge
+                        ///////////////////////////////////////////////////////////////////////////
+
+                        // Note that the source of the processed/"m1" version of the current halfedge is the same as
+                        // the target of the processed/"m1" version of the previous halfedge in the current polygon
+                        vd_t m1_cs_cur_patch_polygon_he_src = m1_cur_patch_cur_poly_prev_he_tgt; // known from previous halfedge
+                        // This initialization assumes the target of the processed/"m1" version of the current halfedge
+                        // is the same descriptor as the unprocessed/"m0" version (this is generally true
+                        // when processing non-boundary/border halfedges and the current patch is a normal patch).
+                        vd_t m1_cs_cur_patch_polygon_he_tgt = m0_cur_patch_cur_poly_cur_he_tgt;
+
+                        // flag whether to insert new edge into "m1_colored"
+                        // bool create_new_edge = false;
+
+                        hd_t m1_cur_patch_cur_poly_cur_he = hmesh_t::null_halfedge();
+
+                        // is the current halfedge the last one to be process in the current polygon?
+                        if (cur_is_last_to_be_transformed) {
 
-                        if (src_is_ivertex && tgt_is_ivertex) { // class 3 : // x-->x
+                            // we can infer the updated version of the target vertex from the halfedge
+                            // which is already updated. Update tgt will be the source of the first
+                            // updated halfedge of the current polygon.
+                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_poly[0]);
 
-                            //
-                            // we now want to check if the current halfedge is interior or exterior
-                            //
+                            if (src_is_ivertex && tgt_is_ivertex) { // class 3 : // x-->x
 
-                            // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.source(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
+                                //
+                                // we now want to check if the current halfedge is interior or exterior
+                                //
 
-                            // get the ps-halfedge in the intersection-registry entry of src
-                            // const hd_t src_coincident_ps_halfedge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he));
+                                // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.source(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
 
-                            // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.target(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
+                                // get the ps-halfedge in the intersection-registry entry of src
+                                // const hd_t src_coincident_ps_halfedge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he));
 
-                            // get the ps-halfedge in the intersection-registry entry of src
-                            // const hd_t tgt_ps_h = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he));
-                            // get the ps-edges corresponding to the ps-halfedges
-                            vd_t src_vertex = m0_cur_patch_cur_poly_cur_he_src; // m0.source(m0_cur_patch_cur_poly_cur_he); // TODO: no need to query m0 [again] (see above)
-                            MCUT_ASSERT((size_t)src_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(src_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                            const std::pair<ed_t, fd_t>& src_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)src_vertex - ps_vtx_cnt);
-                            const ed_t src_ps_edge = src_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he)); // ps.edge(src_coincident_ps_halfedge);
+                                // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.target(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
 
-                            vd_t tgt_vertex = m0_cur_patch_cur_poly_cur_he_tgt; // m0.target(m0_cur_patch_cur_poly_cur_he);
-                            MCUT_ASSERT((size_t)tgt_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(tgt_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                            const std::pair<ed_t, fd_t>& tgt_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)tgt_vertex - ps_vtx_cnt);
-                            const ed_t tgt_ps_edge = tgt_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he)); // ps.edge(tgt_ps_h);
+                                // get the ps-halfedge in the intersection-registry entry of src
+                                // const hd_t tgt_ps_h = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he));
+                                // get the ps-edges corresponding to the ps-halfedges
+                                vd_t src_vertex = m0_cur_patch_cur_poly_cur_he_src; // m0.source(m0_cur_patch_cur_poly_cur_he); // TODO: no need to query m0 [again] (see above)
+                                MCUT_ASSERT((size_t)src_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(src_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
+                                const std::pair<ed_t, fd_t>& src_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)src_vertex - ps_vtx_cnt);
+                                const ed_t src_ps_edge = src_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he)); // ps.edge(src_coincident_ps_halfedge);
 
-                            // is it an interior halfedge
-                            bool is_valid_ambiguious_interior_edge = (src_ps_edge != tgt_ps_edge);
+                                vd_t tgt_vertex = m0_cur_patch_cur_poly_cur_he_tgt; // m0.target(m0_cur_patch_cur_poly_cur_he);
+                                MCUT_ASSERT((size_t)tgt_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(tgt_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
+                                const std::pair<ed_t, fd_t>& tgt_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)tgt_vertex - ps_vtx_cnt);
+                                const ed_t tgt_ps_edge = tgt_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he)); // ps.edge(tgt_ps_h);
 
-                            if (is_valid_ambiguious_interior_edge) { // check is interior ihalfedge (due ambiguity with exterior-interior halfedges x-->x)
+                                // is it an interior halfedge
+                                bool is_valid_ambiguious_interior_edge = (src_ps_edge != tgt_ps_edge);
 
-                                MCUT_ASSERT(m0_to_m1_ihe.find(m0_cur_patch_cur_poly_cur_he_opp) != m0_to_m1_ihe.cend());
+                                if (is_valid_ambiguious_interior_edge) { // check is interior ihalfedge (due ambiguity with exterior-interior halfedges x-->x)
 
-                                const hd_t m1_cur_patch_cur_poly_cur_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cur_patch_cur_poly_cur_he_opp);
-                                const hd_t m1_cur_patch_cur_poly_cur_he_opp_opp = m1_colored.opposite(m1_cur_patch_cur_poly_cur_he_opp);
+                                    MCUT_ASSERT(m0_to_m1_ihe.find(m0_cur_patch_cur_poly_cur_he_opp) != m0_to_m1_ihe.cend());
 
-                                // halfedge already exists. it was created during source-mesh partitioning stage earlier
-                                m1_cur_patch_cur_poly_cur_he = m1_cur_patch_cur_poly_cur_he_opp_opp;
+                                    const hd_t m1_cur_patch_cur_poly_cur_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cur_patch_cur_poly_cur_he_opp);
+                                    const hd_t m1_cur_patch_cur_poly_cur_he_opp_opp = m1_colored.opposite(m1_cur_patch_cur_poly_cur_he_opp);
+
+                                    // halfedge already exists. it was created during source-mesh partitioning stage earlier
+                                    m1_cur_patch_cur_poly_cur_he = m1_cur_patch_cur_poly_cur_he_opp_opp;
 
-                                MCUT_ASSERT(m1_colored.target(m1_cur_patch_cur_poly_cur_he) == m1_cs_cur_patch_polygon_he_tgt);
+                                    MCUT_ASSERT(m1_colored.target(m1_cur_patch_cur_poly_cur_he) == m1_cs_cur_patch_polygon_he_tgt);
+                                }
                             }
-                        }
-                    } // if (cur_is_last_to_be_transformed) {
-                    else if (!src_is_ivertex && tgt_is_ivertex) { // class 1 : o-->x : this type of halfedge can only be "coming in" i.e. pointing torward source mesh
-                        // o-->x
-
-                        /*
-                        Steps:
-
-                        transformed_src = transformed_prev_tgt // always available since cut-mesh polygon updating always starts from a halfedge whose opposite is already updated
-                        transformed_tgt = untransformed_tgt // assume descriptor will not be updated
-                        create_new_edge = FALSE // to insert a new edge into halfedge data structure or not
-
-                        IF "opp" has been transformed // note: if opp is transformed, then polygon coincident to that opp halfedge has been fully updated too since all halfedges of a cut-mesh polygon are transformed before moving onto others.
-                            transformed_tgt = source of transformed "opp"
-                        ELSE
-                            transformed_tgt = source of transformed "next" // note: "next" will always be an interior intersection-halfedge since o-->x ihalfedges are always "incoming" i.e. torward the src-mesh
-                            create_new_edge = TRUE // because opposite does not exist (in "m1")
-
-                        IF create_new_edge
-                            create new edge and use halfedge defined by transformed_src and transformed_tgt
-                        ELSE
-                            use halfedge defined by computed transformed_src and transformed_tgt
-                    */
-
-                        // check if opposite halfedge of current is updated. (NOTE: searching only through
-                        // the polygons of the current patch)
-
-                        // the updated opposite halfedge in the current patch
-                        hd_t m1_cs_cur_patch_polygon_he_opp = hmesh_t::null_halfedge();
-                        // query instances of the "m1" version of the opposite halfedge
-                        std::unordered_map<hd_t /*m0*/, std::map<int /*patch idx*/, hd_t /*m1*/>>::const_iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he_opp);
-
-                        // do we have at least one updated copy of the opposite, irrespective of which patch it
-                        // belongs to.
-                        if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) {
-                            // now check if there is an updated instance corresponding to the current patch
-                            std::map<int /*initial patch polygon*/, hd_t /*m1*/>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
-                            if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
-                                // we have found the already-updated instance of the opposite halfedge
-                                m1_cs_cur_patch_polygon_he_opp = m1_he_instances_find_iter->second;
+                        } // if (cur_is_last_to_be_transformed) {
+                        else if (!src_is_ivertex && tgt_is_ivertex) { // class 1 : o-->x : this type of halfedge can only be "coming in" i.e. pointing torward source mesh
+                            // o-->x
+
+                            /*
+                            Steps:
+
+                            transformed_src = transformed_prev_tgt // always available since cut-mesh polygon updating always starts from a halfedge whose opposite is already updated
+                            transformed_tgt = untransformed_tgt // assume descriptor will not be updated
+                            create_new_edge = FALSE // to insert a new edge into halfedge data structure or not
+
+                            IF "opp" has been transformed // note: if opp is transformed, then polygon coincident to that opp halfedge has been fully updated too since all halfedges of a cut-mesh polygon are transformed before moving onto others.
+                                transformed_tgt = source of transformed "opp"
+                            ELSE
+                                transformed_tgt = source of transformed "next" // note: "next" will always be an interior intersection-halfedge since o-->x ihalfedges are always "incoming" i.e. torward the src-mesh
+                                create_new_edge = TRUE // because opposite does not exist (in "m1")
+
+                            IF create_new_edge
+                                create new edge and use halfedge defined by transformed_src and transformed_tgt
+                            ELSE
+                                use halfedge defined by computed transformed_src and transformed_tgt
+                        */
+
+                            // check if opposite halfedge of current is updated. (NOTE: searching only through
+                            // the polygons of the current patch)
+
+                            // the updated opposite halfedge in the current patch
+                            hd_t m1_cs_cur_patch_polygon_he_opp = hmesh_t::null_halfedge();
+                            // query instances of the "m1" version of the opposite halfedge
+                            std::unordered_map<hd_t /*m0*/, std::map<int /*patch idx*/, hd_t /*m1*/>>::const_iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he_opp);
+
+                            // do we have at least one updated copy of the opposite, irrespective of which patch it
+                            // belongs to.
+                            if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) {
+                                // now check if there is an updated instance corresponding to the current patch
+                                std::map<int /*initial patch polygon*/, hd_t /*m1*/>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
+                                if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
+                                    // we have found the already-updated instance of the opposite halfedge
+                                    m1_cs_cur_patch_polygon_he_opp = m1_he_instances_find_iter->second;
+                                }
                             }
-                        }
 
-                        // check if opposite halfedge is transformed
-                        const bool opp_is_transformed = m1_cs_cur_patch_polygon_he_opp != hmesh_t::null_halfedge();
+                            // check if opposite halfedge is transformed
+                            const bool opp_is_transformed = m1_cs_cur_patch_polygon_he_opp != hmesh_t::null_halfedge();
 
-                        if (opp_is_transformed) {
-                            // infer tgt from opposite
-                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_cur_patch_polygon_he_opp);
-                        } else {
+                            if (opp_is_transformed) {
+                                // infer tgt from opposite
+                                m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_cur_patch_polygon_he_opp);
+                            } else {
 
-                            //
-                            // the opposite halfedge has not been transformed.
-                            // We will deduce the target from the updated "next" halfedge, and
-                            // we have to create a new edge
-                            //
+                                //
+                                // the opposite halfedge has not been transformed.
+                                // We will deduce the target from the updated "next" halfedge, and
+                                // we have to create a new edge
+                                //
 
-                            // look up the updated "next" by looking forward and finding the coincident source-mesh polygon
-                            // and then getting the updated instance of "next".
-                            const int m0_next_cs_polygon_he_index = wrap_integer(m0_cur_patch_cur_poly_cur_he_idx + 1, 0, (int)m0_cur_patch_cur_poly.size() - 1);
-
-                            MCUT_ASSERT(m0_next_cs_polygon_he_index < (int)m0_cur_patch_cur_poly.size());
-
-                            const hd_t m0_cs_next_patch_polygon_he = SAFE_ACCESS(m0_cur_patch_cur_poly, m0_next_cs_polygon_he_index); // next untransformed
-                            const vd_t m0_cs_next_patch_polygon_he_src = m0.source(m0_cs_next_patch_polygon_he);
-                            const vd_t m0_cs_next_patch_polygon_he_tgt = m0.target(m0_cs_next_patch_polygon_he);
-
-                            MCUT_ASSERT(m0_is_intersection_point(m0_cs_next_patch_polygon_he_src, ps_vtx_cnt) && m0_is_intersection_point(m0_cs_next_patch_polygon_he_tgt, ps_vtx_cnt)); // .. because the current halfedge is "incoming"
-
-                            // get the "m0" polygons which are traced with the "next" halfedge
-                            // const std::vector<int>& m0_poly_he_coincident_polys = SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he);
-                            // get reference to src-mesn polygon which is traced with "next" halfedge
-                            // const std::vector<int>::const_iterator find_iter = std::find_if(
-                            //    m0_poly_he_coincident_polys.cbegin(),
-                            //    m0_poly_he_coincident_polys.cend(),
-                            //    [&](const int& e) {
-                            //        return (e < traced_sm_polygon_count); // match with src-mesn polygon
-                            //    });
-
-                            // "next" is always incident to a source-mesh polygon
-                            MCUT_ASSERT(std::find_if(
-                                            SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).cbegin(),
-                                            SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).cend(),
-                                            [&](const int& e) {
-                                                return (e < traced_sm_polygon_count); // match with src-mesn polygon
-                                            })
-                                != SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).cend());
+                                // look up the updated "next" by looking forward and finding the coincident source-mesh polygon
+                                // and then getting the updated instance of "next".
+                                const int m0_next_cs_polygon_he_index = wrap_integer(m0_cur_patch_cur_poly_cur_he_idx + 1, 0, (int)m0_cur_patch_cur_poly.size() - 1);
 
-                            //
-                            // At this point, we have found the adjacent connected component which is
-                            // the one using m0_cs_next_patch_polygon_he. Therefore, we can directly
-                            // determine the connected component by looking up the updated instance
-                            // of m0_cs_next_patch_polygon_he_opp since m0_cs_next_patch_polygon_he_opp
-                            // is guarranteed to have been updated because it is an interior intersection
-                            // halfedge (i.e. its on the cut path).
-                            //
-                            // REMEMBER: exterior patches are stitched to the "upper" source-mesh fragment
-                            const hd_t m0_cs_next_patch_polygon_he_opp = m0.opposite(m0_cs_next_patch_polygon_he);
-                            const hd_t m1_cs_next_patch_polygon_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cs_next_patch_polygon_he_opp);
-                            const hd_t m1_cs_next_patch_polygon_he_opp_opp = m1_colored.opposite(m1_cs_next_patch_polygon_he_opp);
+                                MCUT_ASSERT(m0_next_cs_polygon_he_index < (int)m0_cur_patch_cur_poly.size());
 
-                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_next_patch_polygon_he_opp_opp);
+                                const hd_t m0_cs_next_patch_polygon_he = SAFE_ACCESS(m0_cur_patch_cur_poly, m0_next_cs_polygon_he_index); // next untransformed
 
-                            // create_new_edge = true; // because opposite has not yet been created
-                        }
-                    } else if (src_is_ivertex && tgt_is_ivertex) { // class 3 : // x-->x
+                                MCUT_ASSERT(m0_is_intersection_point(m0.source(m0_cs_next_patch_polygon_he), ps_vtx_cnt) && m0_is_intersection_point(m0.target(m0_cs_next_patch_polygon_he), ps_vtx_cnt)); // .. because the current halfedge is "incoming"
 
-                        // the current halfedge will either be interior or exterior.
+                                // get the "m0" polygons which are traced with the "next" halfedge
+                                // const std::vector<int>& m0_poly_he_coincident_polys = SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he);
+                                // get reference to src-mesn polygon which is traced with "next" halfedge
+                                // const std::vector<int>::const_iterator find_iter = std::find_if(
+                                //    m0_poly_he_coincident_polys.cbegin(),
+                                //    m0_poly_he_coincident_polys.cend(),
+                                //    [&](const int& e) {
+                                //        return (e < traced_sm_polygon_count); // match with src-mesn polygon
+                                //    });
 
-                        // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.source(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
+                                // "next" is always incident to a source-mesh polygon
+                                MCUT_ASSERT(std::find_if(
+                                                SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).cbegin(),
+                                                SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).cend(),
+                                                [&](const int& e) {
+                                                    return (e < traced_sm_polygon_count); // match with src-mesn polygon
+                                                })
+                                    != SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).cend());
 
-                        // const hd_t src_coincident_ps_halfedge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he));
+                                //
+                                // At this point, we have found the adjacent connected component which is
+                                // the one using m0_cs_next_patch_polygon_he. Therefore, we can directly
+                                // determine the connected component by looking up the updated instance
+                                // of m0_cs_next_patch_polygon_he_opp since m0_cs_next_patch_polygon_he_opp
+                                // is guarranteed to have been updated because it is an interior intersection
+                                // halfedge (i.e. its on the cut path).
+                                //
+                                // REMEMBER: exterior patches are stitched to the "upper" source-mesh fragment
+                                const hd_t m0_cs_next_patch_polygon_he_opp = m0.opposite(m0_cs_next_patch_polygon_he);
+                                const hd_t m1_cs_next_patch_polygon_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cs_next_patch_polygon_he_opp);
+                                const hd_t m1_cs_next_patch_polygon_he_opp_opp = m1_colored.opposite(m1_cs_next_patch_polygon_he_opp);
 
-                        // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.target(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
+                                m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_next_patch_polygon_he_opp_opp);
 
-                        // const hd_t tgt_ps_h = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he));
-                        const vd_t src_vertex = m0_cur_patch_cur_poly_cur_he_src; // m0.source(m0_cur_patch_cur_poly_cur_he); // TODO: no need to query m0 [again] (see above)
-                        MCUT_ASSERT((size_t)src_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(src_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                        const std::pair<ed_t, fd_t>& src_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)src_vertex - ps_vtx_cnt);
-                        const ed_t src_ps_edge = src_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he)); // ps.edge(src_coincident_ps_halfedge);
+                                // create_new_edge = true; // because opposite has not yet been created
+                            }
+                        } else if (src_is_ivertex && tgt_is_ivertex) { // class 3 : // x-->x
 
-                        const vd_t tgt_vertex = m0_cur_patch_cur_poly_cur_he_tgt; // m0.target(m0_cur_patch_cur_poly_cur_he);
-                        MCUT_ASSERT((size_t)tgt_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(tgt_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                        const std::pair<ed_t, fd_t>& tgt_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)tgt_vertex - ps_vtx_cnt);
-                        const ed_t tgt_ps_edge = tgt_vertex_ipair.first;
+                            // the current halfedge will either be interior or exterior.
 
-                        // const ed_t src_ps_edge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he)); //ps.edge(src_coincident_ps_halfedge);
-                        // const ed_t tgt_ps_edge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he)); // ps.edge(tgt_ps_h);
-                        bool is_valid_ambiguious_interior_edge = (src_ps_edge != tgt_ps_edge);
+                            // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.source(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
 
-                        // check if current halfedge is interior
-                        if (is_valid_ambiguious_interior_edge) {
+                            // const hd_t src_coincident_ps_halfedge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he));
 
-                            MCUT_ASSERT(m0_to_m1_ihe.find(m0_cur_patch_cur_poly_cur_he_opp) != m0_to_m1_ihe.cend());
-                            const hd_t m1_cur_patch_cur_poly_cur_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cur_patch_cur_poly_cur_he_opp);
-                            const hd_t m1_cur_patch_cur_poly_cur_he_opp_opp = m1_colored.opposite(m1_cur_patch_cur_poly_cur_he_opp);
+                            // MCUT_ASSERT(m0_ivtx_to_ps_edge.find(m0.target(m0_cur_patch_cur_poly_cur_he)) != m0_ivtx_to_ps_edge.cend());
 
-                            // halfedge already exists. it was created during src-mesh partitioning
-                            m1_cur_patch_cur_poly_cur_he = m1_cur_patch_cur_poly_cur_he_opp_opp;
-                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.target(m1_cur_patch_cur_poly_cur_he_opp_opp);
-                        } else { // its an exterior x-->x halfedge
+                            // const hd_t tgt_ps_h = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he));
+                            const vd_t src_vertex = m0_cur_patch_cur_poly_cur_he_src; // m0.source(m0_cur_patch_cur_poly_cur_he); // TODO: no need to query m0 [again] (see above)
+                            MCUT_ASSERT((size_t)src_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(src_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
+                            const std::pair<ed_t, fd_t>& src_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)src_vertex - ps_vtx_cnt);
+                            const ed_t src_ps_edge = src_vertex_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he)); // ps.edge(src_coincident_ps_halfedge);
 
-                            // look up the transformed "next" by looking finding the
-                            // coincident source-mesh polygon and then getting the transformed instance of "next".
-                            const int m0_next_cs_polygon_he_index = wrap_integer(m0_cur_patch_cur_poly_cur_he_idx + 1, 0, (int)m0_cur_patch_cur_poly.size() - 1);
+                            const vd_t tgt_vertex = m0_cur_patch_cur_poly_cur_he_tgt; // m0.target(m0_cur_patch_cur_poly_cur_he);
+                            MCUT_ASSERT((size_t)tgt_vertex - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(tgt_vertex) != m0_ivtx_to_intersection_registry_entry.cend()*/);
+                            const std::pair<ed_t, fd_t>& tgt_vertex_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)tgt_vertex - ps_vtx_cnt);
+                            const ed_t tgt_ps_edge = tgt_vertex_ipair.first;
 
-                            MCUT_ASSERT(m0_next_cs_polygon_he_index < (int)m0_cur_patch_cur_poly.size());
+                            // const ed_t src_ps_edge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.source(m0_cur_patch_cur_poly_cur_he)); //ps.edge(src_coincident_ps_halfedge);
+                            // const ed_t tgt_ps_edge = SAFE_ACCESS(m0_ivtx_to_ps_edge, m0.target(m0_cur_patch_cur_poly_cur_he)); // ps.edge(tgt_ps_h);
+                            bool is_valid_ambiguious_interior_edge = (src_ps_edge != tgt_ps_edge);
 
-                            const hd_t m0_cs_next_patch_polygon_he = m0_cur_patch_cur_poly[m0_next_cs_polygon_he_index]; // next untransformed
-                            const vd_t m0_cs_next_patch_polygon_he_src = m0.source(m0_cs_next_patch_polygon_he);
-                            const vd_t m0_cs_next_patch_polygon_he_tgt = m0.target(m0_cs_next_patch_polygon_he);
+                            // check if current halfedge is interior
+                            if (is_valid_ambiguious_interior_edge) {
 
-                            MCUT_ASSERT(m0_is_intersection_point(m0_cs_next_patch_polygon_he_src, ps_vtx_cnt) && m0_is_intersection_point(m0_cs_next_patch_polygon_he_tgt, ps_vtx_cnt));
-                            MCUT_ASSERT(SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).size() > 0 /*m0_h_to_ply.find(m0_cs_next_patch_polygon_he) != m0_h_to_ply.cend()*/);
+                                MCUT_ASSERT(m0_to_m1_ihe.find(m0_cur_patch_cur_poly_cur_he_opp) != m0_to_m1_ihe.cend());
+                                const hd_t m1_cur_patch_cur_poly_cur_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cur_patch_cur_poly_cur_he_opp);
+                                const hd_t m1_cur_patch_cur_poly_cur_he_opp_opp = m1_colored.opposite(m1_cur_patch_cur_poly_cur_he_opp);
 
-#ifndef NDEBUG
-                            const std::vector<int>& m0_poly_he_coincident_polys = m0_h_to_ply[m0_cs_next_patch_polygon_he];
-                            const std::vector<int>::const_iterator find_iter = std::find_if( // points to src-mesh polygon
-                                m0_poly_he_coincident_polys.cbegin(),
-                                m0_poly_he_coincident_polys.cend(),
-                                [&](const int& e) {
-                                    return (e < traced_sm_polygon_count); // match with source-mesh polygon
-                                });
-
-                            // "next" is always incident to an source-mesh polygon
-                            MCUT_ASSERT(find_iter != m0_poly_he_coincident_polys.cend());
-#endif
-                            const hd_t m0_cs_next_patch_polygon_he_opp = m0.opposite(m0_cs_next_patch_polygon_he);
+                                // halfedge already exists. it was created during src-mesh partitioning
+                                m1_cur_patch_cur_poly_cur_he = m1_cur_patch_cur_poly_cur_he_opp_opp;
+                                m1_cs_cur_patch_polygon_he_tgt = m1_colored.target(m1_cur_patch_cur_poly_cur_he_opp_opp);
+                            } else { // its an exterior x-->x halfedge
 
-                            // Note: this is always true, even in the case of scoop cuts. This is because
-                            // halfedges along the cut-path are updated before stitching (during source-mesh partitioning)
-                            // so we can infer the tgt easily
-                            MCUT_ASSERT(SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he_opp).size() > 0 /*m0_h_to_ply.find(m0_cs_next_patch_polygon_he_opp) != m0_h_to_ply.cend()*/);
+                                // look up the transformed "next" by looking finding the
+                                // coincident source-mesh polygon and then getting the transformed instance of "next".
+                                const int m0_next_cs_polygon_he_index = wrap_integer(m0_cur_patch_cur_poly_cur_he_idx + 1, 0, (int)m0_cur_patch_cur_poly.size() - 1);
 
-                            const hd_t m1_cs_next_patch_polygon_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cs_next_patch_polygon_he_opp);
-                            const hd_t m1_cs_next_patch_polygon_he_opp_opp = m1_colored.opposite(m1_cs_next_patch_polygon_he_opp);
+                                MCUT_ASSERT(m0_next_cs_polygon_he_index < (int)m0_cur_patch_cur_poly.size());
 
-                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_next_patch_polygon_he_opp_opp);
-                        }
-                    } else { // class 0 or 2 i.e. o-->o or x-->o
-
-                        /*
-                        In the following steps, our ability to deduce the correct target vertex instance
-                        by simply checking whether "opp" or "next" is updated before
-                        duplication is guarranteed to work. This is because we update polygons
-                        of a patch using BFS (following adjacency) which guarrantees that when
-                        the condition to create a duplicate vertex is reached, there will have
-                        been no other halfedge referencing the same vertex that had reached the
-                        same condition.
-
-                        transformed_src = transformed_prev_tgt // always available because cut-mesh polygon update always starts from a halfedge whose opposite is already updated
-                        transformed_tgt = untransformed_tgt
-                        create_new_edge = FALSE
-
-                        IF opposite patch is transformed
-                            1. IF opposite halfedge is transformed
-                            2.      infer from opposite halfedge
-                            3. ELSE IF next halfedge is transformed
-                            4.      infer from next
-                            2. ELSE
-                                IF an updated halfedge pointing to tgt already exists (i.e. using "halfedges around vertex")
-                                    infer from that halfedge
-                                ELSE
-                                    create duplicate of untransformed_tgt
-                                    transformed_tgt = duplicate of untransformed_tgt
-                                    create_new_edge = TRUE // because "opposite" AND "next" halfedge are not updated, so we have create a new connection between vertices
-                        ELSE
-                                // Do nothing (keep transformed_tgt as it is) because there
-                                // is no adjacent halfedge which is updated, and the current
-                                // patch gets precedence to use the first/original vertex instances
-                    */
-                        if (cur_is_last_to_be_transformed) {
-                            // initial polygon halfedge which was transformed
-                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_poly.front());
-                        } else {
+                                const hd_t m0_cs_next_patch_polygon_he = m0_cur_patch_cur_poly[m0_next_cs_polygon_he_index]; // next untransformed
 
-                            // check opposite patch of current is transformed
-                            const bool opposite_patch_is_transformed = !is_ccw_patch; // ... since ccw patches are always transformed before their cw counterparts
+                                MCUT_ASSERT(m0_is_intersection_point(m0.source(m0_cs_next_patch_polygon_he), ps_vtx_cnt) && m0_is_intersection_point(m0.target(m0_cs_next_patch_polygon_he), ps_vtx_cnt));
+                                MCUT_ASSERT(SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he).size() > 0 /*m0_h_to_ply.find(m0_cs_next_patch_polygon_he) != m0_h_to_ply.cend()*/);
 
-                            if (opposite_patch_is_transformed) // if true, the current patch is the cw one
-                            {
-                                // check if opposite halfedge of current is transformed. (NOTE: searching
-                                // only through the polygons of the current patch)
+    #ifndef NDEBUG
+                                const std::vector<int>& m0_poly_he_coincident_polys = m0_h_to_ply[m0_cs_next_patch_polygon_he];
+                                const std::vector<int>::const_iterator find_iter = std::find_if( // points to src-mesh polygon
+                                    m0_poly_he_coincident_polys.cbegin(),
+                                    m0_poly_he_coincident_polys.cend(),
+                                    [&](const int& e) {
+                                        return (e < traced_sm_polygon_count); // match with source-mesh polygon
+                                    });
 
-                                hd_t m1_cs_cur_patch_polygon_he_opp = hmesh_t::null_halfedge(); // transformed instance of opposite
-                                std::unordered_map<hd_t /*m0*/, std::map<int /*patch idx*/, hd_t /*m1*/>>::const_iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he_opp);
+                                // "next" is always incident to an source-mesh polygon
+                                MCUT_ASSERT(find_iter != m0_poly_he_coincident_polys.cend());
+    #endif
+                                const hd_t m0_cs_next_patch_polygon_he_opp = m0.opposite(m0_cs_next_patch_polygon_he);
 
-                                if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) { // must transformed at least once since opposite patch is transformed
+                                // Note: this is always true, even in the case of scoop cuts. This is because
+                                // halfedges along the cut-path are updated before stitching (during source-mesh partitioning)
+                                // so we can infer the tgt easily
+                                MCUT_ASSERT(SAFE_ACCESS(m0_h_to_ply, m0_cs_next_patch_polygon_he_opp).size() > 0 /*m0_h_to_ply.find(m0_cs_next_patch_polygon_he_opp) != m0_h_to_ply.cend()*/);
 
-                                    std::map<int /*initial patch polygon*/, hd_t /*m1*/>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
+                                const hd_t m1_cs_next_patch_polygon_he_opp = SAFE_ACCESS(m0_to_m1_ihe, m0_cs_next_patch_polygon_he_opp);
+                                const hd_t m1_cs_next_patch_polygon_he_opp_opp = m1_colored.opposite(m1_cs_next_patch_polygon_he_opp);
 
-                                    if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
-                                        m1_cs_cur_patch_polygon_he_opp = m1_he_instances_find_iter->second;
-                                    }
-                                }
+                                m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_next_patch_polygon_he_opp_opp);
+                            }
+                        } else { // class 0 or 2 i.e. o-->o or x-->o
+
+                            /*
+                            In the following steps, our ability to deduce the correct target vertex instance
+                            by simply checking whether "opp" or "next" is updated before
+                            duplication is guarranteed to work. This is because we update polygons
+                            of a patch using BFS (following adjacency) which guarrantees that when
+                            the condition to create a duplicate vertex is reached, there will have
+                            been no other halfedge referencing the same vertex that had reached the
+                            same condition.
+
+                            transformed_src = transformed_prev_tgt // always available because cut-mesh polygon update always starts from a halfedge whose opposite is already updated
+                            transformed_tgt = untransformed_tgt
+                            create_new_edge = FALSE
+
+                            IF opposite patch is transformed
+                                1. IF opposite halfedge is transformed
+                                2.      infer from opposite halfedge
+                                3. ELSE IF next halfedge is transformed
+                                4.      infer from next
+                                2. ELSE
+                                    IF an updated halfedge pointing to tgt already exists (i.e. using "halfedges around vertex")
+                                        infer from that halfedge
+                                    ELSE
+                                        create duplicate of untransformed_tgt
+                                        transformed_tgt = duplicate of untransformed_tgt
+                                        create_new_edge = TRUE // because "opposite" AND "next" halfedge are not updated, so we have create a new connection between vertices
+                            ELSE
+                                    // Do nothing (keep transformed_tgt as it is) because there
+                                    // is no adjacent halfedge which is updated, and the current
+                                    // patch gets precedence to use the first/original vertex instances
+                        */
+                            if (cur_is_last_to_be_transformed) {
+                                // initial polygon halfedge which was transformed
+                                m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_poly.front());
+                            } else {
 
-                                const bool opp_is_transformed = m1_cs_cur_patch_polygon_he_opp != hmesh_t::null_halfedge();
+                                // check opposite patch of current is transformed
+                                const bool opposite_patch_is_transformed = !is_ccw_patch; // ... since ccw patches are always transformed before their cw counterparts
 
-                                if (opp_is_transformed) {
-                                    m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_cur_patch_polygon_he_opp);
-                                } else {
+                                if (opposite_patch_is_transformed) // if true, the current patch is the cw one
+                                {
+                                    // check if opposite halfedge of current is transformed. (NOTE: searching
+                                    // only through the polygons of the current patch)
 
-                                    // check if next halfedge of current is transformed.
-                                    const int m0_next_cs_polygon_he_index = wrap_integer(m0_cur_patch_cur_poly_cur_he_idx + 1, 0, (int)m0_cur_patch_cur_poly.size() - 1);
-                                    const hd_t m0_cs_next_patch_polygon_he = m0_cur_patch_cur_poly[m0_next_cs_polygon_he_index]; // next untransformed
-                                    m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cs_next_patch_polygon_he);
-                                    hd_t m1_cs_next_patch_polygon_he = hmesh_t::null_halfedge();
+                                    hd_t m1_cs_cur_patch_polygon_he_opp = hmesh_t::null_halfedge(); // transformed instance of opposite
+                                    std::unordered_map<hd_t /*m0*/, std::map<int /*patch idx*/, hd_t /*m1*/>>::const_iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he_opp);
 
                                     if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) { // must transformed at least once since opposite patch is transformed
 
-                                        std::map<int, hd_t>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
+                                        std::map<int /*initial patch polygon*/, hd_t /*m1*/>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
 
                                         if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
-                                            m1_cs_next_patch_polygon_he = m1_he_instances_find_iter->second;
+                                            m1_cs_cur_patch_polygon_he_opp = m1_he_instances_find_iter->second;
                                         }
                                     }
 
-                                    const bool next_is_transformed = m1_cs_next_patch_polygon_he != hmesh_t::null_halfedge();
+                                    const bool opp_is_transformed = m1_cs_cur_patch_polygon_he_opp != hmesh_t::null_halfedge();
 
-                                    if (next_is_transformed) {
-                                        m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_next_patch_polygon_he);
+                                    if (opp_is_transformed) {
+                                        m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_cur_patch_polygon_he_opp);
                                     } else {
 
-                                        //
-                                        // find all transformed halfedges which connect to m0_cur_patch_cur_poly_cur_he_tgt in the current patch
-                                        //
+                                        // check if next halfedge of current is transformed.
+                                        const int m0_next_cs_polygon_he_index = wrap_integer(m0_cur_patch_cur_poly_cur_he_idx + 1, 0, (int)m0_cur_patch_cur_poly.size() - 1);
+                                        const hd_t m0_cs_next_patch_polygon_he = m0_cur_patch_cur_poly[m0_next_cs_polygon_he_index]; // next untransformed
+                                        m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cs_next_patch_polygon_he);
+                                        hd_t m1_cs_next_patch_polygon_he = hmesh_t::null_halfedge();
 
-                                        bool found_transformed_neigh_he = false; // any updated halfedge whose m0 instance references m0_cur_patch_cur_poly_cur_he_tgt
+                                        if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) { // must transformed at least once since opposite patch is transformed
 
-                                        /*
-                                      1. get "m0" halfedges around vertex
-                                      2. for each halfedge around vertex, check if it has a transformed instance that belonging to the current patch
-                                    */
-                                        const std::vector<halfedge_descriptor_t>& m0_incoming_halfedges = m0.get_halfedges_around_vertex(m0_cur_patch_cur_poly_cur_he_tgt);
+                                            std::map<int, hd_t>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
 
-                                        for (std::vector<halfedge_descriptor_t>::const_iterator m0_incoming_halfedges_iter = m0_incoming_halfedges.cbegin();
-                                             m0_incoming_halfedges_iter != m0_incoming_halfedges.cend();
-                                             ++m0_incoming_halfedges_iter) {
+                                            if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
+                                                m1_cs_next_patch_polygon_he = m1_he_instances_find_iter->second;
+                                            }
+                                        }
 
-                                            const halfedge_descriptor_t m0_incoming_halfedge = *m0_incoming_halfedges_iter;
-                                            MCUT_ASSERT(m0_incoming_halfedge != hmesh_t::null_halfedge());
+                                        const bool next_is_transformed = m1_cs_next_patch_polygon_he != hmesh_t::null_halfedge();
 
-                                            // is it transformed?
-                                            m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_incoming_halfedge);
-                                            hd_t m1_incoming_halfedge = hmesh_t::null_halfedge();
+                                        if (next_is_transformed) {
+                                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_cs_next_patch_polygon_he);
+                                        } else {
 
-                                            if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) {
+                                            //
+                                            // find all transformed halfedges which connect to m0_cur_patch_cur_poly_cur_he_tgt in the current patch
+                                            //
 
-                                                // get the transformed instance belonging to the current patch
-                                                std::map<int, hd_t>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
+                                            bool found_transformed_neigh_he = false; // any updated halfedge whose m0 instance references m0_cur_patch_cur_poly_cur_he_tgt
 
-                                                if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
-                                                    m1_incoming_halfedge = m1_he_instances_find_iter->second;
+                                            /*
+                                          1. get "m0" halfedges around vertex
+                                          2. for each halfedge around vertex, check if it has a transformed instance that belonging to the current patch
+                                        */
+                                            const std::vector<halfedge_descriptor_t>& m0_incoming_halfedges = m0.get_halfedges_around_vertex(m0_cur_patch_cur_poly_cur_he_tgt);
 
-                                                    m1_cs_cur_patch_polygon_he_tgt = m1_colored.target(m1_incoming_halfedge);
-                                                    found_transformed_neigh_he = true;
-                                                }
-                                            }
-
-                                            if (!found_transformed_neigh_he) {
-                                                // We enter this scope if: "m1_incoming_halfedge" does not exist
+                                            for (std::vector<halfedge_descriptor_t>::const_iterator m0_incoming_halfedges_iter = m0_incoming_halfedges.cbegin();
+                                                 m0_incoming_halfedges_iter != m0_incoming_halfedges.cend();
+                                                 ++m0_incoming_halfedges_iter) {
 
-                                                // What we are going to try to do now is check if the opposite of "m0_incoming_halfedge" has been transformed (w.r.t the current patch),
-                                                // and if so, we get it transformed instanced from which we deduce the correct value of "m1_cs_cur_patch_polygon_he_tgt"
+                                                const halfedge_descriptor_t m0_incoming_halfedge = *m0_incoming_halfedges_iter;
+                                                MCUT_ASSERT(m0_incoming_halfedge != hmesh_t::null_halfedge());
 
-                                                const halfedge_descriptor_t m0_incoming_halfedge_opp = m0.opposite(m0_incoming_halfedge);
+                                                // is it transformed?
                                                 m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_incoming_halfedge);
-                                                hd_t m1_incoming_halfedge_opp = hmesh_t::null_halfedge();
+                                                hd_t m1_incoming_halfedge = hmesh_t::null_halfedge();
 
                                                 if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) {
 
+                                                    // get the transformed instance belonging to the current patch
                                                     std::map<int, hd_t>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
 
                                                     if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
-                                                        m1_incoming_halfedge_opp = m1_he_instances_find_iter->second;
-                                                        m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_incoming_halfedge_opp); // Note: using "m1.source" not "m1.target"
+                                                        m1_incoming_halfedge = m1_he_instances_find_iter->second;
+
+                                                        m1_cs_cur_patch_polygon_he_tgt = m1_colored.target(m1_incoming_halfedge);
                                                         found_transformed_neigh_he = true;
                                                     }
                                                 }
-                                            }
 
-                                            if (found_transformed_neigh_he) {
-                                                break; // done
-                                            }
-                                        }
+                                                if (!found_transformed_neigh_he) {
+                                                    // We enter this scope if: "m1_incoming_halfedge" does not exist
 
-                                        if (!found_transformed_neigh_he) {
-                                            //
-                                            // none of the adjacent halfedges have been transformed, so we must duplicate m0_cur_patch_cur_poly_cur_he_tgt
-                                            //
+                                                    // What we are going to try to do now is check if the opposite of "m0_incoming_halfedge" has been transformed (w.r.t the current patch),
+                                                    // and if so, we get it transformed instanced from which we deduce the correct value of "m1_cs_cur_patch_polygon_he_tgt"
 
-                                            // is "m1_cs_cur_patch_polygon_he_tgt" a vertex we can duplicate? (partial cut, interior sealing)
-                                            // TODO: std::sort(sm_interior_cs_border_vertices) and then we can use binary search
-                                            const bool is_sm_interior_cs_boundary_vertex = std::find(sm_interior_cs_border_vertices.cbegin(), sm_interior_cs_border_vertices.cend(), m0_cur_patch_cur_poly_cur_he_tgt) != sm_interior_cs_border_vertices.cend();
+                                                    m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_incoming_halfedge);
+                                                    hd_t m1_incoming_halfedge_opp = hmesh_t::null_halfedge();
 
-                                            if (!is_sm_interior_cs_boundary_vertex) {
+                                                    if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) {
 
-                                                const vd_t m0_poly_he_tgt_dupl = m1_colored.add_vertex(m0.vertex(m0_cur_patch_cur_poly_cur_he_tgt));
+                                                        std::map<int, hd_t>::const_iterator m1_he_instances_find_iter = m0_to_m1_he_instances_find_iter->second.find(cur_patch_idx);
 
-                                                MCUT_ASSERT(m0_poly_he_tgt_dupl != hmesh_t::null_halfedge());
+                                                        if (m1_he_instances_find_iter != m0_to_m1_he_instances_find_iter->second.cend()) {
+                                                            m1_incoming_halfedge_opp = m1_he_instances_find_iter->second;
+                                                            m1_cs_cur_patch_polygon_he_tgt = m1_colored.source(m1_incoming_halfedge_opp); // Note: using "m1.source" not "m1.target"
+                                                            found_transformed_neigh_he = true;
+                                                        }
+                                                    }
+                                                }
 
-                                                m1_cs_cur_patch_polygon_he_tgt = m0_poly_he_tgt_dupl;
-                                                // create_new_edge = true;
+                                                if (found_transformed_neigh_he) {
+                                                    break; // done
+                                                }
                                             }
-                                        }
-                                    } // if (next_is_transformed) {
-                                } // if (opp_is_transformed) {
-                            } // if (opposite_patch_is_transformed)
-                        } // if (cur_is_last_to_be_transformed) {
-                    } // class 0 or 2 i.e. o-->o or x-->o
 
-                    // if we could not infer from any pre-existing halfedge
-                    if (m1_cur_patch_cur_poly_cur_he == hmesh_t::null_halfedge()) {
-                        // check if edge exists
-                        // TODO: use mesh built "halfedge(...)" (may require minor update to function)
-                        // ed_t e = get_computed_edge(/*m1_colored, */ m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt);
-                        // hd_t h = m1_colored.halfedge(m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt);
-                        ed_t e = m1_colored.edge(m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt, true);
+                                            if (!found_transformed_neigh_he) {
+                                                //
+                                                // none of the adjacent halfedges have been transformed, so we must duplicate m0_cur_patch_cur_poly_cur_he_tgt
+                                                //
+
+                                                // is "m1_cs_cur_patch_polygon_he_tgt" a vertex we can duplicate? (partial cut, interior sealing)
+                                                // TODO: std::sort(sm_interior_cs_border_vertices) and then we can use binary search
+                                                const bool is_sm_interior_cs_boundary_vertex = std::find(sm_interior_cs_border_vertices.cbegin(), sm_interior_cs_border_vertices.cend(), m0_cur_patch_cur_poly_cur_he_tgt) != sm_interior_cs_border_vertices.cend();
 
-                        if (e != hmesh_t::null_edge()) { // if edge already exists
+                                                if (!is_sm_interior_cs_boundary_vertex) {
 
-                            hd_t h0 = m1_colored.halfedge(e, 0);
+                                                    const vd_t m0_poly_he_tgt_dupl = m1_colored.add_vertex(m0.vertex(m0_cur_patch_cur_poly_cur_he_tgt));
 
-                            if (m1_colored.source(h0) == m1_cs_cur_patch_polygon_he_src) {
-                                m1_cur_patch_cur_poly_cur_he = h0;
+                                                    MCUT_ASSERT(m0_poly_he_tgt_dupl != hmesh_t::null_halfedge());
+
+                                                    m1_cs_cur_patch_polygon_he_tgt = m0_poly_he_tgt_dupl;
+                                                    // create_new_edge = true;
+                                                }
+                                            }
+                                        } // if (next_is_transformed) {
+                                    } // if (opp_is_transformed) {
+                                } // if (opposite_patch_is_transformed)
+                            } // if (cur_is_last_to_be_transformed) {
+                        } // class 0 or 2 i.e. o-->o or x-->o
+
+                        // if we could not infer from any pre-existing halfedge
+                        if (m1_cur_patch_cur_poly_cur_he == hmesh_t::null_halfedge()) {
+                            // check if edge exists
+                            // TODO: use mesh built "halfedge(...)" (may require minor update to function)
+                            // ed_t e = get_computed_edge(/*m1_colored, */ m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt);
+                            // hd_t h = m1_colored.halfedge(m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt);
+                            ed_t e = m1_colored.edge(m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt, true);
+
+                            if (e != hmesh_t::null_edge()) { // if edge already exists
+
+                                hd_t h0 = m1_colored.halfedge(e, 0);
+
+                                if (m1_colored.source(h0) == m1_cs_cur_patch_polygon_he_src) {
+                                    m1_cur_patch_cur_poly_cur_he = h0;
+                                } else {
+                                    hd_t h1 = m1_colored.halfedge(e, 1);
+                                    m1_cur_patch_cur_poly_cur_he = h1;
+                                }
                             } else {
-                                hd_t h1 = m1_colored.halfedge(e, 1);
-                                m1_cur_patch_cur_poly_cur_he = h1;
-                            }
-                        } else {
 
-                            m1_cur_patch_cur_poly_cur_he = m1_colored.add_edge(m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt);
-                            // TODO:replace with map (for O(Log N) searches)
-                            // m1_computed_edges.push_back(m1_colored.edge(m1_cur_patch_cur_poly_cur_he));
-                            // std::map<vd_t, std::vector<std::pair<vd_t, ed_t>>>
+                                m1_cur_patch_cur_poly_cur_he = m1_colored.add_edge(m1_cs_cur_patch_polygon_he_src, m1_cs_cur_patch_polygon_he_tgt);
+                                // TODO:replace with map (for O(Log N) searches)
+                                // m1_computed_edges.push_back(m1_colored.edge(m1_cur_patch_cur_poly_cur_he));
+                                // std::map<vd_t, std::vector<std::pair<vd_t, ed_t>>>
 
-                            // ed_t new_edge = m1_colored.edge(m1_cur_patch_cur_poly_cur_he);
-                            // m1_computed_edges[m1_cs_cur_patch_polygon_he_src].push_back(std::make_pair(m1_cs_cur_patch_polygon_he_tgt, new_edge));
-                            // m1_computed_edges[m1_cs_cur_patch_polygon_he_tgt].push_back(std::make_pair(m1_cs_cur_patch_polygon_he_src, new_edge));
-                        }
-                    } // if (m1_cur_patch_cur_poly_cur_he == hmesh_t::null_halfedge()) {
+                                // ed_t new_edge = m1_colored.edge(m1_cur_patch_cur_poly_cur_he);
+                                // m1_computed_edges[m1_cs_cur_patch_polygon_he_src].push_back(std::make_pair(m1_cs_cur_patch_polygon_he_tgt, new_edge));
+                                // m1_computed_edges[m1_cs_cur_patch_polygon_he_tgt].push_back(std::make_pair(m1_cs_cur_patch_polygon_he_src, new_edge));
+                            }
+                        } // if (m1_cur_patch_cur_poly_cur_he == hmesh_t::null_halfedge()) {
 
-                    //  << m1_colored.source(m1_cur_patch_cur_poly_cur_he) << " " << m1_colored.target(m1_cur_patch_cur_poly_cur_he) << ">" << std::endl;);
+                        //  << m1_colored.source(m1_cur_patch_cur_poly_cur_he) << " " << m1_colored.target(m1_cur_patch_cur_poly_cur_he) << ">" << std::endl;);
 
-                    // halfedge must have been found (created or inferred)
-                    MCUT_ASSERT(m1_cur_patch_cur_poly_cur_he != hmesh_t::null_halfedge());
-                    MCUT_ASSERT(m1_colored.target(m1_poly.back()) == m1_colored.source(m1_cur_patch_cur_poly_cur_he));
+                        // halfedge must have been found (created or inferred)
+                        MCUT_ASSERT(m1_cur_patch_cur_poly_cur_he != hmesh_t::null_halfedge());
+                        MCUT_ASSERT(m1_colored.target(m1_poly.back()) == m1_colored.source(m1_cur_patch_cur_poly_cur_he));
 
-                    // add transformed halfedge to currently transformed polygon
-                    m1_poly.push_back(m1_cur_patch_cur_poly_cur_he);
+                        // add transformed halfedge to currently transformed polygon
+                        m1_poly.push_back(m1_cur_patch_cur_poly_cur_he);
 
-                    //
-                    // map halfedge to transformed instance of current patch
-                    //
+                        //
+                        // map halfedge to transformed instance of current patch
+                        //
 
-                    // NOTE: m0_cur_patch_cur_poly_cur_he will not exist if current patch has CCW orientation
-                    // since such a patch will always be transformed first before its CW counterpart.
-                    std::unordered_map<hd_t, std::map<int, hd_t>>::iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he);
+                        // NOTE: m0_cur_patch_cur_poly_cur_he will not exist if current patch has CCW orientation
+                        // since such a patch will always be transformed first before its CW counterpart.
+                        std::unordered_map<hd_t, std::map<int, hd_t>>::iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he);
 
-                    if (m0_to_m1_he_instances_find_iter == m0_to_m1_he_instances.end()) { // not yet transformed at all (i.e. m0_cur_patch_cur_poly_cur_he belongs to CCW polygon )
+                        if (m0_to_m1_he_instances_find_iter == m0_to_m1_he_instances.end()) { // not yet transformed at all (i.e. m0_cur_patch_cur_poly_cur_he belongs to CCW polygon )
 
-                        std::pair<std::unordered_map<hd_t /*m0*/, std::map<int /*initial patch polygon*/, hd_t /*m1*/>>::iterator, bool> pair = m0_to_m1_he_instances.insert(std::make_pair(m0_cur_patch_cur_poly_cur_he, std::map<int, hd_t>()));
+                            std::pair<std::unordered_map<hd_t /*m0*/, std::map<int /*initial patch polygon*/, hd_t /*m1*/>>::iterator, bool> pair = m0_to_m1_he_instances.insert(std::make_pair(m0_cur_patch_cur_poly_cur_he, std::map<int, hd_t>()));
 
-                        MCUT_ASSERT(pair.second == true);
+                            MCUT_ASSERT(pair.second == true);
 
-                        m0_to_m1_he_instances_find_iter = pair.first;
-                    }
+                            m0_to_m1_he_instances_find_iter = pair.first;
+                        }
 
-                    // stores the an "m1" instance of the current halfedge, for each patch
-                    std::map<int, hd_t /*m1*/>& patch_to_m1_he = m0_to_m1_he_instances_find_iter->second;
-                    // const std::map<int, hd_t /*m1*/>::const_iterator patch_idx_to_m1_he = patch_to_m1_he.find(cur_patch_idx);
+                        // stores the an "m1" instance of the current halfedge, for each patch
+                        std::map<int, hd_t /*m1*/>& patch_to_m1_he = m0_to_m1_he_instances_find_iter->second;
+                        // const std::map<int, hd_t /*m1*/>::const_iterator patch_idx_to_m1_he = patch_to_m1_he.find(cur_patch_idx);
 
-                    // In general, a halfedge may only be transformed once for each patch it is be associated
-                    // with (i.e it will have two copies with one for each opposing patch). Note however that
-                    // in the case that the current halfedge is a border halfedge (partial cut), its transformed
-                    // copy is the same as its untransformed copy for each patch
-                    MCUT_ASSERT(patch_to_m1_he.find(cur_patch_idx) == patch_to_m1_he.cend());
+                        // In general, a halfedge may only be transformed once for each patch it is be associated
+                        // with (i.e it will have two copies with one for each opposing patch). Note however that
+                        // in the case that the current halfedge is a border halfedge (partial cut), its transformed
+                        // copy is the same as its untransformed copy for each patch
+                        MCUT_ASSERT(patch_to_m1_he.find(cur_patch_idx) == patch_to_m1_he.cend());
 
-                    patch_to_m1_he.insert(std::make_pair(cur_patch_idx, m1_cur_patch_cur_poly_cur_he));
-                    transformed_he_counter += 1; // next halfedge in m0_cur_patch_cur_poly
+                        patch_to_m1_he.insert(std::make_pair(cur_patch_idx, m1_cur_patch_cur_poly_cur_he));
+                        transformed_he_counter += 1; // next halfedge in m0_cur_patch_cur_poly
 
-                } while (transformed_he_counter != (int)m0_cur_patch_cur_poly.size()); // while not all halfedges of the current polygon have been transformed.
+                    } while (transformed_he_counter != (int)m0_cur_patch_cur_poly.size()); // while not all halfedges of the current polygon have been transformed.
 
-                //
-                // at this stage, all halfedges of the current polygon have been transformed
-                //
+                    //
+                    // at this stage, all halfedges of the current polygon have been transformed
+                    //
 
-                // ... remove the stitching-initialiation data of current polygon.
-                patch_poly_stitching_queue.pop_front();
+                    // ... remove the stitching-initialiation data of current polygon.
+                    patch_poly_stitching_queue.pop_front();
 
-                ///////////////////////////////////////////////////////////////////////////
-                // find untransformed neighbouring polygons and queue them
-                ///////////////////////////////////////////////////////////////////////////
+                    ///////////////////////////////////////////////////////////////////////////
+                    // find untransformed neighbouring polygons and queue them
+                    ///////////////////////////////////////////////////////////////////////////
 
-                //
-                // We are basically adding all unstitched neighbours of the current polygon
-                // (that we just sticthed) to the queue so they can be stitched as well. These
-                // are polygons on the same patch as the current polygon and are adjacent to
-                // it i.e. they share an edge.
-                //
+                    //
+                    // We are basically adding all unstitched neighbours of the current polygon
+                    // (that we just sticthed) to the queue so they can be stitched as well. These
+                    // are polygons on the same patch as the current polygon and are adjacent to
+                    // it i.e. they share an edge.
+                    //
 
-                MCUT_ASSERT(patches.find(cur_patch_idx) != patches.cend());
+                    MCUT_ASSERT(patches.find(cur_patch_idx) != patches.cend());
 
-                // polygons of current patch
-                // const std::vector<int>& patch_polys = SAFE_ACCESS(patches, cur_patch_idx);
+                    // polygons of current patch
+                    // const std::vector<int>& patch_polys = SAFE_ACCESS(patches, cur_patch_idx);
 
-                // stores the queued adjacent polygon to be stitched that have just been discovered
-                // i.e. discovered while finding the next untransformed adjacent polygons of the
-                // current one that we just transformed
-                std::deque<std::tuple<hd_t /*m1*/, int /*m0 poly*/, int /*m0 he*/>> patch_poly_stitching_queue_tmp;
+                    // stores the queued adjacent polygon to be stitched that have just been discovered
+                    // i.e. discovered while finding the next untransformed adjacent polygons of the
+                    // current one that we just transformed
+                    std::deque<std::tuple<hd_t /*m1*/, int /*m0 poly*/, int /*m0 he*/>> patch_poly_stitching_queue_tmp;
 
-                // for each halfedge of the polygon we just stitched
-                for (traced_polygon_t::const_iterator m0_poly_he_iter = m0_cur_patch_cur_poly.cbegin();
-                     m0_poly_he_iter != m0_cur_patch_cur_poly.cend();
-                     ++m0_poly_he_iter) {
+                    // for each halfedge of the polygon we just stitched
+                    for (traced_polygon_t::const_iterator m0_poly_he_iter = m0_cur_patch_cur_poly.cbegin();
+                         m0_poly_he_iter != m0_cur_patch_cur_poly.cend();
+                         ++m0_poly_he_iter) {
 
-                    const hd_t m0_cur_patch_cur_poly_cur_he = *m0_poly_he_iter;
+                        const hd_t m0_cur_patch_cur_poly_cur_he = *m0_poly_he_iter;
 
-                    // Skip certain neighbours. The adjacent polygon has been processed (assuming
-                    // it exists) if the following conditions are true. Theses conditions are
-                    // evaluated on "m0_cur_patch_cur_poly_cur_he"
-                    //
-                    // 1. is same as initial halfedge
-                    //      implies that opposite is already transformed (before the current polygon,
-                    //      we transformed the polygon which is traced by the opposite halfedge of
-                    //      m0_cur_patch_cur_poly_1st_he)
-                    // 2. is interior intersection-halfedge
-                    //      opposite is already transformed since interior intersection-halfedges
-                    //      are on cut-path (the opposite halfedge is incident to one of the
-                    //      src-mesh connected components)
-                    // 3. is a halfedge whose opposite has been transformed
-                    //      because that implies that its polygon has been transformed (so no need
-                    //      to add to queue).
-                    // 4. it is a border halfedge
-                    //      (i.e. the only face incident to the opposite halfedge is another which
-                    //      belong to the opposite patch)
-                    //
+                        // Skip certain neighbours. The adjacent polygon has been processed (assuming
+                        // it exists) if the following conditions are true. Theses conditions are
+                        // evaluated on "m0_cur_patch_cur_poly_cur_he"
+                        //
+                        // 1. is same as initial halfedge
+                        //      implies that opposite is already transformed (before the current polygon,
+                        //      we transformed the polygon which is traced by the opposite halfedge of
+                        //      m0_cur_patch_cur_poly_1st_he)
+                        // 2. is interior intersection-halfedge
+                        //      opposite is already transformed since interior intersection-halfedges
+                        //      are on cut-path (the opposite halfedge is incident to one of the
+                        //      src-mesh connected components)
+                        // 3. is a halfedge whose opposite has been transformed
+                        //      because that implies that its polygon has been transformed (so no need
+                        //      to add to queue).
+                        // 4. it is a border halfedge
+                        //      (i.e. the only face incident to the opposite halfedge is another which
+                        //      belong to the opposite patch)
+                        //
 
-                    //
-                    // case 1
-                    //
-                    if (m0_cur_patch_cur_poly_cur_he == m0_cur_patch_cur_poly_1st_he) {
-                        continue; // 1
-                    }
+                        //
+                        // case 1
+                        //
+                        if (m0_cur_patch_cur_poly_cur_he == m0_cur_patch_cur_poly_1st_he) {
+                            continue; // 1
+                        }
 
-                    //
-                    // case 2
-                    //
-                    const vd_t m0_cur_patch_cur_poly_cur_he_src = m0.source(m0_cur_patch_cur_poly_cur_he);
-                    const vd_t m0_cur_patch_cur_poly_cur_he_tgt = m0.target(m0_cur_patch_cur_poly_cur_he);
-                    bool is_ambiguious_interior_edge_case = m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_src, ps_vtx_cnt) && m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_tgt, ps_vtx_cnt);
+                        //
+                        // case 2
+                        //
+                        const vd_t m0_cur_patch_cur_poly_cur_he_src = m0.source(m0_cur_patch_cur_poly_cur_he);
+                        const vd_t m0_cur_patch_cur_poly_cur_he_tgt = m0.target(m0_cur_patch_cur_poly_cur_he);
+                        bool is_ambiguious_interior_edge_case = m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_src, ps_vtx_cnt) && m0_is_intersection_point(m0_cur_patch_cur_poly_cur_he_tgt, ps_vtx_cnt);
 
-                    if (is_ambiguious_interior_edge_case) {
-                        MCUT_ASSERT((size_t)m0_cur_patch_cur_poly_cur_he_src - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(m0_cur_patch_cur_poly_cur_he_src) != m0_ivtx_to_intersection_registry_entry.cend()*/);
+                        if (is_ambiguious_interior_edge_case) {
+                            MCUT_ASSERT((size_t)m0_cur_patch_cur_poly_cur_he_src - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(m0_cur_patch_cur_poly_cur_he_src) != m0_ivtx_to_intersection_registry_entry.cend()*/);
 
-                        const std::pair<ed_t, fd_t>& m0_cur_patch_cur_poly_cur_he_src_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)m0_cur_patch_cur_poly_cur_he_src - ps_vtx_cnt);
-                        const ed_t src_ps_edge = m0_cur_patch_cur_poly_cur_he_src_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0_cur_patch_cur_poly_cur_he_src); //ps.edge(src_coincident_ps_halfedge);
+                            const std::pair<ed_t, fd_t>& m0_cur_patch_cur_poly_cur_he_src_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)m0_cur_patch_cur_poly_cur_he_src - ps_vtx_cnt);
+                            const ed_t src_ps_edge = m0_cur_patch_cur_poly_cur_he_src_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0_cur_patch_cur_poly_cur_he_src); //ps.edge(src_coincident_ps_halfedge);
 
-                        MCUT_ASSERT((size_t)m0_cur_patch_cur_poly_cur_he_tgt - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(m0_cur_patch_cur_poly_cur_he_tgt) != m0_ivtx_to_intersection_registry_entry.cend()*/);
-                        const std::pair<ed_t, fd_t>& m0_cur_patch_cur_poly_cur_he_tgt_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)m0_cur_patch_cur_poly_cur_he_tgt - ps_vtx_cnt);
+                            MCUT_ASSERT((size_t)m0_cur_patch_cur_poly_cur_he_tgt - ps_vtx_cnt < m0_ivtx_to_intersection_registry_entry.size() /*m0_ivtx_to_intersection_registry_entry.find(m0_cur_patch_cur_poly_cur_he_tgt) != m0_ivtx_to_intersection_registry_entry.cend()*/);
+                            const std::pair<ed_t, fd_t>& m0_cur_patch_cur_poly_cur_he_tgt_ipair = SAFE_ACCESS(m0_ivtx_to_intersection_registry_entry, (std::size_t)m0_cur_patch_cur_poly_cur_he_tgt - ps_vtx_cnt);
 
-                        const ed_t tgt_ps_edge = m0_cur_patch_cur_poly_cur_he_tgt_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0_cur_patch_cur_poly_cur_he_tgt); //ps.edge(tgt_ps_h);
+                            const ed_t tgt_ps_edge = m0_cur_patch_cur_poly_cur_he_tgt_ipair.first; // SAFE_ACCESS(m0_ivtx_to_ps_edge, m0_cur_patch_cur_poly_cur_he_tgt); //ps.edge(tgt_ps_h);
 
-                        bool is_valid_ambiguious_interior_edge = (src_ps_edge != tgt_ps_edge);
+                            bool is_valid_ambiguious_interior_edge = (src_ps_edge != tgt_ps_edge);
 
-                        if (is_valid_ambiguious_interior_edge) {
-                            continue; // 2
+                            if (is_valid_ambiguious_interior_edge) {
+                                continue; // 2
+                            }
                         }
-                    }
 
-                    //
-                    // case 3
-                    //
-                    const hd_t m0_cur_patch_cur_poly_cur_he_opp = m0.opposite(m0_cur_patch_cur_poly_cur_he);
-                    std::unordered_map<hd_t, std::map<int, hd_t>>::const_iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he_opp); // value will not exist if current patch positive
+                        //
+                        // case 3
+                        //
+                        const hd_t m0_cur_patch_cur_poly_cur_he_opp = m0.opposite(m0_cur_patch_cur_poly_cur_he);
+                        std::unordered_map<hd_t, std::map<int, hd_t>>::const_iterator m0_to_m1_he_instances_find_iter = m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he_opp); // value will not exist if current patch positive
 
-                    if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) { // check exists (i.e. m0_cur_patch_cur_poly_cur_he_opp has be transform but we dont know for which patch it has been transformed (CCW or CW)
+                        if (m0_to_m1_he_instances_find_iter != m0_to_m1_he_instances.cend()) { // check exists (i.e. m0_cur_patch_cur_poly_cur_he_opp has be transform but we dont know for which patch it has been transformed (CCW or CW)
 
-                        const std::map<int, hd_t>& patch_to_m1_he = m0_to_m1_he_instances_find_iter->second;
-                        std::map<int, hd_t>::const_iterator patch_idx_to_m1_he = patch_to_m1_he.find(cur_patch_idx);
+                            const std::map<int, hd_t>& patch_to_m1_he = m0_to_m1_he_instances_find_iter->second;
+                            std::map<int, hd_t>::const_iterator patch_idx_to_m1_he = patch_to_m1_he.find(cur_patch_idx);
 
-                        if (patch_idx_to_m1_he != patch_to_m1_he.cend()) { // check is stitched
-                            MCUT_ASSERT(patch_idx_to_m1_he->second != hmesh_t::null_halfedge());
-                            continue; // 3
+                            if (patch_idx_to_m1_he != patch_to_m1_he.cend()) { // check is stitched
+                                MCUT_ASSERT(patch_idx_to_m1_he->second != hmesh_t::null_halfedge());
+                                continue; // 3
+                            }
                         }
-                    }
 
-                    //
-                    // case 4
-                    //
+                        //
+                        // case 4
+                        //
 
-                    // must exist because m0_cur_patch_cur_poly_cur_he was just transformed
-                    MCUT_ASSERT(m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he) != m0_to_m1_he_instances.cend());
+                        // must exist because m0_cur_patch_cur_poly_cur_he was just transformed
+                        MCUT_ASSERT(m0_to_m1_he_instances.find(m0_cur_patch_cur_poly_cur_he) != m0_to_m1_he_instances.cend());
 
-                    // find m1_cur_polygon_he which is the transformed instance of m0_cur_patch_cur_poly_cur_he
-                    /*const*/ std::map<int, hd_t>& patch_to_m1_he = SAFE_ACCESS(m0_to_m1_he_instances, m0_cur_patch_cur_poly_cur_he);
+                        // find m1_cur_polygon_he which is the transformed instance of m0_cur_patch_cur_poly_cur_he
+                        /*const*/ std::map<int, hd_t>& patch_to_m1_he = SAFE_ACCESS(m0_to_m1_he_instances, m0_cur_patch_cur_poly_cur_he);
 
-                    MCUT_ASSERT(patch_to_m1_he.find(cur_patch_idx) != patch_to_m1_he.cend());
+                        MCUT_ASSERT(patch_to_m1_he.find(cur_patch_idx) != patch_to_m1_he.cend());
 
-                    const hd_t m1_cur_polygon_he = SAFE_ACCESS(patch_to_m1_he, cur_patch_idx);
-                    // transformed halfedge used by adjacent polygon
-                    const hd_t m1_next_poly_seed_he = m1_colored.opposite(m1_cur_polygon_he);
+                        const hd_t m1_cur_polygon_he = SAFE_ACCESS(patch_to_m1_he, cur_patch_idx);
+                        // transformed halfedge used by adjacent polygon
+                        const hd_t m1_next_poly_seed_he = m1_colored.opposite(m1_cur_polygon_he);
 
-                    // infer the index of the next stitched polygon which is traced with m0_cur_patch_cur_poly_cur_he_opp
-                    MCUT_ASSERT(SAFE_ACCESS(m0_h_to_ply, m0_cur_patch_cur_poly_cur_he_opp).size() > 0 /*m0_h_to_ply.find(m0_cur_patch_cur_poly_cur_he_opp) != m0_h_to_ply.cend()*/);
+                        // infer the index of the next stitched polygon which is traced with m0_cur_patch_cur_poly_cur_he_opp
+                        MCUT_ASSERT(SAFE_ACCESS(m0_h_to_ply, m0_cur_patch_cur_poly_cur_he_opp).size() > 0 /*m0_h_to_ply.find(m0_cur_patch_cur_poly_cur_he_opp) != m0_h_to_ply.cend()*/);
 
-                    //
-                    // find the adjacent polygon in the current patch using the opposite of the
-                    // current halfedge
-                    //
+                        //
+                        // find the adjacent polygon in the current patch using the opposite of the
+                        // current halfedge
+                        //
 
-                    // get the polygons traced with the opposite halfedge
-                    const std::vector<int> m0_poly_he_opp_coincident_polys = SAFE_ACCESS(m0_h_to_ply, m0_cur_patch_cur_poly_cur_he_opp);
-                    const std::vector<int>::const_iterator find_iter = std::find_if( // find the current polygon of current patch
-                        m0_poly_he_opp_coincident_polys.cbegin(),
-                        m0_poly_he_opp_coincident_polys.cend(),
-                        [&](const int poly_idx) {
-                            MCUT_ASSERT(m0_cm_poly_to_patch_idx.count(poly_idx) == 1);
-                            // return SAFE_ACCESS(m0_cm_poly_to_patch_idx, poly_idx) == cur_patch_idx;
+                        // get the polygons traced with the opposite halfedge
+                        const std::vector<int> m0_poly_he_opp_coincident_polys = SAFE_ACCESS(m0_h_to_ply, m0_cur_patch_cur_poly_cur_he_opp);
+                        const std::vector<int>::const_iterator find_iter = std::find_if( // find the current polygon of current patch
+                            m0_poly_he_opp_coincident_polys.cbegin(),
+                            m0_poly_he_opp_coincident_polys.cend(),
+                            [&](const int poly_idx) {
+                                MCUT_ASSERT(m0_cm_poly_to_patch_idx.count(poly_idx) == 1);
+                                // return SAFE_ACCESS(m0_cm_poly_to_patch_idx, poly_idx) == cur_patch_idx;
 
-                            bool has_patch_winding_orientation = false;
+                                bool has_patch_winding_orientation = false;
 
-                            // check if polygon has the same winding order as the current patch
+                                // check if polygon has the same winding order as the current patch
 
-                            if (is_ccw_patch) { // is the current patch a "normal" patch?
-                                has_patch_winding_orientation = (poly_idx < traced_polygon_count);
-                            } else {
-                                has_patch_winding_orientation = (poly_idx >= traced_polygon_count);
-                            }
+                                if (is_ccw_patch) { // is the current patch a "normal" patch?
+                                    has_patch_winding_orientation = (poly_idx < traced_polygon_count);
+                                } else {
+                                    has_patch_winding_orientation = (poly_idx >= traced_polygon_count);
+                                }
 
-                            return has_patch_winding_orientation && SAFE_ACCESS(m0_cm_poly_to_patch_idx, poly_idx) == cur_patch_idx; // std::find(patch_polys.cbegin(), patch_polys.cend(), poly_idx) != patch_polys.cend(); // NOTE: only one polygon in the current patch will match
-                        });
+                                return has_patch_winding_orientation && SAFE_ACCESS(m0_cm_poly_to_patch_idx, poly_idx) == cur_patch_idx; // std::find(patch_polys.cbegin(), patch_polys.cend(), poly_idx) != patch_polys.cend(); // NOTE: only one polygon in the current patch will match
+                            });
 
-                    // note: if the current halfedge is on the border of the cut-mesh, then its opposite
-                    // halfedge can only trace one polygon, which is the opposite polygon to the
-                    // current (i.e. on the opposing patch). Hence, if find_iter is null then it means "m0_cur_patch_cur_poly_cur_he"
-                    // is on the border of the cut-mesh.
-                    const bool opp_is_border_halfedge = (find_iter == m0_poly_he_opp_coincident_polys.cend()); // current patch is reversed-patch and
+                        // note: if the current halfedge is on the border of the cut-mesh, then its opposite
+                        // halfedge can only trace one polygon, which is the opposite polygon to the
+                        // current (i.e. on the opposing patch). Hence, if find_iter is null then it means "m0_cur_patch_cur_poly_cur_he"
+                        // is on the border of the cut-mesh.
+                        const bool opp_is_border_halfedge = (find_iter == m0_poly_he_opp_coincident_polys.cend()); // current patch is reversed-patch and
 
-                    if (opp_is_border_halfedge) {
-                        // 4 there is no neighbouring polygon which is coincident to
-                        // "m0_cur_patch_cur_poly_cur_he_opp"
-                        continue;
-                    }
+                        if (opp_is_border_halfedge) {
+                            // 4 there is no neighbouring polygon which is coincident to
+                            // "m0_cur_patch_cur_poly_cur_he_opp"
+                            continue;
+                        }
 
-                    // the adjacent polygon
-                    const int m0_next_poly_idx = *find_iter;
+                        // the adjacent polygon
+                        const int m0_next_poly_idx = *find_iter;
 
-                    //
-                    // TODO: the following conditions below could also be speeded up if we
-                    // create a tmp vector/map which stores all of the adjacent polygons we have
-                    // already queued. Searching over this vector could be that bit faster.
-                    // We could do the right here now that "m0_next_poly_idx" is known.
-                    //
+                        //
+                        // TODO: the following conditions below could also be speeded up if we
+                        // create a tmp vector/map which stores all of the adjacent polygons we have
+                        // already queued. Searching over this vector could be that bit faster.
+                        // We could do the right here now that "m0_next_poly_idx" is known.
+                        //
+
+                        // deduce the index of the next polygon's seed m0 halfedge
+                        // -------------------------------------------------------
+
+                        MCUT_ASSERT(m0_next_poly_idx < (int)m0_polygons.size());
+
+                        // adjacent polygon
+                        const traced_polygon_t& next_poly = m0_polygons[m0_next_poly_idx];
+                        // pointer to the first halfedge in the polygon from which its stitching will begin
+                        const traced_polygon_t::const_iterator he_find_iter = std::find(
+                            next_poly.cbegin(),
+                            next_poly.cend(),
+                            m0_cur_patch_cur_poly_cur_he_opp);
+
+                        // "m0_cur_patch_cur_poly_cur_he_opp" must exist in next_poly since we have
+                        // already established that "m0_cur_patch_cur_poly_cur_he" is not a border
+                        // halfedge. This is further supported by the fact that "next_poly" is in
+                        // current patch and coincident to "m0_cur_patch_cur_poly_cur_he_opp"
+                        MCUT_ASSERT(he_find_iter != next_poly.cend());
+
+                        // index of halfedge from which stitching of the adjacent polygon will begin
+                        const int m0_next_poly_he_idx = (int)std::distance(next_poly.cbegin(), he_find_iter);
+
+                        // NOTE: there is no need to check if the next polygon is transformed here
+                        // because our 4 conditions above take care of this.
+                        // However, we do have to take care not to add the polygon to the queue more
+                        // than once (due to BFS nature of stitching), hence the following.
+
+                        const bool poly_is_already_in_tmp_queue = std::find_if(
+                                                                      patch_poly_stitching_queue_tmp.crbegin(),
+                                                                      patch_poly_stitching_queue_tmp.crend(),
+                                                                      [&](const std::tuple<hd_t, int, int>& elem) {
+                                                                          return std::get<1>(elem) == m0_next_poly_idx;
+                                                                      })
+                            != patch_poly_stitching_queue_tmp.crend();
+
+                        if (!poly_is_already_in_tmp_queue) {
+                            //                   if (!poly_is_already_stitched_wrt_cur_patch) { // TODO: the [if check] will have to go once "poly_is_already_stitched_wrt_cur_patch" is removed
+                            // check the main global queue to make sure poly has not already been added
+                            // std::unordered_map<int, bool>::const_iterator qmap_iter = m0_poly_already_enqueued.find(m0_next_poly_idx);
+                            const bool poly_is_already_in_maqueued = m0_poly_already_enqueued[(std::size_t)m0_next_poly_idx - traced_sm_polygon_count]; /*std::find_if(
+                                                                         patch_poly_stitching_queue.crbegin(),
+                                                                         patch_poly_stitching_queue.crend(),
+                                                                         [&](const std::tuple<hd_t, int, int> &elem)
+                                                                         {
+                                                                             return std::get<1>(elem) == m0_next_poly_idx; // there is an element in the queue with the polygon's ID
+                                                                         }) != patch_poly_stitching_queue.crend();*/
+
+                            if (!poly_is_already_in_maqueued) {
+                                patch_poly_stitching_queue_tmp.push_back(std::make_tuple(m1_next_poly_seed_he, m0_next_poly_idx, m0_next_poly_he_idx));
+                                m0_poly_already_enqueued[(std::size_t)m0_next_poly_idx - traced_sm_polygon_count] = true;
+                            }
+                        }
 
-                    // deduce the index of the next polygon's seed m0 halfedge
-                    // -------------------------------------------------------
-
-                    MCUT_ASSERT(m0_next_poly_idx < (int)m0_polygons.size());
-
-                    // adjacent polygon
-                    const traced_polygon_t& next_poly = m0_polygons[m0_next_poly_idx];
-                    // pointer to the first halfedge in the polygon from which its stitching will begin
-                    const traced_polygon_t::const_iterator he_find_iter = std::find(
-                        next_poly.cbegin(),
-                        next_poly.cend(),
-                        m0_cur_patch_cur_poly_cur_he_opp);
-
-                    // "m0_cur_patch_cur_poly_cur_he_opp" must exist in next_poly since we have
-                    // already established that "m0_cur_patch_cur_poly_cur_he" is not a border
-                    // halfedge. This is further supported by the fact that "next_poly" is in
-                    // current patch and coincident to "m0_cur_patch_cur_poly_cur_he_opp"
-                    MCUT_ASSERT(he_find_iter != next_poly.cend());
-
-                    // index of halfedge from which stitching of the adjacent polygon will begin
-                    const int m0_next_poly_he_idx = (int)std::distance(next_poly.cbegin(), he_find_iter);
-
-                    // NOTE: there is no need to check if the next polygon is transformed here
-                    // because our 4 conditions above take care of this.
-                    // However, we do have to take care not to add the polygon to the queue more
-                    // than once (due to BFS nature of stitching), hence the following.
-
-                    const bool poly_is_already_in_tmp_queue = std::find_if(
-                                                                  patch_poly_stitching_queue_tmp.crbegin(),
-                                                                  patch_poly_stitching_queue_tmp.crend(),
-                                                                  [&](const std::tuple<hd_t, int, int>& elem) {
-                                                                      return std::get<1>(elem) == m0_next_poly_idx;
-                                                                  })
-                        != patch_poly_stitching_queue_tmp.crend();
-
-                    if (!poly_is_already_in_tmp_queue) {
-                        //                   if (!poly_is_already_stitched_wrt_cur_patch) { // TODO: the [if check] will have to go once "poly_is_already_stitched_wrt_cur_patch" is removed
-                        // check the main global queue to make sure poly has not already been added
-                        // std::unordered_map<int, bool>::const_iterator qmap_iter = m0_poly_already_enqueued.find(m0_next_poly_idx);
-                        const bool poly_is_already_in_maqueued = m0_poly_already_enqueued[(std::size_t)m0_next_poly_idx - traced_sm_polygon_count]; /*std::find_if(
-                                                                     patch_poly_stitching_queue.crbegin(),
-                                                                     patch_poly_stitching_queue.crend(),
-                                                                     [&](const std::tuple<hd_t, int, int> &elem)
-                                                                     {
-                                                                         return std::get<1>(elem) == m0_next_poly_idx; // there is an element in the queue with the polygon's ID
-                                                                     }) != patch_poly_stitching_queue.crend();*/
-
-                        if (!poly_is_already_in_maqueued) {
-                            patch_poly_stitching_queue_tmp.push_back(std::make_tuple(m1_next_poly_seed_he, m0_next_poly_idx, m0_next_poly_he_idx));
-                            m0_poly_already_enqueued[(std::size_t)m0_next_poly_idx - traced_sm_polygon_count] = true;
+                        //
+                        // update vertex mapping for non-intersection points
+                        //
+
+                        // since we loop round the whole current polygon, we can just use the target
+                        // NOTE: Possible optimization we could populate "m1_to_m0_cm_ovtx_colored" in the
+                        // do-while loop that stitches cut-mesh patches because the are specific if-cases which deal
+                        // with x-->o and o-->o halfedges, from which we can add elements to "m1_to_m0_cm_ovtx_colored"
+                        const vd_t m0_cur_poly_cur_he_tgt = m0.target(m0_cur_patch_cur_poly_cur_he);
+                        const bool tgt_is_original_vtx = !m0_is_intersection_point(m0_cur_poly_cur_he_tgt, ps_vtx_cnt);
+
+                        if (tgt_is_original_vtx) {
+                            const vd_t m1_cur_poly_cur_he_tgt = m1_colored.target(m1_cur_polygon_he);
+                            // "cur_poly_cur_he_tgt" may already be mapped to its "m1" version w.r.t the current patch.
+                            // This is because of the BFS manner in which we stitch polygons of a patch.
+                            if (m1_to_m0_cm_ovtx_colored.count(m1_cur_poly_cur_he_tgt) == 0) {
+                                m1_to_m0_cm_ovtx_colored[m1_cur_poly_cur_he_tgt] = m0_cur_poly_cur_he_tgt;
+                            }
                         }
                     }
+                    //              } // for each m0 halfedge of current patch-polygon
+
+                    // add elements of tmp/local queue to global queue
+                    while (!patch_poly_stitching_queue_tmp.empty()) {
+                        const std::tuple<hd_t, int, int>& elem = patch_poly_stitching_queue_tmp.front();
+                        patch_poly_stitching_queue.push_back(elem); // add
+                        patch_poly_stitching_queue_tmp.pop_front(); // rm
+                    }
 
                     //
-                    // update vertex mapping for non-intersection points
+                    // NOTE: At this stage, we have finished transforming all the halfedges of the current polygon
+                    // and we have also added all its neighbouring polygons to the queue for stitching.
                     //
 
-                    // since we loop round the whole current polygon, we can just use the target
-                    // NOTE: Possible optimization we could populate "m1_to_m0_cm_ovtx_colored" in the
-                    // do-while loop that stitches cut-mesh patches because the are specific if-cases which deal
-                    // with x-->o and o-->o halfedges, from which we can add elements to "m1_to_m0_cm_ovtx_colored"
-                    const vd_t m0_cur_poly_cur_he_tgt = m0.target(m0_cur_patch_cur_poly_cur_he);
-                    const bool tgt_is_original_vtx = !m0_is_intersection_point(m0_cur_poly_cur_he_tgt, ps_vtx_cnt);
-
-                    if (tgt_is_original_vtx) {
-                        const vd_t m1_cur_poly_cur_he_tgt = m1_colored.target(m1_cur_polygon_he);
-                        // "cur_poly_cur_he_tgt" may already be mapped to its "m1" version w.r.t the current patch.
-                        // This is because of the BFS manner in which we stitch polygons of a patch.
-                        if (m1_to_m0_cm_ovtx_colored.count(m1_cur_poly_cur_he_tgt) == 0) {
-                            m1_to_m0_cm_ovtx_colored[m1_cur_poly_cur_he_tgt] = m0_cur_poly_cur_he_tgt;
-                        }
+                    MCUT_ASSERT(patch_color_label_to_location.find(color_id) != patch_color_label_to_location.cend());
+
+                    ///////////////////////////////////////////////////////////////////////////
+                    // Update output (with the current polygon stitched into a cc)
+                    ///////////////////////////////////////////////////////////////////////////
+
+                    const std::string color_tag_stri = to_string(SAFE_ACCESS(patch_color_label_to_location, color_id)); // == cm_patch_location_t::OUTSIDE ? "e" : "i");
+
+                    // save meshes and dump
+
+                    if (keep_partially_sealed_ccs) {
+                        ///////////////////////////////////////////////////////////////////////////
+                        // create the sealed meshes defined by the [current] set of traced polygons
+                        ///////////////////////////////////////////////////////////////////////////
+
+                        extract_connected_components(
+    #if defined(MCUT_MULTI_THREADED)
+                            *input.scheduler,
+    #endif
+                            separated_stitching_CCs,
+                            m1_colored,
+                            0,
+                            m1_polygons_colored,
+                            sm_polygons_below_cs,
+                            sm_polygons_above_cs,
+                            m1_vertex_to_seam_flag,
+                            m1_to_m0_sm_ovtx_colored,
+                            m1_to_m0_cm_ovtx_colored,
+                            m1_to_m0_face_colored,
+                            m0_to_ps_vtx,
+                            m0_to_ps_face,
+                            ps,
+                            sm_vtx_cnt,
+                            sm_face_count,
+                            input.populate_vertex_maps,
+                            input.populate_face_maps,
+                            input.keep_fragments_below_cutmesh,
+                            input.keep_fragments_above_cutmesh,
+                            input.keep_fragments_partially_cut);
                     }
-                }
-                //              } // for each m0 halfedge of current patch-polygon
 
-                // add elements of tmp/local queue to global queue
-                while (!patch_poly_stitching_queue_tmp.empty()) {
-                    const std::tuple<hd_t, int, int>& elem = patch_poly_stitching_queue_tmp.front();
-                    patch_poly_stitching_queue.push_back(elem); // add
-                    patch_poly_stitching_queue_tmp.pop_front(); // rm
-                }
+                    stitched_poly_counter++;
+
+                } while (!patch_poly_stitching_queue.empty()); // for each polygon of patch
 
                 //
-                // NOTE: At this stage, we have finished transforming all the halfedges of the current polygon
-                // and we have also added all its neighbouring polygons to the queue for stitching.
+                // NOTE: At this stage we have finished stitching all polygons of the current patch.
+                // So, the current patch has been stitch to a src-mesh fragment
                 //
 
-                MCUT_ASSERT(patch_color_label_to_location.find(color_id) != patch_color_label_to_location.cend());
-
-                ///////////////////////////////////////////////////////////////////////////
-                // Update output (with the current polygon stitched into a cc)
-                ///////////////////////////////////////////////////////////////////////////
-
-                const std::string color_tag_stri = to_string(SAFE_ACCESS(patch_color_label_to_location, color_id)); // == cm_patch_location_t::OUTSIDE ? "e" : "i");
+            } // for each patch
 
-                // save meshes and dump
+        } // for each color
 
-                if (input.keep_fragments_sealed_inside_exhaustive || input.keep_fragments_sealed_outside_exhaustive) {
-                    ///////////////////////////////////////////////////////////////////////////
-                    // create the sealed meshes defined by the [current] set of traced polygons
-                    ///////////////////////////////////////////////////////////////////////////
+        return true;
+    };
 
-                    extract_connected_components(
 #if defined(MCUT_MULTI_THREADED)
-                        *input.scheduler,
-#endif
-                        separated_stitching_CCs,
-                        m1_colored,
-                        0,
-                        m1_polygons_colored,
-                        sm_polygons_below_cs,
-                        sm_polygons_above_cs,
-                        m1_vertex_to_seam_flag,
-                        m1_to_m0_sm_ovtx_colored,
-                        m1_to_m0_cm_ovtx_colored,
-                        m1_to_m0_face_colored,
-                        m0_to_ps_vtx,
-                        m0_to_ps_face,
-                        ps_to_sm_vtx,
-                        ps_to_sm_face,
-                        ps_to_cm_vtx,
-                        ps_to_cm_face,
-                        sm_vtx_cnt,
-                        sm_face_count,
-                        input.populate_vertex_maps,
-                        input.populate_face_maps,
-                        input.keep_fragments_below_cutmesh,
-                        input.keep_fragments_above_cutmesh,
-                        input.keep_fragments_partially_cut);
-                }
-
-                ++global_cm_poly_stitch_counter;
-                stitched_poly_counter++;
-
-            } while (!patch_poly_stitching_queue.empty()); // for each polygon of patch
+    // NOTE: when partially sealed fragments are requested, "extract_connected_components" is
+    // called after each stitched polygon and it submits tasks to the thread pool itself,
+    // which must only be done by the scheduling thread.
+    const bool stitch_colors_in_parallel = colors_to_stitch.size() > 1 && !have_partially_sealed_fragments;
 
-            //
-            // NOTE: At this stage we have finished stitching all polygons of the current patch.
-            // So, the current patch has been stitch to a src-mesh fragment
-            //
+    if (stitch_colors_in_parallel) {
+        std::vector<std::future<bool>> futures;
+        bool _1;
 
-        } // for each patch
+        parallel_fork_and_join(
+            *input.scheduler,
+            colors_to_stitch.cbegin(),
+            colors_to_stitch.cend(),
+            1, // one color per thread
+            fn_stitch_colored_patches,
+            _1, // out
+            futures);
 
-    } // for each color
+        for (int i = 0; i < (int)futures.size(); ++i) {
+            std::future<bool>& f = futures[i];
+            MCUT_ASSERT(f.valid());
+            f.wait(); // wait for result to be done
+        }
+    } else {
+        fn_stitch_colored_patches(colors_to_stitch.cbegin(), colors_to_stitch.cend());
+    }
+#else
+    fn_stitch_colored_patches(colors_to_stitch.cbegin(), colors_to_stitch.cend());
+#endif
 
     TIMESTACK_POP(); // &&&&&
 
-    patch_poly_stitching_queue.clear();
-    m0_poly_already_enqueued.clear();
-
     m0_cm_poly_to_patch_idx.clear();
     // m0_ivtx_to_ps_edge.clear(); // free
     m0_polygons.clear();
@@ -10200,68 +9983,65 @@ void dispatch(output_t& output, const input_t& input)
     color_to_patch.clear();
     sm_interior_cs_border_vertices.clear();
     color_to_m0_to_m1_he_instances.clear();
+    m0.reset(); // free, not used by the extraction of the sealed fragments (which use the stitched "m1" versions)
 
     //
     // NOTE: At this stage, all patches of the current have been stitched
     //
 
-    bool userWantsFullySealedFragmentsANY = (input.keep_fragments_sealed_inside || input.keep_fragments_sealed_outside);
-    bool userWantsEvenPartiallySealedFragmentsANY = (input.keep_fragments_sealed_inside_exhaustive || input.keep_fragments_sealed_outside_exhaustive);
+    ///////////////////////////////////////////////////////////////////////////////
+    // create the [fully] sealed meshes defined by the final set of traced polygons
+    ///////////////////////////////////////////////////////////////////////////////
 
-    // if the user wants [only] fully sealed fragment (not partially sealed)
-    if (userWantsFullySealedFragmentsANY && //
-        !userWantsEvenPartiallySealedFragmentsANY) {
-        ///////////////////////////////////////////////////////////////////////////////
-        // create the [fully] sealed meshes defined by the final set of traced polygons
-        ///////////////////////////////////////////////////////////////////////////////
+    for (std::map<char, std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>>::iterator color_to_separated_CCs_iter = color_to_separated_connected_ccsponents.begin();
+         color_to_separated_CCs_iter != color_to_separated_connected_ccsponents.end();
+         ++color_to_separated_CCs_iter) {
 
-        for (std::map<char, std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>>::iterator color_to_separated_CCs_iter = color_to_separated_connected_ccsponents.begin();
-             color_to_separated_CCs_iter != color_to_separated_connected_ccsponents.end();
-             ++color_to_separated_CCs_iter) {
+        const char color_label = color_to_separated_CCs_iter->first;
 
-            const char color_label = color_to_separated_CCs_iter->first;
-            std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>& separated_sealed_CCs = color_to_separated_CCs_iter->second;
+        if (keep_partially_sealed_fragments(color_label)) {
+            continue; // already created while stitching (the last instance of each connected component is fully sealed)
+        }
 
-            const hmesh_t& m1_colored = SAFE_ACCESS(color_to_m1, color_label);
-            MCUT_ASSERT(color_to_m1_polygons.count(color_label) == 1);
-            const std::vector<traced_polygon_t>& m1_polygons_colored = SAFE_ACCESS(color_to_m1_polygons, color_label);
-            MCUT_ASSERT(color_to_m1_to_m0_sm_ovtx.count(color_label) == 1);
-            const std::vector<vd_t>& m1_to_m0_sm_ovtx_colored = SAFE_ACCESS(color_to_m1_to_m0_sm_ovtx, color_label);
+        std::map<std::size_t, std::vector<std::pair<hmesh_t, connected_component_info_t>>>& separated_sealed_CCs = color_to_separated_CCs_iter->second;
 
-            MCUT_ASSERT(colour_to_m1_to_m0_cm_ovtx.count(color_label) == 1);
-            const std::unordered_map<vd_t, vd_t>& m1_to_m0_cm_ovtx_colored = SAFE_ACCESS(colour_to_m1_to_m0_cm_ovtx, color_label);
-            MCUT_ASSERT(color_to_m1_to_m0_face.count(color_label) == 1);
-            /*const*/ std::unordered_map<int, int>& m1_to_m0_face_colored = SAFE_ACCESS(color_to_m1_to_m0_face, color_label);
+        hmesh_t& m1_colored = SAFE_ACCESS(color_to_m1, color_label); // moved into "extract_connected_components" (see below)
+        MCUT_ASSERT(color_to_m1_polygons.count(color_label) == 1);
+        const std::vector<traced_polygon_t>& m1_polygons_colored = SAFE_ACCESS(color_to_m1_polygons, color_label);
+        MCUT_ASSERT(color_to_m1_to_m0_sm_ovtx.count(color_label) == 1);
+        const std::vector<vd_t>& m1_to_m0_sm_ovtx_colored = SAFE_ACCESS(color_to_m1_to_m0_sm_ovtx, color_label);
 
-            // extract the seam vertices
-            extract_connected_components(
+        MCUT_ASSERT(colour_to_m1_to_m0_cm_ovtx.count(color_label) == 1);
+        const std::unordered_map<vd_t, vd_t>& m1_to_m0_cm_ovtx_colored = SAFE_ACCESS(colour_to_m1_to_m0_cm_ovtx, color_label);
+        MCUT_ASSERT(color_to_m1_to_m0_face.count(color_label) == 1);
+        /*const*/ arena_unordered_map_t<int, int>& m1_to_m0_face_colored = SAFE_ACCESS(color_to_m1_to_m0_face, color_label);
+
+        // extract the seam vertices
+        // NOTE: this is the last use of "m1_colored"
+        extract_connected_components(
 #if defined(MCUT_MULTI_THREADED)
-                *input.scheduler,
+            *input.scheduler,
 #endif
-                separated_sealed_CCs,
-                m1_colored,
-                0,
-                m1_polygons_colored,
-                sm_polygons_below_cs,
-                sm_polygons_above_cs,
-                m1_vertex_to_seam_flag,
-                m1_to_m0_sm_ovtx_colored,
-                m1_to_m0_cm_ovtx_colored,
-                m1_to_m0_face_colored,
-                m0_to_ps_vtx,
-                m0_to_ps_face,
-                ps_to_sm_vtx,
-                ps_to_sm_face,
-                ps_to_cm_vtx,
-                ps_to_cm_face,
-                sm_vtx_cnt,
-                sm_face_count,
-                input.populate_vertex_maps,
-                input.populate_face_maps,
-                input.keep_fragments_below_cutmesh,
-                input.keep_fragments_above_cutmesh,
-                input.keep_fragments_partially_cut);
-        }
+            separated_sealed_CCs,
+            std::move(m1_colored),
+            0,
+            m1_polygons_colored,
+            sm_polygons_below_cs,
+            sm_polygons_above_cs,
+            m1_vertex_to_seam_flag,
+            m1_to_m0_sm_ovtx_colored,
+            m1_to_m0_cm_ovtx_colored,
+            m1_to_m0_face_colored,
+            m0_to_ps_vtx,
+            m0_to_ps_face,
+            ps,
+            sm_vtx_cnt,
+            sm_face_count,
+            input.populate_vertex_maps,
+            input.populate_face_maps,
+            input.keep_fragments_below_cutmesh,
+            input.keep_fragments_above_cutmesh,
+            input.keep_fragments_partially_cut);
     }
 
     sm_polygons_below_cs.clear(); // free
@@ -10295,7 +10075,7 @@ void dispatch(output_t& output, const input_t& input)
             // fragment that is "below" will have zero cut-mesh polygons. Hence.
             std::vector<std::pair<hmesh_t, connected_component_info_t>>& cc_instances = cc_iter->second;
 
-            if (!userWantsEvenPartiallySealedFragmentsANY) {
+            if (!keep_partially_sealed_fragments(color_label)) {
                 MCUT_ASSERT(cc_instances.size() == 1); // there is only one, fully sealed, copy
             }
 
@@ -259,16 +259,25 @@
         const std::vector<vec3>& polygon_vertices,
         const vec3& polygon_normal,
         const int polygon_normal_largest_component)
+    {
+        return compute_segment_plane_intersection_type(q, r, polygon_vertices.data(), (int)polygon_vertices.size(),
+            polygon_normal, polygon_normal_largest_component);
+    }
+
+    char compute_segment_plane_intersection_type(const vec3& q, const vec3& r,
+        const vec3* polygon_vertices, const int polygon_vertex_count,
+        const vec3& polygon_normal,
+        const int polygon_normal_largest_component)
     {
         // TODO: we could also return i,j and k so that "determine_three_noncollinear_vertices" is not called multiple times,
         // which we do to determine the type of intersection and the actual intersection point
-        const int polygon_vertex_count = (int)polygon_vertices.size();
         // ... any three vertices that are not collinear
         int i = 0;
         int j = 1;
         int k = 2;
         if (polygon_vertex_count > 3) { // case where we'd have the possibility of noncollinearity
-            bool b = determine_three_noncollinear_vertices(i, j, k, polygon_vertices, polygon_normal,
+            const std::vector<vec3> polygon_vertices_vec(polygon_vertices, polygon_vertices + polygon_vertex_count);
+            bool b = determine_three_noncollinear_vertices(i, j, k, polygon_vertices_vec, polygon_normal,
                 polygon_normal_largest_component);
 
             if (!b) {
@@ -684,11 +693,69 @@
 #endif
     }
 
-    // TODO: update this function to use "project2D" for projection step
+    char compute_point_in_triangle_test(const vec3& p, const vec3& a, const vec3& b, const vec3& c,
+        const int triangle_normal_largest_component)
+    {
+        MCUT_ASSERT(triangle_normal_largest_component >= 0 && triangle_normal_largest_component <= 2);
+
+        // the two axes that are kept
+        const int u = (triangle_normal_largest_component + 1) % 3;
+        const int v = (triangle_normal_largest_component + 2) % 3;
+
+        const vec2 p2(p[u], p[v]);
+        const vec2 a2(a[u], a[v]);
+        const vec2 b2(b[u], b[v]);
+        const vec2 c2(c[u], c[v]);
+
+        const double abc = orient2d(a2, b2, c2);
+
+        if (abc == double(0.0)) {
+            return 0; // degenerate (projected) triangle
+        }
+
+        if (p2 == a2 || p2 == b2 || p2 == c2) {
+            return 'v';
+        }
+
+        // barycentric coordinates of p (scaled by the area of the triangle), with the
+        // orientation of the triangle factored out
+        const double s = (abc > double(0.0)) ? double(1.0) : double(-1.0);
+        const double wa = orient2d(b2, c2, p2) * s;
+        const double wb = orient2d(c2, a2, p2) * s;
+        const double wc = orient2d(a2, b2, p2) * s;
+
+        if (wa < double(0.0) || wb < double(0.0) || wc < double(0.0)) {
+            return 'o';
+        }
+
+        if (wa == double(0.0) || wb == double(0.0) || wc == double(0.0)) {
+            return 'e';
+        }
+
+        return 'i';
+    }
+
     char compute_point_in_polygon_test(const vec3& p, const std::vector<vec3>& polygon_vertices,
         const vec3& polygon_normal, const int polygon_normal_largest_component)
     {
-        const int polygon_vertex_count = (int)polygon_vertices.size();
+        return compute_point_in_polygon_test(p, polygon_vertices.data(), (int)polygon_vertices.size(),
+            polygon_normal, polygon_normal_largest_component);
+    }
+
+    // TODO: update this function to use "project2D" for projection step
+    char compute_point_in_polygon_test(const vec3& p, const vec3* polygon_vertices, const int polygon_vertex_count,
+        const vec3& polygon_normal, const int polygon_normal_largest_component)
+    {
+        if (polygon_vertex_count == 3) {
+            // triangles don't need the (rotational) projection matrix below
+            const char result = compute_point_in_triangle_test(p, polygon_vertices[0], polygon_vertices[1], polygon_vertices[2],
+                polygon_normal_largest_component);
+
+            if (result != 0) {
+                return result;
+            }
+        }
+
         /* Project out coordinate m in both p and the triangular face */
         vec2 pp; /*projected p */
 #if 0
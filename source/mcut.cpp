@@ -165,7 +165,7 @@ MCAPI_ATTR McResult MCAPI_CALL mcGetInfo(const McContext context, McFlags info,
         per_thread_api_log_str = "context ptr (param0) undef (NULL)";
     } else if (bytes != 0 && pMem == nullptr) {
         per_thread_api_log_str = "invalid specification (param2 & param3)";
-    } else if (false == (info == MC_CONTEXT_FLAGS)) // check all possible values
+    } else if (false == (info == MC_CONTEXT_FLAGS || info == MC_CONTEXT_BVH_CACHE_DIRECTORY || info == MC_CONTEXT_BROAD_PHASE)) // check all possible values
     {
         per_thread_api_log_str = "invalid info flag val (param1)";
     } else if ((info == MC_CONTEXT_FLAGS) && (pMem != nullptr && bytes != sizeof(McFlags))) {
@@ -188,6 +188,38 @@ MCAPI_ATTR McResult MCAPI_CALL mcGetInfo(const McContext context, McFlags info,
     return return_value;
 }
 
+MCAPI_ATTR McResult MCAPI_CALL mcBindState(const McContext context, McFlags stateInfo, uint64_t bytes, const void* pMem)
+{
+    McResult return_value = McResult::MC_NO_ERROR;
+    per_thread_api_log_str.clear();
+
+    if (context == nullptr) {
+        per_thread_api_log_str = "context ptr (param0) undef (NULL)";
+    } else if (bytes != 0 && pMem == nullptr) {
+        per_thread_api_log_str = "invalid specification (param2 & param3)";
+    } else if (false == (stateInfo == MC_CONTEXT_BVH_CACHE_DIRECTORY || stateInfo == MC_CONTEXT_BROAD_PHASE)) // check all possible values
+    {
+        per_thread_api_log_str = "invalid state flag val (param1)";
+    } else if (stateInfo == MC_CONTEXT_BROAD_PHASE && (bytes != sizeof(McBroadPhase) || pMem == nullptr)) {
+        per_thread_api_log_str = "invalid broad-phase specification (param2 & param3)";
+    } else {
+        try {
+            bind_state_impl(context, stateInfo, bytes, pMem);
+        }
+        CATCH_POSSIBLE_EXCEPTIONS(per_thread_api_log_str);
+    }
+
+    if (!per_thread_api_log_str.empty()) {
+        std::fprintf(stderr, "%s(...) -> %s\n", __FUNCTION__, per_thread_api_log_str.c_str());
+        if (return_value == McResult::MC_NO_ERROR) // i.e. problem with basic local parameter checks
+        {
+            return_value = McResult::MC_INVALID_VALUE;
+        }
+    }
+
+    return return_value;
+}
+
 MCAPI_ATTR McResult MCAPI_CALL mcDispatch(
     const McContext context,
     McFlags dispatchFlags,
@@ -6,6 +6,7 @@
 #include "mcut/internal/math.h"
 #include "mcut/internal/utils.h"
 
+#include <cstdio>
 #include <numeric> // std::partial_sum
 #include <queue>
 #include <random> // for numerical perturbation
@@ -54,6 +55,7 @@ bool client_input_arrays_to_hmesh(
                 double(z) + (perturbation != NULL ? (*perturbation).z() : double(0.)));
 
             MCUT_ASSERT(vd != hmesh_t::null_vertex() && (uint32_t)vd < numVertices);
+            (void)vd;
         }
     }
     // did the user provide vertex arrays of 64-bit double...?
@@ -73,6 +75,7 @@ bool client_input_arrays_to_hmesh(
                 double(z) + (perturbation != NULL ? (*perturbation).z() : double(0.)));
 
             MCUT_ASSERT(vd != hmesh_t::null_vertex() && (uint32_t)vd < numVertices);
+            (void)vd;
         }
     }
 
@@ -83,10 +86,22 @@ bool client_input_arrays_to_hmesh(
     vec3 bboxMax(-1e10);
 
     TIMESTACK_PUSH("create bbox");
-    for (vertex_array_iterator_t i = halfedgeMesh.vertices_begin(); i != halfedgeMesh.vertices_end(); ++i) {
-        const vec3& coords = halfedgeMesh.vertex(*i);
-        bboxMin = compwise_min(bboxMin, coords);
-        bboxMax = compwise_max(bboxMax, coords);
+    MCUT_ASSERT(halfedgeMesh.number_of_vertices_removed() == 0);
+    // one streaming pass over each coordinate array
+    for (int axis = 0; axis < 3; ++axis) {
+        const std::vector<double>& coords = halfedgeMesh.vertex_coordinates(axis);
+        const double* const coords_ptr = coords.data();
+        const std::size_t coords_count = coords.size();
+        double axis_min = bboxMin[axis];
+        double axis_max = bboxMax[axis];
+
+        for (std::size_t i = 0; i < coords_count; ++i) {
+            axis_min = std::min(axis_min, coords_ptr[i]);
+            axis_max = std::max(axis_max, coords_ptr[i]);
+        }
+
+        bboxMin[axis] = axis_min;
+        bboxMax[axis] = axis_max;
     }
     bboxDiagonal = length(bboxMax - bboxMin);
     TIMESTACK_POP();
@@ -856,8 +871,9 @@ void hmesh_to_array_mesh(
 
 bool is_coplanar(const hmesh_t& m, const fd_t& f, int& fv_count)
 {
-    const std::vector<vd_t> vertices = m.get_vertices_around_face(f);
-    fv_count = (int)vertices.size();
+    // NOTE: the vertices are read through the face's halfedges to avoid building a vertex list
+    const descriptor_array_view_t<hd_t> halfedges = m.get_halfedges_around_face(f);
+    fv_count = (int)halfedges.size();
     if (fv_count > 3) // non-triangle
     {
         for (int i = 0; i < (fv_count - 3); ++i) {
@@ -865,10 +881,10 @@ bool is_coplanar(const hmesh_t& m, const fd_t& f, int& fv_count)
             const int k = (i + 2) % fv_count;
             const int l = (i + 3) % fv_count;
 
-            const vd_t& vi = vertices[i];
-            const vd_t& vj = vertices[j];
-            const vd_t& vk = vertices[k];
-            const vd_t& vl = vertices[l];
+            const vd_t vi = m.target(halfedges[i]);
+            const vd_t vj = m.target(halfedges[j]);
+            const vd_t vk = m.target(halfedges[k]);
+            const vd_t vl = m.target(halfedges[l]);
 
             const vec3& vi_coords = m.vertex(vi);
             const vec3& vj_coords = m.vertex(vj);
@@ -912,7 +928,11 @@ bool check_input_mesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& m
     std::vector<int> fccmap;
     std::vector<int> cc_to_vertex_count;
     std::vector<int> cc_to_face_count;
-    int n = find_connected_components(fccmap, m, cc_to_vertex_count, cc_to_face_count);
+    int n = find_connected_components(
+#if defined(MCUT_MULTI_THREADED)
+        context_uptr->scheduler,
+#endif
+        fccmap, m, cc_to_vertex_count, cc_to_face_count);
 
     if (n != 1) {
         context_uptr->log(
@@ -1245,7 +1265,9 @@ void resolve_floating_polygons(
             // std::vector<vd_t> originFaceVertexDescriptors = parent_face_hmesh_ptr->get_vertices_around_face(origin_face);
             std::vector<vec3> origin_face_vertices_3d;
             // get information about each edge (used by "origin_face") that needs to be split along the respective intersection point
-            const std::vector<hd_t>& origin_face_halfedges = parent_face_hmesh_ptr->get_halfedges_around_face(origin_face);
+            // NOTE: copied because faces are added to "parent_face_hmesh_ptr" while this list is still in use
+            const descriptor_array_view_t<hd_t> origin_face_halfedges_view = parent_face_hmesh_ptr->get_halfedges_around_face(origin_face);
+            const std::vector<hd_t> origin_face_halfedges(origin_face_halfedges_view.cbegin(), origin_face_halfedges_view.cend());
 
             for (std::vector<hd_t>::const_iterator i = origin_face_halfedges.cbegin(); i != origin_face_halfedges.cend(); ++i) {
                 const vd_t src = parent_face_hmesh_ptr->source(*i); // NOTE: we use source so that edge iterators/indices match with internal mesh storage
@@ -1614,7 +1636,8 @@ void resolve_floating_polygons(
                 if (*it == origin_face) {
                     continue;
                 }
-                replacedOrigFaceNeighbourToOldHalfedges[*it] = parent_face_hmesh_ptr->get_halfedges_around_face(*it);
+                const descriptor_array_view_t<hd_t> halfedges = parent_face_hmesh_ptr->get_halfedges_around_face(*it);
+                replacedOrigFaceNeighbourToOldHalfedges[*it].assign(halfedges.cbegin(), halfedges.cend());
             }
 
             // :::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1663,7 +1686,6 @@ void resolve_floating_polygons(
                 for (std::vector<hd_t>::const_iterator j = oldHalfedges.cbegin(); j != oldHalfedges.cend(); ++j) {
 
                     const hd_t oldHalfedge = *j;
-                    hd_t newHalfedge = hmesh_t::null_halfedge();
                     const ed_t oldHalfedgeEdge = parent_face_hmesh_ptr->edge(oldHalfedge);
 
                     // is the halfedge part of an edge that is to be partitioned...?
@@ -1696,6 +1718,7 @@ void resolve_floating_polygons(
 
                 const fd_t fdescr = parent_face_hmesh_ptr->add_face(faceVertices);
                 MCUT_ASSERT(fdescr == i->first);
+                (void)fdescr;
 
 #if 0
                         std::unordered_map<fd_t, fd_t>::const_iterator fiter = child_to_client_birth_face.find(fdescr);
@@ -1803,6 +1826,304 @@ void resolve_floating_polygons(
     } // for (std::vector<floating_polygon_info_t>::const_iterator detected_floating_polygons_iter = kernel_output.detected_floating_polygons.cbegin(); ...
 }
 
+// Polygon partitioning removes the edges that it splits, which leaves holes in the arrays of "hmesh".
+// This packs the mesh again (so that the BVH build, the kernel and output conversion work on dense
+// arrays) and updates the partitioning maps that are keyed by its descriptors.
+void compact_partitioned_hmesh(
+    std::unique_ptr<context_t>& context_uptr,
+    hmesh_t& hmesh,
+    std::unordered_map<fd_t, fd_t>& child_to_usermesh_birth_face,
+    std::unordered_map<vd_t, vec3>& new_poly_partition_vertices)
+{
+    if (hmesh.number_of_vertices_removed() == 0 && hmesh.number_of_edges_removed() == 0 && //
+        hmesh.number_of_halfedges_removed() == 0 && hmesh.number_of_faces_removed() == 0) {
+        return;
+    }
+
+#if !defined(MCUT_MULTI_THREADED)
+    (void)context_uptr;
+#endif
+
+    hmesh_remap_t remap;
+
+    hmesh.compact(
+#if defined(MCUT_MULTI_THREADED)
+        context_uptr->scheduler,
+#endif
+        &remap);
+
+    std::unordered_map<fd_t, fd_t> child_to_usermesh_birth_face_remapped;
+
+    for (std::unordered_map<fd_t, fd_t>::const_iterator i = child_to_usermesh_birth_face.cbegin(); i != child_to_usermesh_birth_face.cend(); ++i) {
+        const fd_t f = SAFE_ACCESS(remap.faces, i->first);
+        MCUT_ASSERT(f != hmesh_t::null_face()); // child faces are never removed
+        child_to_usermesh_birth_face_remapped[f] = i->second;
+    }
+
+    child_to_usermesh_birth_face.swap(child_to_usermesh_birth_face_remapped);
+
+    std::unordered_map<vd_t, vec3> new_poly_partition_vertices_remapped;
+
+    for (std::unordered_map<vd_t, vec3>::const_iterator i = new_poly_partition_vertices.cbegin(); i != new_poly_partition_vertices.cend(); ++i) {
+        const vd_t v = SAFE_ACCESS(remap.vertices, i->first);
+        MCUT_ASSERT(v != hmesh_t::null_vertex());
+        new_poly_partition_vertices_remapped[v] = i->second;
+    }
+
+    new_poly_partition_vertices.swap(new_poly_partition_vertices_remapped);
+}
+
+// returns false if "m" intersects itself, in which case the intersecting faces are logged
+bool check_input_mesh_self_intersections(std::unique_ptr<context_t>& context_uptr, const hmesh_t& m)
+{
+    std::vector<std::pair<fd_t, fd_t>> intersecting_face_pairs;
+
+    find_self_intersecting_faces(
+#if defined(MCUT_MULTI_THREADED)
+        context_uptr->scheduler,
+#endif
+        m, intersecting_face_pairs);
+
+    if (intersecting_face_pairs.empty()) {
+        return true;
+    }
+
+    const int max_logged_pairs = 32;
+    const int num_logged_pairs = std::min((int)intersecting_face_pairs.size(), max_logged_pairs);
+
+    for (int i = 0; i < num_logged_pairs; ++i) {
+        context_uptr->log(
+            MC_DEBUG_SOURCE_API,
+            MC_DEBUG_TYPE_ERROR,
+            0,
+            MC_DEBUG_SEVERITY_HIGH,
+            "Detected self-intersecting faces (" + std::to_string(intersecting_face_pairs[i].first) + ", " + std::to_string(intersecting_face_pairs[i].second) + ")");
+    }
+
+    if ((int)intersecting_face_pairs.size() > num_logged_pairs) {
+        context_uptr->log(
+            MC_DEBUG_SOURCE_API,
+            MC_DEBUG_TYPE_ERROR,
+            0,
+            MC_DEBUG_SEVERITY_HIGH,
+            "Detected " + std::to_string(intersecting_face_pairs.size() - num_logged_pairs) + " more pairs of self-intersecting faces");
+    }
+
+    return false;
+}
+
+#if defined(USE_OIBVH)
+// make a view of the arrays of a BVH that was built with "build_oibvh"
+oibvh_view_t make_oibvh_view(
+    const std::vector<bounding_box_t<vec3>>& bvhAABBs,
+    const std::vector<fd_t>& bvhLeafNodeFaces,
+    const std::vector<bounding_box_t<vec3>>& face_bboxes)
+{
+    oibvh_view_t bvh;
+    bvh.bvhAABBs = array_view_t<bounding_box_t<vec3>>(bvhAABBs);
+    bvh.bvhLeafNodeFaces = array_view_t<fd_t>(bvhLeafNodeFaces);
+    bvh.face_bboxes = array_view_t<bounding_box_t<vec3>>(face_bboxes);
+    return bvh;
+}
+
+// build the BVH of the source mesh, or load it from the context's BVH cache directory
+// if a BVH for a mesh with the same content was saved there before. "bvh" is set to view
+// either the built arrays or the (memory-mapped) file.
+void build_or_load_source_hmesh_oibvh(
+    std::unique_ptr<context_t>& context_uptr,
+    const hmesh_t& source_hmesh,
+    std::vector<bounding_box_t<vec3>>& bvhAABBs,
+    std::vector<fd_t>& bvhLeafNodeFaces,
+    std::vector<bounding_box_t<vec3>>& face_bboxes,
+    oibvh_view_t& bvh)
+{
+    if (context_uptr->bvhCacheDirectory.empty()) {
+        build_oibvh(source_hmesh, bvhAABBs, bvhLeafNodeFaces, face_bboxes);
+        bvh = make_oibvh_view(bvhAABBs, bvhLeafNodeFaces, face_bboxes);
+        return;
+    }
+
+    const uint64_t mesh_content_hash = compute_mesh_content_hash(source_hmesh);
+    const uint32_t num_mesh_vertices = (uint32_t)source_hmesh.number_of_vertices();
+    const uint32_t num_mesh_faces = (uint32_t)source_hmesh.number_of_faces();
+
+    char hash_str[17];
+    std::snprintf(hash_str, sizeof(hash_str), "%016llx", (unsigned long long)mesh_content_hash);
+    const std::string fpath = context_uptr->bvhCacheDirectory + "/" + hash_str + ".oibvh";
+
+    if (load_oibvh(fpath, mesh_content_hash, num_mesh_vertices, num_mesh_faces, bvh)) {
+        context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Loaded source-mesh BVH from " + fpath);
+        return;
+    }
+
+    build_oibvh(source_hmesh, bvhAABBs, bvhLeafNodeFaces, face_bboxes);
+    bvh = make_oibvh_view(bvhAABBs, bvhLeafNodeFaces, face_bboxes);
+
+    if (save_oibvh(fpath, mesh_content_hash, num_mesh_vertices, num_mesh_faces, bvhAABBs, bvhLeafNodeFaces, face_bboxes)) {
+        context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Saved source-mesh BVH to " + fpath);
+    } else {
+        context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_LOW, "Failed to save source-mesh BVH to " + fpath);
+    }
+}
+
+// Broad phase: finds the pairs of polygons (one from each input mesh) whose bounding boxes overlap,
+// and which are then tested for intersection by the kernel (see McBroadPhase). The data of each mesh
+// is built separately since only a modified mesh is rebuilt after polygon partitioning.
+class broad_phase_t {
+public:
+    virtual ~broad_phase_t() { }
+
+    // build the data of the source-mesh. "first_build" is false when the source-mesh was modified
+    // by polygon partitioning
+    virtual void build_source_hmesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& source_hmesh, bool first_build) = 0;
+    // build the data of the cut-mesh, whose bounding boxes are enlarged by "slightEnlargmentEps" so that they
+    // remain valid after the cut-mesh is perturbed
+    virtual void build_cut_hmesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& cut_hmesh, const double& slightEnlargmentEps) = 0;
+    // the output has the same form as that of "intersectOIBVHs". If both meshes are given, then pairs of
+    // polygons that are separated by a plane are not reported
+    virtual void find_potentially_intersecting_polygons(
+        std::unique_ptr<context_t>& context_uptr,
+        std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
+        const hmesh_t* source_hmesh,
+        const hmesh_t* cut_hmesh) const = 0;
+
+    // the bounding boxes of the polygons of each mesh (used by the kernel)
+    virtual const array_view_t<bounding_box_t<vec3>>& source_hmesh_face_bboxes() const = 0;
+    virtual const array_view_t<bounding_box_t<vec3>>& cut_hmesh_face_bboxes() const = 0;
+};
+
+class oibvh_broad_phase_t : public broad_phase_t {
+public:
+    void build_source_hmesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& source_hmesh, bool first_build) override
+    {
+        m_source_hmesh_BVH_aabb_array.clear();
+        m_source_hmesh_BVH_leafdata_array.clear();
+
+        if (first_build) {
+            build_or_load_source_hmesh_oibvh(context_uptr, source_hmesh, m_source_hmesh_BVH_aabb_array, m_source_hmesh_BVH_leafdata_array, m_source_hmesh_face_aabb_array, m_source_hmesh_oibvh);
+        } else {
+            build_oibvh(source_hmesh, m_source_hmesh_BVH_aabb_array, m_source_hmesh_BVH_leafdata_array, m_source_hmesh_face_aabb_array);
+            // NOTE: this also releases the mapping of a cached BVH file (if any)
+            m_source_hmesh_oibvh = make_oibvh_view(m_source_hmesh_BVH_aabb_array, m_source_hmesh_BVH_leafdata_array, m_source_hmesh_face_aabb_array);
+        }
+    }
+
+    void build_cut_hmesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& cut_hmesh, const double& slightEnlargmentEps) override
+    {
+        (void)context_uptr;
+        m_cut_hmesh_BVH_aabb_array.clear();
+        m_cut_hmesh_BVH_leafdata_array.clear();
+        build_oibvh(cut_hmesh, m_cut_hmesh_BVH_aabb_array, m_cut_hmesh_BVH_leafdata_array, m_cut_hmesh_face_aabb_array, slightEnlargmentEps);
+        m_cut_hmesh_oibvh = make_oibvh_view(m_cut_hmesh_BVH_aabb_array, m_cut_hmesh_BVH_leafdata_array, m_cut_hmesh_face_aabb_array);
+    }
+
+    void find_potentially_intersecting_polygons(
+        std::unique_ptr<context_t>& context_uptr,
+        std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
+        const hmesh_t* source_hmesh,
+        const hmesh_t* cut_hmesh) const override
+    {
+        (void)context_uptr;
+        intersectOIBVHs(
+            ps_face_to_potentially_intersecting_others,
+            m_source_hmesh_oibvh.bvhAABBs,
+            m_source_hmesh_oibvh.bvhLeafNodeFaces,
+            m_cut_hmesh_oibvh.bvhAABBs,
+            m_cut_hmesh_oibvh.bvhLeafNodeFaces,
+            source_hmesh,
+            cut_hmesh);
+    }
+
+    const array_view_t<bounding_box_t<vec3>>& source_hmesh_face_bboxes() const override { return m_source_hmesh_oibvh.face_bboxes; }
+    const array_view_t<bounding_box_t<vec3>>& cut_hmesh_face_bboxes() const override { return m_cut_hmesh_oibvh.face_bboxes; }
+
+private:
+    std::vector<bounding_box_t<vec3>> m_source_hmesh_BVH_aabb_array;
+    std::vector<fd_t> m_source_hmesh_BVH_leafdata_array;
+    std::vector<bounding_box_t<vec3>> m_source_hmesh_face_aabb_array;
+    // the arrays that are used, which are either the ones above or those of a cached BVH file
+    oibvh_view_t m_source_hmesh_oibvh;
+
+    std::vector<bounding_box_t<vec3>> m_cut_hmesh_BVH_aabb_array;
+    std::vector<fd_t> m_cut_hmesh_BVH_leafdata_array;
+    std::vector<bounding_box_t<vec3>> m_cut_hmesh_face_aabb_array;
+    oibvh_view_t m_cut_hmesh_oibvh;
+};
+
+class uniform_grid_broad_phase_t : public broad_phase_t {
+public:
+    void build_source_hmesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& source_hmesh, bool first_build) override
+    {
+        (void)first_build; // the grid is built during traversal and is never cached
+        compute_face_bboxes(
+#if defined(MCUT_MULTI_THREADED)
+            context_uptr->scheduler,
+#endif
+            source_hmesh, m_source_hmesh_face_aabb_array);
+        m_source_hmesh_face_aabb_array_view = array_view_t<bounding_box_t<vec3>>(m_source_hmesh_face_aabb_array);
+#if !defined(MCUT_MULTI_THREADED)
+        (void)context_uptr;
+#endif
+    }
+
+    void build_cut_hmesh(std::unique_ptr<context_t>& context_uptr, const hmesh_t& cut_hmesh, const double& slightEnlargmentEps) override
+    {
+        compute_face_bboxes(
+#if defined(MCUT_MULTI_THREADED)
+            context_uptr->scheduler,
+#endif
+            cut_hmesh, m_cut_hmesh_face_aabb_array, slightEnlargmentEps);
+        m_cut_hmesh_face_aabb_array_view = array_view_t<bounding_box_t<vec3>>(m_cut_hmesh_face_aabb_array);
+#if !defined(MCUT_MULTI_THREADED)
+        (void)context_uptr;
+#endif
+    }
+
+    void find_potentially_intersecting_polygons(
+        std::unique_ptr<context_t>& context_uptr,
+        std::map<fd_t, std::vector<fd_t>>& ps_face_to_potentially_intersecting_others,
+        const hmesh_t* source_hmesh,
+        const hmesh_t* cut_hmesh) const override
+    {
+        intersect_uniform_grid(
+#if defined(MCUT_MULTI_THREADED)
+            context_uptr->scheduler,
+#endif
+            ps_face_to_potentially_intersecting_others,
+            m_source_hmesh_face_aabb_array,
+            m_cut_hmesh_face_aabb_array,
+            source_hmesh,
+            cut_hmesh);
+#if !defined(MCUT_MULTI_THREADED)
+        (void)context_uptr;
+#endif
+    }
+
+    const array_view_t<bounding_box_t<vec3>>& source_hmesh_face_bboxes() const override { return m_source_hmesh_face_aabb_array_view; }
+    const array_view_t<bounding_box_t<vec3>>& cut_hmesh_face_bboxes() const override { return m_cut_hmesh_face_aabb_array_view; }
+
+private:
+    std::vector<bounding_box_t<vec3>> m_source_hmesh_face_aabb_array;
+    array_view_t<bounding_box_t<vec3>> m_source_hmesh_face_aabb_array_view;
+    std::vector<bounding_box_t<vec3>> m_cut_hmesh_face_aabb_array;
+    array_view_t<bounding_box_t<vec3>> m_cut_hmesh_face_aabb_array_view;
+};
+
+// create the broad phase that is selected with "mcBindState(..., MC_CONTEXT_BROAD_PHASE, ...)"
+std::unique_ptr<broad_phase_t> make_broad_phase(std::unique_ptr<context_t>& context_uptr, const hmesh_t& source_hmesh)
+{
+    const bool use_uniform_grid = (context_uptr->broadPhase == McBroadPhase::MC_BROAD_PHASE_UNIFORM_GRID) || //
+        (context_uptr->broadPhase == McBroadPhase::MC_BROAD_PHASE_AUTO && prefer_uniform_grid(source_hmesh));
+
+    if (use_uniform_grid) {
+        context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Use uniform-grid broad phase");
+        return std::unique_ptr<broad_phase_t>(new uniform_grid_broad_phase_t);
+    }
+
+    return std::unique_ptr<broad_phase_t>(new oibvh_broad_phase_t);
+}
+#endif
+
 extern "C" void preproc(
     std::unique_ptr<context_t>& context_uptr,
     const void* pSrcMeshVertices,
@@ -1827,11 +2148,22 @@ extern "C" void preproc(
         throw std::invalid_argument("invalid source-mesh connectivity");
     }
 
+    const bool check_self_intersections = (0 != (context_uptr->dispatchFlags & MC_DISPATCH_CHECK_SELF_INTERSECTIONS));
+
+    if (check_self_intersections) {
+        context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Check source-mesh for self-intersections");
+
+        if (false == check_input_mesh_self_intersections(context_uptr, source_hmesh)) {
+            throw std::invalid_argument("self-intersecting source-mesh");
+        }
+    }
+
     input_t kernel_input; // kernel/backend inpout
 
 #if defined(MCUT_MULTI_THREADED)
     kernel_input.scheduler = &context_uptr->scheduler;
 #endif
+    kernel_input.arena = &context_uptr->dispatch_arena;
 
     kernel_input.src_mesh = &source_hmesh;
 
@@ -1884,6 +2216,7 @@ extern "C" void preproc(
     }
 
     kernel_input.enforce_general_position = (0 != (context_uptr->dispatchFlags & MC_DISPATCH_ENFORCE_GENERAL_POSITION));
+    kernel_input.deterministic = (0 != (context_uptr->dispatchFlags & MC_DISPATCH_DETERMINISTIC));
 
     // Construct BVHs
     // ::::::::::::::
@@ -1891,13 +2224,15 @@ extern "C" void preproc(
     context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Build source-mesh BVH");
 
 #if defined(USE_OIBVH)
-    std::vector<bounding_box_t<vec3>> source_hmesh_BVH_aabb_array;
-    std::vector<fd_t> source_hmesh_BVH_leafdata_array;
-    std::vector<bounding_box_t<vec3>> source_hmesh_face_aabb_array;
-    build_oibvh(source_hmesh, source_hmesh_BVH_aabb_array, source_hmesh_BVH_leafdata_array, source_hmesh_face_aabb_array);
+    std::unique_ptr<broad_phase_t> broad_phase = make_broad_phase(context_uptr, source_hmesh);
+    broad_phase->build_source_hmesh(context_uptr, source_hmesh, true);
 #else
     BoundingVolumeHierarchy source_hmesh_BVH;
-    source_hmesh_BVH.buildTree(source_hmesh);
+    source_hmesh_BVH.buildTree(
+#if defined(MCUT_MULTI_THREADED)
+        context_uptr->scheduler,
+#endif
+        source_hmesh);
 #endif
     context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Build cut-mesh BVH");
 
@@ -1944,16 +2279,16 @@ extern "C" void preproc(
     hmesh_t cut_hmesh; // halfedge representation of the cut-mesh
     double cut_hmesh_aabb_diag(0.0);
 
-#if defined(USE_OIBVH)
-    std::vector<bounding_box_t<vec3>> cut_hmesh_BVH_aabb_array;
-    std::vector<fd_t> cut_hmesh_BVH_leafdata_array;
-    std::vector<bounding_box_t<vec3>> cut_hmesh_face_face_aabb_array;
-#else
+#if !defined(USE_OIBVH)
     BoundingVolumeHierarchy cut_hmesh_BVH; // built later (see below)
 #endif
 
     bool source_or_cut_hmesh_BVH_rebuilt = true; // i.e. used to determine whether we should retraverse BVHs
 
+    // NOTE: culled polygon pairs depend on the exact vertex coordinates, so the BVHs are retraversed after each
+    // perturbation of the cut-mesh (the cut-mesh BVH itself is built with enough slack to remain valid)
+    const bool cull_separated_polygons = (0 != (context_uptr->dispatchFlags & MC_DISPATCH_CULL_SEPARATED_POLYGONS));
+
     std::map<fd_t, std::vector<fd_t>> ps_face_to_potentially_intersecting_others; // result of BVH traversal
 
 #if defined(MCUT_MULTI_THREADED)
@@ -1979,6 +2314,13 @@ extern "C" void preproc(
     // If general position is violated, then we apply numerical perturbation of the cut-mesh.
     // And if floating polygons arise, then we partition the suspected face into two new faces with an edge that is guaranteed to be
     // severed during the cut.
+
+    // Generator of the perturbations that are used when deterministic output is requested. It is restarted
+    // on every dispatch call (unlike the thread-local generator used otherwise) so that the perturbations do
+    // not depend on earlier dispatch calls, and its output is mapped to [-1, 1] explicitly because the values
+    // of std::uniform_real_distribution differ between standard library implementations.
+    std::mt19937 deterministic_perturbation_generator(1);
+
     do {
         kernel_invocation_counter++;
 
@@ -2021,12 +2363,19 @@ extern "C" void preproc(
 
             MCUT_ASSERT(numerical_perturbation_constant != double(0.0));
 
-            static thread_local std::default_random_engine random_engine(1);
-            static thread_local std::mt19937 mersenne_twister_generator(random_engine());
-            static thread_local std::uniform_real_distribution<double> uniform_distribution(-1.0, 1.0);
+            if (kernel_input.deterministic) {
+                for (int i = 0; i < 3; ++i) {
+                    const double r = (double)deterministic_perturbation_generator() / (double)std::mt19937::max(); // [0, 1]
+                    perturbation[i] = (r * 2.0 - 1.0) * numerical_perturbation_constant;
+                }
+            } else {
+                static thread_local std::default_random_engine random_engine(1);
+                static thread_local std::mt19937 mersenne_twister_generator(random_engine());
+                static thread_local std::uniform_real_distribution<double> uniform_distribution(-1.0, 1.0);
 
-            for (int i = 0; i < 3; ++i) {
-                perturbation[i] = uniform_distribution(mersenne_twister_generator) * numerical_perturbation_constant;
+                for (int i = 0; i < 3; ++i) {
+                    perturbation[i] = uniform_distribution(mersenne_twister_generator) * numerical_perturbation_constant;
+                }
             }
 
             cut_mesh_perturbation_count++;
@@ -2048,17 +2397,31 @@ extern "C" void preproc(
                 throw std::invalid_argument("invalid cut-mesh arrays");
             }
 
+            if (check_self_intersections && cut_mesh_perturbation_count == 0) {
+                context_uptr->log(MC_DEBUG_SOURCE_API, MC_DEBUG_TYPE_OTHER, 0, MC_DEBUG_SEVERITY_NOTIFICATION, "Check cut-mesh for self-intersections");
+
+                if (false == check_input_mesh_self_intersections(context_uptr, cut_hmesh)) {
+                    throw std::invalid_argument("self-intersecting cut-mesh");
+                }
+            }
+
             numerical_perturbation_constant = cut_hmesh_aabb_diag * GENERAL_POSITION_ENFORCMENT_CONSTANT;
 
             kernel_input.cut_mesh = &cut_hmesh;
 
+            if (cull_separated_polygons && cut_mesh_perturbation_count > 0) {
+                source_or_cut_hmesh_BVH_rebuilt = true;
+            }
+
             if (cut_mesh_perturbation_count == 0) { // i.e. first time we are invoking kernel intersect function
 #if defined(USE_OIBVH)
-                cut_hmesh_BVH_aabb_array.clear();
-                cut_hmesh_BVH_leafdata_array.clear();
-                build_oibvh(cut_hmesh, cut_hmesh_BVH_aabb_array, cut_hmesh_BVH_leafdata_array, cut_hmesh_face_face_aabb_array, numerical_perturbation_constant);
+                broad_phase->build_cut_hmesh(context_uptr, cut_hmesh, numerical_perturbation_constant);
 #else
-                cut_hmesh_BVH.buildTree(cut_hmesh, numerical_perturbation_constant);
+                cut_hmesh_BVH.buildTree(
+#if defined(MCUT_MULTI_THREADED)
+                    context_uptr->scheduler,
+#endif
+                    cut_hmesh, numerical_perturbation_constant);
 #endif
                 source_or_cut_hmesh_BVH_rebuilt = true;
             }
@@ -2086,35 +2449,38 @@ extern "C" void preproc(
                 source_hmesh_new_poly_partition_vertices.get()[0],
                 cut_hmesh_new_poly_partition_vertices);
 
+            if (source_hmesh_modified) {
+                compact_partitioned_hmesh(context_uptr, source_hmesh, source_hmesh_child_to_usermesh_birth_face.get()[0], source_hmesh_new_poly_partition_vertices.get()[0]);
+            }
+
+            if (cut_hmesh_modified) {
+                compact_partitioned_hmesh(context_uptr, cut_hmesh, cut_hmesh_child_to_usermesh_birth_face, cut_hmesh_new_poly_partition_vertices);
+            }
+
             // ::::::::::::::::::::::::::::::::::::::::::::
             // rebuild the BVH of "parent_face_hmesh_ptr" again
 
             if (source_hmesh_modified) {
 #if defined(USE_OIBVH)
-                source_hmesh_BVH_aabb_array.clear();
-                source_hmesh_BVH_leafdata_array.clear();
-                build_oibvh(
-                    source_hmesh,
-                    source_hmesh_BVH_aabb_array,
-                    source_hmesh_BVH_leafdata_array,
-                    source_hmesh_face_aabb_array);
+                broad_phase->build_source_hmesh(context_uptr, source_hmesh, false);
 #else
-                source_hmesh_BVH.buildTree(source_hmesh);
+                source_hmesh_BVH.buildTree(
+#if defined(MCUT_MULTI_THREADED)
+                    context_uptr->scheduler,
+#endif
+                    source_hmesh);
 #endif
             }
 
             if (cut_hmesh_modified) {
 #if defined(USE_OIBVH)
-                cut_hmesh_BVH_aabb_array.clear();
-                cut_hmesh_BVH_leafdata_array.clear();
-                build_oibvh(
-                    cut_hmesh,
-                    cut_hmesh_BVH_aabb_array,
-                    cut_hmesh_BVH_leafdata_array,
-                    cut_hmesh_face_face_aabb_array,
-                    numerical_perturbation_constant);
+                broad_phase->build_cut_hmesh(context_uptr, cut_hmesh, numerical_perturbation_constant);
 #else
-                cut_hmesh_BVH.buildTree(cut_hmesh, numerical_perturbation_constant);
+                cut_hmesh_BVH.buildTree(
+#if defined(MCUT_MULTI_THREADED)
+                    context_uptr->scheduler,
+#endif
+                    cut_hmesh, numerical_perturbation_constant);
 #endif
             }
 
@@ -2151,7 +2517,11 @@ extern "C" void preproc(
 
             ps_face_to_potentially_intersecting_others.clear();
 #if defined(USE_OIBVH)
-            intersectOIBVHs(ps_face_to_potentially_intersecting_others, source_hmesh_BVH_aabb_array, source_hmesh_BVH_leafdata_array, cut_hmesh_BVH_aabb_array, cut_hmesh_BVH_leafdata_array);
+            broad_phase->find_potentially_intersecting_polygons(
+                context_uptr,
+                ps_face_to_potentially_intersecting_others,
+                cull_separated_polygons ? &source_hmesh : nullptr,
+                cull_separated_polygons ? &cut_hmesh : nullptr);
 #else
             BoundingVolumeHierarchy::intersectBVHTrees(
 #if defined(MCUT_MULTI_THREADED)
@@ -2161,7 +2531,8 @@ extern "C" void preproc(
                 source_hmesh_BVH,
                 cut_hmesh_BVH,
                 0,
-                source_hmesh.number_of_faces());
+                source_hmesh.number_of_faces(),
+                cull_separated_polygons);
 
 #endif
 
@@ -2192,8 +2563,8 @@ extern "C" void preproc(
         kernel_input.ps_face_to_potentially_intersecting_others = &ps_face_to_potentially_intersecting_others;
 
 #if defined(USE_OIBVH)
-        kernel_input.source_hmesh_face_aabb_array_ptr = &source_hmesh_face_aabb_array;
-        kernel_input.cut_hmesh_face_aabb_array_ptr = &cut_hmesh_face_face_aabb_array;
+        kernel_input.source_hmesh_face_aabb_array_ptr = &broad_phase->source_hmesh_face_bboxes();
+        kernel_input.cut_hmesh_face_aabb_array_ptr = &broad_phase->cut_hmesh_face_bboxes();
 #else
         kernel_input.source_hmesh_BVH = &source_hmesh_BVH;
         kernel_input.cut_hmesh_BVH = &cut_hmesh_BVH;
@@ -2279,6 +2650,7 @@ extern "C" void preproc(
 
                 std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> frag = std::unique_ptr<fragment_cc_t, void (*)(connected_component_t*)>(new fragment_cc_t, fn_delete_cc<fragment_cc_t>);
                 McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(frag.get());
+                frag->creation_index = context_uptr->connected_component_creation_count++;
                 context_uptr->connected_components.emplace(clientHandle, std::move(frag));
                 fragment_cc_t* asFragPtr = dynamic_cast<fragment_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
                 asFragPtr->type = MC_CONNECTED_COMPONENT_TYPE_FRAGMENT;
@@ -2333,6 +2705,7 @@ extern "C" void preproc(
 
             std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> unsealedFrag = std::unique_ptr<fragment_cc_t, void (*)(connected_component_t*)>(new fragment_cc_t, fn_delete_cc<fragment_cc_t>);
             McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(unsealedFrag.get());
+            unsealedFrag->creation_index = context_uptr->connected_component_creation_count++;
             context_uptr->connected_components.emplace(clientHandle, std::move(unsealedFrag));
             fragment_cc_t* asFragPtr = dynamic_cast<fragment_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
             asFragPtr->type = MC_CONNECTED_COMPONENT_TYPE_FRAGMENT;
@@ -2384,6 +2757,7 @@ extern "C" void preproc(
 
         std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> patchConnComp = std::unique_ptr<patch_cc_t, void (*)(connected_component_t*)>(new patch_cc_t, fn_delete_cc<patch_cc_t>);
         McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(patchConnComp.get());
+        patchConnComp->creation_index = context_uptr->connected_component_creation_count++;
         context_uptr->connected_components.emplace(clientHandle, std::move(patchConnComp));
         patch_cc_t* asPatchPtr = dynamic_cast<patch_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
         asPatchPtr->type = MC_CONNECTED_COMPONENT_TYPE_PATCH;
@@ -2428,6 +2802,7 @@ extern "C" void preproc(
 
         std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> patchConnComp = std::unique_ptr<patch_cc_t, void (*)(connected_component_t*)>(new patch_cc_t, fn_delete_cc<patch_cc_t>);
         McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(patchConnComp.get());
+        patchConnComp->creation_index = context_uptr->connected_component_creation_count++;
         context_uptr->connected_components.emplace(clientHandle, std::move(patchConnComp));
         patch_cc_t* asPatchPtr = dynamic_cast<patch_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
         asPatchPtr->type = MC_CONNECTED_COMPONENT_TYPE_PATCH;
@@ -2469,6 +2844,7 @@ extern "C" void preproc(
         TIMESTACK_PUSH("store source-mesh seam");
         std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> srcMeshSeam = std::unique_ptr<seam_cc_t, void (*)(connected_component_t*)>(new seam_cc_t, fn_delete_cc<seam_cc_t>);
         McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(srcMeshSeam.get());
+        srcMeshSeam->creation_index = context_uptr->connected_component_creation_count++;
         context_uptr->connected_components.emplace(clientHandle, std::move(srcMeshSeam));
         seam_cc_t* asSrcMeshSeamPtr = dynamic_cast<seam_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
         asSrcMeshSeamPtr->type = MC_CONNECTED_COMPONENT_TYPE_SEAM;
@@ -2504,6 +2880,7 @@ extern "C" void preproc(
 
         std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> cutMeshSeam = std::unique_ptr<seam_cc_t, void (*)(connected_component_t*)>(new seam_cc_t, fn_delete_cc<seam_cc_t>);
         McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(cutMeshSeam.get());
+        cutMeshSeam->creation_index = context_uptr->connected_component_creation_count++;
         context_uptr->connected_components.emplace(clientHandle, std::move(cutMeshSeam));
         seam_cc_t* asCutMeshSeamPtr = dynamic_cast<seam_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
         asCutMeshSeamPtr->type = MC_CONNECTED_COMPONENT_TYPE_SEAM;
@@ -2540,6 +2917,7 @@ extern "C" void preproc(
         TIMESTACK_PUSH("store original cut-mesh");
         std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> internalCutMesh = std::unique_ptr<input_cc_t, void (*)(connected_component_t*)>(new input_cc_t, fn_delete_cc<input_cc_t>);
         McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(internalCutMesh.get());
+        internalCutMesh->creation_index = context_uptr->connected_component_creation_count++;
         context_uptr->connected_components.emplace(clientHandle, std::move(internalCutMesh));
         input_cc_t* asCutMeshInputPtr = dynamic_cast<input_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
         asCutMeshInputPtr->type = MC_CONNECTED_COMPONENT_TYPE_INPUT;
@@ -2600,6 +2978,7 @@ extern "C" void preproc(
         TIMESTACK_PUSH("store original src-mesh");
         std::unique_ptr<connected_component_t, void (*)(connected_component_t*)> internalSrcMesh = std::unique_ptr<input_cc_t, void (*)(connected_component_t*)>(new input_cc_t, fn_delete_cc<input_cc_t>);
         McConnectedComponent clientHandle = reinterpret_cast<McConnectedComponent>(internalSrcMesh.get());
+        internalSrcMesh->creation_index = context_uptr->connected_component_creation_count++;
         context_uptr->connected_components.emplace(clientHandle, std::move(internalSrcMesh));
         input_cc_t* asSrcMeshInputPtr = dynamic_cast<input_cc_t*>(context_uptr->connected_components.at(clientHandle).get());
         asSrcMeshInputPtr->type = MC_CONNECTED_COMPONENT_TYPE_INPUT;
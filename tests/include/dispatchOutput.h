@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ * 
+ * NOTE: This file is licensed under GPL-3.0-or-later (default). 
+ * A commercial license can be purchased from Floyd M. Chitalu. 
+ *  
+ * License details:
+ * 
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have 
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ * 
+ * The commercial license options is for users that wish to use MCUT in 
+ * their products for comercial purposes but do not wish to release their 
+ * software products under the GPL license. 
+ * 
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#ifndef DISPATCH_OUTPUT_H_
+#define DISPATCH_OUTPUT_H_
+
+#include <mcut/mcut.h>
+
+#include <string>
+#include <vector>
+
+// number of pairs of input meshes in "MESHES_DIR/benchmarks"
+#define NUMBER_OF_BENCHMARKS 61 //
+
+// path to the source-mesh ("src") or cut-mesh ("cut") of the given benchmark
+std::string getBenchmarkMeshPath(int benchmarkIndex, const std::string& meshType);
+
+// the vertices and faces of each connected component in the order that they are reported
+struct dispatch_output_t {
+    std::vector<std::vector<double>> vertices;
+    std::vector<std::vector<uint32_t>> faceIndices;
+    std::vector<std::vector<uint32_t>> faceSizes;
+};
+
+// cut the given meshes and return the vertices and faces of the connected components
+McResult dispatchAndGetOutput(McContext context, McFlags flags, const std::string& srcMeshPath, const std::string& cutMeshPath, dispatch_output_t& output);
+
+// whether the two outputs have the same connected components, in the same order, with exactly the same
+// vertices, face indices and face sizes
+bool isSameDispatchOutput(const dispatch_output_t& a, const dispatch_output_t& b);
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ * 
+ * NOTE: This file is licensed under GPL-3.0-or-later (default). 
+ * A commercial license can be purchased from Floyd M. Chitalu. 
+ *  
+ * License details:
+ * 
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have 
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ * 
+ * The commercial license options is for users that wish to use MCUT in 
+ * their products for comercial purposes but do not wish to release their 
+ * software products under the GPL license. 
+ * 
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#include "utest.h"
+#include <mcut/mcut.h>
+
+#include <string>
+
+#include "dispatchOutput.h"
+
+struct BroadPhase {
+    McContext myContext = MC_NULL_HANDLE;
+};
+
+UTEST_F_SETUP(BroadPhase)
+{
+    EXPECT_EQ(mcCreateContext(&utest_fixture->myContext, MC_NULL_HANDLE), MC_NO_ERROR);
+    EXPECT_TRUE(utest_fixture->myContext != nullptr);
+}
+
+UTEST_F_TEARDOWN(BroadPhase)
+{
+    EXPECT_EQ(mcReleaseContext(utest_fixture->myContext), MC_NO_ERROR);
+}
+
+UTEST_F(BroadPhase, queryDefault)
+{
+    uint64_t numBytes = 0;
+    ASSERT_EQ(mcGetInfo(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, 0, NULL, &numBytes), MC_NO_ERROR);
+    ASSERT_EQ(numBytes, sizeof(McBroadPhase));
+
+    McBroadPhase broadPhase = MC_BROAD_PHASE_MAX_ENUM;
+    ASSERT_EQ(mcGetInfo(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, numBytes, &broadPhase, NULL), MC_NO_ERROR);
+    ASSERT_EQ(broadPhase, MC_BROAD_PHASE_BVH);
+}
+
+UTEST_F(BroadPhase, bindAndQuery)
+{
+    const McBroadPhase broadPhaseIn = MC_BROAD_PHASE_UNIFORM_GRID;
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, sizeof(McBroadPhase), &broadPhaseIn), MC_NO_ERROR);
+
+    McBroadPhase broadPhaseOut = MC_BROAD_PHASE_MAX_ENUM;
+    ASSERT_EQ(mcGetInfo(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, sizeof(McBroadPhase), &broadPhaseOut, NULL), MC_NO_ERROR);
+    ASSERT_EQ(broadPhaseOut, MC_BROAD_PHASE_UNIFORM_GRID);
+}
+
+UTEST_F(BroadPhase, invalidValue)
+{
+    const McBroadPhase broadPhase = MC_BROAD_PHASE_MAX_ENUM;
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, sizeof(McBroadPhase), &broadPhase), MC_INVALID_VALUE);
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, sizeof(uint8_t), &broadPhase), MC_INVALID_VALUE);
+}
+
+// the broad phase only determines which polygon pairs are tested for intersection, and must not change the result of a cut.
+// Deterministic output is requested so that the connected components of both dispatches can be compared exactly.
+UTEST_F(BroadPhase, uniformGridSameResultAsBVH)
+{
+    const McFlags flags = MC_DISPATCH_DETERMINISTIC | MC_DISPATCH_ENFORCE_GENERAL_POSITION;
+    const McBroadPhase broadPhases[2] = { MC_BROAD_PHASE_BVH, MC_BROAD_PHASE_UNIFORM_GRID };
+
+    for (int i = 0; i < NUMBER_OF_BENCHMARKS; ++i) {
+        const std::string srcMeshPath = getBenchmarkMeshPath(i, "src");
+        const std::string cutMeshPath = getBenchmarkMeshPath(i, "cut");
+
+        McResult results[2] = { MC_NO_ERROR, MC_NO_ERROR };
+        dispatch_output_t output[2];
+
+        for (int j = 0; j < 2; ++j) {
+            ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BROAD_PHASE, sizeof(McBroadPhase), &broadPhases[j]), MC_NO_ERROR);
+            results[j] = dispatchAndGetOutput(utest_fixture->myContext, flags, srcMeshPath, cutMeshPath, output[j]);
+        }
+
+        EXPECT_EQ(results[0], results[1]);
+        EXPECT_TRUE(isSameDispatchOutput(output[0], output[1]));
+    }
+}
@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ * 
+ * NOTE: This file is licensed under GPL-3.0-or-later (default). 
+ * A commercial license can be purchased from Floyd M. Chitalu. 
+ *  
+ * License details:
+ * 
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have 
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ * 
+ * The commercial license options is for users that wish to use MCUT in 
+ * their products for comercial purposes but do not wish to release their 
+ * software products under the GPL license. 
+ * 
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#include "utest.h"
+#include <mcut/mcut.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "dispatchOutput.h"
+
+struct BVHCache {
+    McContext myContext = MC_NULL_HANDLE;
+    // the (fresh) directory in which the BVH files of the test are saved
+    std::string cacheDir;
+    // the files that the context reported to have saved or loaded since the last call to "clearLog"
+    std::vector<std::string> savedFiles;
+    std::vector<std::string> loadedFiles;
+    // every file that was saved during the test
+    std::vector<std::string> allSavedFiles;
+};
+
+static void MCAPI_PTR bvhCacheMessageCallback(McDebugSource /*source*/,
+    McDebugType /*type*/,
+    unsigned int /*id*/,
+    McDebugSeverity /*severity*/,
+    size_t /*length*/,
+    const char* message,
+    const void* userParam)
+{
+    const std::string msg(message);
+    const std::string savedPrefix = "Saved source-mesh BVH to ";
+    const std::string loadedPrefix = "Loaded source-mesh BVH from ";
+    BVHCache* fixture = (BVHCache*)userParam;
+
+    if (msg.compare(0, savedPrefix.size(), savedPrefix) == 0) {
+        fixture->savedFiles.push_back(msg.substr(savedPrefix.size()));
+        fixture->allSavedFiles.push_back(fixture->savedFiles.back());
+    } else if (msg.compare(0, loadedPrefix.size(), loadedPrefix) == 0) {
+        fixture->loadedFiles.push_back(msg.substr(loadedPrefix.size()));
+    }
+}
+
+static void clearLog(BVHCache* fixture)
+{
+    fixture->savedFiles.clear();
+    fixture->loadedFiles.clear();
+}
+
+// create a new empty directory, and return its path (or an empty string on failure)
+static std::string makeTempDirectory()
+{
+#if defined(_WIN32)
+    char path[L_tmpnam];
+    if (tmpnam(path) == nullptr || _mkdir(path) != 0) {
+        return "";
+    }
+    return path;
+#else
+    const char* tmpDir = getenv("TMPDIR");
+    std::string pathTemplate = std::string(tmpDir != nullptr ? tmpDir : "/tmp") + "/mcut-bvh-cache-XXXXXX";
+    std::vector<char> path(pathTemplate.begin(), pathTemplate.end());
+    path.push_back('\0');
+    return mkdtemp(path.data()) != nullptr ? std::string(path.data()) : "";
+#endif
+}
+
+static bool fileExists(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file != nullptr) {
+        fclose(file);
+    }
+    return file != nullptr;
+}
+
+static bool copyFile(const std::string& from, const std::string& to)
+{
+    FILE* in = fopen(from.c_str(), "rb");
+    FILE* out = fopen(to.c_str(), "wb");
+    bool ok = in != nullptr && out != nullptr;
+    char buffer[4096];
+    size_t n = 0;
+    while (ok && (n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        ok = fwrite(buffer, 1, n, out) == n;
+    }
+    if (in != nullptr) {
+        fclose(in);
+    }
+    if (out != nullptr) {
+        ok = fclose(out) == 0 && ok;
+    }
+    return ok;
+}
+
+UTEST_F_SETUP(BVHCache)
+{
+    EXPECT_EQ(mcCreateContext(&utest_fixture->myContext, MC_NULL_HANDLE), MC_NO_ERROR);
+    EXPECT_TRUE(utest_fixture->myContext != nullptr);
+    EXPECT_EQ(mcDebugMessageCallback(utest_fixture->myContext, bvhCacheMessageCallback, utest_fixture), MC_NO_ERROR);
+    EXPECT_EQ(mcDebugMessageControl(utest_fixture->myContext, MC_DEBUG_SOURCE_ALL, MC_DEBUG_TYPE_ALL, MC_DEBUG_SEVERITY_ALL, true), MC_NO_ERROR);
+
+    utest_fixture->cacheDir = makeTempDirectory();
+    ASSERT_TRUE(!utest_fixture->cacheDir.empty());
+}
+
+UTEST_F_TEARDOWN(BVHCache)
+{
+    EXPECT_EQ(mcReleaseContext(utest_fixture->myContext), MC_NO_ERROR);
+
+    for (size_t i = 0; i < utest_fixture->allSavedFiles.size(); ++i) {
+        remove(utest_fixture->allSavedFiles[i].c_str()); // a file may be saved more than once
+    }
+
+    if (!utest_fixture->cacheDir.empty()) {
+#if defined(_WIN32)
+        EXPECT_EQ(_rmdir(utest_fixture->cacheDir.c_str()), 0);
+#else
+        EXPECT_EQ(rmdir(utest_fixture->cacheDir.c_str()), 0);
+#endif
+    }
+}
+
+UTEST_F(BVHCache, queryCacheDirectory)
+{
+    const std::string& cacheDir = utest_fixture->cacheDir;
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, cacheDir.size(), cacheDir.c_str()), MC_NO_ERROR);
+
+    uint64_t numBytes = 0;
+    ASSERT_EQ(mcGetInfo(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, 0, nullptr, &numBytes), MC_NO_ERROR);
+    ASSERT_EQ(numBytes, (uint64_t)cacheDir.size() + 1);
+
+    std::vector<char> queriedDir(numBytes);
+    ASSERT_EQ(mcGetInfo(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, numBytes, queriedDir.data(), nullptr), MC_NO_ERROR);
+    ASSERT_TRUE(cacheDir == std::string(queriedDir.data()));
+
+    // disable
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, 0, nullptr), MC_NO_ERROR);
+    ASSERT_EQ(mcGetInfo(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, 0, nullptr, &numBytes), MC_NO_ERROR);
+    ASSERT_EQ(numBytes, (uint64_t)1);
+}
+
+UTEST_F(BVHCache, invalidStateFlag)
+{
+    McFlags flags = 0;
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_FLAGS, sizeof(McFlags), &flags), MC_INVALID_VALUE);
+}
+
+// The classic BVH is not cached, so the following tests apply only to the Oi-BVH
+#if !defined(MCUT_USE_CLASSIC_BVH)
+
+static const McFlags bvhCacheDispatchFlags = MC_DISPATCH_DETERMINISTIC | MC_DISPATCH_ENFORCE_GENERAL_POSITION;
+
+// The first dispatch builds and saves the source-mesh BVH, and the second one loads it.
+// Both must produce the same output.
+UTEST_F(BVHCache, reuseCachedBVH)
+{
+    const std::string& cacheDir = utest_fixture->cacheDir;
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, cacheDir.size(), cacheDir.c_str()), MC_NO_ERROR);
+
+    const std::string srcMeshPath = getBenchmarkMeshPath(10, "src");
+    const std::string cutMeshPath = getBenchmarkMeshPath(10, "cut");
+    std::vector<dispatch_output_t> output(2);
+
+    ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, bvhCacheDispatchFlags, srcMeshPath, cutMeshPath, output[0]), MC_NO_ERROR);
+    ASSERT_EQ(utest_fixture->loadedFiles.size(), (size_t)0);
+    ASSERT_EQ(utest_fixture->savedFiles.size(), (size_t)1);
+    const std::string savedFile = utest_fixture->savedFiles[0];
+    ASSERT_EQ(savedFile.compare(0, cacheDir.size(), cacheDir), 0);
+    ASSERT_TRUE(fileExists(savedFile));
+
+    clearLog(utest_fixture);
+
+    ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, bvhCacheDispatchFlags, srcMeshPath, cutMeshPath, output[1]), MC_NO_ERROR);
+    ASSERT_EQ(utest_fixture->savedFiles.size(), (size_t)0);
+    ASSERT_EQ(utest_fixture->loadedFiles.size(), (size_t)1);
+    ASSERT_TRUE(utest_fixture->loadedFiles[0] == savedFile);
+
+    EXPECT_TRUE(isSameDispatchOutput(output[0], output[1]));
+}
+
+// A file that holds the BVH of another mesh (here: saved under the name of the
+// expected file) must not be loaded. The BVH is rebuilt and the file is replaced.
+UTEST_F(BVHCache, rejectMismatchedCachedBVH)
+{
+    const std::string& cacheDir = utest_fixture->cacheDir;
+    ASSERT_EQ(mcBindState(utest_fixture->myContext, MC_CONTEXT_BVH_CACHE_DIRECTORY, cacheDir.size(), cacheDir.c_str()), MC_NO_ERROR);
+
+    dispatch_output_t otherOutput;
+
+    // the source mesh of benchmark 12 differs from that of benchmark 10
+    ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, bvhCacheDispatchFlags, getBenchmarkMeshPath(12, "src"), getBenchmarkMeshPath(12, "cut"), otherOutput), MC_NO_ERROR);
+    ASSERT_EQ(utest_fixture->savedFiles.size(), (size_t)1);
+    const std::string otherFile = utest_fixture->savedFiles[0];
+
+    clearLog(utest_fixture);
+
+    const std::string srcMeshPath = getBenchmarkMeshPath(10, "src");
+    const std::string cutMeshPath = getBenchmarkMeshPath(10, "cut");
+    std::vector<dispatch_output_t> output(2);
+
+    ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, bvhCacheDispatchFlags, srcMeshPath, cutMeshPath, output[0]), MC_NO_ERROR);
+    ASSERT_EQ(utest_fixture->savedFiles.size(), (size_t)1);
+    const std::string savedFile = utest_fixture->savedFiles[0];
+    ASSERT_TRUE(savedFile != otherFile);
+
+    ASSERT_TRUE(copyFile(otherFile, savedFile));
+
+    clearLog(utest_fixture);
+
+    ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, bvhCacheDispatchFlags, srcMeshPath, cutMeshPath, output[1]), MC_NO_ERROR);
+    ASSERT_EQ(utest_fixture->loadedFiles.size(), (size_t)0);
+    ASSERT_EQ(utest_fixture->savedFiles.size(), (size_t)1);
+    ASSERT_TRUE(utest_fixture->savedFiles[0] == savedFile);
+
+    EXPECT_TRUE(isSameDispatchOutput(output[0], output[1]));
+
+    clearLog(utest_fixture);
+
+    // the replaced file is loaded again
+    ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, bvhCacheDispatchFlags, srcMeshPath, cutMeshPath, output[1]), MC_NO_ERROR);
+    ASSERT_EQ(utest_fixture->loadedFiles.size(), (size_t)1);
+    EXPECT_TRUE(isSameDispatchOutput(output[0], output[1]));
+}
+
+#endif // #if !defined(MCUT_USE_CLASSIC_BVH)
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ * 
+ * NOTE: This file is licensed under GPL-3.0-or-later (default). 
+ * A commercial license can be purchased from Floyd M. Chitalu. 
+ *  
+ * License details:
+ * 
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have 
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ * 
+ * The commercial license options is for users that wish to use MCUT in 
+ * their products for comercial purposes but do not wish to release their 
+ * software products under the GPL license. 
+ * 
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#include "utest.h"
+#include <mcut/mcut.h>
+
+#include <string>
+
+#include "dispatchOutput.h"
+
+struct DeterministicDispatch {
+    McContext myContext = MC_NULL_HANDLE;
+};
+
+UTEST_F_SETUP(DeterministicDispatch)
+{
+    EXPECT_EQ(mcCreateContext(&utest_fixture->myContext, MC_NULL_HANDLE), MC_NO_ERROR);
+    EXPECT_TRUE(utest_fixture->myContext != nullptr);
+}
+
+UTEST_F_TEARDOWN(DeterministicDispatch)
+{
+    EXPECT_EQ(mcReleaseContext(utest_fixture->myContext), MC_NO_ERROR);
+}
+
+// Repeating a dispatch must produce exactly the same connected components in the same order. This
+// includes inputs for which the cut-mesh is perturbed, since each dispatch starts the perturbation afresh.
+// NOTE: both dispatches use the thread pool of the same context, whose size is fixed by the hardware. This
+// test therefore cannot detect output that depends on the number of threads; that needs a comparison of the
+// output of single-threaded and multi-threaded builds (or of machines with different numbers of cores).
+UTEST_F(DeterministicDispatch, sameOutputWhenRepeated)
+{
+    const McFlags flags = MC_DISPATCH_DETERMINISTIC | MC_DISPATCH_ENFORCE_GENERAL_POSITION;
+
+    for (int i = 0; i < NUMBER_OF_BENCHMARKS; ++i) {
+        const std::string srcMeshPath = getBenchmarkMeshPath(i, "src");
+        const std::string cutMeshPath = getBenchmarkMeshPath(i, "cut");
+
+        dispatch_output_t output[2];
+
+        const McResult result = dispatchAndGetOutput(utest_fixture->myContext, flags, srcMeshPath, cutMeshPath, output[0]);
+        ASSERT_EQ(dispatchAndGetOutput(utest_fixture->myContext, flags, srcMeshPath, cutMeshPath, output[1]), result);
+        EXPECT_TRUE(isSameDispatchOutput(output[0], output[1]));
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ * 
+ * NOTE: This file is licensed under GPL-3.0-or-later (default). 
+ * A commercial license can be purchased from Floyd M. Chitalu. 
+ *  
+ * License details:
+ * 
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have 
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ * 
+ * The commercial license options is for users that wish to use MCUT in 
+ * their products for comercial purposes but do not wish to release their 
+ * software products under the GPL license. 
+ * 
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#include "dispatchOutput.h"
+#include "off.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+std::string getBenchmarkMeshPath(int benchmarkIndex, const std::string& meshType)
+{
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(3) << benchmarkIndex;
+    return std::string(MESHES_DIR) + "/benchmarks/" + meshType + "-mesh" + ss.str() + ".off";
+}
+
+McResult dispatchAndGetOutput(McContext context, McFlags flags, const std::string& srcMeshPath, const std::string& cutMeshPath, dispatch_output_t& output)
+{
+    float* pSrcMeshVertices = NULL;
+    uint32_t* pSrcMeshFaceIndices = NULL;
+    uint32_t* pSrcMeshFaceSizes = NULL;
+    uint32_t numSrcMeshVertices = 0;
+    uint32_t numSrcMeshFaces = 0;
+
+    float* pCutMeshVertices = NULL;
+    uint32_t* pCutMeshFaceIndices = NULL;
+    uint32_t* pCutMeshFaceSizes = NULL;
+    uint32_t numCutMeshVertices = 0;
+    uint32_t numCutMeshFaces = 0;
+
+    readOFF(srcMeshPath.c_str(), &pSrcMeshVertices, &pSrcMeshFaceIndices, &pSrcMeshFaceSizes, &numSrcMeshVertices, &numSrcMeshFaces);
+    readOFF(cutMeshPath.c_str(), &pCutMeshVertices, &pCutMeshFaceIndices, &pCutMeshFaceSizes, &numCutMeshVertices, &numCutMeshFaces);
+
+    McResult result = mcDispatch(
+        context,
+        MC_DISPATCH_VERTEX_ARRAY_FLOAT | flags,
+        pSrcMeshVertices,
+        pSrcMeshFaceIndices,
+        pSrcMeshFaceSizes,
+        numSrcMeshVertices,
+        numSrcMeshFaces,
+        pCutMeshVertices,
+        pCutMeshFaceIndices,
+        pCutMeshFaceSizes,
+        numCutMeshVertices,
+        numCutMeshFaces);
+
+    free(pSrcMeshVertices);
+    free(pSrcMeshFaceIndices);
+    free(pSrcMeshFaceSizes);
+
+    free(pCutMeshVertices);
+    free(pCutMeshFaceIndices);
+    free(pCutMeshFaceSizes);
+
+    output.vertices.clear();
+    output.faceIndices.clear();
+    output.faceSizes.clear();
+
+    if (result != MC_NO_ERROR) {
+        return result;
+    }
+
+    uint32_t numConnComps = 0;
+    result = mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_ALL, 0, NULL, &numConnComps);
+
+    if (result != MC_NO_ERROR || numConnComps == 0) {
+        return result;
+    }
+
+    std::vector<McConnectedComponent> connComps(numConnComps);
+    result = mcGetConnectedComponents(context, MC_CONNECTED_COMPONENT_TYPE_ALL, numConnComps, connComps.data(), NULL);
+
+    output.vertices.resize(numConnComps);
+    output.faceIndices.resize(numConnComps);
+    output.faceSizes.resize(numConnComps);
+
+    for (uint32_t c = 0; c < numConnComps && result == MC_NO_ERROR; ++c) {
+        uint64_t numBytes = 0;
+        result = mcGetConnectedComponentData(context, connComps[c], MC_CONNECTED_COMPONENT_DATA_VERTEX_DOUBLE, 0, NULL, &numBytes);
+
+        if (result == MC_NO_ERROR) {
+            output.vertices[c].resize(numBytes / sizeof(double));
+            result = mcGetConnectedComponentData(context, connComps[c], MC_CONNECTED_COMPONENT_DATA_VERTEX_DOUBLE, numBytes, output.vertices[c].data(), NULL);
+        }
+
+        if (result == MC_NO_ERROR) {
+            result = mcGetConnectedComponentData(context, connComps[c], MC_CONNECTED_COMPONENT_DATA_FACE, 0, NULL, &numBytes);
+        }
+
+        if (result == MC_NO_ERROR) {
+            output.faceIndices[c].resize(numBytes / sizeof(uint32_t));
+            result = mcGetConnectedComponentData(context, connComps[c], MC_CONNECTED_COMPONENT_DATA_FACE, numBytes, output.faceIndices[c].data(), NULL);
+        }
+
+        if (result == MC_NO_ERROR) {
+            result = mcGetConnectedComponentData(context, connComps[c], MC_CONNECTED_COMPONENT_DATA_FACE_SIZE, 0, NULL, &numBytes);
+        }
+
+        if (result == MC_NO_ERROR) {
+            output.faceSizes[c].resize(numBytes / sizeof(uint32_t));
+            result = mcGetConnectedComponentData(context, connComps[c], MC_CONNECTED_COMPONENT_DATA_FACE_SIZE, numBytes, output.faceSizes[c].data(), NULL);
+        }
+    }
+
+    mcReleaseConnectedComponents(context, 0, NULL);
+
+    return result;
+}
+
+bool isSameDispatchOutput(const dispatch_output_t& a, const dispatch_output_t& b)
+{
+    if (a.vertices.size() != b.vertices.size()) {
+        return false;
+    }
+
+    for (size_t c = 0; c < a.vertices.size(); ++c) {
+        if (a.vertices[c] != b.vertices[c] || a.faceIndices[c] != b.faceIndices[c] || a.faceSizes[c] != b.faceSizes[c]) {
+            return false;
+        }
+    }
+
+    return true;
+}
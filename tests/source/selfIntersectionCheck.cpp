@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2021-2022 Floyd M. Chitalu.
+ * All rights reserved.
+ * 
+ * NOTE: This file is licensed under GPL-3.0-or-later (default). 
+ * A commercial license can be purchased from Floyd M. Chitalu. 
+ *  
+ * License details:
+ * 
+ * (A)  GNU General Public License ("GPL"); a copy of which you should have 
+ *      recieved with this file.
+ * 	    - see also: <http://www.gnu.org/licenses/>
+ * (B)  Commercial license.
+ *      - email: floyd.m.chitalu@gmail.com
+ * 
+ * The commercial license options is for users that wish to use MCUT in 
+ * their products for comercial purposes but do not wish to release their 
+ * software products under the GPL license. 
+ * 
+ * Author(s)     : Floyd M. Chitalu
+ */
+
+#include "utest.h"
+#include <mcut/mcut.h>
+#include <string>
+
+// A strip of four triangles, where the last triangle pierces the first one. Triangles
+// 0 and 3 share no vertex, but the vertical edge (4, 5) passes through triangle 0.
+static const float selfIntersectingMeshVertices[] = {
+    0.f, 0.f, 0.f, // 0
+    2.f, 0.f, 0.f, // 1
+    0.f, 2.f, 0.f, // 2
+    2.f, 2.f, 0.f, // 3
+    .5f, .5f, 1.f, // 4
+    .5f, .5f, -1.f // 5
+};
+static const uint32_t selfIntersectingMeshFaceIndices[] = { 0, 1, 2, 1, 3, 2, 2, 3, 4, 3, 5, 4 };
+static const uint32_t selfIntersectingMeshFaceSizes[] = { 3, 3, 3, 3 };
+
+// a triangle that cuts through the strip
+static const float triangleVertices[] = {
+    1.6f, -1.f, -1.f,
+    1.6f, 4.f, -1.f,
+    1.6f, 1.5f, 2.f
+};
+static const uint32_t triangleFaceIndices[] = { 0, 1, 2 };
+static const uint32_t triangleFaceSizes[] = { 3 };
+
+struct SelfIntersectionCheck {
+    McContext myContext = MC_NULL_HANDLE;
+    // number of messages about self-intersecting faces
+    int numMessages = 0;
+    // whether a message reported the pair of faces (0, 3)
+    bool reportedPair = false;
+};
+
+static void MCAPI_PTR selfIntersectionMessageCallback(McDebugSource /*source*/,
+    McDebugType type,
+    unsigned int /*id*/,
+    McDebugSeverity /*severity*/,
+    size_t /*length*/,
+    const char* message,
+    const void* userParam)
+{
+    const std::string msg(message);
+
+    if (type == MC_DEBUG_TYPE_ERROR && msg.find("self-intersecting") != std::string::npos) {
+        SelfIntersectionCheck* fixture = (SelfIntersectionCheck*)userParam;
+        fixture->numMessages++;
+        fixture->reportedPair = fixture->reportedPair || msg.find("(0, 3)") != std::string::npos;
+    }
+}
+
+UTEST_F_SETUP(SelfIntersectionCheck)
+{
+    EXPECT_EQ(mcCreateContext(&utest_fixture->myContext, MC_NULL_HANDLE), MC_NO_ERROR);
+    EXPECT_TRUE(utest_fixture->myContext != nullptr);
+    EXPECT_EQ(mcDebugMessageCallback(utest_fixture->myContext, selfIntersectionMessageCallback, utest_fixture), MC_NO_ERROR);
+    EXPECT_EQ(mcDebugMessageControl(utest_fixture->myContext, MC_DEBUG_SOURCE_ALL, MC_DEBUG_TYPE_ALL, MC_DEBUG_SEVERITY_ALL, true), MC_NO_ERROR);
+}
+
+UTEST_F_TEARDOWN(SelfIntersectionCheck)
+{
+    EXPECT_EQ(mcReleaseContext(utest_fixture->myContext), MC_NO_ERROR);
+}
+
+UTEST_F(SelfIntersectionCheck, selfIntersectingSourceMesh)
+{
+    ASSERT_EQ(mcDispatch(utest_fixture->myContext, MC_DISPATCH_VERTEX_ARRAY_FLOAT | MC_DISPATCH_CHECK_SELF_INTERSECTIONS, //
+                  selfIntersectingMeshVertices, selfIntersectingMeshFaceIndices, selfIntersectingMeshFaceSizes, 6, 4, //
+                  triangleVertices, triangleFaceIndices, triangleFaceSizes, 3, 1),
+        MC_INVALID_VALUE);
+
+    ASSERT_EQ(utest_fixture->numMessages, 1);
+    ASSERT_TRUE(utest_fixture->reportedPair);
+}
+
+UTEST_F(SelfIntersectionCheck, selfIntersectingCutMesh)
+{
+    ASSERT_EQ(mcDispatch(utest_fixture->myContext, MC_DISPATCH_VERTEX_ARRAY_FLOAT | MC_DISPATCH_CHECK_SELF_INTERSECTIONS, //
+                  triangleVertices, triangleFaceIndices, triangleFaceSizes, 3, 1, //
+                  selfIntersectingMeshVertices, selfIntersectingMeshFaceIndices, selfIntersectingMeshFaceSizes, 6, 4),
+        MC_INVALID_VALUE);
+
+    ASSERT_EQ(utest_fixture->numMessages, 1);
+    ASSERT_TRUE(utest_fixture->reportedPair);
+}
+
+// the check must not reject meshes that do not intersect themselves
+UTEST_F(SelfIntersectionCheck, noSelfIntersections)
+{
+    // the strip without its last triangle
+    ASSERT_EQ(mcDispatch(utest_fixture->myContext, MC_DISPATCH_VERTEX_ARRAY_FLOAT | MC_DISPATCH_CHECK_SELF_INTERSECTIONS, //
+                  selfIntersectingMeshVertices, selfIntersectingMeshFaceIndices, selfIntersectingMeshFaceSizes, 5, 3, //
+                  triangleVertices, triangleFaceIndices, triangleFaceSizes, 3, 1),
+        MC_NO_ERROR);
+
+    ASSERT_EQ(utest_fixture->numMessages, 0);
+}